@@ -139,7 +139,7 @@ int GAScripted::ReadProperty(const std::string_view &propName, Reader &reader) {
 
 int GAScripted::Save(Writer &writer) const {
     // Call the script OnSave() function, if it exists
-    g_LuaMan.GetMasterScriptState().RunScriptString("if " + m_LuaClassName + " and " + m_LuaClassName + ".OnSave then " + m_LuaClassName + ":OnSave(); end");
+    g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "OnSave");
 
     GameActivity::Save(writer);
 
@@ -288,7 +288,7 @@ bool GAScripted::SceneIsCompatible(Scene *pScene, int teams) {
     }
 
     // Call the defined function, but only after first checking if it exists
-    g_LuaMan.GetMasterScriptState().RunScriptString("if " + m_LuaClassName + ".SceneTest then " + m_LuaClassName + ":SceneTest(); end");
+    g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "SceneTest");
 
     // If the test left the Scene pointer still set, it means it passed the test
     return g_LuaMan.GetMasterScriptState().GlobalIsDefined("TestScene");
@@ -300,7 +300,7 @@ void GAScripted::HandleCraftEnteringOrbit(ACraft *orbitedCraft) {
     GameActivity::HandleCraftEnteringOrbit(orbitedCraft);
 
     if (orbitedCraft && g_MovableMan.IsActor(orbitedCraft)) {
-        g_LuaMan.GetMasterScriptState().RunScriptFunctionString(m_LuaClassName + ".CraftEnteredOrbit", m_LuaClassName, {m_LuaClassName, m_LuaClassName + ".CraftEnteredOrbit"}, {orbitedCraft});
+        g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "CraftEnteredOrbit", {orbitedCraft});
         for (const GlobalScript *globalScript : m_GlobalScriptsList) {
             if (globalScript->IsActive()) { globalScript->HandleCraftEnteringOrbit(orbitedCraft); }
         }
@@ -334,7 +334,7 @@ int GAScripted::Start() {
     }
 
     // Call the defined function, but only after first checking if it exists
-    if ((error = g_LuaMan.GetMasterScriptState().RunScriptString("if " + m_LuaClassName + ".StartActivity then " + m_LuaClassName + ":StartActivity( " + (initialActivityState == ActivityState::NotStarted ? "true" : "false") + "); end")) < 0) {
+    if ((error = g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "StartActivity", {}, {initialActivityState == ActivityState::NotStarted ? "true" : "false"})) < 0) {
         return error;
     }
 
@@ -378,7 +378,7 @@ void GAScripted::SetPaused(bool pause) {
     GameActivity::SetPaused(pause);
 
     // Call the defined function, but only after first checking if it exists
-    g_LuaMan.GetMasterScriptState().RunScriptString("if " + m_LuaClassName + ".PauseActivity then " + m_LuaClassName + ":PauseActivity(" + (pause ? "true" : "false") + "); end");
+    g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "PauseActivity", {}, {pause ? "true" : "false"});
 
 	// Pause all global scripts
 	for (std::vector<GlobalScript *>::iterator sItr = m_GlobalScriptsList.begin(); sItr < m_GlobalScriptsList.end(); ++sItr) {
@@ -398,7 +398,7 @@ void GAScripted::End() {
     GameActivity::End();
 
     // Call the defined function, but only after first checking if it exists
-    g_LuaMan.GetMasterScriptState().RunScriptString("if " + m_LuaClassName + ".EndActivity then " + m_LuaClassName + ":EndActivity(); end");
+    g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "EndActivity");
 
 
 	// End all global scripts
@@ -457,7 +457,7 @@ void GAScripted::Update() {
 		AddPieSlicesToActiveActorPieMenus();
 
         // Call the defined function, but only after first checking if it exists
-        g_LuaMan.GetMasterScriptState().RunScriptString("if " + m_LuaClassName + ".UpdateActivity then " + m_LuaClassName + ":UpdateActivity(); end");
+        g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "UpdateActivity");
 
         UpdateGlobalScripts(false);
     }
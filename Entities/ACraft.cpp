@@ -271,7 +271,7 @@ void ACraft::Clear()
     m_CurrentExit = m_Exits.begin();
     m_ExitInterval = 1000;
     m_ExitTimer.Reset();
-    m_ExitLinePhase = 0;
+    m_ExitLinePhase.fill(0);
     m_HasDelivered = false;
     m_LandingCraft = true;
     m_FlippedTimer.Reset();
@@ -959,7 +959,7 @@ void ACraft::Update()
 //                  BITMAP of choice.
 
 void ACraft::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichScreen, bool playerControlled) {
-	m_HUDStack = -m_CharHeight / 2;
+	m_HUDStack[whichScreen] = -m_CharHeight / 2;
 
     // Only do HUD if on a team
     if (m_Team < 0)
@@ -992,15 +992,15 @@ void ACraft::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichSc
             //  |  /  /
             //  --------
             // Make the dotted lines crawl out of the exit, indicating that things are still coming out
-            if (--m_ExitLinePhase < 0)
-                m_ExitLinePhase = EXITLINESPACING - 1;
+            if (--m_ExitLinePhase[whichScreen] < 0)
+                m_ExitLinePhase[whichScreen] = EXITLINESPACING - 1;
         }
         // Inventory empty and doors open, so show arrows pointing into the exits IF the delay to allow for things to eject away all the way has passed
         else if (m_ExitTimer.IsPastSimMS(EXITSUCKDELAYMS))
         {
             // Make the dotted lines crawl back into the exit, inviting people to jump in
-            if (++m_ExitLinePhase >= EXITLINESPACING)
-                m_ExitLinePhase = 0;
+            if (++m_ExitLinePhase[whichScreen] >= EXITLINESPACING)
+                m_ExitLinePhase[whichScreen] = 0;
         }
 
         Vector exitRadius;
@@ -1014,9 +1014,9 @@ void ACraft::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichSc
                 exitRadius = RotateOffset(exit->GetVelocity().GetPerpendicular().SetMagnitude(exit->GetRadius()));
                 exitCorner = m_Pos - targetPos + RotateOffset(exit->GetOffset()) + exitRadius;
                 arrowVec = RotateOffset(exit->GetVelocity().SetMagnitude(exit->GetRange()));
-                g_FrameMan.DrawLine(pTargetBitmap, exitCorner, exitCorner + arrowVec, 120, 120, EXITLINESPACING, m_ExitLinePhase);
+                g_FrameMan.DrawLine(pTargetBitmap, exitCorner, exitCorner + arrowVec, 120, 120, EXITLINESPACING, m_ExitLinePhase[whichScreen]);
                 exitCorner -= exitRadius * 2;
-                g_FrameMan.DrawLine(pTargetBitmap, exitCorner, exitCorner + arrowVec, 120, 120, EXITLINESPACING, m_ExitLinePhase);
+                g_FrameMan.DrawLine(pTargetBitmap, exitCorner, exitCorner + arrowVec, 120, 120, EXITLINESPACING, m_ExitLinePhase[whichScreen]);
             }
         }
     }
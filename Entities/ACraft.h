@@ -625,8 +625,8 @@ protected:
     long m_ExitInterval;
     // Times the exit interval
     Timer m_ExitTimer;
-    // The phase of the exit lines animation
-    int m_ExitLinePhase;
+    // The phase of the exit lines animation on each screen
+    std::array<int, c_MaxScreenCount> m_ExitLinePhase;
     // Whether this has landed and delivered yet on its current run
     bool m_HasDelivered;
     // Whether this is capable of landing on the ground at all
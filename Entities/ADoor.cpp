@@ -525,7 +525,7 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void ADoor::DrawHUD(BITMAP *targetBitmap, const Vector &targetPos, int whichScreen, bool playerControlled) {
-		m_HUDStack = -static_cast<int>(m_CharHeight) / 2;
+		m_HUDStack[whichScreen] = -static_cast<int>(m_CharHeight) / 2;
 
 		if (!m_HUDVisible) {
 			return;
@@ -542,7 +542,7 @@ void AEmitter::Update()
                         pParticle->SetWhichMOToNotHit(pRootParent);
 
                     // Let particle loose into the world!
-                    g_MovableMan.AddMO(pParticle);
+                    g_MovableMan.AddMO(pParticle, true);
                     pParticle = 0;
                 }
             }
@@ -74,7 +74,6 @@ void Actor::Clear() {
     m_Status = STABLE;
     m_Health = m_PrevHealth = m_MaxHealth = 100.0F;
 	m_pTeamIcon = nullptr;
-	m_pControllerIcon = nullptr;
     m_LastSecondTimer.Reset();
     m_LastSecondPos.Reset();
     m_RecentMovement.Reset();
@@ -112,7 +111,7 @@ void Actor::Clear() {
     m_Inventory.clear();
 	m_MaxInventoryMass = -1.0F;
 	m_pItemInReach = nullptr;
-    m_HUDStack = 0;
+    m_HUDStack.fill(0);
 	m_DeploymentID = 0;
     m_PassengerSlots = 1;
 
@@ -160,7 +159,7 @@ int Actor::Create()
     m_UpdateMovePath = true;
 
     m_ViewPoint = m_Pos;
-    m_HUDStack = -m_CharHeight / 2;
+    m_HUDStack.fill(-m_CharHeight / 2);
 
     // Sets up the team icon
     SetTeam(m_Team);
@@ -497,6 +496,10 @@ void Actor::DestroyScriptState() {
 
 void Actor::Destroy(bool notInherited)
 {
+	if (m_PathRequest) {
+		const_cast<PathRequest &>(*m_PathRequest).cancelled = true;
+	}
+
 	delete m_DeviceSwitchSound;
 	delete m_BodyHitSound;
 	delete m_PainSound;
@@ -1205,6 +1208,11 @@ void Actor::UpdateMovePath()
     // Estimate how much material this actor can dig through
     float digStrength = EstimateDigStrength();
 
+    // Any path we were still waiting on is about to be replaced, so don't waste a solve on it if it hasn't started yet
+    if (m_PathRequest) {
+        const_cast<PathRequest &>(*m_PathRequest).cancelled = true;
+    }
+
     // If we're following someone/thing, then never advance waypoints until that thing disappears
     if (g_MovableMan.ValidMO(m_pMOMoveTarget)) {
         m_PathRequest = g_SceneMan.GetScene()->CalculatePathAsync(g_SceneMan.MovePointToGround(m_Pos, m_CharHeight*0.2, 10), m_pMOMoveTarget->GetPos(), digStrength, static_cast<Activity::Teams>(m_Team));
@@ -1234,8 +1242,9 @@ void Actor::UpdateMovePath()
             }
         }
         // We had a path before trying to update, so use its last point as the final destination
+        // We can keep following the old path in the meantime, so this refresh can wait behind requests from actors that have no path at all
         else {
-            m_PathRequest = g_SceneMan.GetScene()->CalculatePathAsync(g_SceneMan.MovePointToGround(m_Pos, m_CharHeight*0.2, 10), Vector(m_MovePath.back()), digStrength, static_cast<Activity::Teams>(m_Team));
+            m_PathRequest = g_SceneMan.GetScene()->CalculatePathAsync(g_SceneMan.MovePointToGround(m_Pos, m_CharHeight*0.2, 10), Vector(m_MovePath.back()), digStrength, static_cast<Activity::Teams>(m_Team), nullptr, TaskPriority::Low);
         }
     }
     
@@ -1521,8 +1530,8 @@ void Actor::FullUpdate() {
 
 void Actor::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichScreen, bool playerControlled)
 {
-	// This should indeed be a local var and not alter a member one in a draw func! Can cause nasty jittering etc if multiple sim updates are done without a drawing in between etc
-    m_HUDStack = -m_CharHeight / 2;
+	// Each screen stacks its own HUD, since the screens are drawn in parallel and may show different parts of it.
+    m_HUDStack[whichScreen] = -m_CharHeight / 2;
 
     // Only do HUD if on a team
     if (m_Team < 0)
@@ -1591,12 +1600,12 @@ void Actor::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichScr
     if (m_Controller.IsPlayerControlled() && m_NewControlTmr.GetElapsedSimTimeMS() < ARROWTIME)
     {
 		// Draw the appropriate selection arrow color based on player team
-        draw_sprite(pTargetBitmap, m_apSelectArrow[m_Team], cpuPos.m_X, EaseOut(drawPos.m_Y + m_HUDStack - 60, drawPos.m_Y + m_HUDStack - 20, m_NewControlTmr.GetElapsedSimTimeMS() / (float)ARROWTIME));
+        draw_sprite(pTargetBitmap, m_apSelectArrow[m_Team], cpuPos.m_X, EaseOut(drawPos.m_Y + m_HUDStack[whichScreen] - 60, drawPos.m_Y + m_HUDStack[whichScreen] - 20, m_NewControlTmr.GetElapsedSimTimeMS() / (float)ARROWTIME));
     }
 
     // Draw the alarm exclamation mark if we are alarmed!
     if (m_AlarmTimer.SimTimeLimitProgress() < 0.25)
-        draw_sprite(pTargetBitmap, m_apAlarmExclamation[m_AgeTimer.AlternateSim(100)], cpuPos.m_X - 3, EaseOut(drawPos.m_Y + m_HUDStack - 10, drawPos.m_Y + m_HUDStack - 25, m_AlarmTimer.SimTimeLimitProgress() / 0.25f));
+        draw_sprite(pTargetBitmap, m_apAlarmExclamation[m_AgeTimer.AlternateSim(100)], cpuPos.m_X - 3, EaseOut(drawPos.m_Y + m_HUDStack[whichScreen] - 10, drawPos.m_Y + m_HUDStack[whichScreen] - 25, m_AlarmTimer.SimTimeLimitProgress() / 0.25f));
 
     if (pSmallFont && pSymbolFont)
     {
@@ -1609,20 +1618,20 @@ void Actor::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichScr
             {
 				if (IsPlayerControlled() && g_FrameMan.IsInMultiplayerMode())
 				{
-					m_pControllerIcon = 0;
+					const Icon *controllerIcon = nullptr;
 					if (m_Team == 0)
-						m_pControllerIcon = g_UInputMan.GetDeviceIcon(DEVICE_GAMEPAD_1);
+						controllerIcon = g_UInputMan.GetDeviceIcon(DEVICE_GAMEPAD_1);
 					else if (m_Team == 1)
-						m_pControllerIcon = g_UInputMan.GetDeviceIcon(DEVICE_GAMEPAD_2);
+						controllerIcon = g_UInputMan.GetDeviceIcon(DEVICE_GAMEPAD_2);
 					else if (m_Team == 2)
-						m_pControllerIcon = g_UInputMan.GetDeviceIcon(DEVICE_GAMEPAD_3);
+						controllerIcon = g_UInputMan.GetDeviceIcon(DEVICE_GAMEPAD_3);
 					else if (m_Team == 3)
-						m_pControllerIcon = g_UInputMan.GetDeviceIcon(DEVICE_GAMEPAD_4);
-					if (m_pControllerIcon)
+						controllerIcon = g_UInputMan.GetDeviceIcon(DEVICE_GAMEPAD_4);
+					if (controllerIcon)
 					{
-						std::vector<BITMAP *> apControllerBitmaps = m_pControllerIcon->GetBitmaps8();
+						std::vector<BITMAP *> apControllerBitmaps = controllerIcon->GetBitmaps8();
 
-						masked_blit(apControllerBitmaps[0], pTargetBitmap, 0, 0, drawPos.m_X - apControllerBitmaps[0]->w - 2 + 10, drawPos.m_Y + m_HUDStack - (apControllerBitmaps[0]->h / 2) + 8, apControllerBitmaps[0]->w, apControllerBitmaps[0]->h);
+						masked_blit(apControllerBitmaps[0], pTargetBitmap, 0, 0, drawPos.m_X - apControllerBitmaps[0]->w - 2 + 10, drawPos.m_Y + m_HUDStack[whichScreen] - (apControllerBitmaps[0]->h / 2) + 8, apControllerBitmaps[0]->w, apControllerBitmaps[0]->h);
 					}
 				}
 
@@ -1641,7 +1650,7 @@ void Actor::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichScr
                     // Make team icon blink faster as the health goes down
                     int f = m_HeartBeat.AlternateReal(200 + 800 * (m_Health / 100)) ? 0 : 1;
                     f = MIN(f, m_pTeamIcon ? m_pTeamIcon->GetFrameCount() - 1 : 1);
-                    masked_blit(apIconBitmaps.at(f), pTargetBitmap, 0, 0, drawPos.m_X - apIconBitmaps.at(f)->w - 2, drawPos.m_Y + m_HUDStack - (apIconBitmaps.at(f)->h / 2) + 8, apIconBitmaps.at(f)->w, apIconBitmaps.at(f)->h);
+                    masked_blit(apIconBitmaps.at(f), pTargetBitmap, 0, 0, drawPos.m_X - apIconBitmaps.at(f)->w - 2, drawPos.m_Y + m_HUDStack[whichScreen] - (apIconBitmaps.at(f)->h / 2) + 8, apIconBitmaps.at(f)->w, apIconBitmaps.at(f)->h);
                 }
             }
             // Draw death icon
@@ -1649,7 +1658,7 @@ void Actor::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichScr
             {
                 str[0] = -39;
                 str[1] = 0;
-                pSymbolFont->DrawAligned(&bitmapInt, drawPos.m_X - 10, drawPos.m_Y + m_HUDStack, str, GUIFont::Left);
+                pSymbolFont->DrawAligned(&bitmapInt, drawPos.m_X - 10, drawPos.m_Y + m_HUDStack[whichScreen], str, GUIFont::Left);
             }
 
 /* Obsolete red/gren heart Team icon
@@ -1658,7 +1667,7 @@ void Actor::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichScr
             {
                 str[0] = m_Health > 0 ? (m_Team == 0 ? -64 : -61) : -39;
                 str[1] = 0;
-                pSymbolFont->DrawAligned(&bitmapInt, drawPos.m_X - 10, drawPos.m_Y + m_HUDStack, str, GUIFont::Left);
+                pSymbolFont->DrawAligned(&bitmapInt, drawPos.m_X - 10, drawPos.m_Y + m_HUDStack[whichScreen], str, GUIFont::Left);
                 if (m_HeartBeat.GetElapsedSimTimeMS() > (m_Health > 90 ? 950 : (m_Health > 25 ? 500 : 175)))
                     m_HeartBeat.Reset();
             }
@@ -1666,28 +1675,28 @@ void Actor::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichScr
             {
                 str[0] = m_Team == 0 ? -63 : -60;
                 str[1] = 0;
-                pSymbolFont->DrawAligned(&bitmapInt, drawPos.m_X - 11, drawPos.m_Y + m_HUDStack, str, GUIFont::Left);
+                pSymbolFont->DrawAligned(&bitmapInt, drawPos.m_X - 11, drawPos.m_Y + m_HUDStack[whichScreen], str, GUIFont::Left);
             }
 */
 			std::snprintf(str, sizeof(str), "%.0f", std::ceil(m_Health));
-            pSymbolFont->DrawAligned(&bitmapInt, drawPos.m_X - 0, drawPos.m_Y + m_HUDStack, str, GUIFont::Left);
+            pSymbolFont->DrawAligned(&bitmapInt, drawPos.m_X - 0, drawPos.m_Y + m_HUDStack[whichScreen], str, GUIFont::Left);
 
-            m_HUDStack += -12;
+            m_HUDStack[whichScreen] += -12;
 
 			if (IsPlayerControlled()) {
 				if (GetGoldCarried() > 0) {
 					str[0] = m_GoldPicked ? -57 : -58; str[1] = 0;
-					pSymbolFont->DrawAligned(&bitmapInt, drawPos.GetFloorIntX() - 11, drawPos.GetFloorIntY() + m_HUDStack, str, GUIFont::Left);
+					pSymbolFont->DrawAligned(&bitmapInt, drawPos.GetFloorIntX() - 11, drawPos.GetFloorIntY() + m_HUDStack[whichScreen], str, GUIFont::Left);
 					std::snprintf(str, sizeof(str), "%.0f oz", GetGoldCarried());
-					pSmallFont->DrawAligned(&bitmapInt, drawPos.GetFloorIntX() - 0, drawPos.GetFloorIntY() + m_HUDStack + 2, str, GUIFont::Left);
+					pSmallFont->DrawAligned(&bitmapInt, drawPos.GetFloorIntX() - 0, drawPos.GetFloorIntY() + m_HUDStack[whichScreen] + 2, str, GUIFont::Left);
 
-					m_HUDStack -= 11;
+					m_HUDStack[whichScreen] -= 11;
 				}
 				// Player name
 				if (g_FrameMan.IsInMultiplayerMode()) {
 					if (GameActivity * gameActivity = dynamic_cast<GameActivity *>(g_ActivityMan.GetActivity())) {
-						pSmallFont->DrawAligned(&bitmapInt, drawPos.GetFloorIntX(), drawPos.GetFloorIntY() + m_HUDStack + 2, gameActivity->GetNetworkPlayerName(m_Controller.GetPlayer()).c_str(), GUIFont::Centre);
-						m_HUDStack -= 11;
+						pSmallFont->DrawAligned(&bitmapInt, drawPos.GetFloorIntX(), drawPos.GetFloorIntY() + m_HUDStack[whichScreen] + 2, gameActivity->GetNetworkPlayerName(m_Controller.GetPlayer()).c_str(), GUIFont::Centre);
+						m_HUDStack[whichScreen] -= 11;
 					}
 				}
 			}
@@ -1696,7 +1705,7 @@ void Actor::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whichScr
             if (m_Controller.IsPlayetControlled() && m_NewControlTmr.GetElapsedSimTimeMS() < 1500)
             {
                 std::snprintf(str, sizeof(str), "%c", -38);
-                pSymbolFont->DrawAligned(&bitmapInt, cpuPos.m_X - 0, drawPos.m_Y + m_HUDStack, str, GUIFont::Left);
+                pSymbolFont->DrawAligned(&bitmapInt, cpuPos.m_X - 0, drawPos.m_Y + m_HUDStack[whichScreen], str, GUIFont::Left);
             }
 */
         }
@@ -378,7 +378,7 @@ ClassInfoGetters;
 // Arguments:       None.
 // Return value:    A Vector with the absolute position of this' HUD stack top point.
 
-	Vector GetAboveHUDPos() const override { return m_Pos + Vector(0, m_HUDStack + 6); }
+	Vector GetAboveHUDPos() const override { return m_Pos + Vector(0, static_cast<float>(*std::min_element(m_HUDStack.begin(), m_HUDStack.end()) + 6)); }
 
 
 	/// <summary>
@@ -1459,8 +1459,6 @@ protected:
     float m_PrevHealth;
     // Not owned by this!
     const Icon *m_pTeamIcon;
-	// Not owned by this!
-	const Icon *m_pControllerIcon;
     // Timing the last second to store the position each second so we can determine larger movement
     Timer m_LastSecondTimer;
     // This' position up to a second ago
@@ -1536,8 +1534,8 @@ protected:
     float m_MaxInventoryMass; //!< The mass limit for this Actor's inventory. -1 means there's no limit.
     // The device that can/will be picked up
     HeldDevice *m_pItemInReach;
-    // HUD positioning aid
-    int m_HUDStack;
+    // HUD positioning aid, per screen
+    std::array<int, c_MaxScreenCount> m_HUDStack;
 	// ID of deployment which spawned this actor
 	unsigned int m_DeploymentID;
     // How many passenger slots this actor will take in a craft
@@ -87,7 +87,7 @@ namespace RTE {
 
 	int GlobalScript::Start() {
 		int error = ReloadScripts();
-		if (error == 0) { error = g_LuaMan.GetMasterScriptState().RunScriptString("if " + m_LuaClassName + ".StartScript then " + m_LuaClassName + ":StartScript(); end"); }
+		if (error == 0) { error = g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "StartScript"); }
 		m_IsActive = error == 0;
 
 		return error;
@@ -96,27 +96,27 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int GlobalScript::Pause(bool pause) const {
-		return g_LuaMan.GetMasterScriptState().RunScriptString("if " + m_LuaClassName + ".PauseScript then " + m_LuaClassName + ":PauseScript(" + (pause ? "true" : "false") + "); end");
+		return g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "PauseScript", {}, { pause ? "true" : "false" });
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int GlobalScript::End() const {
-		return g_LuaMan.GetMasterScriptState().RunScriptString("if " + m_LuaClassName + ".EndScript then " + m_LuaClassName + ":EndScript(); end");
+		return g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "EndScript");
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void GlobalScript::HandleCraftEnteringOrbit(const ACraft *orbitedCraft) const {
 		if (orbitedCraft && g_MovableMan.IsActor(orbitedCraft)) {
-			g_LuaMan.GetMasterScriptState().RunScriptFunctionString(m_LuaClassName + ".CraftEnteredOrbit", m_LuaClassName, { m_LuaClassName, m_LuaClassName + ".CraftEnteredOrbit" }, { orbitedCraft });
+			g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "CraftEnteredOrbit", { orbitedCraft });
 		}
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void GlobalScript::Update() {
-		int error = g_LuaMan.GetMasterScriptState().RunScriptString("if " + m_LuaClassName + ".UpdateScript then " + m_LuaClassName + ":UpdateScript(); end");
+		int error = g_LuaMan.GetMasterScriptState().RunScriptMethod(m_LuaClassName, "UpdateScript");
 		if (error) { SetActive(false); }
 	}
 }
\ No newline at end of file
@@ -921,7 +921,7 @@ void HDFirearm::Update()
 						lethalRange *= std::max(1.0F - std::abs(shake) / 20.0F, 0.1F);
 						pPixel->SetLethalRange(lethalRange);
 					}
-                    g_MovableMan.AddParticle(pParticle);
+                    g_MovableMan.AddParticle(pParticle, true);
                 }
                 pParticle = 0;
 
@@ -949,7 +949,7 @@ void HDFirearm::Update()
 					// Set this to ignore team hits in case it's lethal
 					// TODO: Don't hardcode this???
 					pShell->SetIgnoresTeamHits(true);
-                    g_MovableMan.AddParticle(pShell);
+                    g_MovableMan.AddParticle(pShell, true);
                     pShell = 0;
                 }
 
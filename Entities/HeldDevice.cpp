@@ -471,6 +471,12 @@ void HeldDevice::Update()
     }
 
 	if (m_BlinkTimer.IsPastSimTimeLimit()) { m_BlinkTimer.Reset(); }
+
+	// Reset the pickup HUD state here rather than in DrawHUD, which runs for all player screens at once.
+	if (m_Parent && !IsUnPickupable()) {
+		m_SeenByPlayer.fill(false);
+		m_BlinkTimer.Reset();
+	}
 }
 
 
@@ -527,10 +533,7 @@ void HeldDevice::DrawHUD(BITMAP *pTargetBitmap, const Vector &targetPos, int whi
     Attachable::DrawHUD(pTargetBitmap, targetPos, whichScreen);
 
 	if (!IsUnPickupable()) {
-		if (m_Parent) {
-			m_SeenByPlayer.fill(false);
-			m_BlinkTimer.Reset();
-		} else {
+		if (!m_Parent) {
 			int viewingPlayer = g_ActivityMan.GetActivity()->PlayerOfScreen(whichScreen);
             if (viewingPlayer == -1) {
                 return;
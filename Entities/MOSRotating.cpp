@@ -30,19 +30,8 @@ namespace RTE {
 
 ConcreteClassInfo(MOSRotating, MOSprite, 500);
 
-BITMAP * MOSRotating::m_spTempBitmap16 = 0;
-BITMAP * MOSRotating::m_spTempBitmap32 = 0;
-BITMAP * MOSRotating::m_spTempBitmap64 = 0;
-BITMAP * MOSRotating::m_spTempBitmap128 = 0;
-BITMAP * MOSRotating::m_spTempBitmap256 = 0;
-BITMAP * MOSRotating::m_spTempBitmap512 = 0;
-
-BITMAP * MOSRotating::m_spTempBitmapS16 = 0;
-BITMAP * MOSRotating::m_spTempBitmapS32 = 0;
-BITMAP * MOSRotating::m_spTempBitmapS64 = 0;
-BITMAP * MOSRotating::m_spTempBitmapS128 = 0;
-BITMAP * MOSRotating::m_spTempBitmapS256 = 0;
-BITMAP * MOSRotating::m_spTempBitmapS512 = 0;
+RotatedSpriteCache MOSRotating::s_RotatedSpriteCache;
+thread_local MOSRotating::IntermediateBitmaps MOSRotating::s_IntermediateBitmaps;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -83,14 +72,12 @@ void MOSRotating::Clear()
     m_GibSound = nullptr;
     m_EffectOnGib = true;
     m_pFlipBitmap = 0;
-	m_pFlipBitmapS = 0;
-	m_pTempBitmap = 0;
-	m_pTempBitmapS = 0;
     m_LoudnessOnGib = 1;
 	m_DamageMultiplier = 0;
     m_NoSetDamageMultiplier = true;
 	m_FlashWhiteTimer.Reset();
 	m_FlashWhiteTimer.SetRealTimeLimitMS(0);
+	m_RotatedSpriteCacheAngleStep = 0;
     m_StringValueMap.clear();
     m_NumberValueMap.clear();
     m_ObjectValueMap.clear();
@@ -128,74 +115,6 @@ int MOSRotating::Create()
 	if (!m_pFlipBitmap && m_aSprite[0]) {
 		m_pFlipBitmap = create_bitmap_ex(8, m_aSprite[0]->w, m_aSprite[0]->h);
 	}
-	if (!m_pFlipBitmapS && m_aSprite[0]) {
-		m_pFlipBitmapS = create_bitmap_ex(c_MOIDLayerBitDepth, m_aSprite[0]->w, m_aSprite[0]->h);
-	}
-
-/* Not anymore; points to shared static bitmaps
-    if (!m_pTempBitmap && m_aSprite[0])
-        m_pTempBitmap = create_bitmap_ex(8, m_aSprite[0]->w, m_aSprite[0]->h);
-*/
-
-    // Can't create these earlier in the static declaration because allegro_init needs to be called before create_bitmap
-    if (!m_spTempBitmap16)
-        m_spTempBitmap16 = create_bitmap_ex(8, 16, 16);
-    if (!m_spTempBitmap32)
-        m_spTempBitmap32 = create_bitmap_ex(8, 32, 32);
-    if (!m_spTempBitmap64)
-        m_spTempBitmap64 = create_bitmap_ex(8, 64, 64);
-    if (!m_spTempBitmap128)
-        m_spTempBitmap128 = create_bitmap_ex(8, 128, 128);
-    if (!m_spTempBitmap256)
-        m_spTempBitmap256 = create_bitmap_ex(8, 256, 256);
-    if (!m_spTempBitmap512)
-        m_spTempBitmap512 = create_bitmap_ex(8, 512, 512);
-
-    // Can't create these earlier in the static declaration because allegro_init needs to be called before create_bitmap
-    if (!m_spTempBitmapS16)
-        m_spTempBitmapS16 = create_bitmap_ex(c_MOIDLayerBitDepth, 16, 16);
-    if (!m_spTempBitmapS32)
-        m_spTempBitmapS32 = create_bitmap_ex(c_MOIDLayerBitDepth, 32, 32);
-    if (!m_spTempBitmapS64)
-        m_spTempBitmapS64 = create_bitmap_ex(c_MOIDLayerBitDepth, 64, 64);
-    if (!m_spTempBitmapS128)
-        m_spTempBitmapS128 = create_bitmap_ex(c_MOIDLayerBitDepth, 128, 128);
-    if (!m_spTempBitmapS256)
-        m_spTempBitmapS256 = create_bitmap_ex(c_MOIDLayerBitDepth, 256, 256);
-    if (!m_spTempBitmapS512)
-        m_spTempBitmapS512 = create_bitmap_ex(c_MOIDLayerBitDepth, 512, 512);
-
-    // Choose an appropriate size for this' diameter
-    if (m_SpriteDiameter >= 256)
-	{
-        m_pTempBitmap = m_spTempBitmap512;
-        m_pTempBitmapS = m_spTempBitmapS512;
-	}
-    else if (m_SpriteDiameter >= 128)
-	{
-        m_pTempBitmap = m_spTempBitmap256;
-        m_pTempBitmapS = m_spTempBitmapS256;
-	}
-    else if (m_SpriteDiameter >= 64)
-	{
-        m_pTempBitmap = m_spTempBitmap128;
-        m_pTempBitmapS = m_spTempBitmapS128;
-	}
-    else if (m_SpriteDiameter >= 32)
-	{
-        m_pTempBitmap = m_spTempBitmap64;
-        m_pTempBitmapS = m_spTempBitmapS64;
-	}
-    else if (m_SpriteDiameter >= 16)
-	{
-        m_pTempBitmap = m_spTempBitmap32;
-        m_pTempBitmapS = m_spTempBitmapS32;
-	}
-    else
-	{
-		m_pTempBitmap = m_spTempBitmap16;
-		m_pTempBitmapS = m_spTempBitmapS16;
-	}
 
     return 0;
 }
@@ -218,9 +137,6 @@ int MOSRotating::Create(ContentFile spriteFile,
 	if (!m_pFlipBitmap && m_aSprite[0]) {
 		m_pFlipBitmap = create_bitmap_ex(8, m_aSprite[0]->w, m_aSprite[0]->h);
 	}
-	if (!m_pFlipBitmapS && m_aSprite[0]) {
-		m_pFlipBitmapS = create_bitmap_ex(c_MOIDLayerBitDepth, m_aSprite[0]->w, m_aSprite[0]->h);
-	}
 
     return 0;
 }
@@ -290,15 +206,11 @@ int MOSRotating::Create(const MOSRotating &reference) {
 	m_DamageMultiplier = reference.m_DamageMultiplier;
     m_NoSetDamageMultiplier = reference.m_NoSetDamageMultiplier;
 
-    m_pTempBitmap = reference.m_pTempBitmap;
-    m_pTempBitmapS = reference.m_pTempBitmapS;
+	m_RotatedSpriteCacheAngleStep = reference.m_RotatedSpriteCacheAngleStep;
 	
 	if (!m_pFlipBitmap && m_aSprite[0]) {
 		m_pFlipBitmap = create_bitmap_ex(8, m_aSprite[0]->w, m_aSprite[0]->h);
 	}
-	if (!m_pFlipBitmapS && m_aSprite[0]) {
-		m_pFlipBitmapS = create_bitmap_ex(c_MOIDLayerBitDepth, m_aSprite[0]->w, m_aSprite[0]->h);
-	}
 
     return 0;
 }
@@ -376,6 +288,7 @@ int MOSRotating::ReadProperty(const std::string_view &propName, Reader &reader)
         m_NoSetDamageMultiplier = false;
     });
     MatchProperty("AddCustomValue", { ReadCustomValueProperty(reader); });
+	MatchProperty("RotatedSpriteCacheAngleStep", { SetRotatedSpriteCacheAngleStep(std::stof(reader.ReadPropValue())); });
     
     
     EndPropertyList;
@@ -412,6 +325,8 @@ int MOSRotating::Save(Writer &writer) const
 {
     MOSprite::Save(writer);
 
+    writer.NewPropertyWithValue("RotatedSpriteCacheAngleStep", m_RotatedSpriteCacheAngleStep);
+
 // TODO: Make proper save system that knows not to save redundant data!
 /*
     writer.NewProperty("AtomGroup");
@@ -552,6 +467,7 @@ void MOSRotating::AddWound(AEmitter *woundToAdd, const Vector &parentOffsetToSet
         if (woundToAdd->HasNoSetDamageMultiplier()) { woundToAdd->SetDamageMultiplier(1.0F); }
         m_AttachableAndWoundMass += woundToAdd->GetMass();
         m_Wounds.push_back(woundToAdd);
+        g_MovableMan.QueueThreadedBucketUpdate(woundToAdd);
     }
 }
 
@@ -646,10 +562,6 @@ void MOSRotating::Destroy(bool notInherited)
     }
 
     destroy_bitmap(m_pFlipBitmap);
-    destroy_bitmap(m_pFlipBitmapS);
-
-// Not anymore; point to shared static bitmaps
-//    destroy_bitmap(m_pTempBitmap);
 
 	delete m_GibSound;
 
@@ -1142,7 +1054,7 @@ void MOSRotating::CreateGibsWhenGibbing(const Vector &impactImpulse, MovableObje
 					gibParticleClone->SetIgnoresTeamHits(true);
 				}
 
-				g_MovableMan.AddParticle(gibParticleClone);
+				g_MovableMan.AddParticle(gibParticleClone, true);
 			}
 		} else {
 			for (int i = 0; i < count; i++) {
@@ -1189,7 +1101,7 @@ void MOSRotating::CreateGibsWhenGibbing(const Vector &impactImpulse, MovableObje
 					gibParticleClone->SetIgnoresTeamHits(true);
 				}
 
-				g_MovableMan.AddParticle(gibParticleClone);
+				g_MovableMan.AddParticle(gibParticleClone, true);
 			}
 		}
     }
@@ -1454,7 +1366,7 @@ bool MOSRotating::DeepCheck(bool makeMOPs, int skipMOP, int maxMOPs)
                     (*itr)->SetPos((*itr)->GetPos() - m_Vel.GetNormalized() * depth);
 					(*itr)->SetVel(Vector(velMag * RandomNum(0.0F, splashDir), -RandomNum(0.0F, velMag)));
                     m_DeepHardness += (*itr)->GetMaterial()->GetIntegrity() * (*itr)->GetMaterial()->GetPixelDensity();
-                    g_MovableMan.AddParticle(*itr);
+                    g_MovableMan.AddParticle(*itr, true);
                     *itr = 0;
                 }
                 else
@@ -1700,6 +1612,7 @@ void MOSRotating::AddAttachable(Attachable *attachable, const Vector& parentOffs
         m_AttachableAndWoundMass += attachable->GetMass();
         HandlePotentialRadiusAffectingAttachable(attachable);
         m_Attachables.push_back(attachable);
+        g_MovableMan.QueueThreadedBucketUpdate(attachable);
 	}
 }
 
@@ -1853,16 +1766,13 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap, const Vector &targetPos, DrawMode
         if (!attachableToDraw->IsDrawnAfterParent() && attachableToDraw->IsDrawnNormallyByParent()) { attachableToDraw->Draw(pTargetBitmap, targetPos, mode, onlyPhysical); }
     }
 
-	BITMAP * pTempBitmap = m_pTempBitmap;
-	BITMAP * pFlipBitmap = m_pFlipBitmap;
-	int keyColor = g_MaskColor;
-
 	// Switch to non 8-bit drawing mode if we're drawing onto MO layer
-	if (mode == g_DrawMOID || mode == g_DrawNoMOID) {
-		pTempBitmap = m_pTempBitmapS;
-		pFlipBitmap = m_pFlipBitmapS;
-		keyColor = g_MOIDMaskColor;
-	}
+	bool drawingOnMOIDLayer = mode == g_DrawMOID || mode == g_DrawNoMOID;
+	int keyColor = drawingOnMOIDLayer ? g_MOIDMaskColor : g_MaskColor;
+
+	// The intermediate bitmaps are per thread so MOSRotatings can be drawn to different targets concurrently.
+	BITMAP * pTempBitmap = GetTempBitmap(m_SpriteDiameter, drawingOnMOIDLayer);
+	BITMAP * pFlipBitmap = m_HFlipped ? GetFlipBitmap(m_aSprite[0]->w, m_aSprite[0]->h, drawingOnMOIDLayer) : nullptr;
 
     Vector spritePos(m_Pos.GetRounded() - targetPos);
 
@@ -1877,25 +1787,48 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap, const Vector &targetPos, DrawMode
     bool intermediateBitmapUsed = mode != g_DrawColor && mode != g_DrawTrans && mode != g_DrawMOID;
     RTEAssert(mode != g_DrawNoMOID, "DrawNoMOID drawing mode used with no MOID layer!");
 #endif
+    int silhouetteColor = -1;
     if (intermediateBitmapUsed) {
-        clear_to_color(pTempBitmap, keyColor);
-
         // TODO: Fix that MaterialAir and KeyColor don't work at all because they're drawing 0 to a field of 0's
-        // Draw the requested material silhouette on the material bitmap
         if (mode == g_DrawMaterial) {
-            draw_character_ex(pTempBitmap, m_aSprite[m_Frame], 0, 0, m_SettleMaterialDisabled ? GetMaterial()->GetIndex() : GetMaterial()->GetSettleMaterial(), -1);
+            silhouetteColor = m_SettleMaterialDisabled ? GetMaterial()->GetIndex() : GetMaterial()->GetSettleMaterial();
         } else if (mode == g_DrawWhite) {
-            draw_character_ex(pTempBitmap, m_aSprite[m_Frame], 0, 0, g_WhiteColor, -1);
+            silhouetteColor = g_WhiteColor;
         } else if (mode == g_DrawMOID) {
-            draw_character_ex(pTempBitmap, m_aSprite[m_Frame], 0, 0, m_MOID, -1);
+            silhouetteColor = m_MOID;
         } else if (mode == g_DrawNoMOID) {
-            draw_character_ex(pTempBitmap, m_aSprite[m_Frame], 0, 0, g_NoMOID, -1);
+            silhouetteColor = g_NoMOID;
         } else if (mode == g_DrawDoor) {
-			draw_character_ex(pTempBitmap, m_aSprite[m_Frame], 0, 0, g_MaterialDoor, -1);
+			silhouetteColor = g_MaterialDoor;
         } else {
             RTEAbort("Unknown draw mode selected in MOSRotating::Draw()!");
         }
     }
+    bool drawFlipped = m_HFlipped && pFlipBitmap;
+
+    // If this uses the rotated sprite cache, the frame is drawn pre-rotated to the nearest angle step, so none of the intermediate drawing below needs to be done if it's already cached.
+    // Translucent drawing goes through the temp bitmap either way, so it isn't cached.
+    bool useRotatedSpriteCache = m_RotatedSpriteCacheAngleStep > 0 && mode != g_DrawTrans;
+#ifndef DRAW_MOID_LAYER
+    useRotatedSpriteCache = useRotatedSpriteCache && mode != g_DrawMOID;
+#endif
+    RotatedSpriteCache::Key rotatedSpriteCacheKey;
+    std::shared_ptr<BITMAP> rotatedSprite = nullptr;
+    if (useRotatedSpriteCache) {
+        if (drawFlipped) {
+            rotatedSpriteCacheKey = GetRotatedSpriteCacheKey(mode, silhouetteColor, true, pFlipBitmap->w + m_SpriteOffset.GetFloorIntX(), -(m_SpriteOffset.GetFloorIntY()));
+        } else {
+            rotatedSpriteCacheKey = GetRotatedSpriteCacheKey(mode, silhouetteColor, false, -m_SpriteOffset.GetFloorIntX(), -m_SpriteOffset.GetFloorIntY());
+        }
+        rotatedSprite = s_RotatedSpriteCache.Get(rotatedSpriteCacheKey);
+    }
+
+    if (intermediateBitmapUsed && !rotatedSprite) {
+        clear_to_color(pTempBitmap, keyColor);
+
+        // Draw the requested material silhouette on the material bitmap
+        draw_character_ex(pTempBitmap, m_aSprite[m_Frame], 0, 0, silhouetteColor, -1);
+    }
 
     // Take care of wrapping situations
     Vector aDrawPos[4];
@@ -1930,17 +1863,19 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap, const Vector &targetPos, DrawMode
         }
     }
 
-    if (m_HFlipped && pFlipBitmap) {
-        // Don't size the intermediate bitmaps to the m_Scale, because the scaling happens after they are done
-        clear_to_color(pFlipBitmap, keyColor);
+    if (drawFlipped) {
+        if (!rotatedSprite) {
+            // Don't size the intermediate bitmaps to the m_Scale, because the scaling happens after they are done
+            clear_to_color(pFlipBitmap, keyColor);
 
-        // Draw either the source color bitmap or the intermediate material bitmap onto the intermediate flipping bitmap
-		if (mode == g_DrawColor || mode == g_DrawTrans) {
-			draw_sprite_h_flip(pFlipBitmap, m_aSprite[m_Frame], 0, 0);
-		} else {
-			// If using the temp bitmap (which is always larger than the sprite) make sure the flipped image ends up in the upper right corner as if it was just as small as the sprite bitmap
-            draw_sprite_h_flip(pFlipBitmap, pTempBitmap, -(pTempBitmap->w - m_aSprite[m_Frame]->w), 0);
-		}
+            // Draw either the source color bitmap or the intermediate material bitmap onto the intermediate flipping bitmap
+            if (mode == g_DrawColor || mode == g_DrawTrans) {
+                draw_sprite_h_flip(pFlipBitmap, m_aSprite[m_Frame], 0, 0);
+            } else {
+                // If using the temp bitmap (which is always larger than the sprite) make sure the flipped image ends up in the upper right corner as if it was just as small as the sprite bitmap
+                draw_sprite_h_flip(pFlipBitmap, pTempBitmap, -(pTempBitmap->w - m_aSprite[m_Frame]->w), 0);
+            }
+        }
 
         if (mode == g_DrawTrans) {
             clear_to_color(pTempBitmap, keyColor);
@@ -1959,6 +1894,8 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap, const Vector &targetPos, DrawMode
                 draw_trans_sprite(pTargetBitmap, pTempBitmap, spriteX, spriteY);
             }
         } else {
+            if (useRotatedSpriteCache && !rotatedSprite) { rotatedSprite = s_RotatedSpriteCache.Add(rotatedSpriteCacheKey, CreateRotatedSprite(pFlipBitmap, rotatedSpriteCacheKey, keyColor)); }
+
             // Do the passes loop in here so the flipping operation doesn't get done multiple times
             for (int i = 0; i < passes; ++i) {
                 int spriteX = aDrawPos[i].GetFloorIntX();
@@ -1969,8 +1906,12 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap, const Vector &targetPos, DrawMode
                     continue;
                 }
 #endif
-                // Take into account the h-flipped pivot point
-                pivot_scaled_sprite(pTargetBitmap, pFlipBitmap, spriteX, spriteY, pFlipBitmap->w + m_SpriteOffset.GetFloorIntX(), -(m_SpriteOffset.GetFloorIntY()), ftofix(m_Rotation.GetAllegroAngle()), ftofix(m_Scale));
+                if (rotatedSprite) {
+                    draw_sprite(pTargetBitmap, rotatedSprite.get(), spriteX - (rotatedSprite->w / 2), spriteY - (rotatedSprite->h / 2));
+                } else {
+                    // Take into account the h-flipped pivot point
+                    pivot_scaled_sprite(pTargetBitmap, pFlipBitmap, spriteX, spriteY, pFlipBitmap->w + m_SpriteOffset.GetFloorIntX(), -(m_SpriteOffset.GetFloorIntY()), ftofix(m_Rotation.GetAllegroAngle()), ftofix(m_Scale));
+                }
             }
         }
     } else {
@@ -1991,6 +1932,8 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap, const Vector &targetPos, DrawMode
                 draw_trans_sprite(pTargetBitmap, pTempBitmap, spriteX, spriteY);
             }
         } else {
+            if (useRotatedSpriteCache && !rotatedSprite) { rotatedSprite = s_RotatedSpriteCache.Add(rotatedSpriteCacheKey, CreateRotatedSprite(mode == g_DrawColor ? m_aSprite[m_Frame] : pTempBitmap, rotatedSpriteCacheKey, keyColor)); }
+
             for (int i = 0; i < passes; ++i) {
                 int spriteX = aDrawPos[i].GetFloorIntX();
                 int spriteY = aDrawPos[i].GetFloorIntY();
@@ -2000,7 +1943,11 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap, const Vector &targetPos, DrawMode
                     continue;
                 }
 #endif
-                pivot_scaled_sprite(pTargetBitmap, mode == g_DrawColor ? m_aSprite[m_Frame] : pTempBitmap, spriteX, spriteY, -m_SpriteOffset.GetFloorIntX(), -m_SpriteOffset.GetFloorIntY(), ftofix(m_Rotation.GetAllegroAngle()), ftofix(m_Scale));
+                if (rotatedSprite) {
+                    draw_sprite(pTargetBitmap, rotatedSprite.get(), spriteX - (rotatedSprite->w / 2), spriteY - (rotatedSprite->h / 2));
+                } else {
+                    pivot_scaled_sprite(pTargetBitmap, mode == g_DrawColor ? m_aSprite[m_Frame] : pTempBitmap, spriteX, spriteY, -m_SpriteOffset.GetFloorIntX(), -m_SpriteOffset.GetFloorIntY(), ftofix(m_Rotation.GetAllegroAngle()), ftofix(m_Scale));
+                }
             }
         }
     }
@@ -2024,6 +1971,91 @@ void MOSRotating::Draw(BITMAP *pTargetBitmap, const Vector &targetPos, DrawMode
     }
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+RotatedSpriteCache::Key MOSRotating::GetRotatedSpriteCacheKey(DrawMode mode, int silhouetteColor, bool hFlipped, int pivotX, int pivotY) const {
+    RotatedSpriteCache::Key cacheKey;
+    cacheKey.Sprite = m_aSprite[m_Frame];
+    cacheKey.DrawMode = mode;
+    cacheKey.SilhouetteColor = silhouetteColor;
+    cacheKey.PivotX = pivotX;
+    cacheKey.PivotY = pivotY;
+    cacheKey.Scale = m_Scale;
+    cacheKey.AngleStepCount = std::max(1, static_cast<int>(std::round(360.0F / m_RotatedSpriteCacheAngleStep)));
+    cacheKey.AngleIndex = RotatedSpriteCache::QuantizeAngle(m_Rotation.GetAllegroAngle(), cacheKey.AngleStepCount);
+    cacheKey.HFlipped = hFlipped;
+    return cacheKey;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BITMAP * MOSRotating::CreateRotatedSprite(BITMAP *spriteToRotate, const RotatedSpriteCache::Key &cacheKey, int keyColor) const {
+    // Only the sprite sized upper left part of the intermediate bitmaps is drawn on, so the rotated sprite reaches at most as far from the pivot point as the farthest corner of the sprite frame.
+    float farthestCornerDistance = 0;
+    for (int cornerX : { 0, m_aSprite[m_Frame]->w }) {
+        for (int cornerY : { 0, m_aSprite[m_Frame]->h }) {
+            farthestCornerDistance = std::max(farthestCornerDistance, Vector(static_cast<float>(cornerX - cacheKey.PivotX), static_cast<float>(cornerY - cacheKey.PivotY)).GetMagnitude());
+        }
+    }
+    int halfSize = static_cast<int>(std::ceil(farthestCornerDistance * cacheKey.Scale)) + 1;
+
+    BITMAP *rotatedSprite = create_bitmap_ex(bitmap_color_depth(spriteToRotate), (halfSize * 2) + 1, (halfSize * 2) + 1);
+    clear_to_color(rotatedSprite, keyColor);
+    pivot_scaled_sprite(rotatedSprite, spriteToRotate, halfSize, halfSize, cacheKey.PivotX, cacheKey.PivotY, ftofix(RotatedSpriteCache::GetQuantizedAllegroAngle(cacheKey.AngleIndex, cacheKey.AngleStepCount)), ftofix(cacheKey.Scale));
+    return rotatedSprite;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void MOSRotating::IntermediateBitmaps::Destroy() {
+    for (std::array<BITMAP *, c_TempBitmapSizeClassCount> &bitDepthTempBitmaps : TempBitmaps) {
+        for (BITMAP *&tempBitmap : bitDepthTempBitmaps) {
+            destroy_bitmap(tempBitmap);
+            tempBitmap = nullptr;
+        }
+    }
+    for (std::unordered_map<long long, BITMAP *> &bitDepthFlipBitmaps : FlipBitmaps) {
+        for (const auto &[sizeKey, flipBitmap] : bitDepthFlipBitmaps) {
+            destroy_bitmap(flipBitmap);
+        }
+        bitDepthFlipBitmaps.clear();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BITMAP * MOSRotating::GetTempBitmap(int spriteDiameter, bool moidLayerBitDepth) {
+    int sizeClass = 0;
+    while (sizeClass < IntermediateBitmaps::c_TempBitmapSizeClassCount - 1 && spriteDiameter >= (16 << sizeClass)) {
+        ++sizeClass;
+    }
+    BITMAP *&tempBitmap = s_IntermediateBitmaps.TempBitmaps[moidLayerBitDepth ? 1 : 0][sizeClass];
+    if (!tempBitmap) { tempBitmap = create_bitmap_ex(moidLayerBitDepth ? c_MOIDLayerBitDepth : 8, 16 << sizeClass, 16 << sizeClass); }
+    return tempBitmap;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BITMAP * MOSRotating::GetFlipBitmap(int width, int height, bool moidLayerBitDepth) {
+    // Flipped sprites are pivoted around a point relative to the flip bitmap's width, so there needs to be one per sprite size rather than per size class.
+    // Only one is in use at a time, so once a thread has made too many of them they're all thrown out, instead of keeping one for every sprite size it ever drew.
+    static constexpr size_t c_MaxFlipBitmapsPerBitDepth = 32;
+
+    std::unordered_map<long long, BITMAP *> &bitDepthFlipBitmaps = s_IntermediateBitmaps.FlipBitmaps[moidLayerBitDepth ? 1 : 0];
+    long long sizeKey = (static_cast<long long>(width) << 32) | static_cast<unsigned int>(height);
+    if (bitDepthFlipBitmaps.size() >= c_MaxFlipBitmapsPerBitDepth && !bitDepthFlipBitmaps.contains(sizeKey)) {
+        for (const auto &[cachedSizeKey, cachedFlipBitmap] : bitDepthFlipBitmaps) {
+            destroy_bitmap(cachedFlipBitmap);
+        }
+        bitDepthFlipBitmaps.clear();
+    }
+    BITMAP *&flipBitmap = bitDepthFlipBitmaps[sizeKey];
+    if (!flipBitmap) { flipBitmap = create_bitmap_ex(moidLayerBitDepth ? c_MOIDLayerBitDepth : 8, width, height); }
+    return flipBitmap;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 bool MOSRotating::HandlePotentialRadiusAffectingAttachable(const Attachable *attachable) {
     if (!attachable->IsAttachedTo(this) && !attachable->IsWound()) {
         return false;
@@ -18,6 +18,7 @@
 #include "Gib.h"
 #include "PostProcessMan.h"
 #include "SoundContainer.h"
+#include "RotatedSpriteCache.h"
 
 namespace RTE
 {
@@ -670,6 +671,29 @@ ClassInfoGetters;
 	/// <param name="shouldGibAtEndOfLifetime">Whether or not this MOSRotating should gib at the end of its lifetime instead of just being deleted.</param>
 	void SetGibAtEndOfLifetime(bool shouldGibAtEndOfLifetime) { m_GibAtEndOfLifetime = shouldGibAtEndOfLifetime; }
 
+	/// <summary>
+	/// Gets the angle step this MOSRotating's sprite is rotated in when drawn from the shared rotated sprite cache.
+	/// </summary>
+	/// <returns>The angle step, in degrees. 0 means this MOSRotating doesn't use the cache and is drawn at its exact rotation.</returns>
+	float GetRotatedSpriteCacheAngleStep() const { return m_RotatedSpriteCacheAngleStep; }
+
+	/// <summary>
+	/// Sets the angle step this MOSRotating's sprite is rotated in when drawn from the shared rotated sprite cache. Coarser steps mean more cache hits but less smooth rotation.
+	/// </summary>
+	/// <param name="newAngleStep">The new angle step, in degrees. 0 disables the cache for this MOSRotating.</param>
+	void SetRotatedSpriteCacheAngleStep(float newAngleStep) { m_RotatedSpriteCacheAngleStep = std::max(newAngleStep, 0.0F); }
+
+	/// <summary>
+	/// Gets the rotated sprite cache shared by all MOSRotatings.
+	/// </summary>
+	/// <returns>A reference to the shared RotatedSpriteCache.</returns>
+	static RotatedSpriteCache & GetRotatedSpriteCache() { return s_RotatedSpriteCache; }
+
+	/// <summary>
+	/// Destroys the calling thread's intermediate bitmaps for drawing silhouettes, rotations and flips. Worker threads destroy theirs when they exit, but the main thread's need to go before Allegro shuts down.
+	/// </summary>
+	static void DestroyIntermediateBitmaps() { s_IntermediateBitmaps.Destroy(); }
+
     /// <summary>
     /// Gets the gib blast strength this MOSRotating, i.e. the strength with which Gibs and Attachables will be launched when this MOSRotating is gibbed.
     /// </summary>
@@ -1059,28 +1083,11 @@ protected:
 
 	Timer m_FlashWhiteTimer; //!< The timer for timing white draw mode duration.
 
-    // Intermediary drawing bitmap used to flip rotating bitmaps. Owned!
+	float m_RotatedSpriteCacheAngleStep; //!< The angle step this' sprite is rotated in when drawn from the rotated sprite cache, in degrees. 0 means the cache isn't used.
+	static RotatedSpriteCache s_RotatedSpriteCache; //!< Sprite frames that were already rotated, shared between all MOSRotatings that use the same frames the same way.
+
+    // Intermediary drawing bitmap used to flip rotating bitmaps when erasing them from the terrain. Owned!
     BITMAP *m_pFlipBitmap;
-    BITMAP *m_pFlipBitmapS;
-    // Intermediary drawing bitmap used to draw sihouettes and other effects. Not owned; points to the shared static bitmaps
-    BITMAP *m_pTempBitmap;
-    // Temp drawing bitmaps shared between all MOSRotatings
-    static BITMAP *m_spTempBitmap16;
-    static BITMAP *m_spTempBitmap32;
-    static BITMAP *m_spTempBitmap64;
-    static BITMAP *m_spTempBitmap128;
-    static BITMAP *m_spTempBitmap256;
-    static BITMAP *m_spTempBitmap512;
-
-    // Intermediary drawing bitmap used to draw MO silhouettes. Not owned; points to the shared static bitmaps
-    BITMAP *m_pTempBitmapS;
-    // Temp drawing bitmaps shared between all MOSRotatings
-    static BITMAP *m_spTempBitmapS16;
-    static BITMAP *m_spTempBitmapS32;
-    static BITMAP *m_spTempBitmapS64;
-    static BITMAP *m_spTempBitmapS128;
-    static BITMAP *m_spTempBitmapS256;
-    static BITMAP *m_spTempBitmapS512;
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Private member variable and method declarations
@@ -1103,6 +1110,65 @@ private:
     /// <param name="reader">A Reader lined up to the custom value type to be read.</param>
     void ReadCustomValueProperty(Reader &reader);
 
+	/// <summary>
+	/// Makes the RotatedSpriteCache key for drawing a sprite frame of this MOSRotating at its current rotation, quantized to its angle step.
+	/// </summary>
+	/// <param name="mode">The DrawMode the frame is being drawn in.</param>
+	/// <param name="silhouetteColor">The color the frame is drawn as a silhouette of, or -1 if it's drawn in color.</param>
+	/// <param name="hFlipped">Whether the frame is drawn flipped horizontally.</param>
+	/// <param name="pivotX">The X coordinate of the pivot point on the sprite being rotated, after flipping.</param>
+	/// <param name="pivotY">The Y coordinate of the pivot point on the sprite being rotated, after flipping.</param>
+	/// <returns>The key for the rotated frame.</returns>
+	RotatedSpriteCache::Key GetRotatedSpriteCacheKey(DrawMode mode, int silhouetteColor, bool hFlipped, int pivotX, int pivotY) const;
+
+	/// <summary>
+	/// Rotates and scales a sprite around a pivot point onto a new BITMAP, for adding to the rotated sprite cache. The pivot point ends up at the center of the new BITMAP.
+	/// </summary>
+	/// <param name="spriteToRotate">The sprite, or intermediate silhouette or flip bitmap, to rotate.</param>
+	/// <param name="cacheKey">The RotatedSpriteCache key the sprite is rotated for, which holds the pivot point and quantized angle.</param>
+	/// <param name="keyColor">The mask color to clear the new BITMAP to.</param>
+	/// <returns>The rotated sprite. Ownership IS transferred!</returns>
+	BITMAP * CreateRotatedSprite(BITMAP *spriteToRotate, const RotatedSpriteCache::Key &cacheKey, int keyColor) const;
+
+	/// <summary>
+	/// Intermediate bitmaps a thread draws silhouettes, rotations and flips of sprites in. Each thread has its own, which are destroyed along with the thread.
+	/// </summary>
+	struct IntermediateBitmaps {
+		static constexpr int c_TempBitmapSizeClassCount = 6; //!< Size classes of 16, 32, 64, 128, 256 and 512 pixels.
+
+		std::array<std::array<BITMAP *, c_TempBitmapSizeClassCount>, 2> TempBitmaps = {}; //!< Bitmaps for silhouettes and rotations, per bit depth and size class.
+		std::array<std::unordered_map<long long, BITMAP *>, 2> FlipBitmaps; //!< Bitmaps for flipping, per bit depth and keyed by their size.
+
+		/// <summary>
+		/// Destructor method used to clean up the IntermediateBitmaps when its thread exits.
+		/// </summary>
+		~IntermediateBitmaps() { Destroy(); }
+
+		/// <summary>
+		/// Destroys all the intermediate bitmaps.
+		/// </summary>
+		void Destroy();
+	};
+
+	static thread_local IntermediateBitmaps s_IntermediateBitmaps; //!< The calling thread's intermediate bitmaps.
+
+	/// <summary>
+	/// Gets the calling thread's intermediate bitmap for drawing silhouettes and rotating sprites of a given diameter. The bitmap is at least twice as large as the diameter.
+	/// </summary>
+	/// <param name="spriteDiameter">The diameter of the sprite that will be drawn onto the bitmap.</param>
+	/// <param name="moidLayerBitDepth">Whether the bitmap should have the MOID layer bit depth instead of 8 bits.</param>
+	/// <returns>The calling thread's intermediate bitmap of the appropriate size class. Ownership is NOT transferred!</returns>
+	static BITMAP * GetTempBitmap(int spriteDiameter, bool moidLayerBitDepth);
+
+	/// <summary>
+	/// Gets the calling thread's intermediate bitmap for flipping sprites of a given size. Each thread keeps a bounded number of these, so the returned bitmap is only valid until the next call.
+	/// </summary>
+	/// <param name="width">The width of the sprite that will be flipped.</param>
+	/// <param name="height">The height of the sprite that will be flipped.</param>
+	/// <param name="moidLayerBitDepth">Whether the bitmap should have the MOID layer bit depth instead of 8 bits.</param>
+	/// <returns>The calling thread's intermediate flipping bitmap of exactly the given size. Ownership is NOT transferred!</returns>
+	static BITMAP * GetFlipBitmap(int width, int height, bool moidLayerBitDepth);
+
 
     // Disallow the use of some implicit methods.
 	MOSRotating(const MOSRotating &reference) = delete;
@@ -21,6 +21,7 @@
 #include "LuaMan.h"
 #include "Atom.h"
 #include "Actor.h"
+#include "TravelCommandBuffer.h"
 #include "SLTerrain.h"
 
 namespace RTE {
@@ -85,6 +86,10 @@ void MovableObject::Clear()
     m_ThreadedLuaState = nullptr;
     m_HasSinglethreadedScripts = false;
     m_ScriptObjectName.clear();
+    m_ThreadedScriptSelfObject.reset();
+    m_SinglethreadedScriptSelfObject.reset();
+    m_ThreadedScriptSelfObjectClearCount = 0;
+    m_SinglethreadedScriptSelfObjectClearCount = 0;
     m_ScreenEffectFile.Reset();
     m_pScreenEffect = 0;
 	m_EffectRotAngle = 0;
@@ -125,6 +130,7 @@ LuaStateWrapper & MovableObject::GetAndLockStateForScript(const std::string &scr
     if (g_LuaMan.IsScriptThreadSafe(scriptPath)) {
         if (m_ThreadedLuaState == nullptr) {
             m_ThreadedLuaState = g_LuaMan.GetAndLockFreeScriptState();
+            g_MovableMan.QueueThreadedBucketUpdate(this);
         } else {
             m_ThreadedLuaState->GetMutex().lock();
         }
@@ -497,6 +503,7 @@ void MovableObject::DestroyScriptState() {
         if (m_ThreadedLuaState) {
             std::lock_guard<std::recursive_mutex> lock(m_ThreadedLuaState->GetMutex());
             m_ThreadedLuaState->RunScriptString(m_ScriptObjectName + " = nil;");
+            m_ThreadedScriptSelfObject.reset();
         }
 
         if (m_HasSinglethreadedScripts) {
@@ -507,6 +514,7 @@ void MovableObject::DestroyScriptState() {
             else {
                 std::lock_guard<std::recursive_mutex> lock(g_LuaMan.GetMasterScriptState().GetMutex(), std::adopt_lock);
                 g_LuaMan.GetMasterScriptState().RunScriptString(m_ScriptObjectName + " = nil;");
+                m_SinglethreadedScriptSelfObject.reset();
             }
         }
     }
@@ -610,6 +618,9 @@ int MovableObject::InitializeObjectScripts() {
         if (luaState.RunScriptString("_ScriptedObjects = _ScriptedObjects or {}; " + m_ScriptObjectName + " = To" + GetClassName() + "(LuaMan.TempEntity); ") < 0) {
             RTEAbort("Failed to initialize object scripts for " + GetModuleAndPresetName() + ". Please report this to a developer.");
         }
+        // The self object was just replaced in the Lua state, so any cached ones point at the old one.
+        m_ThreadedScriptSelfObject.reset();
+        m_SinglethreadedScriptSelfObject.reset();
     };
     
     if (m_ThreadedLuaState) {
@@ -659,7 +670,8 @@ void MovableObject::EnableOrDisableAllScripts(bool enableScripts) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int MovableObject::RunScriptedFunctionInAppropriateScripts(const std::string &functionName, bool runOnDisabledScripts, bool stopOnError, const std::vector<const Entity *> &functionEntityArguments, const std::vector<std::string_view> &functionLiteralArguments, ThreadScriptsToRun scriptsToRun) {
+template <typename FunctionObjectRunner>
+int MovableObject::RunScriptedFunctionInAppropriateScriptsWith(const std::string &functionName, bool runOnDisabledScripts, bool stopOnError, ThreadScriptsToRun scriptsToRun, FunctionObjectRunner &&runFunctionObject) {
     int status = 0;
 
     auto itr = m_FunctionsAndScripts.find(functionName);
@@ -684,7 +696,7 @@ int MovableObject::RunScriptedFunctionInAppropriateScripts(const std::string &fu
             if (runOnDisabledScripts || m_AllLoadedScripts.at(functionObjectWrapper->GetFilePath())) {
                 LuaStateWrapper& usedState = GetAndLockStateForScript(functionObjectWrapper->GetFilePath());
                 std::lock_guard<std::recursive_mutex> lock(usedState.GetMutex(), std::adopt_lock);   
-				status = usedState.RunScriptFunctionObject(functionObjectWrapper.get(), "_ScriptedObjects", std::to_string(m_UniqueID), functionEntityArguments, functionLiteralArguments);
+				status = runFunctionObject(usedState, functionObjectWrapper.get());
                 if (status < 0 && stopOnError) {
                     return status;
                 }
@@ -696,6 +708,35 @@ int MovableObject::RunScriptedFunctionInAppropriateScripts(const std::string &fu
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+int MovableObject::RunScriptedFunctionInAppropriateScripts(const std::string &functionName, bool runOnDisabledScripts, bool stopOnError, const std::vector<const Entity *> &functionEntityArguments, const std::vector<std::string_view> &functionLiteralArguments, ThreadScriptsToRun scriptsToRun) {
+	return RunScriptedFunctionInAppropriateScriptsWith(functionName, runOnDisabledScripts, stopOnError, scriptsToRun, [&](LuaStateWrapper &usedState, const LuabindObjectWrapper *functionObjectWrapper) {
+		return usedState.RunScriptFunctionObject(functionObjectWrapper, "_ScriptedObjects", std::to_string(m_UniqueID), functionEntityArguments, functionLiteralArguments);
+	});
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int MovableObject::RunScriptedFunctionInAppropriateScripts(const std::string &functionName, std::initializer_list<LuaFunctionArgument> functionArguments, bool runOnDisabledScripts, bool stopOnError, ThreadScriptsToRun scriptsToRun) {
+	return RunScriptedFunctionInAppropriateScriptsWith(functionName, runOnDisabledScripts, stopOnError, scriptsToRun, [&](LuaStateWrapper &usedState, const LuabindObjectWrapper *functionObjectWrapper) {
+		return usedState.RunScriptFunctionObject(functionObjectWrapper, GetScriptSelfObject(usedState), functionArguments);
+	});
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const LuabindObjectWrapper * MovableObject::GetScriptSelfObject(LuaStateWrapper &luaState) {
+	const bool isThreadedLuaState = &luaState == m_ThreadedLuaState;
+	std::unique_ptr<LuabindObjectWrapper> &selfObject = isThreadedLuaState ? m_ThreadedScriptSelfObject : m_SinglethreadedScriptSelfObject;
+	unsigned int &selfObjectClearCount = isThreadedLuaState ? m_ThreadedScriptSelfObjectClearCount : m_SinglethreadedScriptSelfObjectClearCount;
+	if (!selfObject || selfObjectClearCount != luaState.GetUserModuleCacheClearCount()) {
+		selfObject.reset(luaState.RetrieveTableEntry("_ScriptedObjects", std::to_string(m_UniqueID)));
+		selfObjectClearCount = luaState.GetUserModuleCacheClearCount();
+	}
+	return selfObject.get();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 int MovableObject::RunFunctionOfScript(const std::string &scriptPath, const std::string &functionName, const std::vector<const Entity *> &functionEntityArguments, const std::vector<std::string_view> &functionLiteralArguments) {    
     if (m_AllLoadedScripts.empty() || !ObjectScriptsInitialized()) {
 		return -1;
@@ -805,7 +846,9 @@ bool MovableObject::IsAtRest() {
 bool MovableObject::OnMOHit(HitData &hd)
 {
     if (hd.RootBody[HITOR] != hd.RootBody[HITEE] && (hd.Body[HITOR] == this || hd.Body[HITEE] == this)) {
-        RunScriptedFunctionInAppropriateScripts("OnCollideWithMO", false, false, {hd.Body[hd.Body[HITOR] == this ? HITEE : HITOR], hd.RootBody[hd.Body[HITOR] == this ? HITEE : HITOR]});
+        const MovableObject *otherBody = hd.Body[hd.Body[HITOR] == this ? HITEE : HITOR];
+        const MovableObject *otherRootBody = hd.RootBody[hd.Body[HITOR] == this ? HITEE : HITOR];
+        RunScriptedFunctionInAppropriateScripts("OnCollideWithMO", {otherBody, otherRootBody}, false, false);
     }
 	return hd.Terminate[hd.RootBody[HITOR] == this ? HITOR : HITEE] = false;
 }
@@ -819,7 +862,14 @@ void MovableObject::SetHitWhatTerrMaterial(unsigned char matID)
 {
     m_TerrainMatHit = matID;
     m_LastCollisionSimFrameNumber = g_MovableMan.GetSimUpdateFrameNumber();
-    RunScriptedFunctionInAppropriateScripts("OnCollideWithTerrain", false, false, {}, {std::to_string(m_TerrainMatHit)});
+    if (TravelCommandBuffer *travelCommandBuffer = TravelCommandBuffer::GetActive()) {
+        // Script callbacks can touch anything, so they have to wait until the parallel travel is done.
+        if (auto functionItr = m_FunctionsAndScripts.find("OnCollideWithTerrain"); functionItr != m_FunctionsAndScripts.end() && !functionItr->second.empty()) {
+            travelCommandBuffer->Defer([this, matID]() { RunScriptedFunctionInAppropriateScripts("OnCollideWithTerrain", {static_cast<double>(matID)}, false, false); });
+        }
+        return;
+    }
+    RunScriptedFunctionInAppropriateScripts("OnCollideWithTerrain", {static_cast<double>(m_TerrainMatHit)}, false, false);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1026,7 +1076,7 @@ int MovableObject::UpdateScripts(ThreadScriptsToRun scriptsToRun) {
 	m_SimUpdatesSinceLastScriptedUpdate = 0;
 
 	if (status >= 0) {
-		status = RunScriptedFunctionInAppropriateScripts("Update", false, true, {}, {}, scriptsToRun);
+		status = RunScriptedFunctionInAppropriateScripts("Update", {}, false, true, scriptsToRun);
 
         // Perform our synced updates to let multithreaded scripts do anything that interacts with stuff in a non-const way
         // This is identical to non-multithreaded script's Update()
@@ -1035,7 +1085,7 @@ int MovableObject::UpdateScripts(ThreadScriptsToRun scriptsToRun) {
         // I wonder if we can do some SFINAE magic to make the luabindings automagically do a no-op with const objects, to avoid writing the bindings twice
         if (status >= -1 && scriptsToRun == ThreadScriptsToRun::SingleThreaded) {
             // If we're in a SingleThreaded context, we run the MultiThreaded scripts synced updates:
-            status = RunScriptedFunctionInAppropriateScripts("SyncedUpdate", false, true, {}, {}, ThreadScriptsToRun::Both);
+            status = RunScriptedFunctionInAppropriateScripts("SyncedUpdate", {}, false, true, ThreadScriptsToRun::Both);
         }
 	}
 
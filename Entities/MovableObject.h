@@ -226,6 +226,18 @@ enum MOType
     /// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
     int RunScriptedFunctionInAppropriateScripts(const std::string &functionName, bool runOnDisabledScripts = false, bool stopOnError = false, const std::vector<const Entity *> &functionEntityArguments = std::vector<const Entity *>(), const std::vector<std::string_view> &functionLiteralArguments = std::vector<std::string_view>(), ThreadScriptsToRun scriptsToRun = ThreadScriptsToRun::Both);
 
+    /// <summary>
+    /// Runs the given function in all scripts that have it, with the given typed arguments, with the ability to not run on disabled scripts and to cease running if there's an error.
+    /// The first argument to the function will always be 'self', which is resolved once per Lua state instead of being looked up by name every call. Preferred for functions that run very frequently.
+    /// </summary>
+    /// <param name="functionName">The name of the function to run.</param>
+    /// <param name="functionArguments">The arguments that should be passed into the Lua function after 'self', in order.</param>
+    /// <param name="runOnDisabledScripts">Whether to run the function on disabled scripts.</param>
+    /// <param name="stopOnError">Whether to stop if there's an error running any script, or simply print it to the console and continue.</param>
+    /// <param name="scriptsToRun">Which scripts to run, based on whether they're thread safe. Defaults to all of them.</param>
+    /// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+    int RunScriptedFunctionInAppropriateScripts(const std::string &functionName, std::initializer_list<LuaFunctionArgument> functionArguments, bool runOnDisabledScripts, bool stopOnError, ThreadScriptsToRun scriptsToRun = ThreadScriptsToRun::Both);
+
     /// <summary>
     /// Cleans up and destroys the script state of this object, calling the Destroy callback in lua
     /// </summary>
@@ -1585,6 +1597,16 @@ enum MOType
 
 	void SetRestThreshold(int newRestThreshold)  { m_RestThreshold = newRestThreshold; }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetRemoveOrphanTerrainRadius
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Returns the radius in which orphaned terrain is looked for and removed
+//                  when this MO penetrates the terrain.
+// Arguments:       None.
+// Return value:    The orphan removal radius of this MO. 0 means no removal.
+
+	int GetRemoveOrphanTerrainRadius() const { return m_RemoveOrphanTerrainRadius; }
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Static method:  GetNextID
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1955,6 +1977,10 @@ protected:
     bool m_HasSinglethreadedScripts; //!< Whether or not we have any single-threaded scripts attached to us.
 
     std::string m_ScriptObjectName; //!< The name of this object for script usage.
+    std::unique_ptr<LuabindObjectWrapper> m_ThreadedScriptSelfObject; //!< The Lua object representing this in the threaded Lua state, resolved once so it doesn't have to be looked up by name every script call.
+    std::unique_ptr<LuabindObjectWrapper> m_SinglethreadedScriptSelfObject; //!< The Lua object representing this in the master Lua state, resolved once so it doesn't have to be looked up by name every script call.
+    unsigned int m_ThreadedScriptSelfObjectClearCount; //!< The user module cache clear count of the threaded Lua state when its self object was resolved, so it's resolved again after the cache is cleared.
+    unsigned int m_SinglethreadedScriptSelfObjectClearCount; //!< The user module cache clear count of the master Lua state when its self object was resolved, so it's resolved again after the cache is cleared.
     std::unordered_map<std::string, bool> m_AllLoadedScripts; //!< A map of script paths to the enabled state of the given script.
     std::unordered_map<std::string, std::vector<std::unique_ptr<LuabindObjectWrapper>>> m_FunctionsAndScripts; //!< A map of function names to vectors of LuabindObjectWrappers that hold Lua functions. Used to maintain script execution order and avoid extraneous Lua calls.
 
@@ -2036,6 +2062,25 @@ private:
     /// <returns>A script state.</returns>
     LuaStateWrapper & GetAndLockStateForScript(const std::string& scriptPath);
 
+    /// <summary>
+    /// Gets the Lua object representing this in the given Lua state, resolving it if it hasn't been yet.
+    /// </summary>
+    /// <param name="luaState">The Lua state to get the object for. Should be locked by the caller.</param>
+    /// <returns>The LuabindObjectWrapper holding this' Lua object, or nullptr if it doesn't exist in that state. Ownership is NOT transferred!</returns>
+    const LuabindObjectWrapper * GetScriptSelfObject(LuaStateWrapper &luaState);
+
+    /// <summary>
+    /// Runs the given function in all appropriate scripts, with the arguments being handled by the passed in function.
+    /// </summary>
+    /// <param name="functionName">The name of the function to run.</param>
+    /// <param name="runOnDisabledScripts">Whether to run the function on disabled scripts.</param>
+    /// <param name="stopOnError">Whether to stop if there's an error running any script.</param>
+    /// <param name="scriptsToRun">Which scripts to run, based on whether they're thread safe.</param>
+    /// <param name="runFunctionObject">A function taking the locked Lua state and the function object, that runs it and returns its status.</param>
+    /// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+    template <typename FunctionObjectRunner>
+    int RunScriptedFunctionInAppropriateScriptsWith(const std::string &functionName, bool runOnDisabledScripts, bool stopOnError, ThreadScriptsToRun scriptsToRun, FunctionObjectRunner &&runFunctionObject);
+
 	// Disallow the use of some implicit methods.
 	MovableObject(const MovableObject &reference) = delete;
 	MovableObject& operator=(const MovableObject& ref) = delete;
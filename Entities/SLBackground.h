@@ -194,12 +194,13 @@ namespace RTE {
 		void Update() override;
 
 		/// <summary>
-		/// Draws this SLBackground's current scrolled position to a bitmap.
+		/// Draws this SLBackground scrolled to the passed in offset to a bitmap.
 		/// </summary>
 		/// <param name="targetBitmap">The bitmap to draw to.</param>
 		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="offsetOverride">The offset to draw this SLBackground at instead of its own offset.</param>
 		/// <param name="offsetNeedsScrollRatioAdjustment">Whether the offset of this SceneLayer or the passed in offset override need to be adjusted to scroll ratio.</param>
-		void Draw(BITMAP *targetBitmap, Box &targetBox, bool offsetNeedsScrollRatioAdjustment = false) override;
+		void Draw(BITMAP *targetBitmap, Box &targetBox, const Vector &offsetOverride, bool offsetNeedsScrollRatioAdjustment = false) const override;
 #pragma endregion
 
 	private:
@@ -459,19 +459,19 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void SLTerrain::Draw(BITMAP *targetBitmap, Box &targetBox, bool offsetNeedsScrollRatioAdjustment) {
-		switch (m_LayerToDraw) {
+	void SLTerrain::DrawLayer(LayerType layerToDraw, BITMAP *targetBitmap, Box &targetBox, const Vector &offset) const {
+		switch (layerToDraw) {
 			case LayerType::MaterialLayer:
-				SceneLayer::Draw(targetBitmap, targetBox);
+				SceneLayer::Draw(targetBitmap, targetBox, offset);
 				break;
 			case LayerType::ForegroundLayer:
-				m_FGColorLayer->Draw(targetBitmap, targetBox);
+				m_FGColorLayer->Draw(targetBitmap, targetBox, offset);
 				break;
 			case LayerType::BackgroundLayer:
-				m_BGColorLayer->Draw(targetBitmap, targetBox);
+				m_BGColorLayer->Draw(targetBitmap, targetBox, offset);
 				break;
 			default:
-				RTEAbort("Invalid LayerType was set to draw in SLTerrain::Draw!");
+				RTEAbort("Invalid LayerType was passed to SLTerrain::DrawLayer!");
 				break;
 		}
 	}
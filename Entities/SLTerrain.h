@@ -237,12 +237,22 @@ namespace RTE {
 		void Update() override;
 
 		/// <summary>
-		/// Draws this SLTerrain's current scrolled position to a bitmap.
+		/// Draws the layer of this SLTerrain that is set to be drawn, scrolled to the passed in offset, to a bitmap.
 		/// </summary>
 		/// <param name="targetBitmap">The bitmap to draw to.</param>
 		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="offsetOverride">The offset to draw this SLTerrain at instead of its own offset.</param>
 		/// <param name="offsetNeedsScrollRatioAdjustment">Whether the offset of this SceneLayer or the passed in offset override need to be adjusted to scroll ratio.</param>
-		void Draw(BITMAP *targetBitmap, Box &targetBox, bool offsetNeedsScrollRatioAdjustment = false) override;
+		void Draw(BITMAP *targetBitmap, Box &targetBox, const Vector &offsetOverride, bool offsetNeedsScrollRatioAdjustment = false) const override { DrawLayer(m_LayerToDraw, targetBitmap, targetBox, offsetOverride); }
+
+		/// <summary>
+		/// Draws a specific layer of this SLTerrain, scrolled to the passed in offset, to a bitmap. Unlike SetLayerToDraw and Draw, this doesn't modify this SLTerrain, so it can be used to draw to different bitmaps concurrently.
+		/// </summary>
+		/// <param name="layerToDraw">The layer that should be drawn. See LayerType enumeration.</param>
+		/// <param name="targetBitmap">The bitmap to draw to.</param>
+		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="offset">The offset to draw the layer at.</param>
+		void DrawLayer(LayerType layerToDraw, BITMAP *targetBitmap, Box &targetBox, const Vector &offset) const;
 #pragma endregion
 
 	private:
@@ -469,6 +469,7 @@ void Scene::Clear()
     {
         m_UnseenPixelSize[team].Reset();
         m_apUnseenLayer[team] = 0;
+        m_UnseenMaps[team].Reset();
         m_SeenPixels[team].clear();
         m_CleanedPixels[team].clear();
         m_ScanScheduled[team] = false;
@@ -556,7 +557,10 @@ int Scene::Create(const Scene &reference)
     {
         // If the Unseen layers are loaded, then copy them. If not, then copy the procedural param that is responsible for creating them
         if (reference.m_apUnseenLayer[team])
+        {
             m_apUnseenLayer[team] = dynamic_cast<SceneLayer *>(reference.m_apUnseenLayer[team]->Clone());
+            m_UnseenMaps[team] = reference.m_UnseenMaps[team];
+        }
         else
             m_UnseenPixelSize[team] = reference.m_UnseenPixelSize[team];
 
@@ -639,6 +643,7 @@ int Scene::LoadData(bool placeObjects, bool initPathfinding, bool placeUnits)
                 return -1;
             }
         }
+        RebuildUnseenMap(team);
     }
 
 	m_SelectedAssemblies.clear();
@@ -864,7 +869,7 @@ int Scene::LoadData(bool placeObjects, bool initPathfinding, bool placeUnits)
                                 int scaledW = std::ceil(terrainObjectBitmap->w / scale.m_X);
                                 int scaledH = std::ceil(terrainObjectBitmap->h / scale.m_Y);
                                 // Fill the box with key color for the owner ownerTeam, revealing the area that this thing is on
-                                rectfill(m_apUnseenLayer[ownerTeam]->GetBitmap(), scaledX, scaledY, scaledX + scaledW, scaledY + scaledH, g_MaskColor);
+                                RevealUnseenBox(scaledX, scaledY, scaledX + scaledW, scaledY + scaledH, ownerTeam);
                                 // Expand the box a little so the whole placed object is going to be hidden
                                 scaledX -= 1;
                                 scaledY -= 1;
@@ -874,7 +879,7 @@ int Scene::LoadData(bool placeObjects, bool initPathfinding, bool placeUnits)
                                 for (int t = Activity::TeamOne; t < Activity::MaxTeamCount; ++t)
                                 {
                                     if (t != ownerTeam && m_apUnseenLayer[t] && m_apUnseenLayer[t]->GetBitmap())
-                                        rectfill(m_apUnseenLayer[t]->GetBitmap(), scaledX, scaledY, scaledX + scaledW, scaledY + scaledH, g_BlackColor);
+                                        RestoreUnseenBox(scaledX, scaledY, scaledX + scaledW, scaledY + scaledH, t);
                                 }
                             }
                         }
@@ -929,9 +934,10 @@ int Scene::LoadData(bool placeObjects, bool initPathfinding, bool placeUnits)
     {
 		// Create the pathfinding stuff based on the current scene
 		int pathFinderGridNodeSize = g_SettingsMan.GetPathFinderGridNodeSize();
+		int pathFinderChunkSize = g_SettingsMan.GetPathFinderChunkSize();
 
         for (int i = 0; i < m_pPathFinders.size(); ++i) {
-            m_pPathFinders[i] = std::make_unique<PathFinder>(pathFinderGridNodeSize);
+            m_pPathFinders[i] = std::make_unique<PathFinder>(pathFinderGridNodeSize, pathFinderChunkSize);
         }
         ResetPathFinding();
     }
@@ -1164,6 +1170,7 @@ int Scene::ClearData()
                 return -1;
             }
         }
+        m_UnseenMaps[team].Reset();
     }
 
     return 0;
@@ -1757,6 +1764,7 @@ void Scene::FillUnseenLayer(Vector pixelSize, int team, bool createNow)
         m_apUnseenLayer[team]->Create(pUnseenBitmap, true, Vector(), WrapsX(), WrapsY(), Vector(1.0, 1.0));
         // Calculate how many times smaller the unseen map is compared to the entire terrain's dimensions, and set it as the scale factor on the Unseen layer
         m_apUnseenLayer[team]->SetScaleFactor(Vector((float)GetTerrain()->GetBitmap()->w / (float)m_apUnseenLayer[team]->GetBitmap()->w, (float)GetTerrain()->GetBitmap()->h / (float)m_apUnseenLayer[team]->GetBitmap()->h));
+        RebuildUnseenMap(team);
     }
 }
 
@@ -1776,6 +1784,7 @@ void Scene::SetUnseenLayer(SceneLayer *pNewLayer, int team)
     m_apUnseenLayer[team] = pNewLayer;
     // Calculate how many times smaller the unseen map is compared to the entire terrain's dimensions, and set it as the scale factor on the Unseen layer
     m_apUnseenLayer[team]->SetScaleFactor(Vector((float)GetTerrain()->GetBitmap()->w / (float)m_apUnseenLayer[team]->GetBitmap()->w, (float)GetTerrain()->GetBitmap()->h / (float)m_apUnseenLayer[team]->GetBitmap()->h));
+    RebuildUnseenMap(team);
 }
 
 
@@ -1791,30 +1800,25 @@ void Scene::ClearSeenPixels(int team)
         // Clear all the pixels off the map, set them to key color
         if (m_apUnseenLayer[team])
         {
-            for (std::list<Vector>::iterator itr = m_SeenPixels[team].begin(); itr != m_SeenPixels[team].end(); ++itr)
+            // The seen pixels are already seen in the UnseenMap, this only takes away the flash drawn over them on the layer's bitmap
+            for (const Vector &seenPixel : m_SeenPixels[team])
             {
-                putpixel(m_apUnseenLayer[team]->GetBitmap(), (*itr).m_X, (*itr).m_Y, g_MaskColor);
+                putpixel(m_apUnseenLayer[team]->GetBitmap(), seenPixel.m_X, seenPixel.m_Y, g_MaskColor);
 
                 // Clean up around the removed pixels too
-                CleanOrphanPixel((*itr).m_X + 1, (*itr).m_Y, W, team);
-                CleanOrphanPixel((*itr).m_X - 1, (*itr).m_Y, E, team);
-                CleanOrphanPixel((*itr).m_X, (*itr).m_Y + 1, N, team);
-                CleanOrphanPixel((*itr).m_X, (*itr).m_Y - 1, S, team);
-                CleanOrphanPixel((*itr).m_X + 1, (*itr).m_Y + 1, NW, team);
-                CleanOrphanPixel((*itr).m_X - 1, (*itr).m_Y + 1, NE, team);
-                CleanOrphanPixel((*itr).m_X - 1, (*itr).m_Y - 1, SE, team);
-                CleanOrphanPixel((*itr).m_X + 1, (*itr).m_Y - 1, SW, team);
+                CleanOrphanPixel(seenPixel.m_X + 1, seenPixel.m_Y, W, team);
+                CleanOrphanPixel(seenPixel.m_X - 1, seenPixel.m_Y, E, team);
+                CleanOrphanPixel(seenPixel.m_X, seenPixel.m_Y + 1, N, team);
+                CleanOrphanPixel(seenPixel.m_X, seenPixel.m_Y - 1, S, team);
+                CleanOrphanPixel(seenPixel.m_X + 1, seenPixel.m_Y + 1, NW, team);
+                CleanOrphanPixel(seenPixel.m_X - 1, seenPixel.m_Y + 1, NE, team);
+                CleanOrphanPixel(seenPixel.m_X - 1, seenPixel.m_Y - 1, SE, team);
+                CleanOrphanPixel(seenPixel.m_X + 1, seenPixel.m_Y - 1, SW, team);
             }
         }
 
-        // Now actually clear the list too
-        m_SeenPixels[team].clear();
-
-        // Transfer all cleaned pixels from orphans to the seen pixels for next frame
-        for (std::list<Vector>::iterator itr = m_CleanedPixels[team].begin(); itr != m_CleanedPixels[team].end(); ++itr)
-            m_SeenPixels[team].push_back(*itr);
-
-        // We have moved the cleaned pixels to the seen pixels list, now clean up the list for next frame
+        // Transfer all cleaned pixels from orphans to the seen pixels for next frame, and clear the cleaned ones for next frame. Swapping keeps the capacity of both logs around.
+        m_SeenPixels[team].swap(m_CleanedPixels[team]);
         m_CleanedPixels[team].clear();
     }
 }
@@ -1835,7 +1839,7 @@ bool Scene::CleanOrphanPixel(int posX, int posY, NeighborDirection checkingFrom,
     m_apUnseenLayer[team]->WrapPosition(posX, posY);
 
     // First check the actual position of the checked pixel, it may already been seen.
-    if (getpixel(m_apUnseenLayer[team]->GetBitmap(), posX, posY) == g_MaskColor)
+    if (!m_UnseenMaps[team].IsUnseen(posX, posY))
         return false;
 
     // Ok, not seen, so check surrounding pixels for 'support', ie unseen ones that will keep this also unseen
@@ -1846,60 +1850,60 @@ bool Scene::CleanOrphanPixel(int posX, int posY, NeighborDirection checkingFrom,
         testPosX = posX + 1;
         testPosY = posY;
         m_apUnseenLayer[team]->WrapPosition(testPosX, testPosY);
-        support += getpixel(m_apUnseenLayer[team]->GetBitmap(), testPosX, testPosY) != g_MaskColor ? 1 : 0;
+        support += m_UnseenMaps[team].IsUnseen(testPosX, testPosY) ? 1 : 0;
     }
     if (checkingFrom != W)
     {
         testPosX = posX - 1;
         testPosY = posY;
         m_apUnseenLayer[team]->WrapPosition(testPosX, testPosY);
-        support += getpixel(m_apUnseenLayer[team]->GetBitmap(), testPosX, testPosY) != g_MaskColor ? 1 : 0;
+        support += m_UnseenMaps[team].IsUnseen(testPosX, testPosY) ? 1 : 0;
     }
     if (checkingFrom != S)
     {
         testPosX = posX;
         testPosY = posY + 1;
         m_apUnseenLayer[team]->WrapPosition(testPosX, testPosY);
-        support += getpixel(m_apUnseenLayer[team]->GetBitmap(), testPosX, testPosY) != g_MaskColor ? 1 : 0;
+        support += m_UnseenMaps[team].IsUnseen(testPosX, testPosY) ? 1 : 0;
     }
     if (checkingFrom != N)
     {
         testPosX = posX;
         testPosY = posY - 1;
         m_apUnseenLayer[team]->WrapPosition(testPosX, testPosY);
-        support += getpixel(m_apUnseenLayer[team]->GetBitmap(), testPosX, testPosY) != g_MaskColor ? 1 : 0;
+        support += m_UnseenMaps[team].IsUnseen(testPosX, testPosY) ? 1 : 0;
     }
     if (checkingFrom != SE)
     {
         testPosX = posX + 1;
         testPosY = posY + 1;
         m_apUnseenLayer[team]->WrapPosition(testPosX, testPosY);
-        support += getpixel(m_apUnseenLayer[team]->GetBitmap(), testPosX, testPosY) != g_MaskColor ? 0.5f : 0;
+        support += m_UnseenMaps[team].IsUnseen(testPosX, testPosY) ? 0.5f : 0;
     }
     if (checkingFrom != SW)
     {
         testPosX = posX - 1;
         testPosY = posY + 1;
         m_apUnseenLayer[team]->WrapPosition(testPosX, testPosY);
-        support += getpixel(m_apUnseenLayer[team]->GetBitmap(), testPosX, testPosY) != g_MaskColor ? 0.5f : 0;
+        support += m_UnseenMaps[team].IsUnseen(testPosX, testPosY) ? 0.5f : 0;
     }
     if (checkingFrom != NW)
     {
         testPosX = posX - 1;
         testPosY = posY - 1;
         m_apUnseenLayer[team]->WrapPosition(testPosX, testPosY);
-        support += getpixel(m_apUnseenLayer[team]->GetBitmap(), testPosX, testPosY) != g_MaskColor ? 0.5f : 0;
+        support += m_UnseenMaps[team].IsUnseen(testPosX, testPosY) ? 0.5f : 0;
     }
     if (checkingFrom != NE)
     {
         testPosX = posX + 1;
         testPosY = posY - 1;
         m_apUnseenLayer[team]->WrapPosition(testPosX, testPosY);
-        support += getpixel(m_apUnseenLayer[team]->GetBitmap(), testPosX, testPosY) != g_MaskColor ? 0.5f : 0;
+        support += m_UnseenMaps[team].IsUnseen(testPosX, testPosY) ? 0.5f : 0;
     }
 
     // Orphaned enough to remove?
-    if (support <= 2.5)
+    if (support <= 2.5 && m_UnseenMaps[team].Reveal(posX, posY))
     {
         putpixel(m_apUnseenLayer[team]->GetBitmap(), posX, posY, g_MaskColor);
         m_CleanedPixels[team].push_back(Vector(posX, posY));
@@ -1909,6 +1913,92 @@ bool Scene::CleanOrphanPixel(int posX, int posY, NeighborDirection checkingFrom,
     return false;
 }
 
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RevealUnseenPixel
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Reveals a pixel of a team's unseen layer and adds it to the log of
+//                  seen pixels, if it is still unseen.
+
+bool Scene::RevealUnseenPixel(int posX, int posY, int team)
+{
+    if (team == Activity::NoTeam || !m_apUnseenLayer[team] || !m_UnseenMaps[team].Reveal(posX, posY))
+        return false;
+
+    // Add the pixel to the log of now seen pixels so it can be visually flashed
+    m_SeenPixels[team].push_back(Vector(posX, posY));
+    // Clear to key color that pixel on the map so it won't be drawn as unseen anymore
+    putpixel(m_apUnseenLayer[team]->GetBitmap(), posX, posY, g_MaskColor);
+    return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RestoreUnseenPixel
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Hides a pixel of a team's unseen layer again, if it is seen.
+
+bool Scene::RestoreUnseenPixel(int posX, int posY, int team)
+{
+    if (team == Activity::NoTeam || !m_apUnseenLayer[team] || !m_UnseenMaps[team].Restore(posX, posY))
+        return false;
+
+    putpixel(m_apUnseenLayer[team]->GetBitmap(), posX, posY, g_BlackColor);
+    return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RevealUnseenBox
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Reveals a box of a team's unseen layer.
+
+void Scene::RevealUnseenBox(int left, int top, int right, int bottom, int team)
+{
+    if (team == Activity::NoTeam || !m_apUnseenLayer[team] || !m_apUnseenLayer[team]->GetBitmap())
+        return;
+
+    // Scripts can keep revealing boxes that are already fully seen, so skip drawing over them again
+    if (m_UnseenMaps[team].IsCreated() && !m_UnseenMaps[team].AnythingUnseenInBox(left, top, right, bottom))
+        return;
+
+    m_UnseenMaps[team].RevealBox(left, top, right, bottom);
+    rectfill(m_apUnseenLayer[team]->GetBitmap(), left, top, right, bottom, g_MaskColor);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RestoreUnseenBox
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Hides a box of a team's unseen layer again.
+
+void Scene::RestoreUnseenBox(int left, int top, int right, int bottom, int team)
+{
+    if (team == Activity::NoTeam || !m_apUnseenLayer[team] || !m_apUnseenLayer[team]->GetBitmap())
+        return;
+
+    m_UnseenMaps[team].RestoreBox(left, top, right, bottom);
+    rectfill(m_apUnseenLayer[team]->GetBitmap(), left, top, right, bottom, g_BlackColor);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RebuildUnseenMap
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Rebuilds a team's UnseenMap from the bitmap of its unseen layer.
+
+void Scene::RebuildUnseenMap(int team)
+{
+    if (m_apUnseenLayer[team] && m_apUnseenLayer[team]->GetBitmap())
+        m_UnseenMaps[team].Create(m_apUnseenLayer[team]->GetBitmap());
+    else
+        m_UnseenMaps[team].Reset();
+
+    // Logged pixels are in the coordinates of the old layer
+    m_SeenPixels[team].clear();
+    m_CleanedPixels[team].clear();
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 Vector Scene::GetDimensions() const {
@@ -2951,7 +3041,8 @@ void Scene::ResetPathFinding() {
 
 void Scene::BlockUntilAllPathingRequestsComplete() {
 	for (int team = Activity::Teams::NoTeam; team < Activity::Teams::MaxTeamCount; ++team) {
-		while (GetPathFinder(static_cast<Activity::Teams>(team))->GetCurrentPathingRequests() != 0) {};
+		const std::unique_ptr<PathFinder> &pathFinder = GetPathFinder(static_cast<Activity::Teams>(team));
+		while (pathFinder->GetCurrentPathingRequests() != 0 || pathFinder->GetQueuedPathingRequests() != 0) {};
 	}
 }
 
@@ -2966,15 +3057,7 @@ void Scene::UpdatePathFinding()
     constexpr int nodeUpdatesPerCall = 100;
     constexpr int maxUnupdatedMaterialAreas = 1000;
 
-    // If any pathing requests are active, don't update things yet, wait till they're finished
-	// TODO: this can indefinitely block updates if pathing requests are made every frame. Figure out a solution for this
-	// Either force-complete pathing requests occasionally, or delay starting new pathing requests if we've not updated in a while
-    for (int team = Activity::Teams::NoTeam; team < Activity::Teams::MaxTeamCount; ++team) {
-		if (GetPathFinder(static_cast<Activity::Teams>(team))->GetCurrentPathingRequests() != 0) {
-            return;
-        };
-	}
-
+    // Pathing requests in progress don't need to be waited on, they keep solving on the costs they started with while the updated costs are published for the next ones.
     int nodesToUpdate = nodeUpdatesPerCall / g_ActivityMan.GetActivity()->GetTeamCount();
     if (m_pTerrain->GetUpdatedMaterialAreas().size() > maxUnupdatedMaterialAreas) {
         // Our list of boxes is getting too big and a bit out of hand, so clear everything.
@@ -3024,9 +3107,9 @@ float Scene::CalculatePath(const Vector &start, const Vector &end, std::list<Vec
     return false;
 }
 
-std::shared_ptr<volatile PathRequest> Scene::CalculatePathAsync(const Vector &start, const Vector &end, float digStrength, Activity::Teams team, PathCompleteCallback callback) {
+std::shared_ptr<volatile PathRequest> Scene::CalculatePathAsync(const Vector &start, const Vector &end, float digStrength, Activity::Teams team, PathCompleteCallback callback, TaskPriority priority) {
     if (const std::unique_ptr<PathFinder> &pathFinder = GetPathFinder(team)) {
-        return pathFinder->CalculatePathAsync(start, end, digStrength, callback);
+        return pathFinder->CalculatePathAsync(start, end, digStrength, callback, priority);
     }
 
     return nullptr;
@@ -3104,9 +3187,9 @@ void Scene::Update()
 		{
 			if (m_apUnseenLayer[team])
 			{
-				for (std::list<Vector>::iterator itr = m_SeenPixels[team].begin(); itr != m_SeenPixels[team].end(); ++itr)
+				for (const Vector &seenPixel : m_SeenPixels[team])
 				{
-					putpixel(m_apUnseenLayer[team]->GetBitmap(), (*itr).m_X, (*itr).m_Y, g_WhiteColor);
+					putpixel(m_apUnseenLayer[team]->GetBitmap(), seenPixel.m_X, seenPixel.m_Y, g_WhiteColor);
 				}
 			}
 		}
@@ -18,6 +18,7 @@
 #include "Box.h"
 #include "Activity.h"
 #include "PathFinder.h"
+#include "UnseenMap.h"
 
 namespace RTE
 {
@@ -662,11 +663,80 @@ EntityAllocation(Scene)
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetSeenPixels
 //////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Gets the list of pixels that have been seen on a team's unseen layer.
+// Description:     Gets the log of pixels that have been seen on a team's unseen layer.
 // Arguments:       Which team to get the unseen layer for.
-// Return value:    The list of pixel coordinates in the unseen layer's scale.
+// Return value:    The pixel coordinates in the unseen layer's scale, in the order they
+//                  were revealed.
 
-    std::list<Vector> & GetSeenPixels(int team = Activity::TeamOne) { return m_SeenPixels[team]; }
+    std::vector<Vector> & GetSeenPixels(int team = Activity::TeamOne) { return m_SeenPixels[team]; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          AnythingUnseen
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Tells whether a team has any pixel of its unseen layer still unseen.
+// Arguments:       Which team to check the unseen layer of.
+// Return value:    Whether anything is still unseen. False if the team has no unseen layer.
+
+    bool AnythingUnseen(int team = Activity::TeamOne) const { return team != Activity::NoTeam && m_apUnseenLayer[team] && m_UnseenMaps[team].AnythingUnseen(); }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsUnseenPixel
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Checks whether a pixel of a team's unseen layer is still unseen.
+// Arguments:       The X and Y coordinates of the pixel, in the unseen layer's scale.
+//                  Which team's unseen layer to check.
+// Return value:    Whether the pixel is unseen. Pixels off the layer count as unseen.
+//                  False if the team has no unseen layer.
+
+    bool IsUnseenPixel(int posX, int posY, int team = Activity::TeamOne) const { return team != Activity::NoTeam && m_apUnseenLayer[team] && m_UnseenMaps[team].IsCreated() && m_UnseenMaps[team].IsUnseen(posX, posY); }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RevealUnseenPixel
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Reveals a pixel of a team's unseen layer and adds it to the log of
+//                  seen pixels, if it is still unseen.
+// Arguments:       The X and Y coordinates of the pixel, in the unseen layer's scale.
+//                  Which team's unseen layer to reveal the pixel on.
+// Return value:    Whether an unseen pixel was revealed.
+
+    bool RevealUnseenPixel(int posX, int posY, int team = Activity::TeamOne);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RestoreUnseenPixel
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Hides a pixel of a team's unseen layer again, if it is seen.
+// Arguments:       The X and Y coordinates of the pixel, in the unseen layer's scale.
+//                  Which team's unseen layer to hide the pixel on.
+// Return value:    Whether a seen pixel was hidden.
+
+    bool RestoreUnseenPixel(int posX, int posY, int team = Activity::TeamOne);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RevealUnseenBox
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Reveals a box of a team's unseen layer. Revealed boxes don't go in
+//                  the log of seen pixels.
+// Arguments:       The edges of the box, inclusive, in the unseen layer's scale.
+//                  Which team's unseen layer to reveal the box on.
+// Return value:    None.
+
+    void RevealUnseenBox(int left, int top, int right, int bottom, int team = Activity::TeamOne);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RestoreUnseenBox
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Hides a box of a team's unseen layer again.
+// Arguments:       The edges of the box, inclusive, in the unseen layer's scale.
+//                  Which team's unseen layer to hide the box on.
+// Return value:    None.
+
+    void RestoreUnseenBox(int left, int top, int right, int bottom, int team = Activity::TeamOne);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1216,8 +1286,10 @@ const SceneObject * PickPlacedActorInRange(int whichSet, Vector &scenePoint, int
 	/// <param name="end">End position of the pathfinding request.</param>
 	/// <param name="digStrength">The maximum material strength any actor traveling along the path can dig through.</param>
 	/// <param name="team">The team we're pathing for (doors for this team will be considered passable)</param>
+	/// <param name="callback">The callback function to be run when the path calculation is completed.</param>
+	/// <param name="priority">The priority of the request. Queued requests are solved highest priority first.</param>
     /// <returns>A shared pointer to the volatile PathRequest to be used to track whehter the asynchrnous path calculation has been completed, and check its results.</returns>
-    std::shared_ptr<volatile PathRequest> CalculatePathAsync(const Vector &start, const Vector &end, float digStrength = c_PathFindingDefaultDigStrength, Activity::Teams team = Activity::Teams::NoTeam, PathCompleteCallback callback = nullptr);
+    std::shared_ptr<volatile PathRequest> CalculatePathAsync(const Vector &start, const Vector &end, float digStrength = c_PathFindingDefaultDigStrength, Activity::Teams team = Activity::Teams::NoTeam, PathCompleteCallback callback = nullptr, TaskPriority priority = TaskPriority::Normal);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1383,10 +1455,12 @@ protected:
     Vector m_UnseenPixelSize[Activity::MaxTeamCount];
     // Layers representing the unknown areas for each team
     SceneLayer *m_apUnseenLayer[Activity::MaxTeamCount];
+    // The unseen state of each team's unseen layer. The layers' bitmaps are only drawn, all checks and changes to what is unseen go through these
+    UnseenMap m_UnseenMaps[Activity::MaxTeamCount];
     // Which pixels of the unseen map have just been revealed this frame, in the coordinates of the unseen map
-    std::list<Vector> m_SeenPixels[Activity::MaxTeamCount];
+    std::vector<Vector> m_SeenPixels[Activity::MaxTeamCount];
     // Pixels on the unseen map deemed to be orphans and cleaned up, will be moved to seen pixels next update
-    std::list<Vector> m_CleanedPixels[Activity::MaxTeamCount];
+    std::vector<Vector> m_CleanedPixels[Activity::MaxTeamCount];
     // Whether this Scene is scheduled to be orbitally scanned by any team
     bool m_ScanScheduled[Activity::MaxTeamCount];
 
@@ -1436,6 +1510,12 @@ private:
 	/// <param name="saveFullData">Whether or not to save most data. Turned off for stuff like SceneEditor saves.</param>
 	void SaveSceneObject(Writer &writer, const SceneObject *sceneObjectToSave, bool isChildAttachable, bool saveFullData) const;
 
+	/// <summary>
+	/// Rebuilds a team's UnseenMap from the bitmap of its unseen layer. Needs to be done whenever the unseen layer or its bitmap is replaced.
+	/// </summary>
+	/// <param name="team">The team whose UnseenMap to rebuild.</param>
+	void RebuildUnseenMap(int team);
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Clear
 //////////////////////////////////////////////////////////////////////////////////////////
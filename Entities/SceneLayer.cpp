@@ -4,6 +4,7 @@
 #include "SceneMan.h"
 #include "SettingsMan.h"
 #include "ActivityMan.h"
+#include "ThreadMan.h"
 
 namespace RTE {
 
@@ -15,11 +16,14 @@ namespace RTE {
 	template <bool TRACK_DRAWINGS>
 	void SceneLayerImpl<TRACK_DRAWINGS>::Clear() {
 		m_BitmapFile.Reset();
+		m_BitmapClearTask = std::future<void>();
 		m_MainBitmap = nullptr;
 		m_BackBitmap = nullptr;
-		m_HasTransferredLock = true;
 		m_LastClearColor = ColorKeys::g_InvalidColor;
-		m_Drawings.clear();
+		m_DrawingTileCountX = 0;
+		m_DrawingTileCountY = 0;
+		m_DrawnTiles.clear();
+		m_BackDrawnTiles.clear();
 		m_MainBitmapOwned = false;
 		m_DrawMasked = true;
 		m_WrapX = true;
@@ -56,6 +60,7 @@ namespace RTE {
 
 		m_BackBitmap = create_bitmap_ex(bitmap_color_depth(m_MainBitmap), m_MainBitmap->w, m_MainBitmap->h);
 		m_LastClearColor = ColorKeys::g_InvalidColor;
+		InitDrawingTiles();
 
 		m_DrawMasked = drawMasked;
 		m_Offset = offset;
@@ -95,6 +100,7 @@ namespace RTE {
 
 			m_BackBitmap = create_bitmap_ex(bitmap_color_depth(m_MainBitmap), m_MainBitmap->w, m_MainBitmap->h);
 			m_LastClearColor = ColorKeys::g_InvalidColor;
+			InitDrawingTiles();
 
 			InitScrollRatios();
 
@@ -137,6 +143,7 @@ namespace RTE {
 
 	template <bool TRACK_DRAWINGS>
 	void SceneLayerImpl<TRACK_DRAWINGS>::Destroy(bool notInherited) {
+		g_ThreadMan.Wait(m_BitmapClearTask);
 		if (m_MainBitmapOwned) { destroy_bitmap(m_MainBitmap); }
 		if (m_BackBitmap) { destroy_bitmap(m_BackBitmap); }
 		if (!notInherited) { Entity::Destroy(); }
@@ -191,6 +198,7 @@ namespace RTE {
 
 		m_BackBitmap = create_bitmap_ex(bitmap_color_depth(m_MainBitmap), m_MainBitmap->w, m_MainBitmap->h);
 		m_LastClearColor = ColorKeys::g_InvalidColor;
+		InitDrawingTiles();
 
 		InitScrollRatios();
 		return 0;
@@ -225,8 +233,7 @@ namespace RTE {
 
 			m_BitmapFile.SetDataPath(bitmapPath);
 			if (doAsyncSaves) {
-				std::thread saveThread(saveLayerBitmap, outputBitmap);
-				saveThread.detach();
+				g_ThreadMan.Submit([saveLayerBitmap, outputBitmap]() { saveLayerBitmap(outputBitmap); }, TaskPriority::Low);
 			} else {
 				saveLayerBitmap(outputBitmap);
 			}
@@ -238,6 +245,10 @@ namespace RTE {
 
 	template <bool TRACK_DRAWINGS>
 	int SceneLayerImpl<TRACK_DRAWINGS>::ClearData() {
+		// Make sure the background clear isn't still touching the backbuffer before destroying it.
+		g_ThreadMan.Wait(m_BitmapClearTask);
+		m_BitmapClearTask = std::future<void>();
+
 		if (m_MainBitmap && m_MainBitmapOwned) { destroy_bitmap(m_MainBitmap); }
 		m_MainBitmap = nullptr;
 		m_MainBitmapOwned = false;
@@ -245,6 +256,8 @@ namespace RTE {
 		if (m_BackBitmap) { destroy_bitmap(m_BackBitmap); }
 		m_BackBitmap = nullptr;
 		m_LastClearColor = ColorKeys::g_InvalidColor;
+		m_DrawnTiles.clear();
+		m_BackDrawnTiles.clear();
 
 		return 0;
 	}
@@ -294,35 +307,24 @@ namespace RTE {
 	void SceneLayerImpl<TRACK_DRAWINGS>::ClearBitmap(ColorKeys clearTo) {
 		RTEAssert(m_MainBitmapOwned, "Bitmap not owned! We shouldn't be clearing this!");
 
-		while (!m_HasTransferredLock) {};
-		m_BitmapClearMutex.lock();
-
-		// Okay, this is tricky. In extremely CPU-saturated environments, this thread can be delayed from starting (and thus locking the mutex) until this ClearBitmap has been called again
-		// So we need to ensure that the other thread has actually acquired the lock before we can continue
-		// Apparently there's no good way to transfer locks to other threads, so we do this instead
-		m_HasTransferredLock = false;
+		// Wait for the previous background clear to finish, since that's the bitmap we're about to swap in.
+		g_ThreadMan.Wait(m_BitmapClearTask);
 
 		if (m_LastClearColor != clearTo) {
 			// Note: We're clearing to a different color than expected, which is expensive! We should always aim to clear to the same color to avoid it as much as possible.
 			clear_to_color(m_BackBitmap, clearTo);
+			std::fill(m_BackDrawnTiles.begin(), m_BackDrawnTiles.end(), 0);
 			m_LastClearColor = clearTo;
 		}
 
 		std::swap(m_MainBitmap, m_BackBitmap);
+		m_DrawnTiles.swap(m_BackDrawnTiles);
 
-		// Start a new thread to clear the backbuffer bitmap asynchronously.
-		std::thread clearBackBitmapThread([this, clearTo](BITMAP *bitmap, std::vector<IntRect> drawings) {
-			this->m_BitmapClearMutex.lock();
-			this->m_HasTransferredLock = true;
-			ClearDrawings(bitmap, drawings, clearTo);
-			this->m_BitmapClearMutex.unlock();
-		}, m_BackBitmap, m_Drawings);
-
-		clearBackBitmapThread.detach();
-
-		m_BitmapClearMutex.unlock();
-
-		m_Drawings.clear(); // This was copied into the new thread, so can be safely deleted.
+		// Clear the backbuffer bitmap asynchronously on the ThreadMan. High priority because the next ClearBitmap call will block on it.
+		// The backbuffer's tile flags are only touched by this task until then, so they can be used by reference.
+		m_BitmapClearTask = g_ThreadMan.Submit([this, clearTo, bitmap = m_BackBitmap]() {
+			ClearDrawings(bitmap, m_BackDrawnTiles, clearTo);
+		}, TaskPriority::High);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -422,7 +424,32 @@ namespace RTE {
 	template <bool TRACK_DRAWINGS>
 	void SceneLayerImpl<TRACK_DRAWINGS>::RegisterDrawing(int left, int top, int right, int bottom) {
 		if constexpr (TRACK_DRAWINGS) {
-			m_Drawings.emplace_back(left, top, right, bottom);
+			if (m_DrawnTiles.empty()) {
+				return;
+			}
+			int width = m_MainBitmap->w;
+			int height = m_MainBitmap->h;
+
+			// Some callers pass the corners of the area swapped, which drawing functions like rectfill accept too.
+			if (left > right) { std::swap(left, right); }
+			if (top > bottom) { std::swap(top, bottom); }
+
+			// Wrap the parts of the area that are out of bounds to the opposite side, the same way drawing on a wrapping scene does.
+			std::array<std::pair<int, int>, 3> spansX = { std::make_pair(left, right), std::make_pair(1, 0), std::make_pair(1, 0) };
+			std::array<std::pair<int, int>, 3> spansY = { std::make_pair(top, bottom), std::make_pair(1, 0), std::make_pair(1, 0) };
+			if (m_WrapX) {
+				if (left < 0) { spansX[1] = { left + width, width - 1 }; }
+				if (right >= width) { spansX[2] = { 0, right - width }; }
+			}
+			if (m_WrapY) {
+				if (top < 0) { spansY[1] = { top + height, height - 1 }; }
+				if (bottom >= height) { spansY[2] = { 0, bottom - height }; }
+			}
+			for (const auto &[spanTop, spanBottom] : spansY) {
+				for (const auto &[spanLeft, spanRight] : spansX) {
+					FlagDrawnTiles(spanLeft, spanTop, spanRight, spanBottom);
+				}
+			}
 		}
 	}
 
@@ -438,24 +465,21 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	template <bool TRACK_DRAWINGS>
-	void SceneLayerImpl<TRACK_DRAWINGS>::Draw(BITMAP *targetBitmap, Box &targetBox, bool offsetNeedsScrollRatioAdjustment) {
+	void SceneLayerImpl<TRACK_DRAWINGS>::Draw(BITMAP *targetBitmap, Box &targetBox, const Vector &offsetOverride, bool offsetNeedsScrollRatioAdjustment) const {
 		RTEAssert(m_MainBitmap, "Data of this SceneLayerImpl has not been loaded before trying to draw!");
 
-		if (offsetNeedsScrollRatioAdjustment) { m_Offset.SetXY(std::floor(m_Offset.GetX() * m_ScrollRatio.GetX()), std::floor(m_Offset.GetY() * m_ScrollRatio.GetY())); }
 		if (targetBox.IsEmpty()) { targetBox = Box(Vector(), static_cast<float>(targetBitmap->w), static_cast<float>(targetBitmap->h)); }
-		if (!m_WrapX && static_cast<float>(targetBitmap->w) > targetBox.GetWidth()) { m_Offset.SetX(0); }
-		if (!m_WrapY && static_cast<float>(targetBitmap->h) > targetBox.GetHeight()) { m_Offset.SetY(0); }
-
-		m_Offset -= m_OriginOffset;
-		WrapPosition(m_Offset);
+		Vector drawOffset = CalculateDrawOffset(offsetOverride, targetBitmap, targetBox, offsetNeedsScrollRatioAdjustment);
 
 		set_clip_rect(targetBitmap, targetBox.GetCorner().GetFloorIntX(), targetBox.GetCorner().GetFloorIntY(), static_cast<int>(targetBox.GetCorner().GetX() + targetBox.GetWidth()) - 1, static_cast<int>(targetBox.GetCorner().GetY() + targetBox.GetHeight()) - 1);
 		bool drawScaled = m_ScaleFactor.GetX() > 1.0F || m_ScaleFactor.GetY() > 1.0F;
 
-		if (m_MainBitmap->w > targetBitmap->w && m_MainBitmap->h > targetBitmap->h) {
-			DrawWrapped(targetBitmap, targetBox, drawScaled);
+		if (TRACK_DRAWINGS && m_DrawMasked && !drawScaled) {
+			DrawDrawnTiles(targetBitmap, targetBox, drawOffset);
+		} else if (m_MainBitmap->w > targetBitmap->w && m_MainBitmap->h > targetBitmap->h) {
+			DrawWrapped(targetBitmap, targetBox, drawOffset, drawScaled);
 		} else {
-			DrawTiled(targetBitmap, targetBox, drawScaled);
+			DrawTiled(targetBitmap, targetBox, drawOffset, drawScaled);
 		}
 		set_clip_rect(targetBitmap, 0, 0, targetBitmap->w - 1, targetBitmap->h - 1);
 	}
@@ -463,14 +487,28 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	template <bool TRACK_DRAWINGS>
-	void SceneLayerImpl<TRACK_DRAWINGS>::DrawWrapped(BITMAP *targetBitmap, const Box &targetBox, bool drawScaled) const {
+	Vector SceneLayerImpl<TRACK_DRAWINGS>::CalculateDrawOffset(const Vector &offset, const BITMAP *targetBitmap, const Box &targetBox, bool offsetNeedsScrollRatioAdjustment) const {
+		Vector drawOffset = offset;
+		if (offsetNeedsScrollRatioAdjustment) { drawOffset.SetXY(std::floor(drawOffset.GetX() * m_ScrollRatio.GetX()), std::floor(drawOffset.GetY() * m_ScrollRatio.GetY())); }
+		if (!m_WrapX && static_cast<float>(targetBitmap->w) > targetBox.GetWidth()) { drawOffset.SetX(0); }
+		if (!m_WrapY && static_cast<float>(targetBitmap->h) > targetBox.GetHeight()) { drawOffset.SetY(0); }
+
+		drawOffset -= m_OriginOffset;
+		WrapPosition(drawOffset);
+		return drawOffset;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <bool TRACK_DRAWINGS>
+	void SceneLayerImpl<TRACK_DRAWINGS>::DrawWrapped(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset, bool drawScaled) const {
 		if (!drawScaled) {
-			std::array<int, 2> sourcePosX = { m_Offset.GetFloorIntX(), 0 };
-			std::array<int, 2> sourcePosY = { m_Offset.GetFloorIntY(), 0 };
-			std::array<int, 2> sourceWidth = { m_MainBitmap->w - m_Offset.GetFloorIntX(), m_Offset.GetFloorIntX() };
-			std::array<int, 2> sourceHeight = { m_MainBitmap->h - m_Offset.GetFloorIntY(), m_Offset.GetFloorIntY() };
-			std::array<int, 2> destPosX = { targetBox.GetCorner().GetFloorIntX(), targetBox.GetCorner().GetFloorIntX() + m_MainBitmap->w - m_Offset.GetFloorIntX() };
-			std::array<int, 2> destPosY = { targetBox.GetCorner().GetFloorIntY(), targetBox.GetCorner().GetFloorIntY() + m_MainBitmap->h - m_Offset.GetFloorIntY() };
+			std::array<int, 2> sourcePosX = { drawOffset.GetFloorIntX(), 0 };
+			std::array<int, 2> sourcePosY = { drawOffset.GetFloorIntY(), 0 };
+			std::array<int, 2> sourceWidth = { m_MainBitmap->w - drawOffset.GetFloorIntX(), drawOffset.GetFloorIntX() };
+			std::array<int, 2> sourceHeight = { m_MainBitmap->h - drawOffset.GetFloorIntY(), drawOffset.GetFloorIntY() };
+			std::array<int, 2> destPosX = { targetBox.GetCorner().GetFloorIntX(), targetBox.GetCorner().GetFloorIntX() + m_MainBitmap->w - drawOffset.GetFloorIntX() };
+			std::array<int, 2> destPosY = { targetBox.GetCorner().GetFloorIntY(), targetBox.GetCorner().GetFloorIntY() + m_MainBitmap->h - drawOffset.GetFloorIntY() };
 
 			for (int i = 0; i < 2; ++i) {
 				for (int j = 0; j < 2; ++j) {
@@ -482,18 +520,14 @@ namespace RTE {
 				}
 			}
 		} else {
-			std::array<int, 2> sourceWidth = { m_MainBitmap->w, m_Offset.GetFloorIntX() / m_ScaleFactor.GetFloorIntX() };
-			std::array<int, 2> sourceHeight = { m_MainBitmap->h, m_Offset.GetFloorIntY() / m_ScaleFactor.GetFloorIntY() };
-			std::array<int, 2> destPosX = { targetBox.GetCorner().GetFloorIntX() - m_Offset.GetFloorIntX(), targetBox.GetCorner().GetFloorIntX() + m_ScaledDimensions.GetFloorIntX() - m_Offset.GetFloorIntX() };
-			std::array<int, 2> destPosY = { targetBox.GetCorner().GetFloorIntY() - m_Offset.GetFloorIntY(), targetBox.GetCorner().GetFloorIntY() + m_ScaledDimensions.GetFloorIntY() - m_Offset.GetFloorIntY() };
+			std::array<int, 2> sourceWidth = { m_MainBitmap->w, drawOffset.GetFloorIntX() / m_ScaleFactor.GetFloorIntX() };
+			std::array<int, 2> sourceHeight = { m_MainBitmap->h, drawOffset.GetFloorIntY() / m_ScaleFactor.GetFloorIntY() };
+			std::array<int, 2> destPosX = { targetBox.GetCorner().GetFloorIntX() - drawOffset.GetFloorIntX(), targetBox.GetCorner().GetFloorIntX() + m_ScaledDimensions.GetFloorIntX() - drawOffset.GetFloorIntX() };
+			std::array<int, 2> destPosY = { targetBox.GetCorner().GetFloorIntY() - drawOffset.GetFloorIntY(), targetBox.GetCorner().GetFloorIntY() + m_ScaledDimensions.GetFloorIntY() - drawOffset.GetFloorIntY() };
 
 			for (int i = 0; i < 2; ++i) {
 				for (int j = 0; j < 2; ++j) {
-					if (m_DrawMasked) {
-						masked_stretch_blit(m_MainBitmap, targetBitmap, 0, 0, sourceWidth[j], sourceHeight[i], destPosX[j], destPosY[i], sourceWidth[j] * m_ScaleFactor.GetFloorIntX() + 1, sourceHeight[i] * m_ScaleFactor.GetFloorIntY() + 1);
-					} else {
-						stretch_blit(m_MainBitmap, targetBitmap, 0, 0, sourceWidth[j], sourceHeight[i], destPosX[j], destPosY[i], sourceWidth[j] * m_ScaleFactor.GetFloorIntX() + 1, sourceHeight[i] * m_ScaleFactor.GetFloorIntY() + 1);
-					}
+					DrawStretched(targetBitmap, sourceWidth[j], sourceHeight[i], destPosX[j], destPosY[i], sourceWidth[j] * m_ScaleFactor.GetFloorIntX() + 1, sourceHeight[i] * m_ScaleFactor.GetFloorIntY() + 1);
 				}
 			}
 		}
@@ -502,17 +536,17 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	template <bool TRACK_DRAWINGS>
-	void SceneLayerImpl<TRACK_DRAWINGS>::DrawTiled(BITMAP *targetBitmap, const Box &targetBox, bool drawScaled) const {
+	void SceneLayerImpl<TRACK_DRAWINGS>::DrawTiled(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset, bool drawScaled) const {
 		int bitmapWidth = m_ScaledDimensions.GetFloorIntX();
 		int bitmapHeight = m_ScaledDimensions.GetFloorIntY();
-		int areaToCoverX = m_Offset.GetFloorIntX() + targetBox.GetCorner().GetFloorIntX() + std::min(targetBitmap->w, static_cast<int>(targetBox.GetWidth()));
-		int areaToCoverY = m_Offset.GetFloorIntY() + targetBox.GetCorner().GetFloorIntY() + std::min(targetBitmap->h, static_cast<int>(targetBox.GetHeight()));
+		int areaToCoverX = drawOffset.GetFloorIntX() + targetBox.GetCorner().GetFloorIntX() + std::min(targetBitmap->w, static_cast<int>(targetBox.GetWidth()));
+		int areaToCoverY = drawOffset.GetFloorIntY() + targetBox.GetCorner().GetFloorIntY() + std::min(targetBitmap->h, static_cast<int>(targetBox.GetHeight()));
 
 		for (int tiledOffsetX = 0; tiledOffsetX < areaToCoverX;) {
-			int destX = targetBox.GetCorner().GetFloorIntX() + tiledOffsetX - m_Offset.GetFloorIntX();
+			int destX = targetBox.GetCorner().GetFloorIntX() + tiledOffsetX - drawOffset.GetFloorIntX();
 
 			for (int tiledOffsetY = 0; tiledOffsetY < areaToCoverY;) {
-				int destY = targetBox.GetCorner().GetFloorIntY() + tiledOffsetY - m_Offset.GetFloorIntY();
+				int destY = targetBox.GetCorner().GetFloorIntY() + tiledOffsetY - drawOffset.GetFloorIntY();
 
 				if (!drawScaled) {
 					if (m_DrawMasked) {
@@ -521,11 +555,7 @@ namespace RTE {
 						blit(m_MainBitmap, targetBitmap, 0, 0, destX, destY, bitmapWidth, bitmapHeight);
 					}
 				} else {
-					if (m_DrawMasked) {
-						masked_stretch_blit(m_MainBitmap, targetBitmap, 0, 0, m_MainBitmap->w, m_MainBitmap->h, destX, destY, bitmapWidth, bitmapHeight);
-					} else {
-						stretch_blit(m_MainBitmap, targetBitmap, 0, 0, m_MainBitmap->w, m_MainBitmap->h, destX, destY, bitmapWidth, bitmapHeight);
-					}
+					DrawStretched(targetBitmap, m_MainBitmap->w, m_MainBitmap->h, destX, destY, bitmapWidth, bitmapHeight);
 				}
 				if (!m_WrapY) {
 					break;
@@ -542,44 +572,143 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	template <bool TRACK_DRAWINGS>
-	void SceneLayerImpl<TRACK_DRAWINGS>::ClearDrawings(BITMAP* bitmap, const std::vector<IntRect> &drawings, ColorKeys clearTo) const {
-		if constexpr (TRACK_DRAWINGS) {
-			for (const IntRect &rect : drawings) {
-				int left = rect.m_Left;
-				int top = rect.m_Top;
-				int bottom = rect.m_Bottom;
-				int right = rect.m_Right;
-
-				rectfill(bitmap, left, top, right, bottom, clearTo);
-
-				if (m_WrapX) {
-					if (left < 0) {
-						int wrapLeft = left + bitmap->w;
-						int wrapRight = bitmap->w - 1;
-						rectfill(bitmap, wrapLeft, top, wrapRight, bottom, clearTo);
+	void SceneLayerImpl<TRACK_DRAWINGS>::DrawDrawnTiles(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset) const {
+		int offsetX = drawOffset.GetFloorIntX();
+		int offsetY = drawOffset.GetFloorIntY();
+		int areaToCoverX = offsetX + std::min(targetBitmap->w, static_cast<int>(targetBox.GetWidth()));
+		int areaToCoverY = offsetY + std::min(targetBitmap->h, static_cast<int>(targetBox.GetHeight()));
+
+		// The visible area can span more than one wrapped copy of the bitmap, so go through each copy and blit the drawn tiles of it that are visible. Consecutive drawn tiles in a row are blitted together.
+		for (int tiledOffsetY = 0; tiledOffsetY < areaToCoverY; tiledOffsetY += m_MainBitmap->h) {
+			int firstTileY = std::max(offsetY - tiledOffsetY, 0) / c_DrawingTileSize;
+			int lastTileY = std::min((std::min(areaToCoverY - tiledOffsetY, m_MainBitmap->h) - 1) / c_DrawingTileSize, m_DrawingTileCountY - 1);
+
+			for (int tiledOffsetX = 0; tiledOffsetX < areaToCoverX; tiledOffsetX += m_MainBitmap->w) {
+				int firstTileX = std::max(offsetX - tiledOffsetX, 0) / c_DrawingTileSize;
+				int lastTileX = std::min((std::min(areaToCoverX - tiledOffsetX, m_MainBitmap->w) - 1) / c_DrawingTileSize, m_DrawingTileCountX - 1);
+
+				for (int tileY = firstTileY; tileY <= lastTileY; ++tileY) {
+					const unsigned char *tileRow = &m_DrawnTiles[tileY * m_DrawingTileCountX];
+					int sourceY = tileY * c_DrawingTileSize;
+					int sourceHeight = std::min(sourceY + c_DrawingTileSize, m_MainBitmap->h) - sourceY;
+
+					for (int tileX = firstTileX; tileX <= lastTileX; ++tileX) {
+						if (!tileRow[tileX]) {
+							continue;
+						}
+						int runEndTileX = tileX;
+						while (runEndTileX < lastTileX && tileRow[runEndTileX + 1]) {
+							++runEndTileX;
+						}
+						int sourceX = tileX * c_DrawingTileSize;
+						int sourceWidth = std::min((runEndTileX + 1) * c_DrawingTileSize, m_MainBitmap->w) - sourceX;
+						masked_blit(m_MainBitmap, targetBitmap, sourceX, sourceY, targetBox.GetCorner().GetFloorIntX() + tiledOffsetX + sourceX - offsetX, targetBox.GetCorner().GetFloorIntY() + tiledOffsetY + sourceY - offsetY, sourceWidth, sourceHeight);
+						tileX = runEndTileX;
 					}
+				}
+				if (!m_WrapX) {
+					break;
+				}
+			}
+			if (!m_WrapY) {
+				break;
+			}
+		}
+	}
 
-					if (right >= bitmap->w) {
-						int wrapLeft = 0;
-						int wrapRight = right - bitmap->w;
-						rectfill(bitmap, wrapLeft, top, wrapRight, bottom, clearTo);
-					}
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <bool TRACK_DRAWINGS>
+	void SceneLayerImpl<TRACK_DRAWINGS>::DrawStretched(BITMAP *targetBitmap, int sourceWidth, int sourceHeight, int destX, int destY, int destWidth, int destHeight) const {
+		sourceWidth = std::min(sourceWidth, m_MainBitmap->w);
+		sourceHeight = std::min(sourceHeight, m_MainBitmap->h);
+		bool clipped = targetBitmap->clip != 0;
+		int firstX = std::max(destX, clipped ? targetBitmap->cl : 0);
+		int firstY = std::max(destY, clipped ? targetBitmap->ct : 0);
+		int endX = std::min(destX + destWidth, clipped ? targetBitmap->cr : targetBitmap->w);
+		int endY = std::min(destY + destHeight, clipped ? targetBitmap->cb : targetBitmap->h);
+		if (sourceWidth <= 0 || sourceHeight <= 0 || destWidth <= 0 || destHeight <= 0 || firstX >= endX || firstY >= endY) {
+			return;
+		}
+
+		// Nearest neighbor sampling, same as stretch_blit. The source column of each target column is the same for every row, so it's only worked out once.
+		std::vector<int> sourceColumns(endX - firstX);
+		for (int posX = firstX; posX < endX; ++posX) {
+			sourceColumns[posX - firstX] = static_cast<int>((static_cast<int64_t>(posX - destX) * sourceWidth) / destWidth);
+		}
+		int maskColor = bitmap_mask_color(m_MainBitmap);
+		bool directAccess = bitmap_color_depth(m_MainBitmap) == 8 && bitmap_color_depth(targetBitmap) == 8 && is_memory_bitmap(m_MainBitmap) && is_memory_bitmap(targetBitmap);
+
+		for (int posY = firstY; posY < endY; ++posY) {
+			int sourceY = static_cast<int>((static_cast<int64_t>(posY - destY) * sourceHeight) / destHeight);
+			if (directAccess) {
+				const unsigned char *sourceRow = m_MainBitmap->line[sourceY];
+				unsigned char *targetRow = targetBitmap->line[posY];
+				for (int posX = firstX; posX < endX; ++posX) {
+					unsigned char sourcePixel = sourceRow[sourceColumns[posX - firstX]];
+					if (!m_DrawMasked || sourcePixel != maskColor) { targetRow[posX] = sourcePixel; }
 				}
+			} else {
+				for (int posX = firstX; posX < endX; ++posX) {
+					int sourcePixel = getpixel(m_MainBitmap, sourceColumns[posX - firstX], sourceY);
+					if (!m_DrawMasked || sourcePixel != maskColor) { putpixel(targetBitmap, posX, posY, sourcePixel); }
+				}
+			}
+		}
+	}
 
-				if (m_WrapY) {
-					if (top < 0) {
-						int wrapTop = top + bitmap->h;
-						int wrapBottom = bitmap->h - 1;
-						rectfill(bitmap, left, wrapTop, right, wrapBottom, clearTo);
-					}
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <bool TRACK_DRAWINGS>
+	void SceneLayerImpl<TRACK_DRAWINGS>::InitDrawingTiles() {
+		if constexpr (TRACK_DRAWINGS) {
+			m_DrawingTileCountX = (m_MainBitmap->w + c_DrawingTileSize - 1) / c_DrawingTileSize;
+			m_DrawingTileCountY = (m_MainBitmap->h + c_DrawingTileSize - 1) / c_DrawingTileSize;
+			m_DrawnTiles.assign(static_cast<size_t>(m_DrawingTileCountX * m_DrawingTileCountY), 1);
+			m_BackDrawnTiles.assign(static_cast<size_t>(m_DrawingTileCountX * m_DrawingTileCountY), 0);
+		}
+	}
 
-					if (bottom >= bitmap->h) {
-						int wrapTop = 0;
-						int wrapBottom = bottom - bitmap->h;
-						rectfill(bitmap, left, wrapTop, right, wrapBottom, clearTo);
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <bool TRACK_DRAWINGS>
+	void SceneLayerImpl<TRACK_DRAWINGS>::FlagDrawnTiles(int left, int top, int right, int bottom) {
+		left = std::max(left, 0);
+		top = std::max(top, 0);
+		right = std::min(right, m_MainBitmap->w - 1);
+		bottom = std::min(bottom, m_MainBitmap->h - 1);
+		if (left > right || top > bottom) {
+			return;
+		}
+		for (int tileY = top / c_DrawingTileSize; tileY <= bottom / c_DrawingTileSize; ++tileY) {
+			unsigned char *tileRow = &m_DrawnTiles[tileY * m_DrawingTileCountX];
+			std::fill(tileRow + left / c_DrawingTileSize, tileRow + right / c_DrawingTileSize + 1, 1);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <bool TRACK_DRAWINGS>
+	void SceneLayerImpl<TRACK_DRAWINGS>::ClearDrawings(BITMAP *bitmap, std::vector<unsigned char> &drawnTiles, ColorKeys clearTo) const {
+		if constexpr (TRACK_DRAWINGS) {
+			for (int tileY = 0; tileY < m_DrawingTileCountY; ++tileY) {
+				const unsigned char *tileRow = &drawnTiles[tileY * m_DrawingTileCountX];
+				int top = tileY * c_DrawingTileSize;
+				int bottom = std::min(top + c_DrawingTileSize, bitmap->h) - 1;
+
+				for (int tileX = 0; tileX < m_DrawingTileCountX; ++tileX) {
+					if (!tileRow[tileX]) {
+						continue;
+					}
+					int runEndTileX = tileX;
+					while (runEndTileX + 1 < m_DrawingTileCountX && tileRow[runEndTileX + 1]) {
+						++runEndTileX;
 					}
+					rectfill(bitmap, tileX * c_DrawingTileSize, top, std::min((runEndTileX + 1) * c_DrawingTileSize, bitmap->w) - 1, bottom, clearTo);
+					tileX = runEndTileX;
 				}
 			}
+			std::fill(drawnTiles.begin(), drawnTiles.end(), 0);
 		} else {
 			clear_to_color(bitmap, clearTo);
 		}
@@ -243,7 +243,7 @@ namespace RTE {
 
 #pragma region Drawing Tracking
 		/// <summary>
-		/// Registers an area of the SceneLayer to be drawn upon. These areas will be cleared when ClearBitmap is called.
+		/// Registers an area of the SceneLayer to be drawn upon. These areas will be cleared when ClearBitmap is called. The corners of the area may be passed in either order.
 		/// </summary>
 		/// <param name="left">The position of the left side of the area to be drawn upon.</param>
 		/// <param name="top">The position of the top of the area to be drawn upon.</param>
@@ -271,7 +271,16 @@ namespace RTE {
 		/// <param name="targetBitmap">The bitmap to draw to.</param>
 		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
 		/// <param name="offsetNeedsScrollRatioAdjustment">Whether the offset of this SceneLayer or the passed in offset override need to be adjusted to scroll ratio.</param>
-		virtual void Draw(BITMAP *targetBitmap, Box &targetBox, bool offsetNeedsScrollRatioAdjustment = false);
+		void Draw(BITMAP *targetBitmap, Box &targetBox, bool offsetNeedsScrollRatioAdjustment = false) const { Draw(targetBitmap, targetBox, m_Offset, offsetNeedsScrollRatioAdjustment); }
+
+		/// <summary>
+		/// Draws this SceneLayer scrolled to the passed in offset to a bitmap. This doesn't modify this SceneLayer, so it can be drawn to different bitmaps at different offsets concurrently.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw to.</param>
+		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="offsetOverride">The offset to draw this SceneLayer at instead of its own offset.</param>
+		/// <param name="offsetNeedsScrollRatioAdjustment">Whether the offset of this SceneLayer or the passed in offset override need to be adjusted to scroll ratio.</param>
+		virtual void Draw(BITMAP *targetBitmap, Box &targetBox, const Vector &offsetOverride, bool offsetNeedsScrollRatioAdjustment = false) const;
 #pragma endregion
 
 	protected:
@@ -282,10 +291,15 @@ namespace RTE {
 		BITMAP *m_BackBitmap; //!< The backbuffer BITMAP of this SceneLayer.
 
 		// We use two bitmaps, as a backbuffer. While the main bitmap is being used, the secondary bitmap will be cleared on a separate thread. This is because we tend to want to clear some scene layers every frame and that is costly.
-		std::mutex m_BitmapClearMutex; //!< Mutex for clearing BITMAP in background.
-		volatile bool m_HasTransferredLock; //!< Bool to ensure that the other thread has actually acquired the lock before we can continue
+		std::future<void> m_BitmapClearTask; //!< The ThreadMan task clearing the backbuffer BITMAP in the background, if any.
 		ColorKeys m_LastClearColor; //!< The last color we cleared this SceneLayer to.
-		std::vector<IntRect> m_Drawings; //!< All the areas drawn within on this SceneLayer since the last clear.
+
+		// Drawings are tracked per tile instead of per area, so overlapping drawings are only cleared once, and only the tiles that were actually drawn on need to be cleared and composited when drawing this SceneLayer.
+		static constexpr int c_DrawingTileSize = 16; //!< The width and height of the tiles drawings are tracked in, in pixels.
+		int m_DrawingTileCountX; //!< The number of drawing tracking tiles along the X axis of the BITMAPs.
+		int m_DrawingTileCountY; //!< The number of drawing tracking tiles along the Y axis of the BITMAPs.
+		std::vector<unsigned char> m_DrawnTiles; //!< Row-major flags for all the tiles of the main BITMAP, set for tiles that were drawn within since the last clear.
+		std::vector<unsigned char> m_BackDrawnTiles; //!< Row-major flags for all the tiles of the backbuffer BITMAP, set for tiles that still need to be cleared.
 
 		bool m_MainBitmapOwned; //!< Whether the main bitmap is owned by this.
 		bool m_DrawMasked; //!< Whether pixels marked as transparent (index 0, magenta) are skipped when drawing or not (masked drawing).
@@ -317,30 +331,78 @@ namespace RTE {
 		bool ForceBoundsOrWrapPosition(Vector &pos, bool forceBounds) const;
 
 #pragma region Draw Breakdown
+		/// <summary>
+		/// Calculates the position on this SceneLayer's bitmap that lines up with the corner of the target box, adjusted for scroll ratio, origin offset and wrapping.
+		/// </summary>
+		/// <param name="offset">The scrolled offset to draw this SceneLayer at.</param>
+		/// <param name="targetBitmap">The bitmap that will be drawn to.</param>
+		/// <param name="targetBox">The box on the target bitmap drawing will be limited to.</param>
+		/// <param name="offsetNeedsScrollRatioAdjustment">Whether the offset needs to be adjusted to scroll ratio.</param>
+		/// <returns>The offset to draw this SceneLayer's bitmap at.</returns>
+		Vector CalculateDrawOffset(const Vector &offset, const BITMAP *targetBitmap, const Box &targetBox, bool offsetNeedsScrollRatioAdjustment) const;
+
 		/// <summary>
 		/// Performs wrapped drawing of this SceneLayer's bitmap to the screen in cases where it is both wider and taller than the target bitmap.
 		/// </summary>
 		/// <param name="targetBitmap">The bitmap to draw to.</param>
 		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="drawOffset">The offset to draw this SceneLayer's bitmap at, as calculated by CalculateDrawOffset.</param>
 		/// <param name="drawScaled">Whether to use scaled drawing routines or not.</param>
-		void DrawWrapped(BITMAP *targetBitmap, const Box &targetBox, bool drawScaled) const;
+		void DrawWrapped(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset, bool drawScaled) const;
 
 		/// <summary>
 		/// Performs tiled drawing of this SceneLayer's bitmap to the screen in cases where the target bitmap is larger in some dimension.
 		/// </summary>
 		/// <param name="targetBitmap">The bitmap to draw to.</param>
 		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="drawOffset">The offset to draw this SceneLayer's bitmap at, as calculated by CalculateDrawOffset.</param>
 		/// <param name="drawScaled">Whether to use scaled drawing routines or not.</param>
-		void DrawTiled(BITMAP *targetBitmap, const Box &targetBox, bool drawScaled) const;
+		void DrawTiled(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset, bool drawScaled) const;
+
+		/// <summary>
+		/// Performs masked drawing of only the tiles of this SceneLayer's bitmap that were drawn within since the last clear. Used for tracked layers that are mostly empty.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw to.</param>
+		/// <param name="targetBox">The box on the target bitmap to limit drawing to, with the corner of box being where the scroll position lines up.</param>
+		/// <param name="drawOffset">The offset to draw this SceneLayer's bitmap at, as calculated by CalculateDrawOffset.</param>
+		void DrawDrawnTiles(BITMAP *targetBitmap, const Box &targetBox, const Vector &drawOffset) const;
+
+		/// <summary>
+		/// Draws the top left part of this SceneLayer's bitmap stretched to an area of the target bitmap, masked if this SceneLayer is drawn masked. Unlike Allegro's stretch_blit this keeps no global state, so screens can be drawn on different threads.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to draw to. Drawing is limited to its clip rectangle.</param>
+		/// <param name="sourceWidth">The width of the part of this SceneLayer's bitmap to draw.</param>
+		/// <param name="sourceHeight">The height of the part of this SceneLayer's bitmap to draw.</param>
+		/// <param name="destX">The X position on the target bitmap to draw to.</param>
+		/// <param name="destY">The Y position on the target bitmap to draw to.</param>
+		/// <param name="destWidth">The width to stretch the drawn part to.</param>
+		/// <param name="destHeight">The height to stretch the drawn part to.</param>
+		void DrawStretched(BITMAP *targetBitmap, int sourceWidth, int sourceHeight, int destX, int destY, int destWidth, int destHeight) const;
 #pragma endregion
 
 	private:
 
 		/// <summary>
-		/// Clears any tracked and drawn-to areas.
+		/// Sets up the drawing tracking tiles for the current main BITMAP. All tiles of the main BITMAP are flagged as drawn because its contents are unknown.
+		/// </summary>
+		void InitDrawingTiles();
+
+		/// <summary>
+		/// Flags all the tiles within an area as drawn within. The area is clipped to the bounds of the main BITMAP and is not wrapped.
+		/// </summary>
+		/// <param name="left">The position of the left side of the area.</param>
+		/// <param name="top">The position of the top of the area.</param>
+		/// <param name="right">The position of the right side of the area.</param>
+		/// <param name="bottom">The position of the bottom of the area.</param>
+		void FlagDrawnTiles(int left, int top, int right, int bottom);
+
+		/// <summary>
+		/// Clears any tracked and drawn-to tiles and resets their flags.
 		/// </summary>
+		/// <param name="bitmap">The BITMAP to clear.</param>
+		/// <param name="drawnTiles">The drawn tile flags of the BITMAP.</param>
 		/// <param name="clearTo">Color to clear to.</param>
-		void ClearDrawings(BITMAP *bitmap, const std::vector<IntRect> &drawings, ColorKeys clearTo) const;
+		void ClearDrawings(BITMAP *bitmap, std::vector<unsigned char> &drawnTiles, ColorKeys clearTo) const;
 
 		/// <summary>
 		/// Clears all the member variables of this SceneLayer, effectively resetting the members of this abstraction level only.
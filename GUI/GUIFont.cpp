@@ -340,8 +340,10 @@ int GUIFont::CalculateHeight(const std::string &Text, int MaxWidth) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIFont::CacheColor(unsigned long Color) {
+	std::lock_guard<std::mutex> colorCacheLock(m_ColorCacheMutex);
+
 	// Make sure we haven't already cached this color and it isn't a 0 color
-	if (GetFontColor(Color) != nullptr || !Color) {
+	if (!Color || std::find_if(m_ColorCache.begin(), m_ColorCache.end(), [Color](const FontColor &cachedColor) { return cachedColor.m_Color == Color; }) != m_ColorCache.end()) {
 		return;
 	}
 
@@ -376,7 +378,9 @@ void GUIFont::CacheColor(unsigned long Color) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 GUIFont::FontColor * GUIFont::GetFontColor(unsigned long Color) {
-	std::vector<FontColor>::iterator it;
+	std::lock_guard<std::mutex> colorCacheLock(m_ColorCacheMutex);
+
+	std::deque<FontColor>::iterator it;
 	FontColor *F = nullptr;
 	for (it = m_ColorCache.begin(); it != m_ColorCache.end(); it++) {
 		F = &(*it);
@@ -418,7 +422,8 @@ void GUIFont::Destroy() {
 	}
 
 	// Go through the color cache and destroy the bitmaps
-	std::vector<FontColor>::iterator it;
+	std::lock_guard<std::mutex> colorCacheLock(m_ColorCacheMutex);
+	std::deque<FontColor>::iterator it;
 	FontColor *FC = 0;
 	for (it = m_ColorCache.begin(); it != m_ColorCache.end(); it++) {
 		FC = &(*it);
@@ -179,7 +179,8 @@ private:
 
     GUIBitmap *m_Font;
     GUIScreen *m_Screen;
-    std::vector<FontColor > m_ColorCache;
+    std::deque<FontColor> m_ColorCache; // Deque so cached colors stay put while other threads cache more of them
+    std::mutex m_ColorCacheMutex; // Shared fonts are drawn with from several player screens at once
 
     int m_FontHeight;
     unsigned long m_MainColor;
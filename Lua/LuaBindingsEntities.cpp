@@ -930,6 +930,7 @@ namespace RTE {
 		.property("DamageMultiplier", &MOSRotating::GetDamageMultiplier, &MOSRotating::SetDamageMultiplier)
 		.property("WoundCount", (int (MOSRotating:: *)() const) &MOSRotating::GetWoundCount)
 		.property("OrientToVel", &MOSRotating::GetOrientToVel, &MOSRotating::SetOrientToVel)
+		.property("RotatedSpriteCacheAngleStep", &MOSRotating::GetRotatedSpriteCacheAngleStep, &MOSRotating::SetRotatedSpriteCacheAngleStep)
 
 		.def_readonly("Attachables", &MOSRotating::m_Attachables, luabind::return_stl_iterator)
 		.def_readonly("Wounds", &MOSRotating::m_Wounds, luabind::return_stl_iterator)
@@ -191,8 +191,8 @@ namespace RTE {
 		.def("GetTotalModuleCount", &PresetMan::GetTotalModuleCount)
 		.def("GetOfficialModuleCount", &PresetMan::GetOfficialModuleCount)
 		.def("AddPreset", &PresetMan::AddEntityPreset)
-		.def("GetPreset", (const Entity *(PresetMan::*)(std::string, std::string, int))&PresetMan::GetEntityPreset)
-		.def("GetPreset", (const Entity *(PresetMan::*)(std::string, std::string, std::string))&PresetMan::GetEntityPreset)
+		.def("GetPreset", (const Entity *(PresetMan::*)(const std::string &, const std::string &, int))&PresetMan::GetEntityPreset)
+		.def("GetPreset", (const Entity *(PresetMan::*)(const std::string &, const std::string &, const std::string &))&PresetMan::GetEntityPreset)
 		.def("GetLoadout", (Actor * (PresetMan::*)(std::string, std::string, bool))&PresetMan::GetLoadout, luabind::adopt(luabind::result))
 		.def("GetLoadout", (Actor * (PresetMan::*)(std::string, int, bool))&PresetMan::GetLoadout, luabind::adopt(luabind::result))
 		.def("GetRandomOfGroup", &PresetMan::GetRandomOfGroup)
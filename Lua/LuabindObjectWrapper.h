@@ -7,6 +7,15 @@ namespace luabind::adl {
 
 namespace RTE {
 
+	class Entity;
+	class LuabindObjectWrapper;
+
+	/// <summary>
+	/// A typed argument to pass into a Lua function, so it can be pushed onto the Lua stack as-is instead of being formatted into a string and parsed back.
+	/// std::monostate is pushed as nil, Entities are downcast to their most derived Lua type and LuabindObjectWrappers push the Lua object they already hold.
+	/// </summary>
+	using LuaFunctionArgument = std::variant<std::monostate, bool, double, const Entity *, const LuabindObjectWrapper *>;
+
 	/// <summary>
 	/// A wrapper for luabind objects, to avoid include problems with luabind.
 	/// </summary>
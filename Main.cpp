@@ -43,6 +43,7 @@
 #include "WindowMan.h"
 #include "NetworkServer.h"
 #include "NetworkClient.h"
+#include "ThreadMan.h"
 
 extern "C" { FILE __iob_func[3] = { *stdin,*stdout,*stderr }; }
 
@@ -58,6 +59,7 @@ namespace RTE {
 	void InitializeManagers() {
 		g_SettingsMan.Initialize();
 
+		g_ThreadMan.Initialize();
 		g_LuaMan.Initialize();
 		g_NetworkServer.Initialize();
 		g_NetworkClient.Initialize();
@@ -87,6 +89,8 @@ namespace RTE {
 	/// Destroys all the managers and frees all loaded data before termination.
 	/// </summary>
 	void DestroyManagers() {
+		// Finish any outstanding background work (e.g. saves) before anything it might touch is torn down.
+		g_ThreadMan.Destroy();
 		g_NetworkClient.Destroy();
 		g_NetworkServer.Destroy();
 		g_MetaMan.Destroy();
@@ -102,6 +106,8 @@ namespace RTE {
 		g_FrameMan.Destroy();
 		g_TimerMan.Destroy();
 		g_LuaMan.Destroy();
+		MOSRotating::GetRotatedSpriteCache().Clear();
+		MOSRotating::DestroyIntermediateBitmaps();
 		ContentFile::FreeAllLoaded();
 		g_ConsoleMan.Destroy();
 
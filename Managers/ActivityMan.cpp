@@ -23,6 +23,7 @@
 #include "AssemblyEditor.h"
 
 #include "NetworkServer.h"
+#include "ThreadMan.h"
 #include "MultiplayerServerLobby.h"
 #include "MultiplayerGame.h"
 
@@ -137,9 +138,8 @@ namespace RTE {
 			DecrementSavingThreadCount();
 		};
 
-		// Make a thread to flush the data to the disk, and detach it so it can run concurrently with the game simulation.
-		std::thread saveThread(saveWriterData, std::move(writer));
-		saveThread.detach();
+		// Flush the data to the disk on the ThreadMan so it can run concurrently with the game simulation.
+		g_ThreadMan.Submit([saveWriterData, writerToSave = std::move(writer)]() mutable { saveWriterData(std::move(writerToSave)); }, TaskPriority::Low);
 
 		// We didn't transfer ownership, so we must be very careful that sceneAltered's deletion doesn't touch the stuff we got from MovableMan.
 		modifiableScene->ClearPlacedObjectSet(Scene::PlacedObjectSets::PLACEONLOAD, false);
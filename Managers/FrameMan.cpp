@@ -10,6 +10,7 @@
 #include "ConsoleMan.h"
 #include "SettingsMan.h"
 #include "UInputMan.h"
+#include "ThreadMan.h"
 
 #include "SLTerrain.h"
 #include "SLBackground.h"
@@ -44,7 +45,9 @@ namespace RTE {
 		m_HSplit = false;
 		m_VSplit = false;
 		m_TwoPlayerVSplit = false;
-		m_PlayerScreen.reset();
+		for (std::unique_ptr<BITMAP, BitmapDeleter> &playerScreen : m_PlayerScreens) {
+			playerScreen.reset();
+		}
 		m_PlayerScreenWidth = 0;
 		m_PlayerScreenHeight = 0;
 		m_ScreenDumpBuffer.reset();
@@ -151,15 +154,13 @@ namespace RTE {
 		m_PlayerScreenWidth = m_BackBuffer8->w;
 		m_PlayerScreenHeight = m_BackBuffer8->h;
 
-		// Create the splitscreen buffer
+		// Create the splitscreen buffers
 		if (m_HSplit || m_VSplit) {
-			m_PlayerScreen = std::unique_ptr<BITMAP, BitmapDeleter>(create_bitmap_ex(8, resX / (m_VSplit ? 2 : 1), resY / (m_HSplit ? 2 : 1)));
-			clear_to_color(m_PlayerScreen.get(), m_BlackColor);
-			set_clip_state(m_PlayerScreen.get(), 1);
+			CreatePlayerScreens(resX / (m_VSplit ? 2 : 1), resY / (m_HSplit ? 2 : 1));
 
 			// Update these to represent the split screens
-			m_PlayerScreenWidth = m_PlayerScreen->w;
-			m_PlayerScreenHeight = m_PlayerScreen->h;
+			m_PlayerScreenWidth = m_PlayerScreens[0]->w;
+			m_PlayerScreenHeight = m_PlayerScreens[0]->h;
 		}
 
 		m_ScreenDumpBuffer = std::unique_ptr<BITMAP, BitmapDeleter>(create_bitmap_ex(24, m_BackBuffer32->w, m_BackBuffer32->h));
@@ -167,6 +168,21 @@ namespace RTE {
 		return 0;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void FrameMan::CreatePlayerScreens(int screenWidth, int screenHeight) {
+		int screenCount = (m_HSplit ? 2 : 1) * (m_VSplit ? 2 : 1);
+		for (int playerScreen = 0; playerScreen < c_MaxScreenCount; ++playerScreen) {
+			if (playerScreen < screenCount) {
+				m_PlayerScreens[playerScreen] = std::unique_ptr<BITMAP, BitmapDeleter>(create_bitmap_ex(8, screenWidth, screenHeight));
+				clear_to_color(m_PlayerScreens[playerScreen].get(), m_BlackColor);
+				set_clip_state(m_PlayerScreens[playerScreen].get(), 1);
+			} else {
+				m_PlayerScreens[playerScreen].reset();
+			}
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void FrameMan::CreatePresetColorTables() {
@@ -211,6 +227,7 @@ namespace RTE {
 
 		// Prune unused color tables every 5 real minutes to prevent ridiculous memory usage over time.
 		if (m_ColorTablePruneTimer.IsPastRealMS(300000)) {
+			std::lock_guard<std::mutex> colorTablesLock(m_ColorTablesMutex);
 			long long currentTime = g_TimerMan.GetAbsoluteTime() / 10000;
 			for (std::unordered_map<std::array<int, 4>, std::pair<COLOR_MAP, long long>> &colorTableMap : m_ColorTables) {
 				if (colorTableMap.size() >= 100) {
@@ -233,7 +250,9 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void FrameMan::ResetSplitScreens(bool hSplit, bool vSplit) {
-		if (m_PlayerScreen) { release_bitmap(m_PlayerScreen.get()); }
+		for (const std::unique_ptr<BITMAP, BitmapDeleter> &playerScreen : m_PlayerScreens) {
+			if (playerScreen) { release_bitmap(playerScreen.get()); }
+		}
 
 		// Override screen splitting according to settings if needed
 		if ((hSplit || vSplit) && !(hSplit && vSplit) && m_TwoPlayerVSplit) {
@@ -243,14 +262,12 @@ namespace RTE {
 		m_HSplit = hSplit;
 		m_VSplit = vSplit;
 
-		// Create the splitscreen buffer
+		// Create the splitscreen buffers
 		if (m_HSplit || m_VSplit) {
-			m_PlayerScreen = std::unique_ptr<BITMAP, BitmapDeleter>(create_bitmap_ex(8, g_WindowMan.GetResX() / (m_VSplit ? 2 : 1), g_WindowMan.GetResY() / (m_HSplit ? 2 : 1)));
-			clear_to_color(m_PlayerScreen.get(), m_BlackColor);
-			set_clip_state(m_PlayerScreen.get(), 1);
+			CreatePlayerScreens(g_WindowMan.GetResX() / (m_VSplit ? 2 : 1), g_WindowMan.GetResY() / (m_HSplit ? 2 : 1));
 
-			m_PlayerScreenWidth = m_PlayerScreen->w;
-			m_PlayerScreenHeight = m_PlayerScreen->h;
+			m_PlayerScreenWidth = m_PlayerScreens[0]->w;
+			m_PlayerScreenHeight = m_PlayerScreens[0]->h;
 		} else {
 			// No splits, so set the screen dimensions equal to the back buffer
 			m_PlayerScreenWidth = m_BackBuffer8->w;
@@ -431,6 +448,8 @@ namespace RTE {
 				break;
 		}
 
+		std::lock_guard<std::mutex> colorTablesLock(m_ColorTablesMutex);
+
 		// New color tables will be created using the default palette loaded at FrameMan initialization because handling per-palette per-mode color tables is too much headache, even if it may possibly produce better blending results.
 		if (m_ColorTables[blendMode].find(colorChannelBlendAmounts) == m_ColorTables[blendMode].end()) {
 			m_ColorTables[blendMode].try_emplace(colorChannelBlendAmounts);
@@ -459,6 +478,7 @@ namespace RTE {
 	void FrameMan::SetTransTableFromPreset(TransparencyPreset transPreset) {
 		RTEAssert(transPreset == TransparencyPreset::LessTrans || transPreset == TransparencyPreset::HalfTrans || transPreset == TransparencyPreset::MoreTrans, "Undefined transparency preset value passed in. See TransparencyPreset enumeration for defined values.");
 		std::array<int, 4> colorChannelBlendAmounts = { transPreset, transPreset, transPreset, BlendAmountLimits::MinBlend };
+		std::lock_guard<std::mutex> colorTablesLock(m_ColorTablesMutex);
 		if (m_ColorTables[DrawBlendMode::BlendTransparency].find(colorChannelBlendAmounts) != m_ColorTables[DrawBlendMode::BlendTransparency].end()) {
 			color_map = &m_ColorTables[DrawBlendMode::BlendTransparency].at(colorChannelBlendAmounts).first;
 			m_ColorTables[DrawBlendMode::BlendTransparency].at(colorChannelBlendAmounts).second = -1;
@@ -549,8 +569,7 @@ namespace RTE {
 						}
 						destroy_bitmap(bitmapToSaveCopy);
 					};
-					std::thread saveThread(saveScreenDump, outputBitmap);
-					saveThread.detach();
+					g_ThreadMan.Submit([saveScreenDump, outputBitmap]() { saveScreenDump(outputBitmap); }, TaskPriority::Low);
 
 					saveSuccess = true;
 				}
@@ -790,34 +809,31 @@ namespace RTE {
 	void FrameMan::Draw() {
 		// Count how many split screens we'll need
 		int screenCount = (m_HSplit ? 2 : 1) * (m_VSplit ? 2 : 1);
-		RTEAssert(screenCount <= 1 || m_PlayerScreen, "Splitscreen surface not ready when needed!");
+		RTEAssert(screenCount <= 1 || m_PlayerScreens[screenCount - 1], "Splitscreen surface not ready when needed!");
 
 		g_PostProcessMan.ClearScreenPostEffects();
 
 		// These accumulate the effects for each player's screen area, and are then transferred to the post-processing lists with the player screen offset applied
-		std::list<PostEffect> screenRelativeEffects;
-		std::list<Box> screenRelativeGlowBoxes;
+		std::array<std::list<PostEffect>, c_MaxScreenCount> screenRelativeEffects;
+		std::array<std::list<Box>, c_MaxScreenCount> screenRelativeGlowBoxes;
 
 		const Activity *pActivity = g_ActivityMan.GetActivity();
 
-		for (int playerScreen = 0; playerScreen < screenCount; ++playerScreen) {
-			screenRelativeEffects.clear();
-			screenRelativeGlowBoxes.clear();
+		std::array<BITMAP *, c_MaxScreenCount> drawScreens;
+		std::array<BITMAP *, c_MaxScreenCount> drawScreenGUIs;
+		std::array<Vector, c_MaxScreenCount> targetPositions;
 
-			BITMAP *drawScreen = (screenCount == 1) ? m_BackBuffer8.get() : m_PlayerScreen.get();
-			BITMAP *drawScreenGUI = drawScreen;
+		// Updating the scene view of a screen moves the scene layers and camera, so all screens are updated up front. SceneMan keeps the layer offsets of each screen for drawing them afterwards.
+		for (int playerScreen = 0; playerScreen < screenCount; ++playerScreen) {
+			drawScreens[playerScreen] = (screenCount == 1) ? m_BackBuffer8.get() : m_PlayerScreens[playerScreen].get();
+			drawScreenGUIs[playerScreen] = drawScreens[playerScreen];
 			if (IsInMultiplayerMode()) {
-				drawScreen = m_NetworkBackBufferIntermediate8[m_NetworkFrameCurrent][playerScreen].get();
-				drawScreenGUI = m_NetworkBackBufferIntermediateGUI8[m_NetworkFrameCurrent][playerScreen].get();
+				drawScreens[playerScreen] = m_NetworkBackBufferIntermediate8[m_NetworkFrameCurrent][playerScreen].get();
+				drawScreenGUIs[playerScreen] = m_NetworkBackBufferIntermediateGUI8[m_NetworkFrameCurrent][playerScreen].get();
 			}
-			// Need to clear the backbuffers because Scene background layers can be too small to fill the whole backbuffer or drawn masked resulting in artifacts from the previous frame.
-			clear_to_color(drawScreenGUI, ColorKeys::g_MaskColor);
-			// If in online multiplayer mode clear to mask color otherwise the scene background layers will get drawn over.
-			clear_to_color(drawScreen, IsInMultiplayerMode() ? ColorKeys::g_MaskColor : m_BlackColor);
-
-			AllegroBitmap playerGUIBitmap(drawScreenGUI);
+			const BITMAP *drawScreen = drawScreens[playerScreen];
 
-			// Update the scene view to line up with a specific screen and then draw it onto the intermediate screen
+			// Update the scene view to line up with a specific screen
 			g_SceneMan.Update(playerScreen);
 
 			// Save scene layer's offsets for each screen, server will pick them to build the frame state and send to client
@@ -843,41 +859,74 @@ namespace RTE {
 
 			// Try to move at the frame buffer copy time to maybe prevent wonkyness
 			m_TargetPos[m_NetworkFrameCurrent][playerScreen] = targetPos;
+			targetPositions[playerScreen] = targetPos;
+		}
 
-			// Draw the scene
-			if (!IsInMultiplayerMode()) {
-				g_SceneMan.Draw(drawScreen, drawScreenGUI, targetPos);
-			} else {
-				g_SceneMan.Draw(drawScreen, drawScreenGUI, targetPos, true, true);
-			}
+		// Each screen has its own intermediate bitmaps and Allegro's drawing mode, blenders and color map are per thread, so the screens are drawn in parallel up until they're put on the back buffer.
+		// Scaled layers are stretched by SceneLayer itself rather than Allegro's stretch_blit, which sets up its stretching in global state.
+		g_ThreadMan.ParallelFor(0, screenCount, [this, &drawScreens, &drawScreenGUIs, &targetPositions](int playerScreen) {
+			BITMAP *drawScreen = drawScreens[playerScreen];
+			BITMAP *drawScreenGUI = drawScreenGUIs[playerScreen];
+			const Vector &targetPos = targetPositions[playerScreen];
 
-			// Get only the scene-relative post effects that affect this player's screen
-			if (pActivity) {
-				g_PostProcessMan.GetPostScreenEffectsWrapped(targetPos, drawScreen->w, drawScreen->h, screenRelativeEffects, pActivity->GetTeamOfPlayer(pActivity->PlayerOfScreen(playerScreen)));
-				g_PostProcessMan.GetGlowAreasWrapped(targetPos, drawScreen->w, drawScreen->h, screenRelativeGlowBoxes);
+			// Worker threads start out with Allegro's default drawing state, so set up the state everything is drawn with on the main thread.
+			drawing_mode(DRAW_MODE_SOLID, nullptr, 0, 0);
+			SetTransTableFromPreset(TransparencyPreset::HalfTrans);
 
-				if (IsInMultiplayerMode()) { g_PostProcessMan.SetNetworkPostEffectsList(playerScreen, screenRelativeEffects); }
-			}
+			// Some HUD elements are randomized, so each screen gets its own random number generator instead of sharing the simulation one.
+			RandomGenerator *previousRandomGenerator = g_ThreadRandomGenerator;
+			g_ThreadRandomGenerator = &m_ScreenRandomGenerators[playerScreen];
+
+			// Need to clear the backbuffers because Scene background layers can be too small to fill the whole backbuffer or drawn masked resulting in artifacts from the previous frame.
+			clear_to_color(drawScreenGUI, ColorKeys::g_MaskColor);
+			// If in online multiplayer mode clear to mask color otherwise the scene background layers will get drawn over.
+			clear_to_color(drawScreen, IsInMultiplayerMode() ? ColorKeys::g_MaskColor : m_BlackColor);
+
+			// Draw the scene
+			g_SceneMan.DrawLayers(playerScreen, drawScreen, IsInMultiplayerMode(), IsInMultiplayerMode());
+
+			AllegroBitmap playerGUIBitmap(drawScreenGUI);
+			g_SceneMan.DrawGUI(playerScreen, drawScreen, drawScreenGUI, targetPos);
 
 			// TODO: Find out what keeps disabling the clipping on the draw bitmap
 			// Enable clipping on the draw bitmap
 			set_clip_state(drawScreen, 1);
 
 			DrawScreenText(playerScreen, playerGUIBitmap);
+			DrawScreenFlash(playerScreen, drawScreenGUI);
 
-			// The position of the current draw screen on the backbuffer
-			Vector screenOffset;
+			g_ThreadRandomGenerator = previousRandomGenerator;
+		}, 1);
 
-			// If we are dealing with split screens, then deal with the fact that we need to draw the player screens to different locations on the final buffer
-			if (screenCount > 1) { UpdateScreenOffsetForSplitScreen(playerScreen, screenOffset); }
+		// HUDs register post effects and glow areas while they're drawn, so they're only gathered once all the screens are done.
+		if (pActivity) {
+			g_ThreadMan.ParallelFor(0, screenCount, [this, pActivity, &drawScreens, &targetPositions, &screenRelativeEffects, &screenRelativeGlowBoxes](int playerScreen) {
+				const BITMAP *drawScreen = drawScreens[playerScreen];
+				const Vector &targetPos = targetPositions[playerScreen];
 
-			DrawScreenFlash(playerScreen, drawScreenGUI);
+				// Get only the scene-relative post effects that affect this player's screen
+				g_PostProcessMan.GetPostScreenEffectsWrapped(targetPos, drawScreen->w, drawScreen->h, screenRelativeEffects[playerScreen], pActivity->GetTeamOfPlayer(pActivity->PlayerOfScreen(playerScreen)));
+				g_PostProcessMan.GetGlowAreasWrapped(targetPos, drawScreen->w, drawScreen->h, screenRelativeGlowBoxes[playerScreen]);
+
+				if (IsInMultiplayerMode()) { g_PostProcessMan.SetNetworkPostEffectsList(playerScreen, screenRelativeEffects[playerScreen]); }
+			}, 1);
+		}
+
+		// Putting the screens on the back buffer and post-processing lists is shared, so it's done one screen at a time.
+		if (!IsInMultiplayerMode()) {
+			for (int playerScreen = 0; playerScreen < screenCount; ++playerScreen) {
+				BITMAP *drawScreen = drawScreens[playerScreen];
+
+				// The position of the current draw screen on the backbuffer
+				Vector screenOffset;
+
+				// If we are dealing with split screens, then deal with the fact that we need to draw the player screens to different locations on the final buffer
+				if (screenCount > 1) { UpdateScreenOffsetForSplitScreen(playerScreen, screenOffset); }
 
-			if (!IsInMultiplayerMode()) {
 				// Draw the intermediate draw splitscreen to the appropriate spot on the back buffer
 				blit(drawScreen, m_BackBuffer8.get(), 0, 0, screenOffset.GetFloorIntX(), screenOffset.GetFloorIntY(), drawScreen->w, drawScreen->h);
 
-				g_PostProcessMan.AdjustEffectsPosToPlayerScreen(playerScreen, drawScreen, screenOffset, screenRelativeEffects, screenRelativeGlowBoxes);
+				g_PostProcessMan.AdjustEffectsPosToPlayerScreen(playerScreen, drawScreen, screenOffset, screenRelativeEffects[playerScreen], screenRelativeGlowBoxes[playerScreen]);
 			}
 		}
 
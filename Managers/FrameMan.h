@@ -489,9 +489,12 @@ namespace RTE {
 		/// The key is an array of the RGBA values. The value is a pair of the color table itself and a time stamp of when it was last accessed for use during color table pruning.
 		/// </summary>
 		std::array<std::unordered_map<std::array<int, 4>, std::pair<COLOR_MAP, long long>>, DrawBlendMode::BlendModeCount> m_ColorTables;
+		std::mutex m_ColorTablesMutex; //!< Mutex for the color tables, which are looked up and created from every player screen while they're drawn in parallel.
 		Timer m_ColorTablePruneTimer; //!< Timer for pruning unused color tables to prevent ridiculous memory usage.
 
-		std::unique_ptr<BITMAP, BitmapDeleter> m_PlayerScreen; //!< Intermediary split screen bitmap.
+		std::array<RandomGenerator, c_MaxScreenCount> m_ScreenRandomGenerators; //!< Random number generators for drawing each player screen, so the screens don't share the simulation one while they're drawn in parallel.
+
+		std::array<std::unique_ptr<BITMAP, BitmapDeleter>, c_MaxScreenCount> m_PlayerScreens; //!< Intermediary split screen bitmaps, one per screen so the screens can be drawn in parallel.
 		int m_PlayerScreenWidth; //!< Width of the screen of each player. Will be smaller than resolution only if the screen is split.
 		int m_PlayerScreenHeight; //!< Height of the screen of each player. Will be smaller than resolution only if the screen is split.
 
@@ -541,6 +544,13 @@ namespace RTE {
 		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
 		int CreateBackBuffers();
 
+		/// <summary>
+		/// Creates the intermediary split screen bitmaps for the current screen splitting. This is called during CreateBackBuffers() and ResetSplitScreens().
+		/// </summary>
+		/// <param name="screenWidth">The width of each player screen.</param>
+		/// <param name="screenHeight">The height of each player screen.</param>
+		void CreatePlayerScreens(int screenWidth, int screenHeight);
+
 		/// <summary>
 		/// Creates the RGB lookup table and color table presets for drawing with transparency in indexed color mode. This is called during Initialize().
 		/// </summary>
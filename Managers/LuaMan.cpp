@@ -14,6 +14,11 @@ namespace RTE {
 		m_TempEntity = nullptr;
 		m_TempEntityVector.clear();
 		m_LastError.clear();
+		m_UserModuleCacheClearCount = 0;
+		m_ScriptDefinitionsVersion = 1;
+		m_MeasuredScriptCostMS = 0;
+		m_MeasuredScriptedObjectCount = 0;
+		m_EstimatedScriptCostMS = 0;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -232,6 +237,7 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void LuaStateWrapper::Destroy() {
+		m_CachedMethods.clear();
 		lua_close(m_State);
 	}
 
@@ -331,8 +337,16 @@ namespace RTE {
 			return s_luaStateOverride;
 		}
 
+		// Assign to the state with the lowest estimated script cost. Ties are broken round-robin, so states that haven't been measured yet are still filled evenly.
 		int ourState = m_LastAssignedLuaState;
-		m_LastAssignedLuaState = (m_LastAssignedLuaState + 1) % c_NumThreadedLuaStates;
+		for (int stateOffset = 1; stateOffset < c_NumThreadedLuaStates; ++stateOffset) {
+			int candidateState = (m_LastAssignedLuaState + stateOffset) % c_NumThreadedLuaStates;
+			if (m_ScriptStates[candidateState].GetEstimatedScriptCost() < m_ScriptStates[ourState].GetEstimatedScriptCost()) {
+				ourState = candidateState;
+			}
+		}
+		m_LastAssignedLuaState = (ourState + 1) % c_NumThreadedLuaStates;
+		m_ScriptStates[ourState].AddObjectToScriptCostEstimate();
 
 		bool success = m_ScriptStates[ourState].GetMutex().try_lock();
 		RTEAssert(success, "Script mutex was already locked while in a non-multithreaded environment!");
@@ -421,6 +435,9 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void LuaStateWrapper::ClearUserModuleCache() {
+		std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+		m_ScriptDefinitionsVersion++;
+		m_UserModuleCacheClearCount++;
 		luaL_dostring(m_State, "for m, n in pairs(package.loaded) do if type(n) == \"boolean\" then package.loaded[m] = nil; end; end;");
 	}
 
@@ -529,6 +546,9 @@ namespace RTE {
 		std::lock_guard<std::recursive_mutex> lock(m_Mutex);
 		s_currentLuaState = this;
 
+		// A script string can (re)define any function, so everything resolved through RunScriptMethod needs to be looked up again.
+		m_ScriptDefinitionsVersion++;
+
 		lua_pushcfunction(m_State, &AddFileAndLineToError);
 		// Load the script string onto the stack and then execute it with pcall. Pcall will call the file and line error handler if there's an error by pointing 2 up the stack to it.
 		if (luaL_loadstring(m_State, scriptString.c_str()) || lua_pcall(m_State, 0, LUA_MULTRET, -2)) {
@@ -566,9 +586,119 @@ namespace RTE {
 			argumentCount++;
 		}
 
+		PushFunctionArguments(functionEntityArguments, functionLiteralArguments);
+
+		if (lua_pcall(m_State, argumentCount, LUA_MULTRET, -argumentCount - 2) > 0) {
+			m_LastError = lua_tostring(m_State, -1);
+			lua_pop(m_State, 1);
+			g_ConsoleMan.PrintString("ERROR: " + m_LastError);
+			ClearErrors();
+			status = -1;
+		}
+		lua_pop(m_State, 1);
+
+		return status;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int LuaStateWrapper::RunScriptFunctionObject(const LuabindObjectWrapper *functionObjectWrapper, const LuabindObjectWrapper *selfObjectWrapper, std::initializer_list<LuaFunctionArgument> functionArguments) {
+		int status = 0;
+
+		std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+		s_currentLuaState = this;
+
+		lua_pushcfunction(m_State, &AddFileAndLineToError);
+		functionObjectWrapper->GetLuabindObject()->push(m_State);
+
+		// The self object is always passed in, as nil if it's missing, so the other arguments stay in the slots the function expects them in.
+		int argumentCount = static_cast<int>(functionArguments.size()) + 1;
+		if (selfObjectWrapper) {
+			selfObjectWrapper->GetLuabindObject()->push(m_State);
+		} else {
+			lua_pushnil(m_State);
+		}
+		for (const LuaFunctionArgument &functionArgument : functionArguments) {
+			PushFunctionArgument(functionArgument);
+		}
+
+		if (lua_pcall(m_State, argumentCount, LUA_MULTRET, -argumentCount - 2) > 0) {
+			m_LastError = lua_tostring(m_State, -1);
+			lua_pop(m_State, 1);
+			g_ConsoleMan.PrintString("ERROR: " + m_LastError);
+			ClearErrors();
+			status = -1;
+		}
+		lua_pop(m_State, 1);
+
+		return status;
+	}
+
+	int LuaStateWrapper::RunScriptMethod(const std::string &selfGlobalTableName, const std::string &functionName, const std::vector<const Entity *> &functionEntityArguments, const std::vector<std::string_view> &functionLiteralArguments) {
+		std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+		s_currentLuaState = this;
+
+		const LuabindObjectWrapper *functionObject = nullptr;
+		if (!GetCachedMethod(selfGlobalTableName, functionName, functionObject)) {
+			m_LastError = "Can't run method " + functionName + " because the global table " + selfGlobalTableName + " isn't defined!";
+			g_ConsoleMan.PrintString("ERROR: " + m_LastError);
+			ClearErrors();
+			return -1;
+		} else if (!functionObject) {
+			return 0;
+		}
+		int status = 0;
+
+		lua_pushcfunction(m_State, &AddFileAndLineToError);
+		functionObject->GetLuabindObject()->push(m_State);
+		lua_getglobal(m_State, selfGlobalTableName.c_str());
+		PushFunctionArguments(functionEntityArguments, functionLiteralArguments);
+
+		int argumentCount = functionEntityArguments.size() + functionLiteralArguments.size() + 1;
+		if (lua_pcall(m_State, argumentCount, LUA_MULTRET, -argumentCount - 2) > 0) {
+			m_LastError = lua_tostring(m_State, -1);
+			lua_pop(m_State, 1);
+			g_ConsoleMan.PrintString("ERROR: " + m_LastError);
+			ClearErrors();
+			status = -1;
+		}
+		lua_pop(m_State, 1);
+
+		return status;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool LuaStateWrapper::GetCachedMethod(const std::string &selfGlobalTableName, const std::string &functionName, const LuabindObjectWrapper *&functionObject) {
+		CachedMethod &cachedMethod = m_CachedMethods[selfGlobalTableName][functionName];
+		if (cachedMethod.Version == m_ScriptDefinitionsVersion) {
+			functionObject = cachedMethod.Function.get();
+			return true;
+		}
+
+		luabind::object tableObject = luabind::globals(m_State)[selfGlobalTableName];
+		if (luabind::type(tableObject) != LUA_TTABLE && luabind::type(tableObject) != LUA_TUSERDATA) {
+			// Not cached, so a table that gets defined later is picked up and the error keeps being reported until then.
+			functionObject = nullptr;
+			return false;
+		}
+		luabind::object tableFunctionObject = tableObject[functionName];
+		if (luabind::type(tableFunctionObject) == LUA_TFUNCTION) {
+			cachedMethod.Function = std::make_unique<LuabindObjectWrapper>(new luabind::object(tableFunctionObject), selfGlobalTableName);
+		} else {
+			cachedMethod.Function.reset();
+		}
+		cachedMethod.Version = m_ScriptDefinitionsVersion;
+
+		functionObject = cachedMethod.Function.get();
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LuaStateWrapper::PushFunctionArguments(const std::vector<const Entity *> &functionEntityArguments, const std::vector<std::string_view> &functionLiteralArguments) {
 		for (const Entity *functionEntityArgument : functionEntityArguments) {
-			std::unique_ptr<LuabindObjectWrapper> downCastEntityAsLuabindObjectWrapper(LuaAdaptersEntityCast::s_EntityToLuabindObjectCastFunctions.at(functionEntityArgument->GetClassName())(const_cast<Entity *>(functionEntityArgument), m_State));
-			downCastEntityAsLuabindObjectWrapper->GetLuabindObject()->push(m_State);
+			PushEntityArgument(functionEntityArgument);
 		}
 
 		for (const std::string_view &functionLiteralArgument : functionLiteralArguments) {
@@ -583,17 +713,38 @@ namespace RTE {
 				lua_pushlstring(m_State, functionLiteralArgument.data(), functionLiteralArgument.size());
 			}
 		}
+	}
 
-		if (lua_pcall(m_State, argumentCount, LUA_MULTRET, -argumentCount - 2) > 0) {
-			m_LastError = lua_tostring(m_State, -1);
-			lua_pop(m_State, 1);
-			g_ConsoleMan.PrintString("ERROR: " + m_LastError);
-			ClearErrors();
-			status = -1;
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LuaStateWrapper::PushFunctionArgument(const LuaFunctionArgument &functionArgument) {
+		if (const bool *boolArgument = std::get_if<bool>(&functionArgument)) {
+			lua_pushboolean(m_State, *boolArgument ? 1 : 0);
+		} else if (const double *numberArgument = std::get_if<double>(&functionArgument)) {
+			lua_pushnumber(m_State, *numberArgument);
+		} else if (const Entity * const *entityArgument = std::get_if<const Entity *>(&functionArgument)) {
+			PushEntityArgument(*entityArgument);
+		} else if (const LuabindObjectWrapper * const *objectArgument = std::get_if<const LuabindObjectWrapper *>(&functionArgument); objectArgument && *objectArgument && (*objectArgument)->GetLuabindObject()) {
+			(*objectArgument)->GetLuabindObject()->push(m_State);
+		} else {
+			lua_pushnil(m_State);
 		}
-		lua_pop(m_State, 1);
+	}
 
-		return status;
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LuaStateWrapper::PushEntityArgument(const Entity *entity) {
+		if (!entity) {
+			lua_pushnil(m_State);
+			return;
+		}
+		const Entity::ClassInfo *entityClass = &entity->GetClass();
+		auto castFunctionItr = m_EntityCastFunctions.find(entityClass);
+		if (castFunctionItr == m_EntityCastFunctions.end()) {
+			castFunctionItr = m_EntityCastFunctions.try_emplace(entityClass, &LuaAdaptersEntityCast::s_EntityToLuabindObjectCastFunctions.at(entity->GetClassName())).first;
+		}
+		std::unique_ptr<LuabindObjectWrapper> downCastEntityAsLuabindObjectWrapper((*castFunctionItr->second)(const_cast<Entity *>(entity), m_State));
+		downCastEntityAsLuabindObjectWrapper->GetLuabindObject()->push(m_State);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -619,6 +770,9 @@ namespace RTE {
 		std::lock_guard<std::recursive_mutex> lock(m_Mutex);
 		s_currentLuaState = this;
 
+		// Running a script file can (re)define any function, so everything resolved through RunScriptMethod needs to be looked up again.
+		m_ScriptDefinitionsVersion++;
+
 		lua_pushcfunction(m_State, &AddFileAndLineToError);
 		SetLuaPath(fullScriptPath);
 		// Load the script file's contents onto the stack and then execute it with pcall. Pcall will call the file and line error handler if there's an error by pointing 2 up the stack to it.
@@ -660,6 +814,18 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	void LuaStateWrapper::RecordScriptCost(float scriptTimeMS, size_t scriptedObjectCount) {
+		m_MeasuredScriptCostMS += (scriptTimeMS - m_MeasuredScriptCostMS) * c_ScriptCostSmoothing;
+		m_MeasuredScriptedObjectCount = scriptedObjectCount;
+		m_EstimatedScriptCostMS = m_MeasuredScriptCostMS;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void LuaStateWrapper::AddObjectToScriptCostEstimate() {
+		m_EstimatedScriptCostMS += (m_MeasuredScriptedObjectCount > 0 && m_MeasuredScriptCostMS > 0) ? m_MeasuredScriptCostMS / static_cast<float>(m_MeasuredScriptedObjectCount) : c_DefaultScriptCostPerObjectMS;
+	}
+
     void LuaStateWrapper::Update() {
 
     }
@@ -719,6 +885,19 @@ namespace RTE {
 		return isDefined;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	LuabindObjectWrapper * LuaStateWrapper::RetrieveTableEntry(const std::string &tableName, const std::string &indexName) {
+		std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+
+		luabind::object tableObject = luabind::globals(m_State)[tableName];
+		if (luabind::type(tableObject) != LUA_TTABLE) {
+			return nullptr;
+		}
+		luabind::object entryObject = tableObject[indexName];
+		return luabind::type(entryObject) != LUA_TNIL ? new LuabindObjectWrapper(new luabind::object(entryObject), "") : nullptr;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool LuaStateWrapper::TableEntryIsDefined(const std::string &tableName, const std::string &indexName) {
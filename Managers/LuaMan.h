@@ -4,6 +4,7 @@
 #include "Singleton.h"
 #include "Entity.h"
 #include "RTETools.h"
+#include "LuabindObjectWrapper.h"
 
 #define g_LuaMan LuaMan::Instance()
 
@@ -11,8 +12,6 @@ struct lua_State;
 
 namespace RTE {
 
-	class LuabindObjectWrapper;
-
 	class LuaStateWrapper {
 	public:
 #pragma region Creation
@@ -110,6 +109,27 @@ namespace RTE {
 		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
 		int RunScriptFunctionObject(const LuabindObjectWrapper *functionObjectWrapper, const std::string &selfGlobalTableName, const std::string &selfGlobalTableKey, const std::vector<const Entity *> &functionEntityArguments = std::vector<const Entity *>(), const std::vector<std::string_view> &functionLiteralArguments = std::vector<std::string_view>());
 
+		/// <summary>
+		/// Runs the given Lua function object with typed arguments. The first argument to the function will always be the self object.
+		/// </summary>
+		/// <param name="functionObjectWrapper">The LuabindObjectWrapper containing the Lua function to be run.</param>
+		/// <param name="selfObjectWrapper">The LuabindObjectWrapper containing the already resolved self object, or nullptr to pass in nil instead.</param>
+		/// <param name="functionArguments">The arguments that should be passed into the Lua function after the self object, in order.</param>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+		int RunScriptFunctionObject(const LuabindObjectWrapper *functionObjectWrapper, const LuabindObjectWrapper *selfObjectWrapper, std::initializer_list<LuaFunctionArgument> functionArguments);
+
+		/// <summary>
+		/// Runs a function defined in a global Lua table as a method of that table, i.e. the equivalent of running "if Table and Table.Function then Table:Function(...); end" as a script string.
+		/// The function object is resolved once and cached, so no script string has to be built and compiled per call. The cache is invalidated whenever a script file or string is run on this state or the user module cache is cleared, so reassigning the function in any other way only takes effect after that.
+		/// If either argument list has entries, they will be passed into the function after the self table, in order, with entity arguments first.
+		/// </summary>
+		/// <param name="selfGlobalTableName">The name of the global Lua table that defines the function and is passed in as the self object.</param>
+		/// <param name="functionName">The name of the function in that table.</param>
+		/// <param name="functionEntityArguments">Optional vector of entity pointers that should be passed into the Lua function. Their internal Lua states will not be accessible. Defaults to empty.</param>
+		/// <param name="functionLiteralArguments">Optional vector of strings that should be passed into the Lua function. Entries must be surrounded with escaped quotes (i.e.`\"`) they'll be passed in as-is, allowing them to act as booleans, etc.. Defaults to empty.</param>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal, including the global table not being defined. Returns 0 without doing anything if the function isn't defined.</returns>
+		int RunScriptMethod(const std::string &selfGlobalTableName, const std::string &functionName, const std::vector<const Entity *> &functionEntityArguments = std::vector<const Entity *>(), const std::vector<std::string_view> &functionLiteralArguments = std::vector<std::string_view>());
+
 		/// <summary>
 		/// Opens and loads a file containing a script and runs it on the state.
 		/// </summary>
@@ -140,6 +160,24 @@ namespace RTE {
 		/// Gets the mutex to lock this lua state.
 		/// </summary>
 		std::recursive_mutex& GetMutex() { return m_Mutex; };
+
+		/// <summary>
+		/// Gets the estimated time this Lua state spends running threaded scripts each sim update, including an estimate for objects assigned to it since it was last measured.
+		/// </summary>
+		/// <returns>The estimated script cost of this Lua state, in ms.</returns>
+		float GetEstimatedScriptCost() const { return m_EstimatedScriptCostMS; }
+
+		/// <summary>
+		/// Records how long this Lua state spent running threaded scripts over the last sim update, so new objects can be assigned to the least loaded state.
+		/// </summary>
+		/// <param name="scriptTimeMS">The time spent running scripts in this Lua state, in ms.</param>
+		/// <param name="scriptedObjectCount">The number of objects that had scripts run in this Lua state.</param>
+		void RecordScriptCost(float scriptTimeMS, size_t scriptedObjectCount);
+
+		/// <summary>
+		/// Adds the average cost of an object in this Lua state to its estimated script cost, for an object that was just assigned to it.
+		/// </summary>
+		void AddObjectToScriptCostEstimate();
 #pragma endregion
 
 #pragma region
@@ -165,6 +203,14 @@ namespace RTE {
 		/// <returns>Whether that global var has been defined yet in the Lua state.</returns>
 		bool GlobalIsDefined(const std::string &globalName);
 
+		/// <summary>
+		/// Retrieves whatever is defined in a specific index of a global table, so it can be passed into Lua functions later without being looked up again.
+		/// </summary>
+		/// <param name="tableName">The name of the global table to look inside.</param>
+		/// <param name="indexName">The name of the index to retrieve from that table.</param>
+		/// <returns>A LuabindObjectWrapper containing the retrieved object, or nullptr if nothing is defined there. Ownership IS transferred!</returns>
+		LuabindObjectWrapper * RetrieveTableEntry(const std::string &tableName, const std::string &indexName);
+
 		/// <summary>
 		/// Checks if there is anything defined in a specific index of a table.
 		/// </summary>
@@ -177,6 +223,12 @@ namespace RTE {
 		/// Clears internal Lua package tables from all user-defined modules. Those must be reloaded with ReloadAllScripts().
 		/// </summary>
 		void ClearUserModuleCache();
+
+		/// <summary>
+		/// Gets how many times the user module cache of this Lua state was cleared, so Lua objects resolved from it before then can be told apart and resolved again.
+		/// </summary>
+		/// <returns>The number of times the user module cache was cleared.</returns>
+		unsigned int GetUserModuleCacheClearCount() const { return m_UserModuleCacheClearCount; }
 #pragma endregion
 
 #pragma region Error Handling
@@ -235,6 +287,34 @@ namespace RTE {
 		bool FileEOF(int fileIndex);
 #pragma endregion
 
+		/// <summary>
+		/// Gets the function object cached for a method call site, resolving it from the Lua state if it isn't cached yet or scripts were run on this state since it was resolved.
+		/// </summary>
+		/// <param name="selfGlobalTableName">The name of the global Lua table that defines the function.</param>
+		/// <param name="functionName">The name of the function in that table.</param>
+		/// <param name="functionObject">Set to the LuabindObjectWrapper containing the function, or nullptr if the table or function isn't defined. Ownership is NOT transferred!</param>
+		/// <returns>Whether the global table is defined.</returns>
+		bool GetCachedMethod(const std::string &selfGlobalTableName, const std::string &functionName, const LuabindObjectWrapper *&functionObject);
+
+		/// <summary>
+		/// Pushes function arguments onto the Lua stack, entity arguments first.
+		/// </summary>
+		/// <param name="functionEntityArguments">Vector of entity pointers to push, downcast to their most derived Lua type.</param>
+		/// <param name="functionLiteralArguments">Vector of strings to push, converted to nil, booleans or numbers where they represent them, otherwise pushed as strings.</param>
+		void PushFunctionArguments(const std::vector<const Entity *> &functionEntityArguments, const std::vector<std::string_view> &functionLiteralArguments);
+
+		/// <summary>
+		/// Pushes a typed function argument onto the Lua stack.
+		/// </summary>
+		/// <param name="functionArgument">The argument to push.</param>
+		void PushFunctionArgument(const LuaFunctionArgument &functionArgument);
+
+		/// <summary>
+		/// Pushes an Entity onto the Lua stack, downcast to its most derived Lua type.
+		/// </summary>
+		/// <param name="entity">The Entity to push.</param>
+		void PushEntityArgument(const Entity *entity);
+
 		/// <summary>
 		/// Generates a string that describes the current state of the Lua stack, for debugging purposes.
 		/// </summary>
@@ -250,10 +330,29 @@ namespace RTE {
 		Entity *m_TempEntity; //!< Temporary holder for an Entity object that we want to pass into the Lua state without fuss. Lets you export objects to lua easily.
 		std::vector<Entity *> m_TempEntityVector; //!< Temporary holder for a vector of Entities that we want to pass into the Lua state without a fuss. Usually used to pass arguments to special Lua functions.
 		std::string m_LastError; //!< Description of the last error that occurred in the script execution.
+		std::unordered_map<const Entity::ClassInfo *, const std::function<LuabindObjectWrapper * (Entity *, lua_State *)> *> m_EntityCastFunctions; //!< Lua downcast functions already looked up by class name, keyed by the ClassInfo they were looked up for.
+		/// <summary>
+		/// A function object resolved by RunScriptMethod, along with the script definitions version it was resolved at.
+		/// </summary>
+		struct CachedMethod {
+			std::unique_ptr<LuabindObjectWrapper> Function; //!< The resolved function, or nullptr if the table didn't define it.
+			unsigned int Version = 0; //!< The script definitions version this was resolved at. 0 means it was never resolved.
+		};
+
+		std::unordered_map<std::string, std::unordered_map<std::string, CachedMethod>> m_CachedMethods; //!< Function objects resolved by RunScriptMethod, keyed by global table name and function name.
+		unsigned int m_ScriptDefinitionsVersion; //!< Incremented whenever scripts are run on this state or the user module cache is cleared, so cached methods know to be resolved again.
+		unsigned int m_UserModuleCacheClearCount; //!< How many times the user module cache of this Lua state was cleared.
 
 		// This mutex is more for safety, and with new script/AI architecture we shouldn't ever be locking on a mutex. As such we use this primarily to fire asserts.
 		std::recursive_mutex m_Mutex; //!< Mutex to ensure multiple threads aren't running something in this lua state simultaneously.
 
+		static constexpr float c_DefaultScriptCostPerObjectMS = 0.01F; //!< The script cost assumed for an object before any were measured in a Lua state, in ms.
+		static constexpr float c_ScriptCostSmoothing = 0.1F; //!< How much each new measurement affects the smoothed script cost, so a single slow update doesn't skew assignment.
+
+		float m_MeasuredScriptCostMS; //!< The smoothed time this Lua state spent running threaded scripts per sim update, in ms.
+		size_t m_MeasuredScriptedObjectCount; //!< The number of objects that had scripts run in this Lua state when it was last measured.
+		float m_EstimatedScriptCostMS; //!< The measured script cost plus the estimated cost of objects assigned since, in ms.
+
 		// For determinism, every Lua state has it's own random number generator.
 		RandomGenerator m_RandomGenerator; //!< The random number generator used for this lua state.
 	};
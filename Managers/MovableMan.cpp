@@ -20,6 +20,7 @@
 #include "AEmitter.h"
 #include "AHuman.h"
 #include "MOPixel.h"
+#include "MOSParticle.h"
 #include "HeldDevice.h"
 #include "SLTerrain.h"
 #include "Controller.h"
@@ -33,7 +34,9 @@
 #include "SceneMan.h"
 #include "SettingsMan.h"
 #include "LuaMan.h"
+#include "ThreadMan.h"
 
+#include <atomic>
 #include <execution>
 
 namespace RTE {
@@ -87,6 +90,16 @@ void MovableMan::Clear()
 	m_MaxDroppedItems = 100;
     m_SettlingEnabled = true;
     m_MOSubtractionEnabled = true;
+    m_ParallelParticleTravelEnabled = false;
+    m_PixelParticleStoreEnabled = false;
+    m_PixelParticleStore.Clear();
+    m_ThreadedScriptBuckets.assign(c_NumThreadedLuaStates, std::vector<MovableObject *>());
+    m_ThreadedAIBuckets.assign(c_NumThreadedLuaStates, std::vector<Actor *>());
+    m_ThreadedAITimes.assign(c_NumThreadedLuaStates, 0.0F);
+    m_ThreadedBucketMasks.clear();
+    m_ThreadedScriptBucketsToCompact = 0;
+    m_ThreadedAIBucketsToCompact = 0;
+    m_ThreadedBucketUpdateQueue.clear();
 }
 
 
@@ -208,11 +221,9 @@ bool MovableMan::HitTestMOAtPixel(const MovableObject &mo, int pixelX, int pixel
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-MOID MovableMan::GetMOIDPixel(int pixelX, int pixelY, const std::vector<int> &moidList) {
-    // Note - We loop through the MOs in reverse to make sure that the topmost (last drawn) MO that overlaps the specified coordinates is the one returned.
-    for (auto itr = moidList.rbegin(), itrEnd = moidList.rend(); itr < itrEnd; ++itr) {
-        MOID moid = *itr;
-
+MOID MovableMan::GetMOIDPixel(int pixelX, int pixelY, const SpatialPartitionGrid::CellMOIDs &moidList) {
+    // Note - The MOIDs come most recently added first, to make sure that the topmost (last drawn) MO that overlaps the specified coordinates is the one returned.
+    for (MOID moid : moidList) {
         const MovableObject *mo = GetMOFromID(moid);
         RTEAssert(mo, "Null MO found in MOID list!");
 		if (mo && mo->GetScale() == 0) {
@@ -306,6 +317,7 @@ void MovableMan::PurgeAllMOs()
     m_AddedActors.clear();
     m_AddedItems.clear();
     m_AddedParticles.clear();
+    m_PixelParticleStore.Clear();
     m_ValidActors.clear();
     m_ValidItems.clear();
     m_ValidParticles.clear();
@@ -321,6 +333,16 @@ void MovableMan::PurgeAllMOs()
     m_AlarmEvents.clear();
     m_MOIDIndex.clear();
 	m_KnownObjects.clear();
+    for (std::vector<MovableObject *> &bucket : m_ThreadedScriptBuckets) {
+        bucket.clear();
+    }
+    for (std::vector<Actor *> &bucket : m_ThreadedAIBuckets) {
+        bucket.clear();
+    }
+    m_ThreadedBucketMasks.clear();
+    m_ThreadedScriptBucketsToCompact = 0;
+    m_ThreadedAIBucketsToCompact = 0;
+    m_ThreadedBucketUpdateQueue.clear();
 }
 
 
@@ -840,7 +862,7 @@ Actor * MovableMan::GetUnassignedBrain(int team) const
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool MovableMan::AddMO(MovableObject *movableObjectToAdd) {
+bool MovableMan::AddMO(MovableObject *movableObjectToAdd, bool allowPixelParticleStore) {
     if (!movableObjectToAdd) {
         return false;
     }
@@ -852,7 +874,7 @@ bool MovableMan::AddMO(MovableObject *movableObjectToAdd) {
         AddItem(heldDeviceToAdd);
         return true;
     }
-    AddParticle(movableObjectToAdd);
+    AddParticle(movableObjectToAdd, allowPixelParticleStore);
 
     return true;
 }
@@ -910,7 +932,7 @@ void MovableMan::AddItem(HeldDevice *itemToAdd) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void MovableMan::AddParticle(MovableObject *particleToAdd){
+void MovableMan::AddParticle(MovableObject *particleToAdd, bool allowPixelParticleStore){
     if (particleToAdd) {
 		g_ActivityMan.GetActivity()->ForceSetTeamAsActive(particleToAdd->GetTeam());
         particleToAdd->SetAsAddedToMovableMan();
@@ -924,6 +946,12 @@ void MovableMan::AddParticle(MovableObject *particleToAdd){
             particleToAdd->NewFrame();
             particleToAdd->SetAge(0);
         }
+		if (allowPixelParticleStore && m_PixelParticleStoreEnabled && PixelParticleStore::CanStore(particleToAdd)) {
+			// Nothing else can see or reference a plain MOPixel once it's added, so it's safe to replace it with its entry in the store.
+			m_PixelParticleStore.Add(*static_cast<MOPixel *>(particleToAdd));
+			delete particleToAdd;
+			return;
+		}
 		if (particleToAdd->IsDevice()) {
             std::lock_guard<std::mutex> lock(m_AddedItemsMutex);
 			m_AddedItems.push_back(particleToAdd);
@@ -956,6 +984,7 @@ bool MovableMan::RemoveActor(MovableObject *pActorToRem)
             {
                 std::lock_guard<std::mutex> lock(m_ActorsMutex);
                 m_ValidActors.erase(*itr);
+                RemoveFromThreadedBuckets(*itr);
                 m_Actors.erase(itr);
                 removed = true;
                 break;
@@ -1002,6 +1031,7 @@ bool MovableMan::RemoveItem(MovableObject *pItemToRem)
             {
                 std::lock_guard<std::mutex> lock(m_ItemsMutex);
                 m_ValidItems.erase(*itr);
+                RemoveFromThreadedBuckets(*itr);
                 m_Items.erase(itr);
                 removed = true;
                 break;
@@ -1126,6 +1156,7 @@ bool MovableMan::RemoveParticle(MovableObject *pMOToRem)
             {
                 std::lock_guard<std::mutex> lock(m_ParticlesMutex);
                 m_ValidParticles.erase(*itr);
+                RemoveFromThreadedBuckets(*itr);
                 m_Particles.erase(itr);
                 removed = true;
                 break;
@@ -1397,6 +1428,9 @@ int MovableMan::GetAllActors(bool transferOwnership, std::list<SceneObject *> &a
     if (transferOwnership)
     {
         // Clear the internal Actor lists; we transferred the ownership of them
+        for (const Actor *actor : m_Actors) {
+            RemoveFromThreadedBuckets(actor);
+        }
         m_Actors.clear();
         m_AddedActors.clear();
         m_ValidActors.clear();
@@ -1434,6 +1468,9 @@ int MovableMan::GetAllItems(bool transferOwnership, std::list<SceneObject *> &it
     if (transferOwnership)
     {
         // Clear the internal Item list; we transferred the ownership of them
+        for (const MovableObject *item : m_Items) {
+            RemoveFromThreadedBuckets(item);
+        }
         m_Items.clear();
         m_AddedItems.clear();
         m_ValidItems.clear();
@@ -1465,6 +1502,9 @@ int MovableMan::GetAllParticles(bool transferOwnership, std::list<SceneObject *>
     if (transferOwnership)
     {
         // Clear the internal Particle list; we transferred the ownership of them
+        for (const MovableObject *particle : m_Particles) {
+            RemoveFromThreadedBuckets(particle);
+        }
         m_Particles.clear();
         m_AddedParticles.clear();
         m_ValidParticles.clear();
@@ -1551,6 +1591,28 @@ void MovableMan::RedrawOverlappingMOIDs(MovableObject *pOverlapsThis)
     }
 }
 
+/// <summary>
+/// Gets a bitmask of the threaded Lua states that a MovableObject or any of its attached objects have scripts assigned to.
+/// </summary>
+/// <param name="mo">The MovableObject to check.</param>
+/// <param name="firstLuaState">The first threaded Lua state, used to turn Lua states into bit indices.</param>
+/// <returns>A bitmask with a bit set for each threaded Lua state used, by index.</returns>
+unsigned int getThreadedLuaStatesInHierarchy(MovableObject *mo, const LuaStateWrapper *firstLuaState) {
+    unsigned int luaStatesMask = 0;
+    if (const LuaStateWrapper *luaState = mo->GetLuaState()) {
+        luaStatesMask |= 1U << static_cast<unsigned int>(luaState - firstLuaState);
+    }
+    if (MOSRotating *mosr = dynamic_cast<MOSRotating *>(mo)) {
+        for (Attachable *attachable : mosr->GetAttachableList()) {
+            luaStatesMask |= getThreadedLuaStatesInHierarchy(attachable, firstLuaState);
+        }
+        for (AEmitter *wound : mosr->GetWoundList()) {
+            luaStatesMask |= getThreadedLuaStatesInHierarchy(wound, firstLuaState);
+        }
+    }
+    return luaStatesMask;
+}
+
 void updateMultiThreadedScripts(MovableObject* mo, LuaStateWrapper* luaState) {
     if (!luaState || mo->GetLuaState() == luaState) {
         mo->UpdateScripts(ThreadScriptsToRun::MultiThreaded);
@@ -1647,21 +1709,22 @@ void MovableMan::Update()
         LuaStatesArray& luaStates = g_LuaMan.GetThreadedScriptStates();
         std::for_each(std::execution::par, luaStates.begin(), luaStates.end(),
             [&](LuaStateWrapper& luaState) {
+                const size_t luaStateIndex = &luaState - luaStates.data();
+                const long long scriptStartTime = g_TimerMan.GetAbsoluteTime();
                 g_LuaMan.SetThreadLuaStateOverride(&luaState);
 
-                for (Actor* actor : m_Actors) {
-                    updateMultiThreadedScripts(actor, &luaState);
-                }
-
-                for (MovableObject* item : m_Items) {
-                    updateMultiThreadedScripts(item, &luaState);
-                }
-
-                for (MovableObject* particle : m_Particles) {
-                    updateMultiThreadedScripts(particle, &luaState);
+                // Scripts can remove objects from any bucket while it's being iterated, which nulls out their entries, so they're loaded atomically and skipped when null.
+                size_t updatedObjectCount = 0;
+                for (MovableObject *&bucketEntry : m_ThreadedScriptBuckets[luaStateIndex]) {
+                    if (MovableObject *mo = std::atomic_ref<MovableObject *>(bucketEntry).load(std::memory_order_relaxed)) {
+                        updateMultiThreadedScripts(mo, &luaState);
+                        updatedObjectCount++;
+                    }
                 }
 
                 g_LuaMan.SetThreadLuaStateOverride(nullptr);
+                const float scriptTimeMS = static_cast<float>(g_TimerMan.GetAbsoluteTime() - scriptStartTime) / 1000.0F;
+                luaState.RecordScriptCost(scriptTimeMS + m_ThreadedAITimes[luaStateIndex], updatedObjectCount);
             });
     }
     g_PerformanceMan.StopPerformanceMeasurement(PerformanceMan::ScriptsUpdate);
@@ -1727,9 +1790,10 @@ void MovableMan::Update()
         for (aIt = m_AddedActors.begin(); aIt != m_AddedActors.end(); ++aIt)
         {
             // Delete instead if it's marked for it
-            if (!(*aIt)->IsSetToDelete())
+            if (!(*aIt)->IsSetToDelete()) {
                 m_Actors.push_back(*aIt);
-            else
+                AddToThreadedBuckets(*aIt);
+            } else
 			{
                 m_ValidActors.erase(*aIt);
 
@@ -1751,6 +1815,7 @@ void MovableMan::Update()
             // Delete instead if it's marked for it
             if (!(*iIt)->IsSetToDelete()) {
                 m_Items.push_back(*iIt);
+                AddToThreadedBuckets(*iIt);
             } else {
                 m_ValidItems.erase(*iIt);
                 (*iIt)->DestroyScriptState();
@@ -1765,6 +1830,7 @@ void MovableMan::Update()
             // Delete instead if it's marked for it
             if (!(*parIt)->IsSetToDelete()) {
                 m_Particles.push_back(*parIt);
+                AddToThreadedBuckets(*parIt);
             } else {
                 m_ValidParticles.erase(*parIt);
                 (*parIt)->DestroyScriptState();
@@ -1772,6 +1838,11 @@ void MovableMan::Update()
             }
         }
         m_AddedParticles.clear();
+
+        m_PixelParticleStore.CommitAddedParticles();
+
+        // Nothing is waiting to be added anymore, so every queued object whose root is valid is in the simulation.
+        ProcessThreadedBucketUpdateQueue();
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -1802,6 +1873,8 @@ void MovableMan::Update()
                 }
                 
                 m_ValidActors.erase(*aIt);
+                // Dead actors keep running their scripts as particles, but no longer get AI updates
+                RemoveFromThreadedBuckets(*aIt, true);
                 aIt++;
             }
             // Try to set the existing iterator to a safer value, erase can crash in debug mode otherwise?
@@ -1856,6 +1929,7 @@ void MovableMan::Update()
 
             // Delete
             m_ValidActors.erase(*aIt);
+            RemoveFromThreadedBuckets(*aIt);
             (*aIt)->DestroyScriptState();
             delete (*aIt);
             aIt++;
@@ -1870,6 +1944,7 @@ void MovableMan::Update()
 
         while (iIt != m_Items.end()) {
             m_ValidItems.erase(*iIt);
+            RemoveFromThreadedBuckets(*iIt);
             (*iIt)->DestroyScriptState();
             delete (*iIt);
             iIt++;
@@ -1882,6 +1957,7 @@ void MovableMan::Update()
 
         while (parIt != m_Particles.end()) {
             m_ValidParticles.erase(*parIt);
+            RemoveFromThreadedBuckets(*parIt);
             (*parIt)->DestroyScriptState();
             delete (*parIt);
             parIt++;
@@ -1912,6 +1988,7 @@ void MovableMan::Update()
 			}
 			if ((*parIt)->GetDrawPriority() >= terrMat->GetPriority()) { (*parIt)->DrawToTerrain(g_SceneMan.GetTerrain()); }
             m_ValidParticles.erase(*parIt);
+            RemoveFromThreadedBuckets(*parIt);
             (*parIt)->DestroyScriptState();
 			delete (*parIt);
             parIt++;
@@ -2009,6 +2086,11 @@ void MovableMan::Travel()
 
     // Travel particles
     g_PerformanceMan.StartPerformanceMeasurement(PerformanceMan::ParticlesTravel);
+    if (m_ParallelParticleTravelEnabled && g_ThreadMan.GetWorkerCount() > 0)
+    {
+        TravelParticlesInParallel();
+    }
+    else
     {
         for (auto parIt = m_Particles.begin(); parIt != m_Particles.end(); ++parIt)
         {
@@ -2022,11 +2104,206 @@ void MovableMan::Travel()
             (*parIt)->NewFrame();
         }
     }
+    m_PixelParticleStore.Update(m_SettlingEnabled);
     g_PerformanceMan.StopPerformanceMeasurement(PerformanceMan::ParticlesTravel);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
 
+void MovableMan::TravelParticlesInParallel()
+{
+    // Large enough that the per-chunk overhead is negligible, small enough that work is spread evenly.
+    const int chunkSize = 256;
+    const int particleCount = static_cast<int>(m_Particles.size());
+    const int chunkCount = (particleCount + chunkSize - 1) / chunkSize;
+
+    m_ParticlesTraveledInParallel.assign(particleCount, 0);
+    while (m_ParticleTravelCommandBuffers.size() < static_cast<size_t>(chunkCount)) {
+        m_ParticleTravelCommandBuffers.emplace_back(std::make_unique<TravelCommandBuffer>());
+    }
+
+    // Each chunk gets its own random sequence derived from the simulation one, so results don't depend on which worker runs which chunk.
+    const uint64_t frameSeed = static_cast<uint64_t>(RandomNum<int>(0, std::numeric_limits<int>::max()));
+
+    // The terrain and MOID layer are read-only while the chunks run, so lock the scene once for all of them.
+    bool sceneWasLocked = g_SceneMan.SceneIsLocked();
+    if (!sceneWasLocked) { g_SceneMan.LockScene(); }
+
+    g_ThreadMan.ParallelFor(0, chunkCount, [this, chunkSize, particleCount, frameSeed](int chunkIndex) {
+        TravelCommandBuffer &commandBuffer = *m_ParticleTravelCommandBuffers[chunkIndex];
+        commandBuffer.Begin(frameSeed + static_cast<uint64_t>(chunkIndex));
+
+        int chunkEnd = std::min((chunkIndex + 1) * chunkSize, particleCount);
+        for (int particleIndex = chunkIndex * chunkSize; particleIndex < chunkEnd; ++particleIndex) {
+            MovableObject *particle = m_Particles[particleIndex];
+            if (!CanTravelInParallel(particle)) {
+                continue;
+            }
+            m_ParticlesTraveledInParallel[particleIndex] = 1;
+            if (!particle->IsUpdated()) {
+                particle->ApplyForces();
+                particle->PreTravel();
+                particle->Travel();
+                particle->PostTravel();
+            }
+            particle->NewFrame();
+        }
+        commandBuffer.End();
+    }, 1);
+
+    if (!sceneWasLocked) { g_SceneMan.UnlockScene(); }
+
+    // Apply the deferred side effects in chunk order, which is particle order, so the outcome is deterministic.
+    for (int chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex) {
+        m_ParticleTravelCommandBuffers[chunkIndex]->Execute();
+    }
+
+    // Travel the particles that interact with other MOs serially, as before. Particles added by the deferred side effects go into m_AddedParticles, so this doesn't see them.
+    for (int particleIndex = 0; particleIndex < particleCount; ++particleIndex) {
+        if (m_ParticlesTraveledInParallel[particleIndex]) {
+            continue;
+        }
+        MovableObject *particle = m_Particles[particleIndex];
+        if (!particle->IsUpdated()) {
+            particle->ApplyForces();
+            particle->PreTravel();
+            particle->Travel();
+            particle->PostTravel();
+        }
+        particle->NewFrame();
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+bool MovableMan::CanTravelInParallel(const MovableObject *particle) const
+{
+    // Hitting MOs mutates the hit MO and runs collision callbacks on both parties immediately, so those particles can't be deferred.
+    if (particle->HitsMOs()) {
+        return false;
+    }
+#ifdef DRAW_MOID_LAYER
+    // Traveling MOs that can get hit redraw themselves into the shared MOID layer.
+    if (particle->GetsHitByMOs()) {
+        return false;
+    }
+#endif
+    return dynamic_cast<const MOPixel *>(particle) || dynamic_cast<const MOSParticle *>(particle);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+void MovableMan::QueueThreadedBucketUpdate(MovableObject *mo)
+{
+    if (mo && mo->GetRootParent()->HasEverBeenAddedToMovableMan() && getThreadedLuaStatesInHierarchy(mo, g_LuaMan.GetThreadedScriptStates().data()) != 0) {
+        std::lock_guard<std::mutex> lock(m_ThreadedBucketUpdateQueueMutex);
+        m_ThreadedBucketUpdateQueue.push_back(mo->GetUniqueID());
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+void MovableMan::AddToThreadedBuckets(MovableObject *mo)
+{
+    static_assert(c_NumThreadedLuaStates <= std::tuple_size_v<decltype(ThreadedBucketMasks::ScriptBucketIndices)>, "Every threaded Lua state needs a bucket index slot.");
+    LuaStatesArray &luaStates = g_LuaMan.GetThreadedScriptStates();
+    unsigned int scriptBuckets = getThreadedLuaStatesInHierarchy(mo, luaStates.data());
+    if (scriptBuckets == 0) {
+        return;
+    }
+    unsigned int aiBuckets = 0;
+    if (const LuaStateWrapper *luaState = mo->GetLuaState(); luaState && m_ValidActors.find(mo) != m_ValidActors.end()) {
+        aiBuckets = 1U << static_cast<unsigned int>(luaState - luaStates.data());
+    }
+
+    std::lock_guard<std::mutex> lock(m_ThreadedBucketsMutex);
+    ThreadedBucketMasks &bucketMasks = m_ThreadedBucketMasks[mo];
+    for (unsigned int newBuckets = scriptBuckets & ~bucketMasks.ScriptBuckets; newBuckets != 0; newBuckets &= newBuckets - 1) {
+        std::vector<MovableObject *> &bucket = m_ThreadedScriptBuckets[std::countr_zero(newBuckets)];
+        bucketMasks.ScriptBucketIndices[std::countr_zero(newBuckets)] = static_cast<unsigned int>(bucket.size());
+        bucket.push_back(mo);
+    }
+    for (unsigned int newBuckets = aiBuckets & ~bucketMasks.AIBuckets; newBuckets != 0; newBuckets &= newBuckets - 1) {
+        std::vector<Actor *> &bucket = m_ThreadedAIBuckets[std::countr_zero(newBuckets)];
+        bucketMasks.AIBucketIndices[std::countr_zero(newBuckets)] = static_cast<unsigned int>(bucket.size());
+        bucket.push_back(dynamic_cast<Actor *>(mo));
+    }
+    bucketMasks.ScriptBuckets |= scriptBuckets;
+    bucketMasks.AIBuckets |= aiBuckets;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+void MovableMan::RemoveFromThreadedBuckets(const MovableObject *mo, bool aiBucketsOnly)
+{
+    std::lock_guard<std::mutex> lock(m_ThreadedBucketsMutex);
+    std::unordered_map<const MovableObject *, ThreadedBucketMasks>::iterator bucketMasksItr = m_ThreadedBucketMasks.find(mo);
+    if (bucketMasksItr == m_ThreadedBucketMasks.end()) {
+        return;
+    }
+    // The buckets may be being iterated by threaded scripts right now, so the entries are only nulled out, atomically, and left for ProcessThreadedBucketUpdateQueue to compact.
+    ThreadedBucketMasks &bucketMasks = bucketMasksItr->second;
+    for (unsigned int buckets = bucketMasks.AIBuckets; buckets != 0; buckets &= buckets - 1) {
+        std::atomic_ref<Actor *>(m_ThreadedAIBuckets[std::countr_zero(buckets)][bucketMasks.AIBucketIndices[std::countr_zero(buckets)]]).store(nullptr, std::memory_order_relaxed);
+    }
+    m_ThreadedAIBucketsToCompact |= bucketMasks.AIBuckets;
+    bucketMasks.AIBuckets = 0;
+    if (!aiBucketsOnly) {
+        for (unsigned int buckets = bucketMasks.ScriptBuckets; buckets != 0; buckets &= buckets - 1) {
+            std::atomic_ref<MovableObject *>(m_ThreadedScriptBuckets[std::countr_zero(buckets)][bucketMasks.ScriptBucketIndices[std::countr_zero(buckets)]]).store(nullptr, std::memory_order_relaxed);
+        }
+        m_ThreadedScriptBucketsToCompact |= bucketMasks.ScriptBuckets;
+        m_ThreadedBucketMasks.erase(bucketMasksItr);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+void MovableMan::ProcessThreadedBucketUpdateQueue()
+{
+    // Compacting keeps the order of the remaining objects, so each Lua state keeps running its scripts in a deterministic order.
+    for (unsigned int buckets = m_ThreadedScriptBucketsToCompact; buckets != 0; buckets &= buckets - 1) {
+        const int bucketIndex = std::countr_zero(buckets);
+        std::vector<MovableObject *> &bucket = m_ThreadedScriptBuckets[bucketIndex];
+        unsigned int compactedSize = 0;
+        for (MovableObject *mo : bucket) {
+            if (mo) {
+                m_ThreadedBucketMasks[mo].ScriptBucketIndices[bucketIndex] = compactedSize;
+                bucket[compactedSize++] = mo;
+            }
+        }
+        bucket.resize(compactedSize);
+    }
+    for (unsigned int buckets = m_ThreadedAIBucketsToCompact; buckets != 0; buckets &= buckets - 1) {
+        const int bucketIndex = std::countr_zero(buckets);
+        std::vector<Actor *> &bucket = m_ThreadedAIBuckets[bucketIndex];
+        unsigned int compactedSize = 0;
+        for (Actor *actor : bucket) {
+            if (actor) {
+                m_ThreadedBucketMasks[actor].AIBucketIndices[bucketIndex] = compactedSize;
+                bucket[compactedSize++] = actor;
+            }
+        }
+        bucket.resize(compactedSize);
+    }
+    m_ThreadedScriptBucketsToCompact = 0;
+    m_ThreadedAIBucketsToCompact = 0;
+
+    std::vector<unsigned long> queuedUniqueIDs;
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadedBucketUpdateQueueMutex);
+        queuedUniqueIDs.swap(m_ThreadedBucketUpdateQueue);
+    }
+    for (unsigned long uniqueID : queuedUniqueIDs) {
+        if (MovableObject *mo = FindObjectByUniqueID(uniqueID)) {
+            MovableObject *rootParent = mo->GetRootParent();
+            if (ValidMO(rootParent)) { AddToThreadedBuckets(rootParent); }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
 void MovableMan::UpdateControllers()
 {
     g_PerformanceMan.StartPerformanceMeasurement(PerformanceMan::ActorsAI);
@@ -2038,13 +2315,16 @@ void MovableMan::UpdateControllers()
         LuaStatesArray& luaStates = g_LuaMan.GetThreadedScriptStates();
         std::for_each(std::execution::par, luaStates.begin(), luaStates.end(), 
             [&](LuaStateWrapper &luaState) {
+                const size_t luaStateIndex = &luaState - luaStates.data();
+                const long long aiStartTime = g_TimerMan.GetAbsoluteTime();
                 g_LuaMan.SetThreadLuaStateOverride(&luaState);
-                for (Actor *actor : m_Actors) {
-                    if (actor->GetLuaState() == &luaState) {
+                for (Actor *&bucketEntry : m_ThreadedAIBuckets[luaStateIndex]) {
+                    if (Actor *actor = std::atomic_ref<Actor *>(bucketEntry).load(std::memory_order_relaxed)) {
                         actor->GetController()->UpdateAI(ThreadScriptsToRun::MultiThreaded);
                     }
                 }
                 g_LuaMan.SetThreadLuaStateOverride(nullptr);
+                m_ThreadedAITimes[luaStateIndex] = static_cast<float>(g_TimerMan.GetAbsoluteTime() - aiStartTime) / 1000.0F;
             });
 
         for (Actor* actor : m_Actors) {
@@ -2079,6 +2359,8 @@ void MovableMan::DrawMatter(BITMAP *pTargetBitmap, Vector &targetPos)
 
     for (std::deque<MovableObject *>::iterator parIt = --m_Particles.end(); parIt != --m_Particles.begin(); --parIt)
         (*parIt)->Draw(pTargetBitmap, targetPos, g_DrawMaterial);
+
+    m_PixelParticleStore.DrawMaterial(pTargetBitmap, targetPos);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -2177,6 +2459,8 @@ void MovableMan::UpdateDrawMOIDs(BITMAP *pTargetBitmap)
 void MovableMan::Draw(BITMAP *pTargetBitmap, const Vector &targetPos)
 {
     // Draw objects to accumulation bitmap, in reverse order so actors appear on top.
+    m_PixelParticleStore.Draw(pTargetBitmap, targetPos);
+
     for (std::deque<MovableObject *>::iterator parIt = m_Particles.begin(); parIt != m_Particles.end(); ++parIt)
         (*parIt)->Draw(pTargetBitmap, targetPos);
 
@@ -17,6 +17,9 @@
 #include "Serializable.h"
 #include "Singleton.h"
 #include "Activity.h"
+#include "TravelCommandBuffer.h"
+#include "PixelParticleStore.h"
+#include "SpatialPartitionGrid.h"
 
 #define g_MovableMan MovableMan::Instance()
 
@@ -164,9 +167,9 @@ public:
     /// </summary>
     /// <param name="pixelX">The X coordinate of the Scene pixel to get the MOID of.</param>
     /// <param name="pixelY">The Y coordinate of the Scene pixel to get the MOID of.</param>
-    /// <param name="moidList">The collection of MOIDs to check the against the specified coordinates.</param>
+    /// <param name="moidList">The MOIDs to check the against the specified coordinates, from the topmost (last drawn) to the bottommost.</param>
     /// <returns>The topmost MOID currently at the specified pixel coordinates.</returns>
-    MOID GetMOIDPixel(int pixelX, int pixelY, const std::vector<int> &moidList);
+    MOID GetMOIDPixel(int pixelX, int pixelY, const SpatialPartitionGrid::CellMOIDs &moidList);
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetTeamMOIDCount
@@ -413,6 +416,17 @@ public:
     long GetParticleCount() const { return m_Particles.size(); }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetStoredPixelParticleCount
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the number of plain MOPixels currently simulated in the pixel
+//                  particle store, rather than as full MovableObjects.
+// Arguments:       None.
+// Return value:    The number of stored pixel particles.
+
+    long GetStoredPixelParticleCount() const { return static_cast<long>(m_PixelParticleStore.GetParticleCount()); }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetSplashRatio
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -459,8 +473,9 @@ public:
     /// Adds a MovableObject to this, after it is determined what it is and the best way to add it is. E.g. if it's an Actor, it will be added as such. Ownership IS transferred!
     /// </summary>
     /// <param name="movableObjectToAdd">A pointer to the MovableObject to add. Ownership IS transferred!</param>
+    /// <param name="allowPixelParticleStore">Whether a plain MOPixel may be moved into the pixel particle store, which deletes the passed in object. Only pass true where nothing keeps using the object after adding it.</param>
     /// <returns>Whether the MovableObject was successfully added or not. Note that Ownership IS transferred either way, but the MovableObject will be deleted if this is not successful.</returns>
-    bool AddMO(MovableObject *movableObjectToAdd);
+    bool AddMO(MovableObject *movableObjectToAdd, bool allowPixelParticleStore = false);
 
     /// <summary>
     /// Adds an Actor to the internal list of Actors. Destruction and deletion will be taken care of automatically. Ownership IS transferred!
@@ -478,7 +493,8 @@ public:
     /// Adds a MovableObject to the internal list of particles. Destruction and deletion will be taken care of automatically. Ownership IS transferred!
     /// </summary>
     /// <param name="particleToAdd">A pointer to the MovableObject to add. Ownership is transferred!</param>
-    void AddParticle(MovableObject *particleToAdd);
+    /// <param name="allowPixelParticleStore">Whether a plain MOPixel may be moved into the pixel particle store, which deletes the passed in object. Only pass true where nothing keeps using the object after adding it.</param>
+    void AddParticle(MovableObject *particleToAdd, bool allowPixelParticleStore = false);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -749,6 +765,49 @@ public:
     void EnableParticleSettling(bool enable = true) { m_SettlingEnabled = enable; }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsParallelParticleTravelEnabled
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Shows whether eligible particles travel in parallel chunks, with their
+//                  side effects deferred and applied in order afterwards.
+// Arguments:       None.
+// Return value:    Whether enabled or not.
+
+    bool IsParallelParticleTravelEnabled() const { return m_ParallelParticleTravelEnabled; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          EnableParallelParticleTravel
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Sets whether eligible particles travel in parallel chunks.
+// Arguments:       Whether to enable or not.
+// Return value:    None.
+
+    void EnableParallelParticleTravel(bool enable = true) { m_ParallelParticleTravelEnabled = enable; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsPixelParticleStoreEnabled
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Shows whether plain MOPixels get moved into the pixel particle store
+//                  when added, instead of being simulated as full MovableObjects.
+// Arguments:       None.
+// Return value:    Whether enabled or not.
+
+    bool IsPixelParticleStoreEnabled() const { return m_PixelParticleStoreEnabled; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          EnablePixelParticleStore
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Sets whether plain MOPixels get moved into the pixel particle store.
+//                  Particles already in the store stay there either way.
+// Arguments:       Whether to enable or not.
+// Return value:    None.
+
+    void EnablePixelParticleStore(bool enable = true) { m_PixelParticleStoreEnabled = enable; }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          IsMOSubtractionEnabled
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -870,6 +929,14 @@ public:
 	MovableObject * FindObjectByUniqueID(long int id) { if (m_KnownObjects.count(id) > 0) return m_KnownObjects[id]; else return 0; }
 
 
+    /// <summary>
+    /// Queues the root of an object that was just assigned a threaded Lua state or attached to something to be added to the threaded script buckets of the Lua states in its hierarchy.
+    /// Objects that aren't in the simulation yet are bucketed once they're added, so only objects with a root that has been added to MovableMan are queued. Safe to call from threaded scripts.
+    /// </summary>
+    /// <param name="mo">The object whose hierarchy changed.</param>
+    void QueueThreadedBucketUpdate(MovableObject *mo);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetKnownObjectsCount
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1014,6 +1081,39 @@ protected:
     bool m_SettlingEnabled;
     // Whtehr MO's vcanng et subtracted form the terrain at all
     bool m_MOSubtractionEnabled;
+    // Whether eligible particles travel in parallel chunks
+    bool m_ParallelParticleTravelEnabled;
+    // The side effects of each parallel particle travel chunk, kept around between frames to reuse their storage
+    std::vector<std::unique_ptr<TravelCommandBuffer>> m_ParticleTravelCommandBuffers;
+    // Which particles were traveled in a parallel chunk this frame, by index in m_Particles
+    std::vector<unsigned char> m_ParticlesTraveledInParallel;
+    // Whether plain MOPixels get moved into the pixel particle store when added
+    bool m_PixelParticleStoreEnabled;
+    // Plain MOPixels that don't need to be full MovableObjects, simulated in bulk
+    PixelParticleStore m_PixelParticleStore;
+    // Which threaded Lua state buckets an actor, item or particle is in, as bitmasks by Lua state index, and where in each of those buckets it is so removing it doesn't need to search them
+    struct ThreadedBucketMasks {
+        unsigned int ScriptBuckets = 0;
+        unsigned int AIBuckets = 0;
+        std::array<unsigned int, 8> ScriptBucketIndices = {};
+        std::array<unsigned int, 8> AIBucketIndices = {};
+    };
+    // For each threaded Lua state, the actors, items and particles that have anything in their hierarchy assigned to that state. Kept up to date as objects are added, removed and assigned Lua states
+    std::vector<std::vector<MovableObject *>> m_ThreadedScriptBuckets;
+    // For each threaded Lua state, the actors assigned to that state. Kept up to date along with the script buckets
+    std::vector<std::vector<Actor *>> m_ThreadedAIBuckets;
+    // The buckets each bucketed actor, item and particle is in, so adding and removing them only touches their own buckets
+    std::unordered_map<const MovableObject *, ThreadedBucketMasks> m_ThreadedBucketMasks;
+    // Guards the buckets and their masks, since objects can be removed from threaded scripts
+    std::mutex m_ThreadedBucketsMutex;
+    // The script and AI buckets that objects were removed from since they were last compacted, as bitmasks by Lua state index. Removed objects are left as null entries until then, so buckets that are being iterated never get shifted
+    unsigned int m_ThreadedScriptBucketsToCompact;
+    unsigned int m_ThreadedAIBucketsToCompact;
+    // The unique IDs of objects whose hierarchy gained a threaded Lua state since the last update, so their roots get added to the matching buckets
+    std::vector<unsigned long> m_ThreadedBucketUpdateQueue;
+    std::mutex m_ThreadedBucketUpdateQueueMutex;
+    // For each threaded Lua state, the time spent running threaded AI this update, in ms, so it can be added to the state's measured script cost
+    std::vector<float> m_ThreadedAITimes;
 
 	unsigned int m_SimUpdateFrameNumber;
 
@@ -1043,6 +1143,39 @@ private:
     /// </summary>
     void Travel();
 
+    /// <summary>
+    /// Travels all of our particles, splitting the ones that can be traveled independently into chunks that are run in parallel on the ThreadMan.
+    /// Side effects of the parallel chunks are recorded into per-chunk TravelCommandBuffers and executed in particle order afterwards, followed by the serial travel of the remaining particles.
+    /// </summary>
+    void TravelParticlesInParallel();
+
+    /// <summary>
+    /// Gets whether a particle can be traveled in a parallel chunk, i.e. its travel doesn't touch any other MOs and all its other side effects can be deferred.
+    /// </summary>
+    /// <param name="particle">The particle to check.</param>
+    /// <returns>Whether the particle can be traveled in parallel.</returns>
+    bool CanTravelInParallel(const MovableObject *particle) const;
+
+    /// <summary>
+    /// Adds an actor, item or particle that is in the simulation to the threaded script buckets of the states its own or any of its attached objects' scripts are assigned to, and actors to the threaded AI bucket of their own state.
+    /// This lets each threaded script and AI update only walk the objects relevant to it, instead of every object. Buckets the object is already in are left as they are.
+    /// </summary>
+    /// <param name="mo">The root object to add.</param>
+    void AddToThreadedBuckets(MovableObject *mo);
+
+    /// <summary>
+    /// Removes an object from all the threaded script and AI buckets it's in.
+    /// Its entries are only nulled out, since this can be called from threaded scripts while the buckets are being iterated. The buckets get compacted by ProcessThreadedBucketUpdateQueue.
+    /// </summary>
+    /// <param name="mo">The root object to remove.</param>
+    /// <param name="aiBucketsOnly">Whether to only remove it from the AI buckets, for actors that died and keep being simulated as particles.</param>
+    void RemoveFromThreadedBuckets(const MovableObject *mo, bool aiBucketsOnly = false);
+
+    /// <summary>
+    /// Compacts out the null entries left by RemoveFromThreadedBuckets, then adds the roots of the objects queued by QueueThreadedBucketUpdate to the buckets of their hierarchy, if they're still in the simulation.
+    /// </summary>
+    void ProcessThreadedBucketUpdateQueue();
+
     /// <summary>
     /// Updates the controllers of all the actors we own.
     /// This is needed for a tricky reason - we want the controller from the activity to override the normal controller state
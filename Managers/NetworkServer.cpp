@@ -16,6 +16,9 @@
 #include "TimerMan.h"
 #include "AudioMan.h"
 #include "FrameMan.h"
+#include "ThreadMan.h"
+
+#include "SIMD.h"
 
 #include "RakNetStatistics.h"
 #include "RakSleep.h"
@@ -1276,203 +1279,55 @@ namespace RTE {
 		m_SendEven[player] = !m_SendEven[player];
 
 		if (m_TransmitAsBoxes) {
-			MsgFrameBox *frameData = (MsgFrameBox *)m_CompressedLineBuffer[player];
-
-			int boxedWidth = m_BackBuffer8[player]->w / m_BoxWidth;
-			int boxedHeight = m_BackBuffer8[player]->h / m_BoxHeight;
-			int boxMaxSize = m_BoxWidth * m_BoxHeight;
-
-			if (m_BackBuffer8[player]->w % m_BoxWidth != 0) { boxedWidth += 1; }
-
-			for (unsigned char layer = 0; layer < 2; layer++) {
-				const BITMAP *backBuffer = nullptr;
-				unsigned char *prevLineBuffers = 0;
-
-				if (layer == 0) {
-					backBuffer = m_BackBuffer8[player];
-					prevLineBuffers = m_PixelLineBuffersPrev[player];
-				} else if (layer == 1) {
-					backBuffer = m_BackBufferGUI8[player];
-					prevLineBuffers = m_PixelLineBuffersGUIPrev[player];
+			int boxColumns = (m_BackBuffer8[player]->w + m_BoxWidth - 1) / m_BoxWidth;
+			int boxRows = (m_BackBuffer8[player]->h + m_BoxHeight - 1) / m_BoxHeight;
+			int layerBoxCount = boxColumns * boxRows;
+			int boxMessageSize = sizeof(MsgFrameBox) + m_BoxWidth * m_BoxHeight;
+
+			m_EncodedFrameBoxes[player].resize(layerBoxCount * 2);
+			m_EncodedFrameBoxMessages[player].resize(layerBoxCount * 2 * boxMessageSize);
+
+			// Encode the boxes of both layers across the thread pool. Each box only writes to its own message slot and its own part of the previous frame buffers, so no synchronization is needed.
+			g_ThreadMan.ParallelFor(0, layerBoxCount * 2, [this, player, boxColumns, layerBoxCount, boxMessageSize](int boxIndex) {
+				int layerBoxIndex = boxIndex % layerBoxCount;
+				EncodeFrameBox(player, static_cast<unsigned char>(boxIndex / layerBoxCount), layerBoxIndex % boxColumns, layerBoxIndex / boxColumns, m_EncodedFrameBoxes[player][boxIndex], m_EncodedFrameBoxMessages[player].data() + boxIndex * boxMessageSize);
+			}, 16, TaskPriority::Low);
+
+			// Then send the encoded boxes in order, layer by layer and row by row.
+			for (int boxIndex = 0; boxIndex < layerBoxCount * 2; boxIndex++) {
+				const EncodedFrameBox &encodedBox = m_EncodedFrameBoxes[player][boxIndex];
+				const MsgFrameBox *frameData = (const MsgFrameBox *)(m_EncodedFrameBoxMessages[player].data() + boxIndex * boxMessageSize);
+				int thisBoxSize = encodedBox.UncompressedSize;
+
+				if (encodedBox.IsEmpty) {
+					if (!encodedBox.SendEmptyBox) { m_EmptyBlocks[player]++; }
+				} else {
+					m_FullBlocks[player]++;
 				}
 
-				for (int by = 0; by <= boxedHeight; by++) {
-					for (int bx = 0; bx <= boxedWidth; bx++) {
-						int bpx = bx * m_BoxWidth;
-						int bpy = by * m_BoxHeight;
-
-						if (bpx >= m_BackBuffer8[player]->w || bpy >= m_BackBuffer8[player]->h) {
-							break;
-						}
-
-						frameData->BoxX = bx;
-						frameData->BoxY = by;
-
-						int maxWidth = m_BoxWidth;
-						if (bpx + m_BoxWidth >= m_BackBuffer8[player]->w) { maxWidth = m_BackBuffer8[player]->w - bpx; }
-
-						int maxHeight = m_BoxHeight;
-						if (bpy + m_BoxHeight >= m_BackBuffer8[player]->h) { maxHeight = m_BackBuffer8[player]->h - bpy; }
-
-						int lineStart = 0;
-						int lineStep = 1;
-						int lineCount = maxHeight;
-
-						if (m_UseInterlacing) {
-							lineStep = 2;
-							if (m_SendEven[player]) { lineStart = 1; }
-							maxHeight /= 2;
-						}
-						int thisBoxSize = maxWidth * maxHeight;
-
-						bool boxIsEmpty = true;
-						bool boxIsDelta = false;
-						bool sendEmptyBox = false;
-
-						unsigned char *dest = (unsigned char *)(m_PixelLineBuffer[player]);
-
-						// Copy block line by line to linear buffer
-						for (int line = lineStart; line < lineCount; line += lineStep) {
-							// Copy bitmap data
-							memcpy(dest, backBuffer->line[bpy + line] + bpx, maxWidth);
-							dest += maxWidth;
-						}
-
-						if (m_UseDeltaCompression) {
-							// Store a copy of a line buffer to calculate and store delta
-							memcpy(m_PixelLineBufferDelta[player], m_PixelLineBuffer[player], thisBoxSize);
-
-							int bytesNeededPlain = 0;
-							int bytesNeededPrev = 0;
-							int bytesNeededDelta = 0;
-
-							// Previous line to delta against
-							int interlacedOffset = 0;
-							if (m_UseInterlacing) { interlacedOffset = m_SendEven[player] ? thisBoxSize : 0; }
-
-							unsigned char *prevLineBufferStart = prevLineBuffers + by * boxedWidth * boxMaxSize + bx * boxMaxSize;
-							unsigned char *prevLineBufferWithOffset = prevLineBufferStart + interlacedOffset;
-							// Currently processed box line buffer and delta storage
-							unsigned char *currLineBuffer = (unsigned char*)(m_PixelLineBufferDelta[player]);
-
-							// Calculate delta and decide whether we use it
-							for (int i = 0; i < thisBoxSize; i++) {
-								if (currLineBuffer[i] > 0) { bytesNeededPlain++; }
-								if (prevLineBufferWithOffset[i] > 0) { bytesNeededPrev++; }
-
-								currLineBuffer[i] = currLineBuffer[i] - prevLineBufferWithOffset[i];
-
-								if (currLineBuffer[i] > 0) { bytesNeededDelta++; }
-							}
-
-							// Store current line for delta check in the next frame
-							memcpy(prevLineBufferWithOffset, m_PixelLineBuffer[player], thisBoxSize);
-
-							if (bytesNeededPlain > 0) {
-								boxIsEmpty = false;
-
-								// If delta compression provides less significant bytes then use it
-								if (bytesNeededDelta < bytesNeededPlain) {
-									boxIsDelta = true;
-
-									if (bytesNeededDelta == 0) {
-										boxIsEmpty = true;
-									} else {
-										// Copy delta compressed buffer into plain pixel line
-										memcpy(m_PixelLineBuffer[player], m_PixelLineBufferDelta[player], thisBoxSize);
-									}
-								}
-							} else {
-								// Previous non empty block is now empty, clear it
-								if (bytesNeededPrev > 0 && bytesNeededPlain == 0) { sendEmptyBox = true; }
-							}
-						} else {
-							// Check if block is empty by evaluating by 64-bit ints
-							unsigned long *pixelInt = (unsigned long *)m_PixelLineBuffer[player];
-							int counter = 0;
+				int payloadSize = frameData->DataSize + sizeof(MsgFrameBox);
 
-							for (counter = 0; counter < thisBoxSize; counter += sizeof(unsigned long)) {
-								if (*pixelInt > 0) {
-									boxIsEmpty = false;
-									break;
-								}
-								pixelInt++;
-							}
-							// Box area is not divisible by 8
-							if (boxIsEmpty && counter > thisBoxSize) {
-								pixelInt--;
-								counter -= sizeof(unsigned long);
-
-								const unsigned char *pixelChr = (unsigned char*)pixelInt;
-								for (; counter < thisBoxSize; counter++) {
-									if (*pixelChr > 0) {
-										boxIsEmpty = false;
-										break;
-									}
-									pixelChr++;
-								}
-							}
-						}
-
-						// Save msg ID
-						if (boxIsDelta) {
-							frameData->Id = layer == 0 ? ID_SRV_FRAME_BOX_MO_DELTA : ID_SRV_FRAME_BOX_UI_DELTA;
-						} else {
-							frameData->Id = layer == 0 ? ID_SRV_FRAME_BOX_MO : ID_SRV_FRAME_BOX_UI;
-						}
-						frameData->DataSize = thisBoxSize;
-
-						if (boxIsEmpty) {
-							frameData->DataSize = 0;
-							if (!sendEmptyBox) { m_EmptyBlocks[player]++; }
-						} else {
-							int result = 0;
-
-							if (m_UseHighCompression) {
-								result = LZ4_compress_HC_extStateHC(m_LZ4CompressionState[player], (char *)m_PixelLineBuffer[player], (char *)(m_CompressedLineBuffer[player] + sizeof(MsgFrameBox)), thisBoxSize, thisBoxSize, compressionMethod);
-							} else if (m_UseFastCompression) {
-								result = LZ4_compress_fast_extState(m_LZ4FastCompressionState[player], (char *)m_PixelLineBuffer[player], (char *)(m_CompressedLineBuffer[player] + sizeof(MsgFrameBox)), thisBoxSize, thisBoxSize, accelerationFactor);
-							}
-
-							// Compression failed or ineffective, send as is
-							if (result == 0 || result == backBuffer->w) {
-#ifdef _WIN32
-								memcpy_s(m_CompressedLineBuffer[player] + sizeof(MsgFrameBox), c_MaxPixelLineBufferSize, m_PixelLineBuffer[player], thisBoxSize);
-#else
-								memcpy(m_CompressedLineBuffer[player] + sizeof(MsgFrameBox), m_PixelLineBuffer[player], thisBoxSize);
-#endif
-							} else {
-								frameData->DataSize = result;
-							}
-
-							m_FullBlocks[player]++;
-						}
-
-						int payloadSize = frameData->DataSize + sizeof(MsgFrameBox);
-
-						if (!boxIsEmpty || sendEmptyBox) {
-							m_Server->Send((const char *)frameData, payloadSize, MEDIUM_PRIORITY, UNRELIABLE_SEQUENCED, 0, m_ClientConnections[player].ClientId, false);
-						} else {
-							payloadSize = 0;
-						}
+				if (!encodedBox.IsEmpty || encodedBox.SendEmptyBox) {
+					m_Server->Send((const char *)frameData, payloadSize, MEDIUM_PRIORITY, UNRELIABLE_SEQUENCED, 0, m_ClientConnections[player].ClientId, false);
+				} else {
+					payloadSize = 0;
+				}
 
-						if (boxIsEmpty) {
-							m_EmptyBlocksSentCurrent[player][STAT_CURRENT] += 1;
-							m_EmptyBlocksDataSentCurrent[player][STAT_CURRENT] += payloadSize;
-						} else {
-							m_FullBlocksSentCurrent[player][STAT_CURRENT] += 1;
-							m_FullBlocksDataSentCurrent[player][STAT_CURRENT] += payloadSize;
+				if (encodedBox.IsEmpty) {
+					m_EmptyBlocksSentCurrent[player][STAT_CURRENT] += 1;
+					m_EmptyBlocksDataSentCurrent[player][STAT_CURRENT] += payloadSize;
+				} else {
+					m_FullBlocksSentCurrent[player][STAT_CURRENT] += 1;
+					m_FullBlocksDataSentCurrent[player][STAT_CURRENT] += payloadSize;
 
-							m_DataSentCurrent[player][STAT_CURRENT] += payloadSize;
-							m_DataSentTotal[player] += payloadSize;
+					m_DataSentCurrent[player][STAT_CURRENT] += payloadSize;
+					m_DataSentTotal[player] += payloadSize;
 
-							m_FrameDataSentCurrent[player][STAT_CURRENT] += payloadSize;
-							m_FrameDataSentTotal[player] += payloadSize;
+					m_FrameDataSentCurrent[player][STAT_CURRENT] += payloadSize;
+					m_FrameDataSentTotal[player] += payloadSize;
 
-							m_DataUncompressedCurrent[player][STAT_CURRENT] += thisBoxSize;
-							m_DataUncompressedTotal[player] += thisBoxSize;
-						}
-					}
+					m_DataUncompressedCurrent[player][STAT_CURRENT] += thisBoxSize;
+					m_DataUncompressedTotal[player] += thisBoxSize;
 				}
 			}
 		} else {
@@ -1589,6 +1444,199 @@ namespace RTE {
 		return 0;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::EncodeFrameBox(short player, unsigned char layer, int boxX, int boxY, EncodedFrameBox &encodedBox, unsigned char *encodedBoxMessage) const {
+		// Boxes are encoded on the thread pool, so every thread gets its own scratch buffers and compression states.
+		thread_local std::vector<unsigned char> pixelLineBuffer(c_MaxPixelLineBufferSize);
+		thread_local std::vector<unsigned char> pixelLineBufferDelta(c_MaxPixelLineBufferSize);
+		thread_local std::vector<char> compressionState(LZ4_sizeofStateHC());
+		thread_local std::vector<char> fastCompressionState(LZ4_sizeofState());
+
+		const BITMAP *backBuffer = (layer == 0) ? m_BackBuffer8[player] : m_BackBufferGUI8[player];
+		unsigned char *prevLineBuffers = (layer == 0) ? m_PixelLineBuffersPrev[player] : m_PixelLineBuffersGUIPrev[player];
+
+		int boxedWidth = m_BackBuffer8[player]->w / m_BoxWidth;
+		if (m_BackBuffer8[player]->w % m_BoxWidth != 0) { boxedWidth += 1; }
+		int boxMaxSize = m_BoxWidth * m_BoxHeight;
+
+		int bpx = boxX * m_BoxWidth;
+		int bpy = boxY * m_BoxHeight;
+
+		MsgFrameBox *frameData = (MsgFrameBox *)encodedBoxMessage;
+		frameData->BoxX = boxX;
+		frameData->BoxY = boxY;
+
+		int maxWidth = m_BoxWidth;
+		if (bpx + m_BoxWidth >= m_BackBuffer8[player]->w) { maxWidth = m_BackBuffer8[player]->w - bpx; }
+
+		int maxHeight = m_BoxHeight;
+		if (bpy + m_BoxHeight >= m_BackBuffer8[player]->h) { maxHeight = m_BackBuffer8[player]->h - bpy; }
+
+		int lineStart = 0;
+		int lineStep = 1;
+		int lineCount = maxHeight;
+
+		if (m_UseInterlacing) {
+			lineStep = 2;
+			if (m_SendEven[player]) { lineStart = 1; }
+			maxHeight /= 2;
+		}
+		int thisBoxSize = maxWidth * maxHeight;
+
+		bool boxIsEmpty = true;
+		bool boxIsDelta = false;
+		bool sendEmptyBox = false;
+
+		unsigned char *dest = pixelLineBuffer.data();
+
+		// Copy block line by line to linear buffer
+		for (int line = lineStart; line < lineCount; line += lineStep) {
+			memcpy(dest, backBuffer->line[bpy + line] + bpx, maxWidth);
+			dest += maxWidth;
+		}
+		const unsigned char *boxPixels = pixelLineBuffer.data();
+
+		if (m_UseDeltaCompression) {
+			// Previous line to delta against
+			int interlacedOffset = 0;
+			if (m_UseInterlacing) { interlacedOffset = m_SendEven[player] ? thisBoxSize : 0; }
+
+			unsigned char *prevLineBufferWithOffset = prevLineBuffers + boxY * boxedWidth * boxMaxSize + boxX * boxMaxSize + interlacedOffset;
+
+			// A box that didn't change since the previous frame has no significant delta bytes and is never sent, so skip straight past it.
+			if (memcmp(pixelLineBuffer.data(), prevLineBufferWithOffset, thisBoxSize) != 0) {
+				int bytesNeededPlain = 0;
+				int bytesNeededPrev = 0;
+				int bytesNeededDelta = 0;
+				CalculateDelta(pixelLineBuffer.data(), prevLineBufferWithOffset, pixelLineBufferDelta.data(), thisBoxSize, bytesNeededPlain, bytesNeededPrev, bytesNeededDelta);
+
+				// Store current line for delta check in the next frame
+				memcpy(prevLineBufferWithOffset, pixelLineBuffer.data(), thisBoxSize);
+
+				if (bytesNeededPlain > 0) {
+					boxIsEmpty = false;
+
+					// If delta compression provides less significant bytes then use it
+					if (bytesNeededDelta < bytesNeededPlain) {
+						boxIsDelta = true;
+						boxPixels = pixelLineBufferDelta.data();
+					}
+				} else {
+					// Previous non empty block is now empty, clear it
+					if (bytesNeededPrev > 0) { sendEmptyBox = true; }
+				}
+			}
+		} else {
+			boxIsEmpty = BufferIsEmpty(pixelLineBuffer.data(), thisBoxSize);
+		}
+
+		// Save msg ID
+		if (boxIsDelta) {
+			frameData->Id = layer == 0 ? ID_SRV_FRAME_BOX_MO_DELTA : ID_SRV_FRAME_BOX_UI_DELTA;
+		} else {
+			frameData->Id = layer == 0 ? ID_SRV_FRAME_BOX_MO : ID_SRV_FRAME_BOX_UI;
+		}
+		frameData->DataSize = thisBoxSize;
+
+		encodedBox.IsEmpty = boxIsEmpty;
+		encodedBox.SendEmptyBox = sendEmptyBox;
+		encodedBox.UncompressedSize = thisBoxSize;
+
+		if (boxIsEmpty) {
+			frameData->DataSize = 0;
+			return;
+		}
+		int result = 0;
+
+		if (m_UseHighCompression) {
+			result = LZ4_compress_HC_extStateHC(compressionState.data(), (const char *)boxPixels, (char *)(encodedBoxMessage + sizeof(MsgFrameBox)), thisBoxSize, thisBoxSize, m_HighCompressionLevel);
+		} else if (m_UseFastCompression) {
+			result = LZ4_compress_fast_extState(fastCompressionState.data(), (const char *)boxPixels, (char *)(encodedBoxMessage + sizeof(MsgFrameBox)), thisBoxSize, thisBoxSize, m_FastAccelerationFactor);
+		}
+
+		// Compression failed or ineffective, send as is
+		if (result == 0 || result == backBuffer->w) {
+			memcpy(encodedBoxMessage + sizeof(MsgFrameBox), boxPixels, thisBoxSize);
+		} else {
+			frameData->DataSize = result;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool NetworkServer::BufferIsEmpty(const unsigned char *buffer, int size) {
+		int i = 0;
+#ifdef RTE_SIMD_AVX2
+		for (; i + 32 <= size; i += 32) {
+			__m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(buffer + i));
+			if (!_mm256_testz_si256(bytes, bytes)) {
+				return false;
+			}
+		}
+#endif
+#ifdef RTE_SIMD_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 16 <= size; i += 16) {
+			__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buffer + i));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)) != 0xFFFF) {
+				return false;
+			}
+		}
+#endif
+		for (; i < size; i++) {
+			if (buffer[i] != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void NetworkServer::CalculateDelta(const unsigned char *currentBuffer, const unsigned char *previousBuffer, unsigned char *deltaBuffer, int size, int &currentBytesNeeded, int &previousBytesNeeded, int &deltaBytesNeeded) {
+		currentBytesNeeded = 0;
+		previousBytesNeeded = 0;
+		deltaBytesNeeded = 0;
+
+		// The non-zero bytes of each vector are counted as the vector size minus the number of lanes equal to zero.
+		int i = 0;
+#ifdef RTE_SIMD_AVX2
+		const __m256i zero256 = _mm256_setzero_si256();
+		for (; i + 32 <= size; i += 32) {
+			__m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(currentBuffer + i));
+			__m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(previousBuffer + i));
+			__m256i delta = _mm256_sub_epi8(current, previous);
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(deltaBuffer + i), delta);
+
+			currentBytesNeeded += 32 - std::popcount(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(current, zero256))));
+			previousBytesNeeded += 32 - std::popcount(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(previous, zero256))));
+			deltaBytesNeeded += 32 - std::popcount(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(delta, zero256))));
+		}
+#endif
+#ifdef RTE_SIMD_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 16 <= size; i += 16) {
+			__m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i *>(currentBuffer + i));
+			__m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i *>(previousBuffer + i));
+			__m128i delta = _mm_sub_epi8(current, previous);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(deltaBuffer + i), delta);
+
+			currentBytesNeeded += 16 - std::popcount(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(current, zero))));
+			previousBytesNeeded += 16 - std::popcount(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(previous, zero))));
+			deltaBytesNeeded += 16 - std::popcount(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(delta, zero))));
+		}
+#endif
+		for (; i < size; i++) {
+			if (currentBuffer[i] > 0) { currentBytesNeeded++; }
+			if (previousBuffer[i] > 0) { previousBytesNeeded++; }
+
+			deltaBuffer[i] = currentBuffer[i] - previousBuffer[i];
+
+			if (deltaBuffer[i] > 0) { deltaBytesNeeded++; }
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void NetworkServer::UpdateStats(short player) {
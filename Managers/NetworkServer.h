@@ -265,12 +265,23 @@ namespace RTE {
 		std::mutex m_SceneLock[c_MaxClients]; //!<
 
 		unsigned char m_PixelLineBuffer[c_MaxClients][c_MaxPixelLineBufferSize]; //!< Buffer to store currently transferred pixel data line.
-		unsigned char m_PixelLineBufferDelta[c_MaxClients][c_MaxPixelLineBufferSize]; //!< Buffer to store currently transferred pixel data line.
 		unsigned char m_CompressedLineBuffer[c_MaxClients][c_MaxPixelLineBufferSize]; //!< Buffer to store compressed pixel data line.
 
 		unsigned char *m_PixelLineBuffersPrev[c_MaxClients]; //!<
 		unsigned char *m_PixelLineBuffersGUIPrev[c_MaxClients]; //!<
 
+		/// <summary>
+		/// The outcome of encoding one box of a frame. Boxes are encoded in parallel and then sent in order, so this holds what the sending needs to know.
+		/// </summary>
+		struct EncodedFrameBox {
+			bool IsEmpty; //!< Whether the box has no pixels, or no changed pixels when delta compressed.
+			bool SendEmptyBox; //!< Whether the box became empty since the previous frame, so the client needs to be told to clear it.
+			int UncompressedSize; //!< The size of the box's pixel data before compression.
+		};
+
+		std::vector<EncodedFrameBox> m_EncodedFrameBoxes[c_MaxClients]; //!< The outcome of encoding each box of both layers of the frame being sent to each player.
+		std::vector<unsigned char> m_EncodedFrameBoxMessages[c_MaxClients]; //!< The MsgFrameBox and compressed pixel data of each box of the frame being sent to each player, in fixed size slots so the boxes can be encoded in parallel.
+
 		std::queue<NetworkTerrainChange> m_PendingTerrainChanges[c_MaxClients]; //!<
 		std::queue<NetworkTerrainChange> m_CurrentTerrainChanges[c_MaxClients]; //!<
 
@@ -556,6 +567,38 @@ namespace RTE {
 		/// <param name="player"></param>
 		/// <returns></returns>
 		int SendFrame(short player);
+
+		/// <summary>
+		/// Encodes one box of a layer of a player's frame into a MsgFrameBox followed by its compressed pixel data, and stores the box's pixels for delta compression of the next frame.
+		/// Safe to call from multiple threads at once, as long as no two calls encode the same box.
+		/// </summary>
+		/// <param name="player">The player whose frame the box belongs to.</param>
+		/// <param name="layer">The layer of the frame the box belongs to. 0 for the frame, 1 for the GUI.</param>
+		/// <param name="boxX">The X index of the box.</param>
+		/// <param name="boxY">The Y index of the box.</param>
+		/// <param name="encodedBox">The EncodedFrameBox to store the outcome of the encoding in.</param>
+		/// <param name="encodedBoxMessage">The buffer to write the MsgFrameBox and compressed pixel data to. Must fit a MsgFrameBox and a full box of pixels.</param>
+		void EncodeFrameBox(short player, unsigned char layer, int boxX, int boxY, EncodedFrameBox &encodedBox, unsigned char *encodedBoxMessage) const;
+
+		/// <summary>
+		/// Checks whether a buffer holds only zeroes. Checks a whole vector of bytes at a time where possible.
+		/// </summary>
+		/// <param name="buffer">The buffer to check.</param>
+		/// <param name="size">The size of the buffer.</param>
+		/// <returns>Whether the buffer holds only zeroes.</returns>
+		static bool BufferIsEmpty(const unsigned char *buffer, int size);
+
+		/// <summary>
+		/// Calculates the byte by byte difference between the current and previous contents of a buffer, and counts the non-zero bytes of all three. Handles a whole vector of bytes at a time where possible.
+		/// </summary>
+		/// <param name="currentBuffer">The current contents of the buffer.</param>
+		/// <param name="previousBuffer">The previous contents of the buffer.</param>
+		/// <param name="deltaBuffer">The buffer to write the difference to.</param>
+		/// <param name="size">The size of the buffers.</param>
+		/// <param name="currentBytesNeeded">Set to the number of non-zero bytes in the current buffer.</param>
+		/// <param name="previousBytesNeeded">Set to the number of non-zero bytes in the previous buffer.</param>
+		/// <param name="deltaBytesNeeded">Set to the number of non-zero bytes in the difference.</param>
+		static void CalculateDelta(const unsigned char *currentBuffer, const unsigned char *previousBuffer, unsigned char *deltaBuffer, int size, int &currentBytesNeeded, int &previousBytesNeeded, int &deltaBytesNeeded);
 #pragma endregion
 
 #pragma region Network Stats Handling
@@ -2,9 +2,11 @@
 
 #include "CameraMan.h"
 #include "FrameMan.h"
+#include "ThreadMan.h"
 #include "Scene.h"
 #include "ContentFile.h"
 #include "Matrix.h"
+#include "SIMD.h"
 
 namespace RTE {
 
@@ -20,6 +22,8 @@ namespace RTE {
 		m_BlueGlow = nullptr;
 		m_BlueGlowHash = 0;
 		m_TempEffectBitmaps.clear();
+		m_GlowPixels.clear();
+		m_BatchedPostScreenEffects.clear();
 		for (int i = 0; i < c_MaxScreenCount; ++i) {
 			m_ScreenRelativeEffects[i].clear();
 		}
@@ -94,7 +98,10 @@ namespace RTE {
 	void PostProcessMan::RegisterPostEffect(const Vector &effectPos, BITMAP *effect, size_t hash, int strength, float angle) {
 		// These effects get applied when there's a drawn frame that followed one or more sim updates.
 		// They are not only registered on drawn sim updates; flashes and stuff could be missed otherwise if they occur on undrawn sim updates.
-		if (effect && g_TimerMan.SimUpdatesSinceDrawn() >= 0) { m_PostSceneEffects.push_back(PostEffect(effectPos, effect, hash, strength, angle)); }
+		if (effect && g_TimerMan.SimUpdatesSinceDrawn() >= 0) {
+			std::lock_guard<std::mutex> sceneEffectsLock(m_SceneEffectsMutex);
+			m_PostSceneEffects.push_back(PostEffect(effectPos, effect, hash, strength, angle));
+		}
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -277,7 +284,7 @@ namespace RTE {
 
 	void PostProcessMan::PostProcess() {
 		// First copy the current 8bpp backbuffer to the 32bpp buffer; we'll add effects to it
-		blit(g_FrameMan.GetBackBuffer8(), g_FrameMan.GetBackBuffer32(), 0, 0, 0, 0, g_FrameMan.GetBackBuffer8()->w, g_FrameMan.GetBackBuffer8()->h);
+		ExpandBackBuffer8();
 
 		// Set the screen blender mode for glows
 		set_screen_blender(128, 128, 128, 128);
@@ -299,86 +306,252 @@ namespace RTE {
 		m_PostScreenEffects.clear();
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PostProcessMan::FindGlowPixelsInRow(const unsigned char *rowPixels, int startX, int endX, int posY, std::vector<GlowPixel> &glowPixels) {
+		// Pixels of these colors get the yellow dot glow. The two lighter shades are 98 and 120.
+		static constexpr std::array<unsigned char, 3> c_YellowGlowColors = { static_cast<unsigned char>(g_YellowGlowColor), 98, 120 };
+
+		int posX = startX;
+#ifdef RTE_SIMD_AVX2
+		const __m256i yellowGlowColorA = _mm256_set1_epi8(static_cast<char>(c_YellowGlowColors[0]));
+		const __m256i yellowGlowColorB = _mm256_set1_epi8(static_cast<char>(c_YellowGlowColors[1]));
+		const __m256i yellowGlowColorC = _mm256_set1_epi8(static_cast<char>(c_YellowGlowColors[2]));
+		for (; posX + 32 <= endX; posX += 32) {
+			__m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rowPixels + posX));
+			__m256i matches = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(pixels, yellowGlowColorA), _mm256_cmpeq_epi8(pixels, yellowGlowColorB)), _mm256_cmpeq_epi8(pixels, yellowGlowColorC));
+			ForEachSetBit(static_cast<unsigned int>(_mm256_movemask_epi8(matches)), [&](int lane) { glowPixels.push_back({ posX + lane, posY, rowPixels[posX + lane] }); });
+		}
+#endif
+#ifdef RTE_SIMD_SSE2
+		const __m128i yellowGlowColorA128 = _mm_set1_epi8(static_cast<char>(c_YellowGlowColors[0]));
+		const __m128i yellowGlowColorB128 = _mm_set1_epi8(static_cast<char>(c_YellowGlowColors[1]));
+		const __m128i yellowGlowColorC128 = _mm_set1_epi8(static_cast<char>(c_YellowGlowColors[2]));
+		for (; posX + 16 <= endX; posX += 16) {
+			__m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rowPixels + posX));
+			__m128i matches = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(pixels, yellowGlowColorA128), _mm_cmpeq_epi8(pixels, yellowGlowColorB128)), _mm_cmpeq_epi8(pixels, yellowGlowColorC128));
+			ForEachSetBit(static_cast<unsigned int>(_mm_movemask_epi8(matches)), [&](int lane) { glowPixels.push_back({ posX + lane, posY, rowPixels[posX + lane] }); });
+		}
+#endif
+		for (; posX < endX; ++posX) {
+			unsigned char pixel = rowPixels[posX];
+			if (pixel == c_YellowGlowColors[0] || pixel == c_YellowGlowColors[1] || pixel == c_YellowGlowColors[2]) { glowPixels.push_back({ posX, posY, pixel }); }
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if defined(RTE_SIMD_AVX2) || defined(RTE_SIMD_AVX2_DISPATCH)
+#ifdef RTE_SIMD_AVX2_DISPATCH
+	RTE_SIMD_TARGET_AVX2
+#endif
+	int PostProcessMan::ExpandPaletteRowAVX2(const unsigned char *sourcePixels, uint32_t *destPixels, int width, const int *paletteColors) {
+		int posX = 0;
+		for (; posX + 8 <= width; posX += 8) {
+			__m256i paletteIndices = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(sourcePixels + posX)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(destPixels + posX), _mm256_i32gather_epi32(paletteColors, paletteIndices, 4));
+		}
+		return posX;
+	}
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PostProcessMan::ExpandPaletteRow(const unsigned char *sourcePixels, uint32_t *destPixels, int width, const int *paletteColors) {
+		int posX = 0;
+#if defined(RTE_SIMD_AVX2)
+		posX = ExpandPaletteRowAVX2(sourcePixels, destPixels, width, paletteColors);
+#elif defined(RTE_SIMD_AVX2_DISPATCH)
+		if (CPUSupportsAVX2()) { posX = ExpandPaletteRowAVX2(sourcePixels, destPixels, width, paletteColors); }
+#endif
+		// SSE2 has no gather, so without AVX2 the lookups are done one pixel at a time.
+		for (; posX < width; ++posX) {
+			destPixels[posX] = static_cast<uint32_t>(paletteColors[sourcePixels[posX]]);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PostProcessMan::ScreenBlendRow(const uint32_t *sourcePixels, uint32_t *destPixels, int width, int strength) {
+		// Allegro's _blender_trans24 bumps any non-zero strength by one so full strength divides out exactly by 256.
+		// It also blends the outer two channels in one go while adding the whole destination pixel back in afterwards, so the middle channel of the destination ends up as a rounding bias for the third channel. That is matched here so the results are identical.
+		const int blendFactor = (strength > 0) ? strength + 1 : 0;
+
+		int posX = 0;
+#ifdef RTE_SIMD_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i channelMax = _mm_set1_epi16(255);
+		const __m128i blendFactors = _mm_set1_epi16(static_cast<short>(blendFactor));
+		const __m128i maskColor = _mm_set1_epi32(MASK_COLOR_32);
+		const __m128i colorBits = _mm_set1_epi32(0x00FFFFFF);
+		const __m128i thirdChannels = _mm_set_epi16(0, -1, 0, 0, 0, -1, 0, 0);
+
+		// Each channel is widened to 16 bits so the products of the screen and the blend can't overflow. Both are at most 255 * 256, and the rounding bias of the third channel at most 255 more.
+		auto screenBlendChannels = [&](__m128i sourceChannels, __m128i destChannels) {
+			__m128i inverseProduct = _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(channelMax, sourceChannels), _mm_sub_epi16(channelMax, destChannels)), 8);
+			__m128i screenedChannels = _mm_sub_epi16(channelMax, inverseProduct);
+			__m128i roundingBias = _mm_and_si128(_mm_slli_epi64(destChannels, 16), thirdChannels);
+			return _mm_add_epi16(destChannels, _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(screenedChannels, destChannels), blendFactors), roundingBias), 8));
+		};
+
+		for (; posX + 4 <= width; posX += 4) {
+			__m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sourcePixels + posX));
+			__m128i dest = _mm_loadu_si128(reinterpret_cast<const __m128i *>(destPixels + posX));
+			__m128i blendedLow = screenBlendChannels(_mm_unpacklo_epi8(source, zero), _mm_unpacklo_epi8(dest, zero));
+			__m128i blendedHigh = screenBlendChannels(_mm_unpackhi_epi8(source, zero), _mm_unpackhi_epi8(dest, zero));
+			__m128i blended = _mm_and_si128(_mm_packus_epi16(blendedLow, blendedHigh), colorBits);
+
+			__m128i isMaskColor = _mm_cmpeq_epi32(source, maskColor);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(destPixels + posX), _mm_or_si128(_mm_and_si128(isMaskColor, dest), _mm_andnot_si128(isMaskColor, blended)));
+		}
+#endif
+		for (; posX < width; ++posX) {
+			uint32_t sourcePixel = sourcePixels[posX];
+			if (sourcePixel != MASK_COLOR_32) {
+				uint32_t destPixel = destPixels[posX];
+				uint32_t blendedPixel = 0;
+				for (int channelShift = 0; channelShift < 24; channelShift += 8) {
+					int sourceChannel = (sourcePixel >> channelShift) & 0xFF;
+					int destChannel = (destPixel >> channelShift) & 0xFF;
+					int screenedChannel = 255 - ((255 - sourceChannel) * (255 - destChannel)) / 256;
+					int roundingBias = (channelShift == 16) ? static_cast<int>((destPixel >> 8) & 0xFF) : 0;
+					blendedPixel |= static_cast<uint32_t>(destChannel + ((screenedChannel - destChannel) * blendFactor + roundingBias) / 256) << channelShift;
+				}
+				destPixels[posX] = blendedPixel;
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PostProcessMan::ExpandBackBuffer8() const {
+		BITMAP *backBuffer8 = g_FrameMan.GetBackBuffer8();
+		BITMAP *backBuffer32 = g_FrameMan.GetBackBuffer32();
+
+		// palette_color only holds the 32bpp colors of the current palette while the color depth is 32bpp. If anything else is off, or Allegro would keep the mask color, let Allegro do the blit.
+		if (get_color_depth() != 32 || bitmap_color_depth(backBuffer8) != 8 || bitmap_color_depth(backBuffer32) != 32 || !is_memory_bitmap(backBuffer8) || !is_memory_bitmap(backBuffer32) || (get_color_conversion() & COLORCONV_KEEP_TRANS)) {
+			blit(backBuffer8, backBuffer32, 0, 0, 0, 0, backBuffer8->w, backBuffer8->h);
+			return;
+		}
+		const int *paletteColors = palette_color;
+		int width = std::min(backBuffer8->w, backBuffer32->w);
+		int height = std::min(backBuffer8->h, backBuffer32->h);
+
+		g_ThreadMan.ParallelFor(0, height, [backBuffer8, backBuffer32, width, paletteColors](int y) {
+			ExpandPaletteRow(backBuffer8->line[y], reinterpret_cast<uint32_t *>(backBuffer32->line[y]), width, paletteColors);
+		});
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PostProcessMan::DrawScreenBlendedSprite(BITMAP *targetBitmap, BITMAP *sprite, int posX, int posY, int strength) {
+		if (bitmap_color_depth(targetBitmap) != 32 || bitmap_color_depth(sprite) != 32 || !is_memory_bitmap(targetBitmap) || !is_memory_bitmap(sprite) || strength < 0 || strength > 255) {
+			set_screen_blender(strength, strength, strength, strength);
+			draw_trans_sprite(targetBitmap, sprite, posX, posY);
+			return;
+		}
+		int spriteStartX = 0;
+		int spriteStartY = 0;
+		int spriteEndX = sprite->w;
+		int spriteEndY = sprite->h;
+
+		if (targetBitmap->clip) {
+			spriteStartX = std::max(targetBitmap->cl - posX, 0);
+			spriteStartY = std::max(targetBitmap->ct - posY, 0);
+			spriteEndX = std::min(targetBitmap->cr - posX, sprite->w);
+			spriteEndY = std::min(targetBitmap->cb - posY, sprite->h);
+		}
+		if (spriteEndX <= spriteStartX) {
+			return;
+		}
+		for (int y = spriteStartY; y < spriteEndY; ++y) {
+			ScreenBlendRow(reinterpret_cast<const uint32_t *>(sprite->line[y]) + spriteStartX, reinterpret_cast<uint32_t *>(targetBitmap->line[posY + y]) + posX + spriteStartX, spriteEndX - spriteStartX, strength);
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void PostProcessMan::DrawDotGlowEffects() {
-		int startX = 0;
-		int startY = 0;
-		int endX = 0;
-		int endY = 0;
-		int testpixel = 0;
-
-		// Randomly sample the entire backbuffer, looking for pixels to put a glow on.
-		// NOTE THIS IS SLOW, especially on higher resolutions!
+		BITMAP *backBuffer8 = g_FrameMan.GetBackBuffer8();
+		BITMAP *backBuffer32 = g_FrameMan.GetBackBuffer32();
+
+		// Find all the glow colored pixels in the glow boxes first, a row at a time, so the backbuffer is only read in vector sized chunks instead of pixel by pixel.
+		m_GlowPixels.clear();
+		m_BatchedPostScreenEffects.clear();
 		for (const Box &glowBox : m_PostScreenGlowBoxes) {
-			startX = glowBox.m_Corner.GetFloorIntX();
-			startY = glowBox.m_Corner.GetFloorIntY();
-			endX = startX + static_cast<int>(glowBox.m_Width);
-			endY = startY + static_cast<int>(glowBox.m_Height);
+			int startX = glowBox.m_Corner.GetFloorIntX();
+			int startY = glowBox.m_Corner.GetFloorIntY();
+			int endX = startX + static_cast<int>(glowBox.m_Width);
+			int endY = startY + static_cast<int>(glowBox.m_Height);
 
 			// Sanity check a little at least
-			if (startX < 0 || startX >= g_FrameMan.GetBackBuffer8()->w || startY < 0 || startY >= g_FrameMan.GetBackBuffer8()->h ||
-				endX < 0 || endX >= g_FrameMan.GetBackBuffer8()->w || endY < 0 || endY >= g_FrameMan.GetBackBuffer8()->h) {
+			if (startX < 0 || startX >= backBuffer8->w || startY < 0 || startY >= backBuffer8->h || endX < 0 || endX >= backBuffer8->w || endY < 0 || endY >= backBuffer8->h) {
 				continue;
 			}
 
 #ifdef DEBUG_BUILD
 			// Draw a rectangle around the glow box so we see it's position and size
-			rect(g_FrameMan.GetBackBuffer32(), startX, startY, endX, endY, g_RedColor);
+			rect(backBuffer32, startX, startY, endX, endY, g_RedColor);
 #endif
 
 			for (int y = startY; y < endY; ++y) {
-				for (int x = startX; x < endX; ++x) {
-					testpixel = _getpixel(g_FrameMan.GetBackBuffer8(), x, y);
-
-					// YELLOW
-					if ((testpixel == g_YellowGlowColor && RandomNum() < 0.9F) || testpixel == 98 || (testpixel == 120 && RandomNum() < 0.7F)) {
-						draw_trans_sprite(g_FrameMan.GetBackBuffer32(), m_YellowGlow, x - 2, y - 2);
-					}
-					// TODO: Enable and add more colors once we actually have something that needs these.
-					// RED
-					/*
-					if (testpixel == 13) {
-						draw_trans_sprite(m_BackBuffer32, m_RedGlow, x - 2, y - 2);
-					}
-					// BLUE
-					if (testpixel == 166) {
-						draw_trans_sprite(g_FrameMan.GetBackBuffer32(), m_BlueGlow, x - 2, y - 2);
-					}
-					*/
-				}
+				FindGlowPixelsInRow(backBuffer8->line[y], startX, endX, y, m_GlowPixels);
 			}
 		}
+
+		// Then blend the glows of all the found pixels in one go. The found pixels are in the same order they were sampled in before, so the random glow chances play out the same.
+		for (const GlowPixel &glowPixel : m_GlowPixels) {
+			if ((glowPixel.Color == g_YellowGlowColor && RandomNum() < 0.9F) || glowPixel.Color == 98 || (glowPixel.Color == 120 && RandomNum() < 0.7F)) {
+				DrawScreenBlendedSprite(backBuffer32, m_YellowGlow, glowPixel.PosX - 2, glowPixel.PosY - 2, 128);
+			}
+			// TODO: Enable and add more colors once we actually have something that needs these. Red glows on color 13, blue glows on color 166.
+		}
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void PostProcessMan::DrawPostScreenEffects() const {
-		BITMAP *effectBitmap = nullptr;
-		int effectPosX = 0;
-		int effectPosY = 0;
-		int effectStrength = 0;
+	void PostProcessMan::DrawPostScreenEffects() {
+		BITMAP *backBuffer32 = g_FrameMan.GetBackBuffer32();
 
+		// Group the effects by bitmap and angle, keeping the order they were registered in within each group, so each rotated bitmap only gets rotated once per group and the rows of each effect bitmap stay in cache while it's being blended.
+		m_BatchedPostScreenEffects.clear();
 		for (const PostEffect &postEffect : m_PostScreenEffects) {
-			if (postEffect.m_Bitmap) {
-				effectBitmap = postEffect.m_Bitmap;
-				effectStrength = postEffect.m_Strength;
-				effectPosX = postEffect.m_Pos.GetFloorIntX() - (effectBitmap->w / 2);
-				effectPosY = postEffect.m_Pos.GetFloorIntY() - (effectBitmap->h / 2);
-				set_screen_blender(effectStrength, effectStrength, effectStrength, effectStrength);
-
-				// Draw all the scene screen effects accumulated this frame
-				if (postEffect.m_Angle == 0) {
-					draw_trans_sprite(g_FrameMan.GetBackBuffer32(), effectBitmap, effectPosX, effectPosY);
-				} else {
-					BITMAP *targetBitmap = GetTempEffectBitmap(effectBitmap);
-					clear_to_color(targetBitmap, 0);
-
-					Matrix newAngle(postEffect.m_Angle);
-					rotate_sprite(targetBitmap, effectBitmap, 0, 0, ftofix(newAngle.GetAllegroAngle()));
-					draw_trans_sprite(g_FrameMan.GetBackBuffer32(), targetBitmap, effectPosX, effectPosY);
+			if (postEffect.m_Bitmap) { m_BatchedPostScreenEffects.push_back(&postEffect); }
+		}
+		std::stable_sort(m_BatchedPostScreenEffects.begin(), m_BatchedPostScreenEffects.end(), [](const PostEffect *postEffect, const PostEffect *otherPostEffect) {
+			if (postEffect->m_BitmapHash != otherPostEffect->m_BitmapHash) {
+				return postEffect->m_BitmapHash < otherPostEffect->m_BitmapHash;
+			} else if (postEffect->m_Bitmap != otherPostEffect->m_Bitmap) {
+				return std::less<const BITMAP *>()(postEffect->m_Bitmap, otherPostEffect->m_Bitmap);
+			}
+			return postEffect->m_Angle < otherPostEffect->m_Angle;
+		});
+
+		const BITMAP *rotatedEffectBitmap = nullptr;
+		float rotatedEffectAngle = 0;
+		BITMAP *rotatedBitmap = nullptr;
+
+		for (const PostEffect *postEffect : m_BatchedPostScreenEffects) {
+			BITMAP *effectBitmap = postEffect->m_Bitmap;
+			int effectPosX = postEffect->m_Pos.GetFloorIntX() - (effectBitmap->w / 2);
+			int effectPosY = postEffect->m_Pos.GetFloorIntY() - (effectBitmap->h / 2);
+
+			// Draw all the scene screen effects accumulated this frame
+			if (postEffect->m_Angle == 0) {
+				DrawScreenBlendedSprite(backBuffer32, effectBitmap, effectPosX, effectPosY, postEffect->m_Strength);
+			} else {
+				// The previous effect's rotation can be reused as long as the group of the same bitmap and angle continues.
+				if (effectBitmap != rotatedEffectBitmap || postEffect->m_Angle != rotatedEffectAngle) {
+					rotatedBitmap = GetTempEffectBitmap(effectBitmap);
+					clear_to_color(rotatedBitmap, 0);
+
+					Matrix newAngle(postEffect->m_Angle);
+					rotate_sprite(rotatedBitmap, effectBitmap, 0, 0, ftofix(newAngle.GetAllegroAngle()));
+					rotatedEffectBitmap = effectBitmap;
+					rotatedEffectAngle = postEffect->m_Angle;
 				}
+				DrawScreenBlendedSprite(backBuffer32, rotatedBitmap, effectPosX, effectPosY, postEffect->m_Strength);
 			}
 		}
 	}
-}
\ No newline at end of file
+}
@@ -132,7 +132,12 @@ namespace RTE {
 		/// Registers a specific IntRect to be post-processed and have special pixel colors lit up by glow effects in it.
 		/// </summary>
 		/// <param name="glowArea">The IntRect to have special color pixels glow in, in scene coordinates.</param>
-		void RegisterGlowArea(const IntRect &glowArea) { if (g_TimerMan.DrawnSimUpdate() && g_TimerMan.SimUpdatesSinceDrawn() >= 0) { m_GlowAreas.push_back(glowArea); } }
+		void RegisterGlowArea(const IntRect &glowArea) {
+			if (g_TimerMan.DrawnSimUpdate() && g_TimerMan.SimUpdatesSinceDrawn() >= 0) {
+				std::lock_guard<std::mutex> sceneEffectsLock(m_SceneEffectsMutex);
+				m_GlowAreas.push_back(glowArea);
+			}
+		}
 
 		/// <summary>
 		/// Creates an IntRect and registers it to be post-processed and have special pixel colors lit up by glow effects in it.
@@ -186,6 +191,7 @@ namespace RTE {
 
 		std::list<Box> m_PostScreenGlowBoxes; //!< List of areas that will be processed with glow.
 		std::list<IntRect> m_GlowAreas; //!< All the areas to do post glow pixel effects on, in scene coordinates.
+		std::mutex m_SceneEffectsMutex; //!< Mutex for registering scene post effects and glow areas, which happens from every player screen while their HUDs are drawn in parallel.
 
 		std::array<std::list<PostEffect>, c_MaxScreenCount> m_ScreenRelativeEffects; //!< List of screen relative effects for each player in online multiplayer.
 		std::array<std::mutex, c_MaxScreenCount> ScreenRelativeEffectsMutex; //!< Mutex for the ScreenRelativeEffects list when accessed by multiple threads in online multiplayer.
@@ -202,6 +208,18 @@ namespace RTE {
 
 	private:
 
+		/// <summary>
+		/// A pixel of the 8bpp backbuffer that is colored with one of the glow colors.
+		/// </summary>
+		struct GlowPixel {
+			int PosX; //!< The X position of the pixel on the backbuffer.
+			int PosY; //!< The Y position of the pixel on the backbuffer.
+			unsigned char Color; //!< The palette index of the pixel.
+		};
+
+		std::vector<GlowPixel> m_GlowPixels; //!< The glow colored pixels found in the glow boxes this frame. Kept between frames so it doesn't need to be reallocated.
+		std::vector<const PostEffect *> m_BatchedPostScreenEffects; //!< The screen effects of this frame, grouped by bitmap and angle so each rotation is only done once. Kept between frames so it doesn't need to be reallocated.
+
 #pragma region Post Effect Handling
 		/// <summary>
 		/// Gets all screen effects that are located within a box in the scene. Their coordinates will be returned relative to the upper left corner of the box passed in here.
@@ -241,6 +259,61 @@ namespace RTE {
 		/// <param name="which">Which of the dot glow colors to get, see the DotGlowColor enumerator.</param>
 		/// <returns>The hash value of the requested glow dot BITMAP.</returns>
 		size_t GetDotGlowEffectHash(DotGlowColor whichColor) const;
+
+		/// <summary>
+		/// Finds the glow colored pixels in a span of a row of an 8bpp bitmap and adds them to a list. Compares a whole vector of pixels at a time where possible.
+		/// </summary>
+		/// <param name="rowPixels">The pixels of the row.</param>
+		/// <param name="startX">The X position to start searching at.</param>
+		/// <param name="endX">The X position to stop searching at, exclusive.</param>
+		/// <param name="posY">The Y position of the row, to store in the found GlowPixels.</param>
+		/// <param name="glowPixels">The list to add the found GlowPixels to.</param>
+		static void FindGlowPixelsInRow(const unsigned char *rowPixels, int startX, int endX, int posY, std::vector<GlowPixel> &glowPixels);
+#pragma endregion
+
+#pragma region Software Compositing
+		/// <summary>
+		/// Expands a span of a row of 8bpp palette indices to 32bpp colors. Looks up a whole vector of pixels at a time where possible.
+		/// </summary>
+		/// <param name="sourcePixels">The palette indices to expand.</param>
+		/// <param name="destPixels">The 32bpp pixels to write the colors to.</param>
+		/// <param name="width">The number of pixels to expand.</param>
+		/// <param name="paletteColors">The 32bpp color of each of the 256 palette indices.</param>
+		static void ExpandPaletteRow(const unsigned char *sourcePixels, uint32_t *destPixels, int width, const int *paletteColors);
+
+		/// <summary>
+		/// Expands as many whole vectors of 8 pixels of a row of 8bpp palette indices to 32bpp colors as fit using AVX2 gathers. Only defined on x86-64, and only called if the CPU supports AVX2.
+		/// </summary>
+		/// <param name="sourcePixels">The palette indices to expand.</param>
+		/// <param name="destPixels">The 32bpp pixels to write the colors to.</param>
+		/// <param name="width">The number of pixels in the row.</param>
+		/// <param name="paletteColors">The 32bpp color of each of the 256 palette indices.</param>
+		/// <returns>The number of pixels that were expanded. The rest are left for the caller.</returns>
+		static int ExpandPaletteRowAVX2(const unsigned char *sourcePixels, uint32_t *destPixels, int width, const int *paletteColors);
+
+		/// <summary>
+		/// Screen blends a span of a row of 32bpp sprite pixels onto 32bpp destination pixels, giving the same result as draw_trans_sprite with set_screen_blender. Sprite pixels of the mask color are skipped. Blends a whole vector of pixels at a time where possible.
+		/// </summary>
+		/// <param name="sourcePixels">The sprite pixels to blend.</param>
+		/// <param name="destPixels">The pixels to blend the sprite pixels onto.</param>
+		/// <param name="width">The number of pixels to blend.</param>
+		/// <param name="strength">The strength of the blend, 0 to 255.</param>
+		static void ScreenBlendRow(const uint32_t *sourcePixels, uint32_t *destPixels, int width, int strength);
+
+		/// <summary>
+		/// Copies the 8bpp backbuffer to the 32bpp backbuffer, expanding the palette indices to colors with the current palette. The rows are split between the worker threads.
+		/// </summary>
+		void ExpandBackBuffer8() const;
+
+		/// <summary>
+		/// Screen blends a sprite onto a bitmap. 32bpp sprites with a valid strength are blended in software with ScreenBlendRow, anything else falls back to Allegro's draw_trans_sprite.
+		/// </summary>
+		/// <param name="targetBitmap">The bitmap to blend the sprite onto.</param>
+		/// <param name="sprite">The sprite to blend.</param>
+		/// <param name="posX">The X position of the sprite's upper left corner on the target bitmap.</param>
+		/// <param name="posY">The Y position of the sprite's upper left corner on the target bitmap.</param>
+		/// <param name="strength">The strength of the blend, 0 to 255.</param>
+		static void DrawScreenBlendedSprite(BITMAP *targetBitmap, BITMAP *sprite, int posX, int posY, int strength);
 #pragma endregion
 
 #pragma region PostProcess Breakdown
@@ -252,7 +325,7 @@ namespace RTE {
 		/// <summary>
 		/// Draws all the glow effects registered for this frame. This is called from PostProcess().
 		/// </summary>
-		void DrawPostScreenEffects() const;
+		void DrawPostScreenEffects();
 #pragma endregion
 
 		/// <summary>
@@ -38,6 +38,8 @@ namespace RTE {
 		{c_UserScriptedSavesModuleName, "Scripted Activity Saves" }
 	}};
 
+	const std::string PresetMan::c_FileCacheName = "ModuleFileCache.bin";
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Clear
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -50,6 +52,7 @@ void PresetMan::Clear()
     m_DataModuleIDs.clear();
     m_OfficialModuleCount = 0;
     m_TotalGroupRegister.clear();
+    m_ResolvedPresetCache.clear();
 	m_LastReloadedEntityPresetInfo.fill("");
 	m_ReloadEntityPresetCalledThisUpdate = false;
 }
@@ -109,6 +112,7 @@ bool PresetMan::LoadDataModule(const std::string &moduleName, bool official, boo
 
 	// Only instantiate it here, because it needs to be in the lists of this before being created.
 	DataModule *newModule = new DataModule();
+	ClearResolvedPresetCache();
 
 	// Official modules are stacked in the beginning of the vector.
 	if (official && !userdata) {
@@ -149,19 +153,15 @@ bool PresetMan::LoadAllDataModules() {
 
 	FindAndExtractZippedModules();
 
-	// Load all the official modules first!
-	for (const std::string &officialModule : c_OfficialModules) {
-		if (!LoadDataModule(officialModule, true, false, LoadingScreen::LoadingSplashProgressReport)) {
-			return false;
-		}
-	}
+	// Gather all the modules to load in the order they need to be loaded in. Official modules first!
+	std::vector<std::string> officialModulesToLoad(c_OfficialModules.begin(), c_OfficialModules.end());
+	std::vector<std::string> modModulesToLoad;
+	std::vector<std::string> userdataModulesToLoad;
 
 	// If a single module is specified, skip loading all other unofficial modules and load specified module only.
-	if (!m_SingleModuleToLoad.empty() && !IsModuleOfficial(m_SingleModuleToLoad)) {
-		if (!LoadDataModule(m_SingleModuleToLoad, false, false, LoadingScreen::LoadingSplashProgressReport)) {
-			g_ConsoleMan.PrintString("ERROR: Failed to load DataModule \"" + m_SingleModuleToLoad + "\"! Only official modules were loaded!");
-			return false;
-		}
+	bool loadingSingleModule = !m_SingleModuleToLoad.empty() && !IsModuleOfficial(m_SingleModuleToLoad);
+	if (loadingSingleModule) {
+		modModulesToLoad.emplace_back(m_SingleModuleToLoad);
 	} else {
 		std::vector<std::filesystem::directory_entry> modDirectoryFolders;
 		const std::string modDirectory = System::GetWorkingDirectory() + System::GetModDirectory();
@@ -174,11 +174,7 @@ bool PresetMan::LoadAllDataModules() {
 			std::string directoryEntryPath = directoryEntry.path().generic_string();
 			if (std::regex_match(directoryEntryPath, std::regex(".*\.rte"))) {
 				std::string moduleName = directoryEntryPath.substr(directoryEntryPath.find_last_of('/') + 1, std::string::npos);
-				if (!g_SettingsMan.IsModDisabled(moduleName) && !IsModuleOfficial(moduleName) && !IsModuleUserdata(moduleName)) {
-					int moduleID = GetModuleID(moduleName);
-					// NOTE: LoadDataModule can return false (especially since it may try to load already loaded modules, which is okay) and shouldn't cause stop, so we can ignore its return value here.
-					if (moduleID < 0 || moduleID >= GetOfficialModuleCount()) { LoadDataModule(moduleName, false, false, LoadingScreen::LoadingSplashProgressReport); }
-				}
+				if (!g_SettingsMan.IsModDisabled(moduleName) && !IsModuleOfficial(moduleName) && !IsModuleUserdata(moduleName)) { modModulesToLoad.emplace_back(moduleName); }
 			}
 		}
 
@@ -188,19 +184,72 @@ bool PresetMan::LoadAllDataModules() {
 				bool scanContentsAndIgnoreMissing = userdataModuleName == c_UserScenesModuleName;
 				DataModule::CreateOnDiskAsUserdata(userdataModuleName, userdataModuleFriendlyName, scanContentsAndIgnoreMissing, scanContentsAndIgnoreMissing);
 			}
-			if (!LoadDataModule(userdataModuleName, false, true, LoadingScreen::LoadingSplashProgressReport)) {
-				return false;
-			}
+			userdataModulesToLoad.emplace_back(userdataModuleName);
+		}
+	}
+
+	// Files that didn't change since the last load are taken already parsed from the file cache, instead of being parsed again.
+	const std::string fileCachePath = System::GetUserdataDirectory() + c_FileCacheName;
+	Reader::LoadFileCache(fileCachePath);
+
+	// Parse the ini files of all the modules in parallel first, which also starts decoding the images they point to in the background.
+	// Creating the presets from the parsed files has to stay serial and in order, because CopyOf and other preset references are resolved against the modules loaded before them.
+	std::vector<const std::string *> modulesToParse;
+	for (const std::vector<std::string> *modulesToLoad : { &officialModulesToLoad, &modModulesToLoad, &userdataModulesToLoad }) {
+		for (const std::string &moduleName : *modulesToLoad) {
+			modulesToParse.emplace_back(&moduleName);
 		}
 	}
+	ContentFile::StartPrefetchingImages();
+	std::for_each(std::execution::par, modulesToParse.begin(), modulesToParse.end(),
+		[](const std::string *moduleName) {
+			DataModule::ParseFiles(*moduleName);
+		}
+	);
 
-	if (g_SettingsMan.IsMeasuringModuleLoadTime()) {
+	bool allModulesLoaded = LoadDataModulesInOrder(officialModulesToLoad, modModulesToLoad, userdataModulesToLoad, loadingSingleModule);
+	ContentFile::StopPrefetchingImages();
+
+	if (allModulesLoaded) { Reader::SaveFileCache(fileCachePath); }
+	Reader::ClearParsedFiles();
+
+	if (allModulesLoaded && g_SettingsMan.IsMeasuringModuleLoadTime()) {
 		std::chrono::milliseconds moduleLoadElapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - moduleLoadTimerStart);
 		g_ConsoleMan.PrintString("Module load duration is: " + std::to_string(moduleLoadElapsedTime.count()) + "ms");
 	}
-	return true;
+	return allModulesLoaded;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool PresetMan::LoadDataModulesInOrder(const std::vector<std::string> &officialModules, const std::vector<std::string> &modModules, const std::vector<std::string> &userdataModules, bool loadingSingleModule) {
+	for (const std::string &officialModule : officialModules) {
+		if (!LoadDataModule(officialModule, true, false, LoadingScreen::LoadingSplashProgressReport)) {
+			return false;
+		}
+	}
+
+	if (loadingSingleModule) {
+		if (!LoadDataModule(m_SingleModuleToLoad, false, false, LoadingScreen::LoadingSplashProgressReport)) {
+			g_ConsoleMan.PrintString("ERROR: Failed to load DataModule \"" + m_SingleModuleToLoad + "\"! Only official modules were loaded!");
+			return false;
+		}
+		return true;
+	}
+
+	for (const std::string &modModule : modModules) {
+		int moduleID = GetModuleID(modModule);
+		// NOTE: LoadDataModule can return false (especially since it may try to load already loaded modules, which is okay) and shouldn't cause stop, so we can ignore its return value here.
+		if (moduleID < 0 || moduleID >= GetOfficialModuleCount()) { LoadDataModule(modModule, false, false, LoadingScreen::LoadingSplashProgressReport); }
+	}
+
+	for (const std::string &userdataModule : userdataModules) {
+		if (!LoadDataModule(userdataModule, false, true, LoadingScreen::LoadingSplashProgressReport)) {
+			return false;
+		}
+	}
+	return true;
+}
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetDataModule
@@ -360,6 +409,7 @@ bool PresetMan::AddEntityPreset(Entity *pEntToAdd, int whichModule, bool overwri
 {
     RTEAssert(whichModule >= 0 && whichModule < m_pDataModules.size(), "Tried to access an out of bounds data module number!");
 
+    InvalidateResolvedPreset(pEntToAdd->GetClassName(), pEntToAdd->GetPresetName());
     return m_pDataModules[whichModule]->AddEntityPreset(pEntToAdd, overwriteSame, readFromFile);
 }
 
@@ -368,33 +418,65 @@ bool PresetMan::AddEntityPreset(Entity *pEntToAdd, int whichModule, bool overwri
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Gets a previously read in (defined) Entity, by type and instance name.
 
-const Entity * PresetMan::GetEntityPreset(std::string type, std::string preset, int whichModule)
+const Entity * PresetMan::GetEntityPreset(const std::string &type, const std::string &preset, int whichModule)
 {
     RTEAssert(whichModule < (int)m_pDataModules.size(), "Tried to access an out of bounds data module number!");
 
+    {
+        std::shared_lock<std::shared_mutex> cacheLock(m_ResolvedPresetCacheMutex);
+        if (auto typeItr = m_ResolvedPresetCache.find(type); typeItr != m_ResolvedPresetCache.end()) {
+            if (auto presetItr = typeItr->second.find(preset); presetItr != typeItr->second.end()) {
+                for (const auto &[moduleID, resolvedPreset] : presetItr->second) {
+                    if (moduleID == whichModule) {
+                        return resolvedPreset;
+                    }
+                }
+            }
+        }
+    }
+
+    const Entity *pRetEntity = FindEntityPreset(type, preset, whichModule);
+    if (!pRetEntity) {
+        return nullptr;
+    }
+
+    std::unique_lock<std::shared_mutex> cacheLock(m_ResolvedPresetCacheMutex);
+    std::vector<std::pair<int, const Entity *>> &cachedResults = m_ResolvedPresetCache[type][preset];
+    if (std::find_if(cachedResults.begin(), cachedResults.end(), [whichModule](const std::pair<int, const Entity *> &cachedResult) { return cachedResult.first == whichModule; }) == cachedResults.end()) {
+        cachedResults.emplace_back(whichModule, pRetEntity);
+    }
+    return pRetEntity;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const Entity * PresetMan::FindEntityPreset(const std::string &type, const std::string &preset, int whichModule)
+{
     const Entity *pRetEntity = 0;
 
     // Preset name might have "[ModuleName]/" preceding it, detect it here and select proper module!
+    std::string presetNameWithoutModule;
     int slashPos = preset.find_first_of('/');
     if (slashPos != std::string::npos)
     {
         // Get the module ID and cut off the module specifier in the string
         whichModule = GetModuleID(preset.substr(0, slashPos));
-        preset = preset.substr(slashPos + 1);
+        presetNameWithoutModule = preset.substr(slashPos + 1);
     }
+    const std::string &presetToFind = slashPos != std::string::npos ? presetNameWithoutModule : preset;
 
     // All modules
     if (whichModule < 0)
     {
         // Search all modules
         for (int i = 0; i < m_pDataModules.size() && !pRetEntity; ++i)
-            pRetEntity = m_pDataModules[i]->GetEntityPreset(type, preset);
+            pRetEntity = m_pDataModules[i]->GetEntityPreset(type, presetToFind);
     }
     // Specific module
     else
     {
         // Try to get it from the asked for module
-        pRetEntity = m_pDataModules[whichModule]->GetEntityPreset(type, preset);
+        pRetEntity = m_pDataModules[whichModule]->GetEntityPreset(type, presetToFind);
 
         // If couldn't find it in there, then try all the official modules!
         if (!pRetEntity)
@@ -402,7 +484,7 @@ const Entity * PresetMan::GetEntityPreset(std::string type, std::string preset,
             RTEAssert(m_OfficialModuleCount <= m_pDataModules.size(), "More official modules than modules loaded?!");
             for (int i = 0; i < m_OfficialModuleCount && !pRetEntity; ++i)
             {
-                pRetEntity = m_pDataModules[i]->GetEntityPreset(type, preset);
+                pRetEntity = m_pDataModules[i]->GetEntityPreset(type, presetToFind);
             }
         }
     }
@@ -410,6 +492,27 @@ const Entity * PresetMan::GetEntityPreset(std::string type, std::string preset,
     return pRetEntity;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void PresetMan::ClearResolvedPresetCache()
+{
+    std::unique_lock<std::shared_mutex> cacheLock(m_ResolvedPresetCacheMutex);
+    m_ResolvedPresetCache.clear();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void PresetMan::InvalidateResolvedPreset(const std::string &type, const std::string &presetName)
+{
+    std::unique_lock<std::shared_mutex> cacheLock(m_ResolvedPresetCacheMutex);
+    if (auto typeItr = m_ResolvedPresetCache.find(type); typeItr != m_ResolvedPresetCache.end()) {
+        std::erase_if(typeItr->second, [&presetName](const auto &cachedPreset) {
+            const std::string &askedForName = cachedPreset.first;
+            return askedForName == presetName || (askedForName.size() > presetName.size() && askedForName.ends_with(presetName) && askedForName[askedForName.size() - presetName.size() - 1] == '/');
+        });
+    }
+}
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetEntityPreset
@@ -453,6 +556,7 @@ const Entity * PresetMan::GetEntityPreset(Reader &reader)
 		else if (pNewInstance)
 		{
 			// Try to add the instance to the collection
+			InvalidateResolvedPreset(pNewInstance->GetClassName(), pNewInstance->GetPresetName());
 			m_pDataModules[whichModule]->AddEntityPreset(pNewInstance, reader.GetPresetOverwriting(), entityFilePath);
 
 			// Regardless of whether there was a collision or not, use whatever now exists in the instance map of that class and name
@@ -513,6 +617,7 @@ Entity * PresetMan::ReadReflectedPreset(Reader &reader)
 		{
 			// Try to add the instance to the collection.
 			// Note that we'll return this instance regardless of whether the adding was succesful or not
+			InvalidateResolvedPreset(pNewInstance->GetClassName(), pNewInstance->GetPresetName());
 			m_pDataModules[whichModule]->AddEntityPreset(pNewInstance, reader.GetPresetOverwriting(), entityFilePath);
 		    return pNewInstance;
 		}
@@ -949,6 +1054,8 @@ bool PresetMan::ReloadEntityPreset(const std::string &presetName, const std::str
 		reader.ReadPropName();
 		g_PresetMan.GetEntityPreset(reader);
 	}
+	// Sprites are reloaded in place, so anything rotated from the old ones has to go.
+	MOSRotating::GetRotatedSpriteCache().Clear();
 	g_ConsoleMan.PrintString("SYSTEM: Entity preset with name \"" + presetName + "\" of type \"" + className + "\" defined in \"" + actualDataModuleOfPreset + "\" was successfully reloaded");
 
 	if (storeReloadedPresetDataForQuickReloading) {
@@ -243,10 +243,11 @@ public:
 //                  the official modules will be searched also. -1 means search ALL modules!
 // Return value:    A pointer to the requested Entity instance. 0 if no Entity with that
 //                  derived type or instance name was found. Ownership is NOT transferred!
+//                  Results are cached, so repeated lookups of the same preset are O(1).
 
-    const Entity * GetEntityPreset(std::string type, std::string preset, int whichModule = -1);
+    const Entity * GetEntityPreset(const std::string &type, const std::string &preset, int whichModule = -1);
     // Helper for passing in string module name instead of ID
-    const Entity * GetEntityPreset(std::string type, std::string preset, std::string module) { return GetEntityPreset(type, preset, GetModuleID(module)); }
+    const Entity * GetEntityPreset(const std::string &type, const std::string &preset, const std::string &module) { return GetEntityPreset(type, preset, GetModuleID(module)); }
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetEntityPreset
@@ -572,15 +573,51 @@ private:
 
 	static const std::array<std::string, 10> c_OfficialModules; // Array storing the names of all the official modules.
 	static const std::array<std::pair<std::string, std::string>, 3> c_UserdataModules; // Array storing the names of all the userdata modules.
+	static const std::string c_FileCacheName; //!< The name of the file in the userdata directory that caches the parsed ini files of all modules between loads.
 
 	std::array<std::string, 3> m_LastReloadedEntityPresetInfo; //!< Array storing the last reloaded Entity preset info (ClassName, PresetName and DataModule). Used for quick reloading via key combination.
 	bool m_ReloadEntityPresetCalledThisUpdate; //!< A flag for whether or not ReloadEntityPreset was called this update.
 
+	std::unordered_map<std::string, std::unordered_map<std::string, std::vector<std::pair<int, const Entity *>>>> m_ResolvedPresetCache; //!< Results of GetEntityPreset, keyed by type, then preset name as asked for, then the module asked for. Failed lookups aren't cached, since scripts can ask for any name.
+	std::shared_mutex m_ResolvedPresetCacheMutex; //!< Mutex to allow presets to be looked up from multiple threads, as scripts do.
+
+	/// <summary>
+	/// Finds a previously read in (defined) Entity by searching the DataModules, without using or updating the resolved preset cache.
+	/// </summary>
+	/// <param name="type">The type name of the derived Entity.</param>
+	/// <param name="preset">The instance name of the derived Entity instance, optionally preceded by "[ModuleName]/".</param>
+	/// <param name="whichModule">Which module to try to get the entity from. If it's not found there, the official modules will be searched also. -1 means search ALL modules!</param>
+	/// <returns>A pointer to the requested Entity instance, or nullptr if none was found. Ownership is NOT transferred!</returns>
+	const Entity * FindEntityPreset(const std::string &type, const std::string &preset, int whichModule);
+
+	/// <summary>
+	/// Clears the resolved preset cache. Needs to be done whenever modules are added, as that can change the result of any lookup.
+	/// </summary>
+	void ClearResolvedPresetCache();
+
+	/// <summary>
+	/// Removes the cached lookups of a preset from the resolved preset cache. Needs to be done whenever a preset is added, as that can change which module the preset resolves to.
+	/// Only lookups of the same exact type and preset name are affected, with or without a module name preceding the preset name.
+	/// </summary>
+	/// <param name="type">The exact type name of the added preset.</param>
+	/// <param name="presetName">The name of the added preset.</param>
+	void InvalidateResolvedPreset(const std::string &type, const std::string &presetName);
+
 	/// <summary>
 	/// Iterates through the working directory to find any files matching the zipped module package extension (.rte.zip) and proceeds to extract them.
 	/// </summary>
 	void FindAndExtractZippedModules() const;
 
+	/// <summary>
+	/// Loads the gathered modules with LoadDataModule, one after another in the order they were gathered in.
+	/// </summary>
+	/// <param name="officialModules">The official modules to load, in order.</param>
+	/// <param name="modModules">The non-official modules to load, in order. Modules that fail to load are skipped.</param>
+	/// <param name="userdataModules">The userdata modules to load, in order.</param>
+	/// <param name="loadingSingleModule">Whether only the official modules and m_SingleModuleToLoad should be loaded.</param>
+	/// <returns>Whether all the modules required to run the game were loaded.</returns>
+	bool LoadDataModulesInOrder(const std::vector<std::string> &officialModules, const std::vector<std::string> &modModules, const std::vector<std::string> &userdataModules, bool loadingSingleModule);
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Clear
 //////////////////////////////////////////////////////////////////////////////////////////
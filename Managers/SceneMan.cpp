@@ -33,6 +33,7 @@
 #include "MOPixel.h"
 #include "Atom.h"
 #include "Material.h"
+#include "TravelCommandBuffer.h"
 // Temp
 #include "Controller.h"
 
@@ -71,7 +72,10 @@ void SceneMan::Clear()
     m_pUnseenRevealSound = nullptr;
     m_DrawRayCastVisualizations = false;
     m_DrawPixelCheckVisualizations = false;
-    m_LastUpdatedScreen = 0;
+    for (ScreenLayerOffsets &screenLayerOffsets : m_ScreenLayerOffsets) {
+        screenLayerOffsets.Offset.Reset();
+        screenLayerOffsets.BackgroundLayerOffsets.clear();
+    }
     m_SecondStructPass = false;
 //    m_CalcTimer.Reset();
     m_CleanTimer.Reset();
@@ -480,7 +484,8 @@ unsigned char SceneMan::GetTerrMatter(int pixelX, int pixelY)
 
     WrapPosition(pixelX, pixelY);
 
-    if (m_pDebugLayer && m_DrawPixelCheckVisualizations) { m_pDebugLayer->SetPixel(pixelX, pixelY, 5); }
+    const TravelCommandBuffer *travelCommandBuffer = TravelCommandBuffer::GetActive();
+    if (m_pDebugLayer && m_DrawPixelCheckVisualizations && !travelCommandBuffer) { m_pDebugLayer->SetPixel(pixelX, pixelY, 5); }
 
     BITMAP *pTMatBitmap = m_pCurrentScene->GetTerrain()->GetMaterialBitmap();
 	if (pTMatBitmap == nullptr) {
@@ -496,6 +501,10 @@ unsigned char SceneMan::GetTerrMatter(int pixelX, int pixelY)
     if (pixelY < 0)
         return g_MaterialAir;
 
+    // Pixels that a deferred penetration is going to remove are already air as far as the traveling chunk is concerned.
+    if (travelCommandBuffer && travelCommandBuffer->IsTerrainPixelRemoved(pixelX, pixelY))
+        return g_MaterialAir;
+
     return getpixel(pTMatBitmap, pixelX, pixelY);
 }
 
@@ -514,7 +523,7 @@ MOID SceneMan::GetMOIDPixel(int pixelX, int pixelY, int ignoreTeam)
 #ifdef DRAW_MOID_LAYER
 	MOID moid = getpixel(m_pMOIDLayer->GetBitmap(), pixelX, pixelY);
 #else
-    const std::vector<MOID> &moidList = m_MOIDsGrid.GetMOIDsAtPosition(pixelX, pixelY, ignoreTeam, true);
+    SpatialPartitionGrid::CellMOIDs moidList = m_MOIDsGrid.GetMOIDsAtPosition(pixelX, pixelY, ignoreTeam, true);
     MOID moid = g_MovableMan.GetMOIDPixel(pixelX, pixelY, moidList);
 #endif
 
@@ -726,7 +735,7 @@ int SceneMan::RemoveOrphans(int posX, int posY,
 
             pixelMO->SetToHitMOs(spawnMat->GetIndex() == c_GoldMaterialID);
             pixelMO->SetToGetHitByMOs(false);
-            g_MovableMan.AddParticle(pixelMO);
+            g_MovableMan.AddParticle(pixelMO, true);
             pixelMO = 0;
         }
         m_pCurrentScene->GetTerrain()->SetFGColorPixel(posX, posY, g_MaskColor);
@@ -873,8 +882,9 @@ bool SceneMan::TryPenetrate(int posX,
         return false;
 
     WrapPosition(posX, posY);
+    TravelCommandBuffer *travelCommandBuffer = TravelCommandBuffer::GetActive();
     unsigned char materialID = _getpixel(m_pCurrentScene->GetTerrain()->GetMaterialBitmap(), posX, posY);
-    if (materialID == g_MaterialAir)
+    if (materialID == g_MaterialAir || (travelCommandBuffer && travelCommandBuffer->IsTerrainPixelRemoved(posX, posY)))
     {
 //        RTEAbort("Why are we penetrating air??");
         return true;
@@ -888,6 +898,17 @@ bool SceneMan::TryPenetrate(int posX,
     // Test if impulse force is enough to penetrate
     if (sqrImpMag >= (sceneMat->GetIntegrity() * sceneMat->GetIntegrity()))
     {
+        // When traveling in parallel, only the outcome for the traveling particle is decided here. The terrain changes and debris are applied later, in order, on the main thread.
+        if (travelCommandBuffer) {
+            if (numPenetrations <= 3) { travelCommandBuffer->MarkTerrainPixelRemoved(posX, posY); }
+            travelCommandBuffer->Defer([this, posX, posY, impulse, velocity, airRatio, numPenetrations, removeOrphansRadius, removeOrphansMaxArea, removeOrphansRate]() {
+                float deferredRetardation;
+                TryPenetrate(posX, posY, impulse, velocity, deferredRetardation, airRatio, numPenetrations, removeOrphansRadius, removeOrphansMaxArea, removeOrphansRate);
+            });
+            retardation = -(sceneMat->GetIntegrity() / std::sqrt(sqrImpMag));
+            return true;
+        }
+
         if (numPenetrations <= 3)
         {
             spawnMat = sceneMat->GetSpawnMaterial() ? GetMaterialFromID(sceneMat->GetSpawnMaterial()) : sceneMat;
@@ -928,7 +949,7 @@ bool SceneMan::TryPenetrate(int posX,
 // TODO: Make material IDs more robust!")
                 pixelMO->SetToHitMOs(spawnMat->GetIndex() == c_GoldMaterialID);
                 pixelMO->SetToGetHitByMOs(false);
-                g_MovableMan.AddParticle(pixelMO);
+                g_MovableMan.AddParticle(pixelMO, true);
                 pixelMO = 0;
             }
             m_pCurrentScene->GetTerrain()->SetFGColorPixel(posX, posY, g_MaskColor);
@@ -983,7 +1004,7 @@ bool SceneMan::TryPenetrate(int posX,
 
 								pixelMO->SetToHitMOs(spawnMat->GetIndex() == c_GoldMaterialID);
 								pixelMO->SetToGetHitByMOs(false);
-								g_MovableMan.AddParticle(pixelMO);
+								g_MovableMan.AddParticle(pixelMO, true);
 								pixelMO = 0;
 							}
 							RemoveOrphans(posX + testY % 2 ? -1 : 1, testY, removeOrphansRadius + 5, removeOrphansMaxArea + 10, true);
@@ -1078,9 +1099,10 @@ bool SceneMan::LoadUnseenLayer(std::string bitmapPath, int team)
 bool SceneMan::AnythingUnseen(const int team)
 {
     RTEAssert(m_pCurrentScene, "Checking scene before the scene exists when checking if anything is unseen!");
+	if (team < Activity::TeamOne || team >= Activity::MaxTeamCount)
+		return false;
 
-    return m_pCurrentScene->GetUnseenLayer(team) != 0;
-// TODO: Actually check all pixels on the map too?
+    return m_pCurrentScene->AnythingUnseen(team);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1113,7 +1135,7 @@ bool SceneMan::IsUnseen(const int posX, const int posY, const int team)
         Vector scale = pUnseenLayer->GetScaleFactor();
         int scaledX = posX / scale.m_X;
         int scaledY = posY / scale.m_Y;
-        return getpixel(pUnseenLayer->GetBitmap(), scaledX, scaledY) != g_MaskColor;
+        return m_pCurrentScene->IsUnseenPixel(scaledX, scaledY, team);
     }
 
     return false;
@@ -1135,14 +1157,9 @@ bool SceneMan::RevealUnseen(const int posX, const int posY, const int team)
         int scaledX = posX / scale.m_X;
         int scaledY = posY / scale.m_Y;
 
-        // Make sure we're actually revealing an unseen pixel that is ON the bitmap!
-        int pixel = getpixel(pUnseenLayer->GetBitmap(), scaledX, scaledY);
-        if (pixel != g_MaskColor && pixel != -1)
+        // Make sure we're actually revealing an unseen pixel that is ON the bitmap! The Scene adds it to the seen pixels so it can be visually flashed.
+        if (m_pCurrentScene->RevealUnseenPixel(scaledX, scaledY, team))
         {
-            // Add the pixel to the list of now seen pixels so it can be visually flashed
-            m_pCurrentScene->GetSeenPixels(team).push_back(Vector(scaledX, scaledY));
-            // Clear to key color that pixel on the map so it won't be detected as unseen again
-            putpixel(pUnseenLayer->GetBitmap(), scaledX, scaledY, g_MaskColor);
             // Play the reveal sound, if there's not too many already revealed this frame
             if (g_SettingsMan.BlipOnRevealUnseen() && m_pUnseenRevealSound && m_pCurrentScene->GetSeenPixels(team).size() < 5)
                 m_pUnseenRevealSound->Play(Vector(posX, posY));
@@ -1170,14 +1187,9 @@ bool SceneMan::RestoreUnseen(const int posX, const int posY, const int team)
         int scaledX = posX / scale.m_X;
         int scaledY = posY / scale.m_Y;
 
-        // Make sure we're actually revealing an unseen pixel that is ON the bitmap!
-        int pixel = getpixel(pUnseenLayer->GetBitmap(), scaledX, scaledY);
-        if (pixel != g_BlackColor && pixel != -1)
+        // Make sure we're actually hiding a seen pixel that is ON the bitmap!
+        if (m_pCurrentScene->RestoreUnseenPixel(scaledX, scaledY, team))
         {
-            // Add the pixel to the list of now seen pixels so it can be visually flashed
-            m_pCurrentScene->GetSeenPixels(team).push_back(Vector(scaledX, scaledY));
-            // Clear to key color that pixel on the map so it won't be detected as unseen again
-            putpixel(pUnseenLayer->GetBitmap(), scaledX, scaledY, g_BlackColor);
             // Play the reveal sound, if there's not too many already revealed this frame
             //if (g_SettingsMan.BlipOnRevealUnseen() && m_pUnseenRevealSound && m_pCurrentScene->GetSeenPixels(team).size() < 5)
             //    m_pUnseenRevealSound->Play(g_SceneMan.TargetDistanceScalar(Vector(posX, posY)));
@@ -1208,7 +1220,7 @@ void SceneMan::RevealUnseenBox(const int posX, const int posY, const int width,
         int scaledH = height / scale.m_Y;
 
         // Fill the box
-        rectfill(pUnseenLayer->GetBitmap(), scaledX, scaledY, scaledX + scaledW, scaledY + scaledH, g_MaskColor);
+        m_pCurrentScene->RevealUnseenBox(scaledX, scaledY, scaledX + scaledW, scaledY + scaledH, team);
     }
 }
 
@@ -1231,7 +1243,7 @@ void SceneMan::RestoreUnseenBox(const int posX, const int posY, const int width,
         int scaledH = height / scale.m_Y;
 
         // Fill the box
-        rectfill(pUnseenLayer->GetBitmap(), scaledX, scaledY, scaledX + scaledW, scaledY + scaledH, g_BlackColor);
+        m_pCurrentScene->RestoreUnseenBox(scaledX, scaledY, scaledX + scaledW, scaledY + scaledH, team);
     }
 }
 
@@ -2730,8 +2742,6 @@ void SceneMan::Update(int screenId) {
 		return;
 	}
 
-	m_LastUpdatedScreen = screenId;
-
 	// Update the scene, only if doing the first screen, since it only needs done once per update.
 	if (screenId == 0) {
 		m_pCurrentScene->Update();
@@ -2752,9 +2762,13 @@ void SceneMan::Update(int screenId) {
 
 	// Background layers may scroll in fractions of the real offset and need special care to avoid jumping after having traversed wrapped edges, so they need the total offset without taking wrapping into account.
     const Vector &unwrappedOffset = g_CameraMan.GetUnwrappedOffset(screenId);
+	ScreenLayerOffsets &screenLayerOffsets = m_ScreenLayerOffsets[screenId];
+	screenLayerOffsets.Offset = offset;
+	screenLayerOffsets.BackgroundLayerOffsets.clear();
 	for (SLBackground *backgroundLayer : m_pCurrentScene->GetBackLayers()) {
 		backgroundLayer->SetOffset(unwrappedOffset);
 		backgroundLayer->Update();
+		screenLayerOffsets.BackgroundLayerOffsets.emplace_back(backgroundLayer->GetOffset());
 	}
 
 	// Update the unseen obstruction layer for this team's screen view, if there is one.
@@ -2771,11 +2785,8 @@ void SceneMan::Update(int screenId) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void SceneMan::Draw(BITMAP *targetBitmap, BITMAP *targetGUIBitmap, const Vector &targetPos, bool skipBackgroundLayers, bool skipTerrain) {
-	if (!m_pCurrentScene) {
-		return;
-	}
-	SLTerrain *terrain = m_pCurrentScene->GetTerrain();
+Box SceneMan::GetScreenTargetBox(const BITMAP *targetBitmap) const {
+	const SLTerrain *terrain = m_pCurrentScene->GetTerrain();
 	// Set up the target box to draw to on the target bitmap, if it is larger than the scene in either dimension.
 	Box targetBox(Vector(), static_cast<float>(targetBitmap->w), static_cast<float>(targetBitmap->h));
 
@@ -2787,49 +2798,71 @@ void SceneMan::Draw(BITMAP *targetBitmap, BITMAP *targetGUIBitmap, const Vector
 		targetBox.SetCorner(Vector(targetBox.GetCorner().GetX(), static_cast<float>((targetBitmap->h - GetSceneHeight()) / 2)));
 		targetBox.SetHeight(static_cast<float>(GetSceneHeight()));
 	}
+	return targetBox;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SceneMan::DrawLayers(int screenId, BITMAP *targetBitmap, bool skipBackgroundLayers, bool skipTerrain) const {
+	if (!m_pCurrentScene) {
+		return;
+	}
+	const SLTerrain *terrain = m_pCurrentScene->GetTerrain();
+	const ScreenLayerOffsets &screenLayerOffsets = m_ScreenLayerOffsets[screenId];
+	Box targetBox = GetScreenTargetBox(targetBitmap);
 
 	switch (m_LayerDrawMode) {
 		case LayerDrawMode::g_LayerTerrainMatter:
-			terrain->SetLayerToDraw(SLTerrain::LayerType::MaterialLayer);
-			terrain->Draw(targetBitmap, targetBox);
+			terrain->DrawLayer(SLTerrain::LayerType::MaterialLayer, targetBitmap, targetBox, screenLayerOffsets.Offset);
 			break;
 #ifdef DRAW_MOID_LAYER
 		case LayerDrawMode::g_LayerMOID:
-			m_pMOIDLayer->Draw(targetBitmap, targetBox);
+			m_pMOIDLayer->Draw(targetBitmap, targetBox, screenLayerOffsets.Offset);
 			break;
 #endif
 		default:
 			if (!skipBackgroundLayers) {
-				for (std::list<SLBackground *>::reverse_iterator backgroundLayer = m_pCurrentScene->GetBackLayers().rbegin(); backgroundLayer != m_pCurrentScene->GetBackLayers().rend(); ++backgroundLayer) {
-					(*backgroundLayer)->Draw(targetBitmap, targetBox);
+				const std::list<SLBackground *> &backgroundLayers = m_pCurrentScene->GetBackLayers();
+				int backgroundLayerIndex = static_cast<int>(backgroundLayers.size()) - 1;
+				for (std::list<SLBackground *>::const_reverse_iterator backgroundLayer = backgroundLayers.crbegin(); backgroundLayer != backgroundLayers.crend(); ++backgroundLayer, --backgroundLayerIndex) {
+					// Layers added since the last Update of this screen have no offset recorded yet, so they're only drawn from the next frame on.
+					if (backgroundLayerIndex < static_cast<int>(screenLayerOffsets.BackgroundLayerOffsets.size())) { (*backgroundLayer)->Draw(targetBitmap, targetBox, screenLayerOffsets.BackgroundLayerOffsets[backgroundLayerIndex]); }
 				}
 			}
-			if (!skipTerrain) {
-				terrain->SetLayerToDraw(SLTerrain::LayerType::BackgroundLayer);
-				terrain->Draw(targetBitmap, targetBox);
-			}
-			m_pMOColorLayer->Draw(targetBitmap, targetBox);
+			if (!skipTerrain) { terrain->DrawLayer(SLTerrain::LayerType::BackgroundLayer, targetBitmap, targetBox, screenLayerOffsets.Offset); }
+
+			m_pMOColorLayer->Draw(targetBitmap, targetBox, screenLayerOffsets.Offset);
+
+			if (!skipTerrain) { terrain->DrawLayer(SLTerrain::LayerType::ForegroundLayer, targetBitmap, targetBox, screenLayerOffsets.Offset); }
 
-			if (!skipTerrain) {
-				terrain->SetLayerToDraw(SLTerrain::LayerType::ForegroundLayer);
-				terrain->Draw(targetBitmap, targetBox);
-			}
             if (!g_FrameMan.IsInMultiplayerMode()) {
-                int teamId = g_CameraMan.GetScreenTeam(m_LastUpdatedScreen);
-				if (SceneLayer *unseenLayer = (teamId != Activity::NoTeam) ? m_pCurrentScene->GetUnseenLayer(teamId) : nullptr) {
-                    unseenLayer->Draw(targetBitmap, targetBox);
+                int teamId = g_CameraMan.GetScreenTeam(screenId);
+				if (const SceneLayer *unseenLayer = (teamId != Activity::NoTeam) ? m_pCurrentScene->GetUnseenLayer(teamId) : nullptr) {
+                    unseenLayer->Draw(targetBitmap, targetBox, screenLayerOffsets.Offset);
                 }
 			}
+			break;
+	}
+}
 
-			g_MovableMan.DrawHUD(targetGUIBitmap, targetPos, m_LastUpdatedScreen);
-			g_PrimitiveMan.DrawPrimitives(m_LastUpdatedScreen, targetGUIBitmap, targetPos);
-			g_ActivityMan.GetActivity()->DrawGUI(targetGUIBitmap, targetPos, m_LastUpdatedScreen);
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-			if (m_pDebugLayer) {
-                m_pDebugLayer->Draw(targetBitmap, targetBox);
-            }
+void SceneMan::DrawGUI(int screenId, BITMAP *targetBitmap, BITMAP *targetGUIBitmap, const Vector &targetPos) {
+	if (!m_pCurrentScene || m_LayerDrawMode == LayerDrawMode::g_LayerTerrainMatter) {
+		return;
+	}
+#ifdef DRAW_MOID_LAYER
+	if (m_LayerDrawMode == LayerDrawMode::g_LayerMOID) {
+		return;
+	}
+#endif
+	g_MovableMan.DrawHUD(targetGUIBitmap, targetPos, screenId);
+	g_PrimitiveMan.DrawPrimitives(screenId, targetGUIBitmap, targetPos);
+	g_ActivityMan.GetActivity()->DrawGUI(targetGUIBitmap, targetPos, screenId);
 
-			break;
+	if (m_pDebugLayer) {
+		Box targetBox = GetScreenTargetBox(targetBitmap);
+		m_pDebugLayer->Draw(targetBitmap, targetBox, m_ScreenLayerOffsets[screenId].Offset);
 	}
 }
 
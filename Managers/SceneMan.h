@@ -712,7 +712,8 @@ public:
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          AnythingUnseen
 //////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Tells whether a team has anything still unseen on the scene.
+// Description:     Tells whether a team has anything still unseen on the scene. This is
+//                  kept as a running count, so it's cheap to check before casting rays.
 // Arguments:       The team we're talking about.
 // Return value:    A bool indicating whether that team has anyhting yet unseen.
 
@@ -1331,7 +1332,8 @@ public:
 // Method:          Update
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Updates the state of this SceneMan. Supposed to be done every frame
-//                  before drawing.
+//                  before drawing. The layer offsets of the screen are kept so the
+//                  screen can be drawn after other screens were updated.
 // Arguments:       Which screen to update for.
 // Return value:    None.
 
@@ -1339,17 +1341,34 @@ public:
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Draw
+// Method:          DrawLayers
 //////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Draws this SceneMan's current graphical representation to a
-//                  BITMAP of choice.
-// Arguments:       A pointer to a BITMAP to draw on, appropriately sized for the split
+// Description:     Draws the scene layers of a screen, as scrolled during the last
+//                  Update of that screen, to a BITMAP of choice. Only reads shared
+//                  state, so different screens can be drawn concurrently.
+// Arguments:       Which screen to draw the layers of.
+//                  A pointer to a BITMAP to draw on, appropriately sized for the split
 //                  screen segment.
+//                  Whether to skip drawing the background layers.
+//                  Whether to skip drawing the terrain.
+// Return value:    None.
+
+	void DrawLayers(int screenId, BITMAP *targetBitmap, bool skipBackgroundLayers = false, bool skipTerrain = false) const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawGUI
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws the HUDs, primitives and activity GUI of a screen on top of
+//                  its scene layers. Must be called from the main thread.
+// Arguments:       Which screen to draw the GUI of.
+//                  A pointer to the BITMAP the layers of the screen were drawn on.
+//                  A pointer to a BITMAP to draw the GUI on.
 //                  The offset into the scene where the target bitmap's upper left corner
 //                  is located.
 // Return value:    None.
 
-	void Draw(BITMAP *targetBitmap, BITMAP *targetGUIBitmap,  const Vector &targetPos = Vector(), bool skipBackgroundLayers = false, bool skipTerrain = false);
+	void DrawGUI(int screenId, BITMAP *targetBitmap, BITMAP *targetGUIBitmap, const Vector &targetPos = Vector());
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1466,8 +1485,15 @@ public:
     bool m_DrawRayCastVisualizations; //!< Whether to visibly draw RayCasts to the Scene debug Bitmap.
     bool m_DrawPixelCheckVisualizations; //!< Whether to visibly draw pixel checks (GetTerrMatter and GetMOIDPixel) to the Scene debug Bitmap.
 
-    // The last screen everything has been updated to
-    int m_LastUpdatedScreen;
+    /// <summary>
+    /// The offsets the layers of a screen were scrolled to during the last Update of that screen.
+    /// </summary>
+    struct ScreenLayerOffsets {
+        Vector Offset; //!< The offset of the terrain, MO and unseen layers.
+        std::vector<Vector> BackgroundLayerOffsets; //!< The offsets of the background layers, in the order of the Scene's background layer list.
+    };
+
+    std::array<ScreenLayerOffsets, c_MaxScreenCount> m_ScreenLayerOffsets; //!< The layer offsets of each screen.
     // Whether we're in second pass of the structural computations.
     // Second pass is where structurally unsound areas of the Terrain are turned into
     // MovableObject:s.
@@ -1492,6 +1518,13 @@ private:
 
 	static const std::string c_ClassName; //!< A string with the friendly-formatted type name of this object.
 
+	/// <summary>
+	/// Gets the box on a screen's target bitmap that the scene is drawn within. The scene is centered on the bitmap in dimensions where the bitmap is larger than a non-wrapping scene.
+	/// </summary>
+	/// <param name="targetBitmap">The bitmap the screen is drawn to.</param>
+	/// <returns>The box on the target bitmap to draw the scene layers within.</returns>
+	Box GetScreenTargetBox(const BITMAP *targetBitmap) const;
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Clear
 //////////////////////////////////////////////////////////////////////////////////////////
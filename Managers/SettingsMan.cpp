@@ -2,6 +2,7 @@
 #include "ConsoleMan.h"
 #include "CameraMan.h"
 #include "MovableMan.h"
+#include "MOSRotating.h"
 #include "WindowMan.h"
 #include "FrameMan.h"
 #include "PostProcessMan.h"
@@ -52,6 +53,7 @@ namespace RTE {
 		m_DisableFactionBuyMenuThemes = false;
 		m_DisableFactionBuyMenuThemeCursors = false;
 		m_PathFinderGridNodeSize = c_PPM;
+		m_PathFinderChunkSize = 0;
 		m_AIUpdateInterval = 2;
 
 		m_SkipIntro = false;
@@ -169,10 +171,14 @@ namespace RTE {
 		MatchProperty("DisableFactionBuyMenuThemes", { reader >> m_DisableFactionBuyMenuThemes; });
 		MatchProperty("DisableFactionBuyMenuThemeCursors", { reader >> m_DisableFactionBuyMenuThemeCursors; });
 		MatchProperty("PathFinderGridNodeSize", { reader >> m_PathFinderGridNodeSize; });
+		MatchProperty("PathFinderChunkSize", { reader >> m_PathFinderChunkSize; });
 		MatchProperty("EnableMultithreadedLua", { reader >> m_EnableMultithreadedLua; });
 		MatchProperty("AIUpdateInterval", { reader >> m_AIUpdateInterval; });
 		MatchProperty("EnableParticleSettling", { reader >> g_MovableMan.m_SettlingEnabled; });
 		MatchProperty("EnableMOSubtraction", { reader >> g_MovableMan.m_MOSubtractionEnabled; });
+		MatchProperty("EnableParallelParticleTravel", { reader >> g_MovableMan.m_ParallelParticleTravelEnabled; });
+		MatchProperty("EnablePixelParticleStore", { reader >> g_MovableMan.m_PixelParticleStoreEnabled; });
+		MatchProperty("RotatedSpriteCacheSizeMB", { MOSRotating::GetRotatedSpriteCache().SetMemoryLimit(static_cast<size_t>(std::max(std::stoi(reader.ReadPropValue()), 0)) * 1024 * 1024); });
 		MatchProperty("DeltaTime", { g_TimerMan.SetDeltaTimeSecs(std::stof(reader.ReadPropValue())); });
 		MatchProperty("RealToSimCap", { g_TimerMan.SetRealToSimCap(std::stof(reader.ReadPropValue())); });
 		MatchProperty("AllowSavingToBase", { reader >> m_AllowSavingToBase; });
@@ -316,9 +322,13 @@ namespace RTE {
 		writer.NewPropertyWithValue("DisableFactionBuyMenuThemes", m_DisableFactionBuyMenuThemes);
 		writer.NewPropertyWithValue("DisableFactionBuyMenuThemeCursors", m_DisableFactionBuyMenuThemeCursors);
 		writer.NewPropertyWithValue("PathFinderGridNodeSize", m_PathFinderGridNodeSize);
+		writer.NewPropertyWithValue("PathFinderChunkSize", m_PathFinderChunkSize);
 		writer.NewPropertyWithValue("AIUpdateInterval", m_AIUpdateInterval);
 		writer.NewPropertyWithValue("EnableParticleSettling", g_MovableMan.m_SettlingEnabled);
 		writer.NewPropertyWithValue("EnableMOSubtraction", g_MovableMan.m_MOSubtractionEnabled);
+		writer.NewPropertyWithValue("EnableParallelParticleTravel", g_MovableMan.m_ParallelParticleTravelEnabled);
+		writer.NewPropertyWithValue("EnablePixelParticleStore", g_MovableMan.m_PixelParticleStoreEnabled);
+		writer.NewPropertyWithValue("RotatedSpriteCacheSizeMB", static_cast<int>(MOSRotating::GetRotatedSpriteCache().GetMemoryLimit() / (1024 * 1024)));
 		writer.NewPropertyWithValue("DeltaTime", g_TimerMan.GetDeltaTimeSecs());
 		writer.NewPropertyWithValue("RealToSimCap", g_TimerMan.GetRealToSimCap());
 		
@@ -117,6 +117,12 @@ namespace RTE {
 		/// <returns>The PathFinder grid node size.</returns>
 		int GetPathFinderGridNodeSize() const { return m_PathFinderGridNodeSize; }
 
+		/// <summary>
+		/// Gets the PathFinder chunk size, which long paths are solved through before being refined on the grid.
+		/// </summary>
+		/// <returns>The PathFinder chunk size, in grid nodes. 0 means long paths are solved on the grid only.</returns>
+		int GetPathFinderChunkSize() const { return m_PathFinderChunkSize; }
+
 		/// <summary>
 		/// Returns whether or not any experimental settings are used.
 		/// </summary>
@@ -555,6 +561,7 @@ namespace RTE {
 		bool m_DisableFactionBuyMenuThemes; //!< Whether faction BuyMenu theme support is disabled.
 		bool m_DisableFactionBuyMenuThemeCursors; //!< Whether custom cursor support in faction BuyMenu themes is disabled.
 		int m_PathFinderGridNodeSize; //!< The grid size used by the PathFinder, in pixels.
+		int m_PathFinderChunkSize; //!< The chunk size used by the PathFinder to solve long paths, in grid nodes. 0 to solve them on the grid only.
 		int m_AIUpdateInterval; //!< How often actor's AI should be updated, i.e. every n simulation updates.
 
 		bool m_SkipIntro; //!< Whether to play the intro of the game or skip directly to the main menu.
@@ -1,62 +1,194 @@
-//////////////////////////////////////////////////////////////////////////////////////////
-// File:            ThreadMan.cpp
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Source file for the ThreadMan class.
-// Project:         Retro Terrain Engine
-// Author(s):       
-//                  
-//                  
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Inclusions of header files
-
-
 #include "ThreadMan.h"
 
-using namespace std;
-
-namespace RTE
-{
-
-#define DELTABUFFERSIZE 30
-
-const string ThreadMan::m_ClassName = "ThreadMan";
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Clear
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Clears all the member variables of this ThreadMan, effectively
-//                  resetting the members of this abstraction level only.
-
-void ThreadMan::Clear()
-{
-}
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Create
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Makes the ThreadMan object ready for use.
-
-int ThreadMan::Create()
-{
-
-	return 0;
+namespace RTE {
+
+	// The index of the worker the current thread is, or -1 if it isn't one of the ThreadMan's workers.
+	thread_local int s_WorkerIndex = -1;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TaskGroup::Wait() {
+		while (!IsComplete()) {
+			if (!g_ThreadMan.RunPendingTaskWhileWaiting()) {
+				// Non-workers sleep once whatever is left is already being run by the workers.
+				if (!g_ThreadMan.IsWorkerThread()) {
+					break;
+				}
+				std::this_thread::yield();
+			}
+		}
+		// Always take the lock once, so the task that completed the group is guaranteed to be done touching it before the group can be destroyed.
+		std::unique_lock<std::mutex> completionLock(m_CompletionMutex);
+		m_CompletionCondition.wait(completionLock, [this]() { return IsComplete(); });
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TaskGroup::OnTaskComplete() {
+		std::lock_guard<std::mutex> completionLock(m_CompletionMutex);
+		if (m_OutstandingTaskCount.fetch_sub(1, std::memory_order_acq_rel) == 1) { m_CompletionCondition.notify_all(); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::Clear() {
+		m_Workers.clear();
+		m_WorkerQueues.clear();
+		m_PendingTaskCount = 0;
+		m_ActiveTaskCount = 0;
+		m_NextQueueIndex = 0;
+		m_StopRequested = false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int ThreadMan::Initialize(int workerCount) {
+		if (!m_Workers.empty()) {
+			return 0;
+		}
+		if (workerCount <= 0) {
+			workerCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+		}
+		m_StopRequested = false;
+
+		m_WorkerQueues.reserve(workerCount);
+		for (int i = 0; i < workerCount; ++i) {
+			m_WorkerQueues.emplace_back(std::make_unique<WorkerQueue>());
+		}
+		m_Workers.reserve(workerCount);
+		for (int i = 0; i < workerCount; ++i) {
+			m_Workers.emplace_back(&ThreadMan::WorkerLoop, this, i);
+		}
+		return 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::Destroy() {
+		if (!m_Workers.empty()) {
+			{
+				std::lock_guard<std::mutex> wakeLock(m_WakeMutex);
+				m_StopRequested = true;
+			}
+			m_WakeCondition.notify_all();
+			for (std::thread &worker : m_Workers) {
+				worker.join();
+			}
+		}
+		Clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool ThreadMan::IsWorkerThread() const {
+		return s_WorkerIndex >= 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::WaitForAllTasks() {
+		if (IsWorkerThread()) {
+			// A worker waiting for all tasks would wait on itself, so only drain what's queued.
+			while (RunPendingTask()) {}
+			return;
+		}
+		std::unique_lock<std::mutex> wakeLock(m_WakeMutex);
+		m_IdleCondition.wait(wakeLock, [this]() { return m_ActiveTaskCount.load() == 0; });
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool ThreadMan::RunPendingTask(TaskPriority minimumPriority) {
+		Task task;
+		if (TryTakeTask(s_WorkerIndex, task, minimumPriority)) {
+			RunTask(task);
+			return true;
+		}
+		return false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::QueueTask(Task &&task, TaskPriority priority) {
+		if (m_Workers.empty()) {
+			// No pool to run on (e.g. before Initialize or after Destroy), so run synchronously rather than dropping the task.
+			task();
+			return;
+		}
+		// Tasks spawned from a worker go to its own queue so they're likely to run while the data they touch is still hot. Everything else is spread round-robin.
+		int queueIndex = s_WorkerIndex >= 0 ? s_WorkerIndex : static_cast<int>(m_NextQueueIndex.fetch_add(1, std::memory_order_relaxed) % m_WorkerQueues.size());
+		m_ActiveTaskCount.fetch_add(1, std::memory_order_relaxed);
+		{
+			WorkerQueue &workerQueue = *m_WorkerQueues[queueIndex];
+			std::lock_guard<std::mutex> queueLock(workerQueue.QueueMutex);
+			workerQueue.Tasks[static_cast<size_t>(priority)].emplace_back(std::move(task));
+		}
+		{
+			std::lock_guard<std::mutex> wakeLock(m_WakeMutex);
+			m_PendingTaskCount.fetch_add(1, std::memory_order_release);
+		}
+		m_WakeCondition.notify_one();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool ThreadMan::TryTakeTask(int workerIndex, Task &task, TaskPriority minimumPriority) {
+		if (m_PendingTaskCount.load(std::memory_order_acquire) <= 0) {
+			return false;
+		}
+		int queueCount = static_cast<int>(m_WorkerQueues.size());
+		int firstQueue = workerIndex >= 0 ? workerIndex : 0;
+
+		for (int priority = static_cast<int>(TaskPriority::PriorityCount) - 1; priority >= static_cast<int>(minimumPriority); --priority) {
+			for (int offset = 0; offset < queueCount; ++offset) {
+				int queueIndex = (firstQueue + offset) % queueCount;
+				WorkerQueue &workerQueue = *m_WorkerQueues[queueIndex];
+				std::lock_guard<std::mutex> queueLock(workerQueue.QueueMutex);
+				std::deque<Task> &tasks = workerQueue.Tasks[priority];
+				if (tasks.empty()) {
+					continue;
+				}
+				if (queueIndex == workerIndex) {
+					task = std::move(tasks.back());
+					tasks.pop_back();
+				} else {
+					task = std::move(tasks.front());
+					tasks.pop_front();
+				}
+				m_PendingTaskCount.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		return false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::RunTask(Task &task) {
+		task();
+		task = nullptr;
+		if (m_ActiveTaskCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			std::lock_guard<std::mutex> wakeLock(m_WakeMutex);
+			m_IdleCondition.notify_all();
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ThreadMan::WorkerLoop(int workerIndex) {
+		s_WorkerIndex = workerIndex;
+		Task task;
+		while (true) {
+			if (TryTakeTask(workerIndex, task)) {
+				RunTask(task);
+				continue;
+			}
+			std::unique_lock<std::mutex> wakeLock(m_WakeMutex);
+			m_WakeCondition.wait(wakeLock, [this]() { return m_StopRequested || m_PendingTaskCount.load(std::memory_order_acquire) > 0; });
+			if (m_StopRequested && m_PendingTaskCount.load(std::memory_order_acquire) <= 0) {
+				break;
+			}
+		}
+		s_WorkerIndex = -1;
+	}
 }
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Destroy
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Destroys and resets (through Clear()) the ThreadMan object.
-
-void ThreadMan::Destroy()
-{
-
-
-    Clear();
-}
-
-} // namespace RTE
\ No newline at end of file
@@ -1,141 +1,325 @@
-#ifndef _RTEThreadMan_
-#define _RTEThreadMan_
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// File:            ThreadMan.h
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Header file for the ThreadMan class.
-// Project:         Retro Terrain Engine
-// Author(s):       
-//                  
-//                  
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Inclusions of header files
-
-#include "global_types.h"
-
-
-//#include <boost/thread.hpp>
+#ifndef _RTETHREADMAN_
+#define _RTETHREADMAN_
 
 #include "Singleton.h"
-#define g_ThreadMan ThreadMan::Instance()
-
-namespace RTE
-{
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Class:           ThreadMan
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     The centralized singleton manager of all threads.
-// Parent(s):       Singleton
-// Class history:   03/29/2014  ThreadMan created.
-
-
-class ThreadMan:
-    public Singleton<ThreadMan>
-{
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Public member variable, method and friend function declarations
-
-public:
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Constructor:     ThreadMan
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Constructor method used to instantiate a ThreadMan object in system
-//                  memory. Create() should be called before using the object.
-// Arguments:       None.
-
-    ThreadMan() { Clear(); Create(); }
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Destructor:      ~ThreadMan
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Destructor method used to clean up a ThreadMan object before deletion
-//                  from system memory.
-// Arguments:       None.
-
-    virtual ~ThreadMan() { Destroy(); }
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Create
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Makes the ThreadMan object ready for use.
-// Arguments:       None.
-// Return value:    An error return value signaling sucess or any particular failure.
-//                  Anything below 0 is an error signal.
 
-    virtual int Create();
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Virtual method:  Reset
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Resets the entire ThreadMan, including its inherited members, to
-//                  their default settings or values.
-// Arguments:       None.
-// Return value:    None.
-
-    virtual void Reset() { Clear(); }
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Destroy
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Destroys and resets (through Clear()) the ThreadMan object.
-// Arguments:       None.
-// Return value:    None.
-
-    void Destroy();
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Virtual method:  GetClassName
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Gets the class name of this Entity.
-// Arguments:       None.
-// Return value:    A string with the friendly-formatted type name of this object.
-
-    virtual const std::string & GetClassName() const { return m_ClassName; }
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Protected member variable and method declarations
-
-protected:
-
-    // Member variables
-    static const std::string m_ClassName;
-
-
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Private member variable and method declarations
-
-private:
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Method:          Clear
-//////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Clears all the member variables of this ThreadMan, effectively
-//                  resetting the members of this abstraction level only.
-// Arguments:       None.
-// Return value:    None.
-
-    void Clear();
-
-    // Disallow the use of some implicit methods.
-    ThreadMan(const ThreadMan &reference);
-    ThreadMan & operator=(const ThreadMan &rhs);
-
-};
-
-} // namespace RTE
+#define g_ThreadMan ThreadMan::Instance()
 
-#endif // File
+namespace RTE {
+
+	/// <summary>
+	/// The priority of a task submitted to the ThreadMan. Higher priority tasks are always picked up before lower priority ones.
+	/// </summary>
+	enum class TaskPriority {
+		Low, //!< Background work that nothing is waiting on, e.g. saving files to disk.
+		Normal, //!< Work that is expected to complete within a few frames, e.g. pathfinding requests.
+		High, //!< Work that the simulation or rendering will block on within the current frame.
+		PriorityCount
+	};
+
+	/// <summary>
+	/// A group of tasks that can be waited on together. Tasks are added to the group through ThreadMan::Submit.
+	/// </summary>
+	class TaskGroup {
+		friend class ThreadMan;
+
+	public:
+
+		/// <summary>
+		/// Constructor method used to instantiate a TaskGroup object in system memory.
+		/// </summary>
+		TaskGroup() = default;
+
+		/// <summary>
+		/// Destructor method used to clean up a TaskGroup object before deletion from system memory. Blocks until all tasks in the group are complete.
+		/// </summary>
+		~TaskGroup() { Wait(); }
+
+		/// <summary>
+		/// Gets whether all the tasks in this TaskGroup are complete.
+		/// </summary>
+		/// <returns>Whether all the tasks in this TaskGroup are complete.</returns>
+		bool IsComplete() const { return m_OutstandingTaskCount.load(std::memory_order_acquire) == 0; }
+
+		/// <summary>
+		/// Blocks until all the tasks in this TaskGroup are complete. Pending tasks are executed while waiting, see ThreadMan::RunPendingTaskWhileWaiting.
+		/// </summary>
+		void Wait();
+
+	private:
+
+		std::atomic<int> m_OutstandingTaskCount = 0; //!< The number of tasks in this TaskGroup that haven't finished executing yet.
+		std::mutex m_CompletionMutex; //!< Mutex guarding the completion condition.
+		std::condition_variable m_CompletionCondition; //!< Condition signaled when the last outstanding task in this TaskGroup finishes.
+
+		/// <summary>
+		/// Marks one task of this TaskGroup as complete and wakes any waiters if it was the last one.
+		/// </summary>
+		void OnTaskComplete();
+
+		// Disallow the use of some implicit methods.
+		TaskGroup(const TaskGroup &reference) = delete;
+		TaskGroup & operator=(const TaskGroup &rhs) = delete;
+	};
+
+	/// <summary>
+	/// The singleton manager of the persistent worker thread pool. Work is distributed over per-worker queues, and idle workers steal from each other.
+	/// </summary>
+	class ThreadMan : public Singleton<ThreadMan> {
+
+	public:
+
+		/// <summary>
+		/// Type-erased task that can be queued on the ThreadMan.
+		/// </summary>
+		using Task = std::function<void()>;
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a ThreadMan object in system memory. Initialize() should be called before using the object.
+		/// </summary>
+		ThreadMan() { Clear(); }
+
+		/// <summary>
+		/// Makes the ThreadMan object ready for use, spawning the worker threads.
+		/// </summary>
+		/// <param name="workerCount">The number of worker threads to spawn. 0 means one less than the number of hardware threads, to leave the main thread its own core.</param>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+		int Initialize(int workerCount = 0);
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Destructor method used to clean up a ThreadMan object before deletion from system memory.
+		/// </summary>
+		~ThreadMan() { Destroy(); }
+
+		/// <summary>
+		/// Destroys and resets (through Clear()) the ThreadMan object. All queued tasks are run to completion before the workers are joined.
+		/// </summary>
+		void Destroy();
+#pragma endregion
+
+#pragma region Getters
+		/// <summary>
+		/// Gets the number of worker threads in the pool.
+		/// </summary>
+		/// <returns>The number of worker threads in the pool.</returns>
+		int GetWorkerCount() const { return static_cast<int>(m_Workers.size()); }
+
+		/// <summary>
+		/// Gets the number of tasks that are queued but haven't been picked up by a worker yet.
+		/// </summary>
+		/// <returns>The number of queued tasks.</returns>
+		int GetPendingTaskCount() const { return m_PendingTaskCount.load(std::memory_order_relaxed); }
+
+		/// <summary>
+		/// Gets whether the calling thread is one of the ThreadMan's workers.
+		/// </summary>
+		/// <returns>Whether the calling thread is one of the ThreadMan's workers.</returns>
+		bool IsWorkerThread() const;
+#pragma endregion
+
+#pragma region Task Submission
+		/// <summary>
+		/// Queues a callable to be run on the worker pool.
+		/// </summary>
+		/// <param name="callable">The callable to run. Must be invocable with no arguments.</param>
+		/// <param name="priority">The priority of the task.</param>
+		/// <returns>A future that can be used to wait on the task and retrieve its result.</returns>
+		template <typename Callable>
+		std::future<std::invoke_result_t<std::decay_t<Callable>>> Submit(Callable &&callable, TaskPriority priority = TaskPriority::Normal) {
+			using ResultType = std::invoke_result_t<std::decay_t<Callable>>;
+
+			// std::function requires copyable targets, so the move-only packaged_task is shared instead.
+			auto packagedTask = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Callable>(callable));
+			std::future<ResultType> future = packagedTask->get_future();
+			QueueTask([packagedTask]() { (*packagedTask)(); }, priority);
+			return future;
+		}
+
+		/// <summary>
+		/// Queues a callable to be run on the worker pool as part of a TaskGroup.
+		/// </summary>
+		/// <param name="taskGroup">The TaskGroup the task belongs to. Must outlive the task.</param>
+		/// <param name="callable">The callable to run. Must be invocable with no arguments.</param>
+		/// <param name="priority">The priority of the task.</param>
+		template <typename Callable>
+		void Submit(TaskGroup &taskGroup, Callable &&callable, TaskPriority priority = TaskPriority::Normal) {
+			taskGroup.m_OutstandingTaskCount.fetch_add(1, std::memory_order_relaxed);
+			QueueTask([&taskGroup, task = std::forward<Callable>(callable)]() mutable {
+				task();
+				taskGroup.OnTaskComplete();
+			}, priority);
+		}
+
+		/// <summary>
+		/// Runs a function over the index range [begin, end) split into chunks across the worker pool, and blocks until all chunks are complete.
+		/// Chunks are handed out through a shared index, so the calling thread processes any chunks the workers haven't gotten to, even if they're all busy with other work.
+		/// </summary>
+		/// <param name="begin">The first index of the range.</param>
+		/// <param name="end">One past the last index of the range.</param>
+		/// <param name="function">The function to run for each index. Must be invocable with a single int argument.</param>
+		/// <param name="chunkSize">The number of indices processed per chunk. 0 means the range is split evenly between the workers and the calling thread.</param>
+		/// <param name="priority">The priority of the tasks that let the workers help with the chunks.</param>
+		template <typename Function>
+		void ParallelFor(int begin, int end, const Function &function, int chunkSize = 0, TaskPriority priority = TaskPriority::High) {
+			int count = end - begin;
+			if (count <= 0) {
+				return;
+			}
+			if (chunkSize <= 0) {
+				chunkSize = std::max(1, count / (GetWorkerCount() + 1));
+			}
+			if (m_Workers.empty() || count <= chunkSize) {
+				for (int i = begin; i < end; ++i) {
+					function(i);
+				}
+				return;
+			}
+			std::shared_ptr<ParallelForChunks> chunks = std::make_shared<ParallelForChunks>();
+			chunks->ChunkCount = (count + chunkSize - 1) / chunkSize;
+			auto runChunks = [&function, begin, end, chunkSize](ParallelForChunks &chunks) {
+				for (int chunkIndex = chunks.NextChunkIndex.fetch_add(1, std::memory_order_relaxed); chunkIndex < chunks.ChunkCount; chunkIndex = chunks.NextChunkIndex.fetch_add(1, std::memory_order_relaxed)) {
+					int chunkBegin = begin + chunkIndex * chunkSize;
+					int chunkEnd = std::min(chunkBegin + chunkSize, end);
+					for (int i = chunkBegin; i < chunkEnd; ++i) {
+						function(i);
+					}
+					if (chunks.CompletedChunkCount.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks.ChunkCount) {
+						std::lock_guard<std::mutex> completionLock(chunks.CompletionMutex);
+						chunks.CompletionCondition.notify_all();
+					}
+				}
+			};
+			// The calling thread works on the chunks too, so one less helper than there are chunks is needed. Helpers that only start once all chunks are claimed return without touching the function.
+			int helperCount = std::min(GetWorkerCount(), chunks->ChunkCount - 1);
+			for (int helper = 0; helper < helperCount; ++helper) {
+				QueueTask([chunks, runChunks]() { runChunks(*chunks); }, priority);
+			}
+			runChunks(*chunks);
+
+			// Only chunks that were already claimed by a worker are waited on, never helpers that haven't started, which may be queued behind long running tasks.
+			while (chunks->CompletedChunkCount.load(std::memory_order_acquire) < chunks->ChunkCount) {
+				if (!RunPendingTaskWhileWaiting()) {
+					std::unique_lock<std::mutex> completionLock(chunks->CompletionMutex);
+					chunks->CompletionCondition.wait(completionLock, [&chunks]() { return chunks->CompletedChunkCount.load(std::memory_order_acquire) >= chunks->ChunkCount; });
+				}
+			}
+		}
+#pragma endregion
+
+#pragma region Waiting
+		/// <summary>
+		/// Blocks until the passed in future is ready. Pending tasks are executed while waiting, see RunPendingTaskWhileWaiting.
+		/// </summary>
+		/// <param name="future">The future to wait on.</param>
+		template <typename FutureType>
+		void Wait(const FutureType &future) {
+			if (!future.valid()) {
+				return;
+			}
+			while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+				if (!RunPendingTaskWhileWaiting()) {
+					if (!IsWorkerThread()) {
+						// Whatever is left is already being run by the workers, so there's nothing to do but sleep until it's done.
+						future.wait();
+						return;
+					}
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		/// <summary>
+		/// Blocks until every task queued so far has finished executing.
+		/// </summary>
+		void WaitForAllTasks();
+
+		/// <summary>
+		/// Picks up and runs a single pending task on the calling thread, if there is one.
+		/// </summary>
+		/// <param name="minimumPriority">The lowest priority of task to pick up.</param>
+		/// <returns>Whether a task was run.</returns>
+		bool RunPendingTask(TaskPriority minimumPriority = TaskPriority::Low);
+
+		/// <summary>
+		/// Picks up and runs a single pending task on a thread that's waiting on other tasks. Workers pick up any task, so the pool can't deadlock on itself.
+		/// Other threads only pick up High priority tasks, so they help with the work they're most likely waiting on instead of getting stuck in a long pathfinding solve or the like.
+		/// </summary>
+		/// <returns>Whether a task was run.</returns>
+		bool RunPendingTaskWhileWaiting() { return RunPendingTask(IsWorkerThread() ? TaskPriority::Low : TaskPriority::High); }
+#pragma endregion
+
+	private:
+
+		/// <summary>
+		/// A per-worker task queue, one deque per priority. The owning worker pops from the back, other workers steal from the front.
+		/// </summary>
+		struct WorkerQueue {
+			std::mutex QueueMutex; //!< Mutex guarding the task deques.
+			std::array<std::deque<Task>, static_cast<size_t>(TaskPriority::PriorityCount)> Tasks; //!< The queued tasks of this worker, by priority.
+		};
+
+		/// <summary>
+		/// The chunks of a ParallelFor. Shared with the tasks helping with them, as those may only start after the ParallelFor returned.
+		/// </summary>
+		struct ParallelForChunks {
+			int ChunkCount = 0; //!< The number of chunks the range is split into.
+			std::atomic<int> NextChunkIndex = 0; //!< The index of the next chunk to be claimed.
+			std::atomic<int> CompletedChunkCount = 0; //!< The number of chunks that finished running.
+			std::mutex CompletionMutex; //!< Mutex guarding the completion condition.
+			std::condition_variable CompletionCondition; //!< Condition signaled when the last chunk finishes running.
+		};
+
+		std::vector<std::thread> m_Workers; //!< The worker threads.
+		std::vector<std::unique_ptr<WorkerQueue>> m_WorkerQueues; //!< The task queue of each worker thread.
+
+		std::atomic<int> m_PendingTaskCount; //!< The number of tasks queued but not yet picked up.
+		std::atomic<int> m_ActiveTaskCount; //!< The number of tasks queued or currently executing.
+		std::atomic<unsigned int> m_NextQueueIndex; //!< Round-robin index used to distribute tasks submitted from outside the pool.
+		bool m_StopRequested; //!< Whether the workers should exit once the queues are drained.
+
+		std::mutex m_WakeMutex; //!< Mutex guarding the wake and idle conditions.
+		std::condition_variable m_WakeCondition; //!< Condition signaled when new tasks are queued or the pool is stopping.
+		std::condition_variable m_IdleCondition; //!< Condition signaled when the last active task finishes.
+
+		/// <summary>
+		/// Adds a task to a worker queue and wakes a worker to run it.
+		/// </summary>
+		/// <param name="task">The task to queue.</param>
+		/// <param name="priority">The priority of the task.</param>
+		void QueueTask(Task &&task, TaskPriority priority);
+
+		/// <summary>
+		/// Takes the highest priority task available, preferring the given worker's own queue before stealing from others.
+		/// </summary>
+		/// <param name="workerIndex">The index of the worker looking for work, or -1 if the calling thread isn't a worker.</param>
+		/// <param name="task">Output task.</param>
+		/// <param name="minimumPriority">The lowest priority of task to take.</param>
+		/// <returns>Whether a task was taken.</returns>
+		bool TryTakeTask(int workerIndex, Task &task, TaskPriority minimumPriority = TaskPriority::Low);
+
+		/// <summary>
+		/// Runs a task taken from the queues and updates the active task bookkeeping.
+		/// </summary>
+		/// <param name="task">The task to run.</param>
+		void RunTask(Task &task);
+
+		/// <summary>
+		/// The main loop of each worker thread.
+		/// </summary>
+		/// <param name="workerIndex">The index of this worker.</param>
+		void WorkerLoop(int workerIndex);
+
+		/// <summary>
+		/// Clears all the member variables of this ThreadMan, effectively resetting the members of this abstraction level only.
+		/// </summary>
+		void Clear();
+
+		// Disallow the use of some implicit methods.
+		ThreadMan(const ThreadMan &reference) = delete;
+		ThreadMan & operator=(const ThreadMan &rhs) = delete;
+	};
+}
+#endif
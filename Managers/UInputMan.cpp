@@ -947,6 +947,7 @@ namespace RTE {
 		} else if (!FlagCtrlState() && FlagAltState()) {
 			if (KeyPressed(SDLK_F2)) {
 				ContentFile::ReloadAllBitmaps();
+				MOSRotating::GetRotatedSpriteCache().Clear();
 			// Alt+Enter to switch resolution multiplier
 			} else if (KeyPressed(SDLK_RETURN)) {
 				g_WindowMan.ChangeResolutionMultiplier();
@@ -6,6 +6,7 @@
 #include "MOPixel.h"
 #include "PresetMan.h"
 #include "Actor.h"
+#include "TravelCommandBuffer.h"
 
 namespace RTE {
 
@@ -904,20 +905,20 @@ namespace RTE {
 								const float randomChoice = RandomNum(0.0f, m_Material->GetStickiness() + (ownerMOAsPixel ? ownerMOAsPixel->GetStaininess() : 0.0f));
 								if (randomChoice <= m_Material->GetStickiness()) {
 									m_OwnerMO->SetPos(Vector(intPos[X], intPos[Y]));
-									m_OwnerMO->DrawToTerrain(g_SceneMan.GetTerrain());
+									DrawOwnerToTerrain();
 									m_OwnerMO->SetToDelete(true);
 									m_LastHit.Terminate[HITOR] = hit[dom] = hit[sub] = true;
 									break;
 								} else if (MOPixel *ownerMOAsPixel = dynamic_cast<MOPixel *>(m_OwnerMO); ownerMOAsPixel && randomChoice <= m_Material->GetStickiness() + ownerMOAsPixel->GetStaininess()) {
 									Vector stickPos(intPos[X], intPos[Y]);
 									stickPos += velocity * (c_PPM * g_TimerMan.GetDeltaTimeSecs()) * RandomNum();
-									int terrainMaterialID = g_SceneMan.GetTerrain()->GetMaterialPixel(stickPos.GetFloorIntX(), stickPos.GetFloorIntY());
+									int terrainMaterialID = g_SceneMan.GetTerrMatter(stickPos.GetFloorIntX(), stickPos.GetFloorIntY());
 									if (terrainMaterialID != g_MaterialAir && terrainMaterialID != g_MaterialDoor) {
 										m_OwnerMO->SetPos(Vector(stickPos.GetRoundIntX(), stickPos.GetRoundIntY()));
 									} else {
 										m_OwnerMO->SetPos(Vector(intPos[X], intPos[Y]));
 									}
-									m_OwnerMO->DrawToTerrain(g_SceneMan.GetTerrain());
+									DrawOwnerToTerrain();
 									m_OwnerMO->SetToDelete(true);
 									m_LastHit.Terminate[HITOR] = hit[dom] = hit[sub] = true;
 									break;
@@ -1001,12 +1002,18 @@ namespace RTE {
 
 		// Draw the trail
 		if (g_TimerMan.DrawnSimUpdate() && m_TrailLength && trailPoints.size() > 0) {
+			TravelCommandBuffer *travelCommandBuffer = TravelCommandBuffer::GetActive();
+			std::vector<std::pair<int, int>> deferredTrailPoints;
 			Vector topLeftExtent = Vector(trailPoints[0].first, trailPoints[0].second);
 			Vector bottomRightExtent = topLeftExtent + Vector(1.0F, 1.0F);
 
 			int length = static_cast<int>(static_cast<float>(m_TrailLength) * RandomNum(1.0F - m_TrailLengthVariation, 1.0F));
 			for (int i = trailPoints.size() - std::min(length, static_cast<int>(trailPoints.size())); i < trailPoints.size(); ++i) {
-				putpixel(trailBitmap, trailPoints[i].first, trailPoints[i].second, m_TrailColor.GetIndex());
+				if (travelCommandBuffer) {
+					deferredTrailPoints.emplace_back(trailPoints[i]);
+				} else {
+					putpixel(trailBitmap, trailPoints[i].first, trailPoints[i].second, m_TrailColor.GetIndex());
+				}
 
 				topLeftExtent.m_X = std::min(topLeftExtent.m_X, static_cast<float>(trailPoints[i].first));
 				topLeftExtent.m_Y = std::min(topLeftExtent.m_Y, static_cast<float>(trailPoints[i].second));
@@ -1014,7 +1021,16 @@ namespace RTE {
 				bottomRightExtent.m_Y = std::max(bottomRightExtent.m_Y, static_cast<float>(trailPoints[i].second));
 			}
 
-			g_SceneMan.RegisterDrawing(trailBitmap, g_NoMOID, topLeftExtent.m_X, topLeftExtent.m_Y, bottomRightExtent.m_X + 1.0F, bottomRightExtent.m_Y + 1.0F);
+			if (travelCommandBuffer) {
+				travelCommandBuffer->Defer([trailBitmap, trailColorIndex = m_TrailColor.GetIndex(), points = std::move(deferredTrailPoints), topLeftExtent, bottomRightExtent]() {
+					for (const auto &[pointX, pointY] : points) {
+						putpixel(trailBitmap, pointX, pointY, trailColorIndex);
+					}
+					g_SceneMan.RegisterDrawing(trailBitmap, g_NoMOID, topLeftExtent.m_X, topLeftExtent.m_Y, bottomRightExtent.m_X + 1.0F, bottomRightExtent.m_Y + 1.0F);
+				});
+			} else {
+				g_SceneMan.RegisterDrawing(trailBitmap, g_NoMOID, topLeftExtent.m_X, topLeftExtent.m_Y, bottomRightExtent.m_X + 1.0F, bottomRightExtent.m_Y + 1.0F);
+			}
 		}
 
 		// Unlock all bitmaps involved.
@@ -1034,6 +1050,22 @@ namespace RTE {
 		return hitCount;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Atom::DrawOwnerToTerrain() const {
+		if (TravelCommandBuffer *travelCommandBuffer = TravelCommandBuffer::GetActive()) {
+			// The owner is flagged for deletion but isn't actually deleted until after the deferred commands are executed, so it's safe to hold on to it.
+			travelCommandBuffer->Defer([ownerMO = m_OwnerMO, drawPos = m_OwnerMO->GetPos()]() {
+				Vector finalPos = ownerMO->GetPos();
+				ownerMO->SetPos(drawPos);
+				ownerMO->DrawToTerrain(g_SceneMan.GetTerrain());
+				ownerMO->SetPos(finalPos);
+			});
+		} else {
+			m_OwnerMO->DrawToTerrain(g_SceneMan.GetTerrain());
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void HitData::Clear() {
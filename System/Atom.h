@@ -531,6 +531,11 @@ namespace RTE {
 
 		static const std::string c_ClassName; //!< A string with the friendly-formatted type name of this.
 
+		/// <summary>
+		/// Draws the owning MO to the terrain at its current position, deferring it if a TravelCommandBuffer is active.
+		/// </summary>
+		void DrawOwnerToTerrain() const;
+
 		/// <summary>
 		/// Clears all the member variables of this Atom, effectively resetting the members of this abstraction level only.
 		/// </summary>
@@ -3,6 +3,7 @@
 #include "AudioMan.h"
 #include "PresetMan.h"
 #include "ConsoleMan.h"
+#include "ThreadMan.h"
 #include "RTETools.h"
 
 #include "png.h"
@@ -16,6 +17,11 @@ namespace RTE {
 	std::array<std::unordered_map<std::string, BITMAP *>, ContentFile::BitDepths::BitDepthCount> ContentFile::s_LoadedBitmaps;
 	std::unordered_map<std::string, FMOD::Sound *> ContentFile::s_LoadedSamples;
 	std::unordered_map<size_t, std::string> ContentFile::s_PathHashes;
+	std::mutex ContentFile::s_LoadedBitmapsMutex;
+
+	std::atomic<bool> ContentFile::s_PrefetchingImages = false;
+	std::mutex ContentFile::s_PrefetchedImagesMutex;
+	std::unordered_map<std::string, std::shared_ptr<ContentFile::ImagePrefetch>> ContentFile::s_PrefetchedImages;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -53,6 +59,7 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void ContentFile::FreeAllLoaded() {
+		std::lock_guard<std::mutex> loadedBitmapsLock(s_LoadedBitmapsMutex);
 		for (int depth = BitDepths::Eight; depth < BitDepths::BitDepthCount; ++depth) {
 			for (const auto &[bitmapPath, bitmapPtr] : s_LoadedBitmaps[depth]) {
 				destroy_bitmap(bitmapPtr);
@@ -65,7 +72,10 @@ namespace RTE {
 	int ContentFile::ReadProperty(const std::string_view &propName, Reader &reader) {
 		StartPropertyList(return Serializable::ReadProperty(propName, reader));
 		
-		MatchForwards("FilePath") MatchProperty("Path", { SetDataPath(reader.ReadPropValue()); });
+		MatchForwards("FilePath") MatchProperty("Path", {
+			SetDataPath(reader.ReadPropValue());
+			if (s_PrefetchingImages) { QueueImagePrefetch(m_DataPath, m_DataPathWithoutExtension, m_DataPathExtension); }
+		});
 		
 		
 		EndPropertyList;
@@ -228,26 +238,37 @@ namespace RTE {
 		}
 
 		// Check if the file has already been read and loaded from the disk and, if so, use that data.
-		std::unordered_map<std::string, BITMAP *>::iterator foundBitmap = s_LoadedBitmaps[bitDepth].find(dataPathToLoad);
-		if (storeBitmap && foundBitmap != s_LoadedBitmaps[bitDepth].end()) {
-			returnBitmap = (*foundBitmap).second;
-		} else {
-			if (!System::PathExistsCaseSensitive(dataPathToLoad)) {
-				const std::string dataPathWithoutExtension = dataPathToLoad.substr(0, dataPathToLoad.length() - m_DataPathExtension.length());
-				const std::string altFileExtension = (m_DataPathExtension == ".png") ? ".bmp" : ".png";
-
-				if (System::PathExistsCaseSensitive(dataPathWithoutExtension + altFileExtension)) {
-					g_ConsoleMan.AddLoadWarningLogExtensionMismatchEntry(m_DataPath, m_FormattedReaderPosition, altFileExtension);
-					SetDataPath(m_DataPathWithoutExtension + altFileExtension);
-					dataPathToLoad = dataPathWithoutExtension + altFileExtension;
-				} else {
-					RTEAbort("Failed to find image file with following path and name:\n\n" + dataPathToLoad + " or " + altFileExtension + "\n" + m_FormattedReaderPosition);
-				}
+		if (storeBitmap) {
+			std::lock_guard<std::mutex> loadedBitmapsLock(s_LoadedBitmapsMutex);
+			std::unordered_map<std::string, BITMAP *>::iterator foundBitmap = s_LoadedBitmaps[bitDepth].find(dataPathToLoad);
+			if (foundBitmap != s_LoadedBitmaps[bitDepth].end()) {
+				return (*foundBitmap).second;
 			}
-			returnBitmap = LoadAndReleaseBitmap(conversionMode, dataPathToLoad); // NOTE: This takes ownership of the bitmap file
+		}
+
+		if (!System::PathExistsCaseSensitive(dataPathToLoad)) {
+			const std::string dataPathWithoutExtension = dataPathToLoad.substr(0, dataPathToLoad.length() - m_DataPathExtension.length());
+			const std::string altFileExtension = (m_DataPathExtension == ".png") ? ".bmp" : ".png";
 
-			// Insert the bitmap into the map, PASSING OVER OWNERSHIP OF THE LOADED DATAFILE
-			if (storeBitmap) { s_LoadedBitmaps[bitDepth].try_emplace(dataPathToLoad, returnBitmap); }
+			if (System::PathExistsCaseSensitive(dataPathWithoutExtension + altFileExtension)) {
+				g_ConsoleMan.AddLoadWarningLogExtensionMismatchEntry(m_DataPath, m_FormattedReaderPosition, altFileExtension);
+				SetDataPath(m_DataPathWithoutExtension + altFileExtension);
+				dataPathToLoad = dataPathWithoutExtension + altFileExtension;
+			} else {
+				RTEAbort("Failed to find image file with following path and name:\n\n" + dataPathToLoad + " or " + altFileExtension + "\n" + m_FormattedReaderPosition);
+			}
+		}
+		returnBitmap = TakePrefetchedBitmap(conversionMode, dataPathToLoad);
+		if (!returnBitmap) { returnBitmap = LoadAndReleaseBitmap(conversionMode, dataPathToLoad); } // NOTE: This takes ownership of the bitmap file
+
+		// Insert the bitmap into the map, PASSING OVER OWNERSHIP OF THE LOADED DATAFILE
+		if (storeBitmap) {
+			std::lock_guard<std::mutex> loadedBitmapsLock(s_LoadedBitmapsMutex);
+			// If the same file was loaded on another thread in the meantime, the one that made it into the map first is kept so all users share it.
+			if (auto [storedBitmap, bitmapInserted] = s_LoadedBitmaps[bitDepth].try_emplace(dataPathToLoad, returnBitmap); !bitmapInserted) {
+				destroy_bitmap(returnBitmap);
+				returnBitmap = (*storedBitmap).second;
+			}
 		}
 		return returnBitmap;
 	}
@@ -390,4 +411,197 @@ namespace RTE {
 
 		destroy_bitmap(newBitmap);
 	}
-}
\ No newline at end of file
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::StartPrefetchingImages() {
+		s_PrefetchingImages = true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::StopPrefetchingImages() {
+		// Queued prefetches check this before decoding, so the ones that haven't started yet finish right away. The ones in progress finish into their own ImagePrefetch, which is freed along with the last task or thread referencing it.
+		s_PrefetchingImages = false;
+
+		std::lock_guard<std::mutex> prefetchedImagesLock(s_PrefetchedImagesMutex);
+		s_PrefetchedImages.clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::QueueImagePrefetch(const std::string &dataPath) {
+		if (!s_PrefetchingImages) {
+			return;
+		}
+		// Resolved the same way SetDataPath does, so the prefetched images are found under the path the ContentFile will end up with.
+		std::string fullDataPath = g_PresetMan.GetFullModulePath(dataPath);
+		std::string dataPathExtension = std::filesystem::path(fullDataPath).extension().string();
+		QueueImagePrefetch(fullDataPath, fullDataPath.substr(0, fullDataPath.length() - dataPathExtension.length()), dataPathExtension);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::QueueImagePrefetch(const std::string &dataPath, const std::string &dataPathWithoutExtension, const std::string &dataPathExtension) {
+		// Only PNGs are decoded in the background, anything else is left to load_bitmap.
+		if (dataPathExtension != ".png") {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> loadedBitmapsLock(s_LoadedBitmapsMutex);
+			if (s_LoadedBitmaps[BitDepths::Eight].contains(dataPath)) {
+				return;
+			}
+		}
+		std::lock_guard<std::mutex> prefetchedImagesLock(s_PrefetchedImagesMutex);
+		if (!s_PrefetchedImages.contains(dataPath)) {
+			std::shared_ptr<ImagePrefetch> imagePrefetch = std::make_shared<ImagePrefetch>();
+			imagePrefetch->DataPath = dataPath;
+			imagePrefetch->DataPathWithoutExtension = dataPathWithoutExtension;
+			imagePrefetch->DataPathExtension = dataPathExtension;
+			// The task keeps the prefetch alive on its own, so it can't be freed from under it if prefetching is stopped in the meantime.
+			g_ThreadMan.Submit([imagePrefetch]() { PrefetchImages(*imagePrefetch); }, TaskPriority::Low);
+			s_PrefetchedImages.try_emplace(dataPath, std::move(imagePrefetch));
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::PrefetchImages(ImagePrefetch &imagePrefetch) {
+		if (imagePrefetch.DecodeClaimed.exchange(true, std::memory_order_acq_rel)) {
+			return;
+		}
+		std::vector<PrefetchedImage> prefetchedImages;
+		// NOTE: Existence is checked case insensitively here because System::PathExistsCaseSensitive isn't thread safe. GetAsBitmap still does its own checks before it takes any of the images.
+		if (s_PrefetchingImages && std::filesystem::exists(imagePrefetch.DataPath)) {
+			if (PrefetchedImage decodedImage; DecodePalettedPNG(imagePrefetch.DataPath, decodedImage)) { prefetchedImages.emplace_back(std::move(decodedImage)); }
+		}
+		char framePath[1024];
+		for (int frameNum = 0; s_PrefetchingImages; ++frameNum) {
+			std::snprintf(framePath, sizeof(framePath), "%s%03i%s", imagePrefetch.DataPathWithoutExtension.c_str(), frameNum, imagePrefetch.DataPathExtension.c_str());
+			if (!std::filesystem::exists(framePath)) {
+				break;
+			}
+			if (PrefetchedImage decodedImage; DecodePalettedPNG(framePath, decodedImage)) { prefetchedImages.emplace_back(std::move(decodedImage)); }
+		}
+		{
+			std::lock_guard<std::mutex> prefetchedImagesLock(s_PrefetchedImagesMutex);
+			imagePrefetch.Images = std::move(prefetchedImages);
+		}
+		imagePrefetch.DecodedPromise.set_value();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool ContentFile::DecodePalettedPNG(const std::string &filePath, PrefetchedImage &decodedImage) {
+		FILE *imageFile = fopen(filePath.c_str(), "rb");
+		if (!imageFile) {
+			return false;
+		}
+		std::array<uint8_t, 8> fileSignature = {};
+		if (fread(fileSignature.data(), sizeof(uint8_t), fileSignature.size(), imageFile) != fileSignature.size() || png_sig_cmp(fileSignature.data(), 0, fileSignature.size()) != 0) {
+			fclose(imageFile);
+			return false;
+		}
+		png_structp pngReadStruct = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+		png_infop pngInfo = pngReadStruct ? png_create_info_struct(pngReadStruct) : nullptr;
+		if (!pngInfo) {
+			png_destroy_read_struct(&pngReadStruct, nullptr, nullptr);
+			fclose(imageFile);
+			return false;
+		}
+		// libpng reports errors by jumping back here. The image is then left to load_bitmap, which reports the error the usual way.
+		if (setjmp(png_jmpbuf(pngReadStruct))) {
+			png_destroy_read_struct(&pngReadStruct, &pngInfo, nullptr);
+			fclose(imageFile);
+			decodedImage.Pixels.clear();
+			return false;
+		}
+		png_init_io(pngReadStruct, imageFile);
+		// Set the PNG reader to skip the first 8 bytes since we already handled them.
+		png_set_sig_bytes(pngReadStruct, fileSignature.size());
+		png_read_info(pngReadStruct, pngInfo);
+
+		bool decoded = false;
+		// load_bitmap expands paletted images with transparency information to 32 bit, so those are left to it.
+		if (png_get_color_type(pngReadStruct, pngInfo) == PNG_COLOR_TYPE_PALETTE && !png_get_valid(pngReadStruct, pngInfo, PNG_INFO_tRNS)) {
+			// Unpack 1, 2 and 4 bit indices to a byte each, same as load_bitmap does.
+			if (png_get_bit_depth(pngReadStruct, pngInfo) < 8) { png_set_packing(pngReadStruct); }
+			int passCount = png_set_interlace_handling(pngReadStruct);
+			png_read_update_info(pngReadStruct, pngInfo);
+
+			decodedImage.Width = static_cast<int>(png_get_image_width(pngReadStruct, pngInfo));
+			decodedImage.Height = static_cast<int>(png_get_image_height(pngReadStruct, pngInfo));
+			if (png_get_rowbytes(pngReadStruct, pngInfo) == static_cast<size_t>(decodedImage.Width)) {
+				decodedImage.Path = filePath;
+				decodedImage.Pixels.resize(static_cast<size_t>(decodedImage.Width) * static_cast<size_t>(decodedImage.Height));
+				// Interlaced images are read one pass at a time, each pass filling in more of the rows read by the previous one.
+				for (int pass = 0; pass < passCount; ++pass) {
+					for (int row = 0; row < decodedImage.Height; ++row) {
+						png_read_row(pngReadStruct, &decodedImage.Pixels[static_cast<size_t>(row) * static_cast<size_t>(decodedImage.Width)], nullptr);
+					}
+				}
+				decoded = true;
+			}
+		}
+		png_destroy_read_struct(&pngReadStruct, &pngInfo, nullptr);
+		fclose(imageFile);
+		return decoded;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	BITMAP * ContentFile::TakePrefetchedBitmap(int conversionMode, const std::string &dataPathToLoad) {
+		// Paletted images are only kept at 8 bit by these conversion modes, otherwise load_bitmap has to convert them using the palette.
+		if (conversionMode != COLORCONV_NONE && conversionMode != COLORCONV_REDUCE_TO_256) {
+			return nullptr;
+		}
+		std::shared_ptr<ImagePrefetch> imagePrefetch;
+		{
+			std::lock_guard<std::mutex> prefetchedImagesLock(s_PrefetchedImagesMutex);
+			if (s_PrefetchedImages.empty()) {
+				return nullptr;
+			}
+			std::unordered_map<std::string, std::shared_ptr<ImagePrefetch>>::iterator foundPrefetch = s_PrefetchedImages.find(dataPathToLoad);
+
+			// Animation frames are prefetched along with the data path they're numbered after, so look that up if the path ends with a frame number.
+			if (foundPrefetch == s_PrefetchedImages.end()) {
+				std::string_view dataPathToLoadWithoutExtension(dataPathToLoad.data(), dataPathToLoad.length() - std::filesystem::path(dataPathToLoad).extension().string().length());
+				if (dataPathToLoadWithoutExtension.length() > 3 && std::all_of(dataPathToLoadWithoutExtension.end() - 3, dataPathToLoadWithoutExtension.end(), [](char character) { return character >= '0' && character <= '9'; })) {
+					std::string animationDataPath(dataPathToLoadWithoutExtension.substr(0, dataPathToLoadWithoutExtension.length() - 3));
+					animationDataPath.append(dataPathToLoad, dataPathToLoadWithoutExtension.length());
+					foundPrefetch = s_PrefetchedImages.find(animationDataPath);
+				}
+			}
+			if (foundPrefetch == s_PrefetchedImages.end()) {
+				return nullptr;
+			}
+			imagePrefetch = (*foundPrefetch).second;
+		}
+		// The decoding task is low priority, so it may still be queued behind other work. In that case it's claimed and done right here instead of waiting for it, and the task does nothing once it comes up.
+		// Only blocks if a worker is already decoding these images.
+		PrefetchImages(*imagePrefetch);
+		g_ThreadMan.Wait(imagePrefetch->Decoded);
+
+		PrefetchedImage decodedImage;
+		{
+			std::lock_guard<std::mutex> prefetchedImagesLock(s_PrefetchedImagesMutex);
+			for (PrefetchedImage &prefetchedImage : imagePrefetch->Images) {
+				if (prefetchedImage.Path == dataPathToLoad && !prefetchedImage.Pixels.empty()) {
+					// The pixels are moved out so they're freed as soon as the BITMAP is made. Any later request for the same file goes through load_bitmap, or more likely finds the BITMAP in the static maps.
+					decodedImage = std::move(prefetchedImage);
+					break;
+				}
+			}
+		}
+		if (decodedImage.Pixels.empty()) {
+			return nullptr;
+		}
+		BITMAP *returnBitmap = create_bitmap_ex(8, decodedImage.Width, decodedImage.Height);
+		RTEAssert(returnBitmap, "Failed to create bitmap for image file with following path and name:\n\n" + dataPathToLoad);
+		for (int row = 0; row < decodedImage.Height; ++row) {
+			std::memcpy(returnBitmap->line[row], &decodedImage.Pixels[static_cast<size_t>(row) * static_cast<size_t>(decodedImage.Width)], static_cast<size_t>(decodedImage.Width));
+		}
+		return returnBitmap;
+	}
+}
@@ -183,8 +183,49 @@ namespace RTE {
 		FMOD::Sound * GetAsSound(bool abortGameForInvalidSound = true, bool asyncLoading = true);
 #pragma endregion
 
+#pragma region Image Prefetching
+		/// <summary>
+		/// Starts decoding the images of ContentFiles that are read from now on in the background, so GetAsBitmap only has to wait if that specific image isn't decoded yet. Used while loading DataModules.
+		/// </summary>
+		static void StartPrefetchingImages();
+
+		/// <summary>
+		/// Stops queuing images for decoding, cancels the ones that haven't started yet and frees any decoded images that were never used.
+		/// </summary>
+		static void StopPrefetchingImages();
+
+		/// <summary>
+		/// Queues the image at a data path to be decoded in the background before any ContentFile is read with it, e.g. while DataModules are parsed ahead of being read. Thread safe, and does nothing unless images are being prefetched.
+		/// </summary>
+		/// <param name="dataPath">The data path of the image, as it would be read into a ContentFile.</param>
+		static void QueueImagePrefetch(const std::string &dataPath);
+#pragma endregion
+
 	private:
 
+		/// <summary>
+		/// The palette indices of an image that was decoded in the background, waiting to be turned into a BITMAP.
+		/// </summary>
+		struct PrefetchedImage {
+			std::string Path; //!< The path of the image file.
+			int Width = 0; //!< The width of the image, in pixels.
+			int Height = 0; //!< The height of the image, in pixels.
+			std::vector<unsigned char> Pixels; //!< The palette index of each pixel, row by row. Emptied once the image is turned into a BITMAP.
+		};
+
+		/// <summary>
+		/// The images prefetched for a data path, decoded either by a ThreadMan worker or by the first thread that needs them before a worker got to it.
+		/// </summary>
+		struct ImagePrefetch {
+			std::string DataPath; //!< The data path of the ContentFile the images are prefetched for.
+			std::string DataPathWithoutExtension; //!< The data path without the file's extension.
+			std::string DataPathExtension; //!< The extension of the data path.
+			std::atomic<bool> DecodeClaimed = false; //!< Whether a thread has started decoding the images, so they're only ever decoded once.
+			std::promise<void> DecodedPromise; //!< Fulfilled by the thread that decoded the images once they're stored.
+			std::shared_future<void> Decoded = DecodedPromise.get_future().share(); //!< Ready once the images are decoded and stored.
+			std::vector<PrefetchedImage> Images; //!< The images that could be decoded, which can include animation frames. Guarded by s_PrefetchedImagesMutex.
+		};
+
 		/// <summary>
 		/// Enumeration for loading BITMAPs by bit depth. NOTE: This can't be lower down because s_LoadedBitmaps relies on this definition.
 		/// </summary>
@@ -200,6 +241,11 @@ namespace RTE {
 		static std::unordered_map<size_t, std::string> s_PathHashes; //!< Static map containing the hash values of paths of all loaded data files.
 		static std::array<std::unordered_map<std::string, BITMAP *>, BitDepths::BitDepthCount> s_LoadedBitmaps; //!< Static map containing all the already loaded BITMAPs and their paths for each bit depth.
 		static std::unordered_map<std::string, FMOD::Sound *> s_LoadedSamples; //!< Static map containing all the already loaded FSOUND_SAMPLEs and their paths.
+		static std::mutex s_LoadedBitmapsMutex; //!< Mutex to ensure BITMAPs can be looked up and added to the static maps from multiple threads.
+
+		static std::atomic<bool> s_PrefetchingImages; //!< Whether images of ContentFiles that are read should be queued for decoding, and whether queued images should still be decoded.
+		static std::mutex s_PrefetchedImagesMutex; //!< Mutex guarding the prefetched images map and the images in it.
+		static std::unordered_map<std::string, std::shared_ptr<ImagePrefetch>> s_PrefetchedImages; //!< Map of the data paths images were prefetched for to their prefetches.
 
 		std::string m_DataPath; //!< The path to this ContentFile's data file. In the case of an animation, this filename/name will be appended with 000, 001, 002 etc.
 		std::string m_DataPathExtension; //!< The extension of the data file of this ContentFile's path.
@@ -260,6 +306,39 @@ namespace RTE {
 		static void ReloadBitmap(const std::string &filePath, int conversionMode = 0);
 #pragma endregion
 
+#pragma region Image Prefetching Helpers
+		/// <summary>
+		/// Queues the image at a data path, or the animation frames numbered after it, to be decoded in the background if they weren't already.
+		/// </summary>
+		/// <param name="dataPath">The full data path of the image.</param>
+		/// <param name="dataPathWithoutExtension">The data path without the file's extension.</param>
+		/// <param name="dataPathExtension">The extension of the data path.</param>
+		static void QueueImagePrefetch(const std::string &dataPath, const std::string &dataPathWithoutExtension, const std::string &dataPathExtension);
+
+		/// <summary>
+		/// Decodes the image at the data path of an ImagePrefetch and all the animation frames numbered after it that exist, the same way GetAsAnimation looks for them.
+		/// Does nothing if another thread already claimed the decoding. Run on the ThreadMan workers, or inline by TakePrefetchedBitmap if no worker got to it yet.
+		/// </summary>
+		/// <param name="imagePrefetch">The ImagePrefetch to decode the images of.</param>
+		static void PrefetchImages(ImagePrefetch &imagePrefetch);
+
+		/// <summary>
+		/// Decodes a paletted PNG file into its palette indices, which is all load_bitmap keeps of it when the image stays 8 bit. Other kinds of images are left to load_bitmap.
+		/// </summary>
+		/// <param name="filePath">The path of the PNG file to decode.</param>
+		/// <param name="decodedImage">The PrefetchedImage to decode into.</param>
+		/// <returns>Whether the file was a paletted PNG and was decoded successfully.</returns>
+		static bool DecodePalettedPNG(const std::string &filePath, PrefetchedImage &decodedImage);
+
+		/// <summary>
+		/// Turns a prefetched image into a BITMAP, decoding it on the calling thread if no worker started on it yet, or waiting for the worker that did. Ownership of the BITMAP IS transferred!
+		/// </summary>
+		/// <param name="conversionMode">The Allegro color conversion mode the bitmap is being loaded with. Prefetched images are only used if it leaves them at 8 bit.</param>
+		/// <param name="dataPathToLoad">The path of the image file to get.</param>
+		/// <returns>Pointer to the BITMAP made from the prefetched image, or nullptr if there was no usable prefetched image for the path.</returns>
+		static BITMAP * TakePrefetchedBitmap(int conversionMode, const std::string &dataPathToLoad);
+#pragma endregion
+
 		/// <summary>
 		/// Clears all the member variables of this ContentFile, effectively resetting the members of this abstraction level only.
 		/// </summary>
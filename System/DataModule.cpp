@@ -26,6 +26,11 @@ namespace RTE {
 		m_PresetList.clear();
 		m_EntityList.clear();
 		m_TypeMap.clear();
+		m_ExactTypePresetMap.clear();
+		m_GroupIndexedPresets.clear();
+		m_GroupPresetIndices.clear();
+		m_GroupIndexVersion = 0;
+		m_GroupIndexIsStale = true;
 		m_MaterialMappings.fill(0);
 		m_ScanFolderContents = false;
 		m_IgnoreMissingItems = false;
@@ -46,11 +51,7 @@ namespace RTE {
 		if (progressCallback) { progressCallback(m_FileName + " " + static_cast<char>(-43) + " loading:", true); }
 
 		Reader reader;
-		std::string indexPath = g_PresetMan.GetFullModulePath(m_FileName + "/Index.ini");
-		std::string mergedIndexPath = g_PresetMan.GetFullModulePath(m_FileName + "/MergedIndex.ini");
-
-		// NOTE: This looks for the MergedIndex.ini generated by the index merger tool. The tool is mostly superseded by disabling loading visuals, but still provides some benefit.
-		if (std::filesystem::exists(mergedIndexPath)) { indexPath = mergedIndexPath; }
+		std::string indexPath = GetIndexFilePath(m_FileName);
 
 		// If the module is a mod, read only its `index.ini` to validate its SupportedGameVersion.
 		if (m_ModuleID >= g_PresetMan.GetOfficialModuleCount() && !m_IsUserdata && ReadModuleProperties(moduleName, progressCallback) >= 0) {
@@ -70,6 +71,14 @@ namespace RTE {
 		return -1;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void DataModule::ParseFiles(const std::string &moduleName) {
+		for (const std::string &contentFilePath : Reader::ParseFileTree(GetIndexFilePath(std::filesystem::path(moduleName).generic_string()))) {
+			ContentFile::QueueImagePrefetch(contentFilePath);
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool DataModule::CreateOnDiskAsUserdata(const std::string &moduleName, const std::string_view &friendlyName, bool ignoreMissingItems, bool scanFolderContents) {
@@ -250,18 +259,7 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	const Entity * DataModule::GetEntityPreset(const std::string &exactType, const std::string &instance) {
-		if (exactType.empty() || instance == "None" || instance.empty()) {
-			return nullptr;
-		}
-		if (auto classItr = m_TypeMap.find(exactType); classItr != m_TypeMap.end()) {
-			// Find an instance of that EXACT type and name; derived types are not matched
-			for (const auto &[instanceName, entity] : classItr->second) {
-				if (instanceName == instance && entity->GetClassName() == exactType) {
-					return entity;
-				}
-			}
-		}
-		return nullptr;
+		return GetEntityIfExactType(exactType, instance);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -282,6 +280,7 @@ namespace RTE {
 				entityToAdd->Clone(existingEntity);
 				// Make sure the existing one is still marked as the Original Preset
 				existingEntity->m_IsOriginalPreset = true;
+				m_GroupIndexIsStale = true;
 				// Alter the instance entry to reflect the data file location of the new definition
 				if (readFromFile != "Same") {
 					std::list<PresetEntry>::iterator itr = m_PresetList.begin();
@@ -311,6 +310,7 @@ namespace RTE {
 			m_PresetList.push_back(PresetEntry(entityClone, readFromFile != "Same" ? readFromFile : m_PresetList.back().m_FileReadFrom));
 			m_EntityList.push_back(entityClone);
 			entityAdded = AddToTypeMap(entityClone);
+			m_GroupIndexIsStale = true;
 			RTEAssert(entityAdded, "Unexpected problem while adding Entity instance \"" + entityToAdd->GetPresetName() + "\" to the type map of data module: " + m_FileName);
 		}
 		return entityAdded;
@@ -358,32 +358,55 @@ namespace RTE {
 		bool foundAny = false;
 
 		// Find either the Entity typelist that contains all entities in this DataModule, or the specific class' typelist (which will get all derived classes too).
-		if (auto classItr = m_TypeMap.find((type.empty() || type == "All") ? "Entity" : type); classItr != m_TypeMap.end()) {
-			RTEAssert(!classItr->second.empty(), "DataModule has class entry without instances in its map!?");
+		auto classItr = m_TypeMap.find((type.empty() || type == "All") ? "Entity" : type);
+		if (classItr == m_TypeMap.end()) {
+			return false;
+		}
+		RTEAssert(!classItr->second.empty(), "DataModule has class entry without instances in its map!?");
 
+		std::vector<uint64_t> groupBits;
+		bool matchAllGroups = Entity::MakeGroupBits(groups, groupBits);
+
+		if (excludeGroups || matchAllGroups) {
+			if (excludeGroups && matchAllGroups) {
+				return false;
+			}
 			for (const auto &[instanceName, entity] : classItr->second) {
-				if (excludeGroups) {
-					bool excludeEntity = false;
-					for (const std::string &group : groups) {
-						if (entity->IsInGroup(group)) {
-							excludeEntity = true;
-							break;
-						}
-					}
-					if (!excludeEntity) {
-						entityList.emplace_back(entity);
-						foundAny = true;
-					}
-				} else {
-					for (const std::string &group : groups) {
-						if (entity->IsInGroup(group)) {
-							entityList.emplace_back(entity);
-							foundAny = true;
-							break;
-						}
-					}
+				if (!excludeGroups || !entity->IsInAnyGroup(groupBits)) {
+					entityList.emplace_back(entity);
+					foundAny = true;
 				}
 			}
+			return foundAny;
+		}
+
+		UpdateGroupIndex();
+		std::shared_lock<std::shared_mutex> groupIndexLock(m_GroupIndexMutex);
+
+		// Union the posting lists of all the groups. They're in the order Entities were added, which is also the order of every typelist, so results keep the order a typelist scan would give.
+		std::vector<int> presetIndices;
+		int postingListCount = 0;
+		for (size_t word = 0; word < groupBits.size(); ++word) {
+			for (uint64_t remainingBits = groupBits[word]; remainingBits != 0; remainingBits &= remainingBits - 1) {
+				size_t groupID = word * 64 + static_cast<size_t>(std::countr_zero(remainingBits));
+				if (groupID < m_GroupPresetIndices.size() && !m_GroupPresetIndices[groupID].empty()) {
+					presetIndices.insert(presetIndices.end(), m_GroupPresetIndices[groupID].begin(), m_GroupPresetIndices[groupID].end());
+					postingListCount++;
+				}
+			}
+		}
+		if (postingListCount > 1) {
+			std::sort(presetIndices.begin(), presetIndices.end());
+			presetIndices.erase(std::unique(presetIndices.begin(), presetIndices.end()), presetIndices.end());
+		}
+
+		const Entity::ClassInfo *typeClass = (classItr->first == "Entity") ? nullptr : Entity::ClassInfo::GetClass(classItr->first);
+		for (int presetIndex : presetIndices) {
+			Entity *entity = m_GroupIndexedPresets[presetIndex];
+			if (!typeClass || entity->GetClass().IsClassOrChildClassOf(typeClass)) {
+				entityList.emplace_back(entity);
+				foundAny = true;
+			}
 		}
 		return foundAny;
 	}
@@ -460,22 +483,57 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	// TODO: This method is almost identical to GetEntityPreset, except it doesn't return a const Entity *.
+	// TODO: GetEntityPreset is just a const version of this method.
 	// Investigate if the latter needs to return const (based on what's using it) and if not, get rid of this and replace its uses. At the very least, consider renaming this
 	// See https://github.com/cortex-command-community/Cortex-Command-Community-Project-Source/issues/87
 	Entity * DataModule::GetEntityIfExactType(const std::string &exactType, const std::string &presetName) {
 		if (exactType.empty() || presetName == "None" || presetName.empty()) {
 			return nullptr;
 		}
-		if (auto classItr = m_TypeMap.find(exactType); classItr != m_TypeMap.end()) {
-			// Find an instance of that EXACT type and name; derived types are not matched
+		// Find an instance of that EXACT type and name; derived types are not matched
+		if (auto classItr = m_ExactTypePresetMap.find(exactType); classItr != m_ExactTypePresetMap.end()) {
+			if (auto presetItr = classItr->second.find(presetName); presetItr != classItr->second.end()) {
+				return presetItr->second;
+			}
+		}
+		return nullptr;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void DataModule::UpdateGroupIndex() {
+		if (std::shared_lock<std::shared_mutex> groupIndexLock(m_GroupIndexMutex); !m_GroupIndexIsStale && m_GroupIndexVersion == Entity::GetPresetGroupsVersion()) {
+			return;
+		}
+		std::unique_lock<std::shared_mutex> groupIndexLock(m_GroupIndexMutex);
+		// Another thread may have rebuilt the index while we were waiting for the lock.
+		unsigned int presetGroupsVersion = Entity::GetPresetGroupsVersion();
+		if (!m_GroupIndexIsStale && m_GroupIndexVersion == presetGroupsVersion) {
+			return;
+		}
+		m_GroupIndexIsStale = false;
+		m_GroupIndexVersion = presetGroupsVersion;
+
+		m_GroupIndexedPresets.clear();
+		for (std::vector<int> &postingList : m_GroupPresetIndices) {
+			postingList.clear();
+		}
+		if (auto classItr = m_TypeMap.find("Entity"); classItr != m_TypeMap.end()) {
+			m_GroupIndexedPresets.reserve(classItr->second.size());
 			for (const auto &[instanceName, entity] : classItr->second) {
-				if (instanceName == presetName && entity->GetClassName() == exactType) {
-					return entity;
+				int presetIndex = static_cast<int>(m_GroupIndexedPresets.size());
+				m_GroupIndexedPresets.emplace_back(entity);
+
+				const std::vector<uint64_t> &groupBits = entity->GetGroupBits();
+				for (size_t word = 0; word < groupBits.size(); ++word) {
+					for (uint64_t remainingBits = groupBits[word]; remainingBits != 0; remainingBits &= remainingBits - 1) {
+						size_t groupID = word * 64 + static_cast<size_t>(std::countr_zero(remainingBits));
+						if (groupID >= m_GroupPresetIndices.size()) { m_GroupPresetIndices.resize(groupID + 1); }
+						m_GroupPresetIndices[groupID].emplace_back(presetIndex);
+					}
 				}
 			}
 		}
-		return nullptr;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -497,9 +555,19 @@ namespace RTE {
 			// NOTE We're adding the entity to the class category list but not transferring ownership. Also, we're not checking for collisions as they're assumed to have been checked for already
 			(*classItr).second.push_back(std::pair<std::string, Entity *>(entityToAdd->GetPresetName(), entityToAdd));
 		}
+		m_ExactTypePresetMap[entityToAdd->GetClassName()].try_emplace(entityToAdd->GetPresetName(), entityToAdd);
 		return true;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::string DataModule::GetIndexFilePath(const std::string &moduleName) {
+		std::string mergedIndexPath = g_PresetMan.GetFullModulePath(moduleName + "/MergedIndex.ini");
+
+		// NOTE: This looks for the MergedIndex.ini generated by the index merger tool. The tool is mostly superseded by disabling loading visuals, but still provides some benefit.
+		return std::filesystem::exists(mergedIndexPath) ? mergedIndexPath : g_PresetMan.GetFullModulePath(moduleName + "/Index.ini");
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void DataModule::CheckSupportedGameVersion() const {
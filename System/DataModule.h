@@ -69,6 +69,13 @@ namespace RTE {
 		/// <param name="ignoreMissingItems">Whether module loader should ignore missing items in this module.</param>
 		/// <returns>Whether the DataModule was successfully created on disk.</returns>
 		static bool CreateOnDiskAsUserdata(const std::string &moduleName, const std::string_view &friendlyName, bool scanFolderContents = false, bool ignoreMissingItems = false);
+
+		/// <summary>
+		/// Parses the index file of a DataModule and all the files it includes into their property lines, and queues the images they point to for decoding, so creating the DataModule later only has to create its presets from them.
+		/// Does NOT instantiate the DataModule. Thread safe, so multiple DataModules can be parsed in parallel.
+		/// </summary>
+		/// <param name="moduleName">File/folder name of the data module, e.g. "MyMod.rte".</param>
+		static void ParseFiles(const std::string &moduleName);
 #pragma endregion
 
 #pragma region Destruction
@@ -354,11 +361,31 @@ namespace RTE {
 		/// </summary>
 		std::unordered_map<std::string, std::list<std::pair<std::string, Entity *>>> m_TypeMap;
 
+		/// <summary>
+		/// Map of exact class names to maps of preset names and the one Entity instance of that exact class and name that was read for this DataModule.
+		/// This indexes the exact-type entries of m_TypeMap, so exact type and name lookups don't have to scan the type-lists.
+		/// The Entity instances are NOT owned by this map.
+		/// </summary>
+		std::unordered_map<std::string, std::unordered_map<std::string, Entity *>> m_ExactTypePresetMap;
+
+		std::shared_mutex m_GroupIndexMutex; //!< Mutex to ensure the group index isn't rebuilt while it's being queried from another thread.
+		std::vector<Entity *> m_GroupIndexedPresets; //!< All Entity instances of the "Entity" type-list, in the same order. The Entity instances are NOT owned by this.
+		std::vector<std::vector<int>> m_GroupPresetIndices; //!< Posting lists of group IDs to the ascending indices in m_GroupIndexedPresets of the Entities in that group.
+		unsigned int m_GroupIndexVersion; //!< The preset group version the group index was built at. If it differs from Entity::GetPresetGroupsVersion, the index is stale.
+		std::atomic<bool> m_GroupIndexIsStale; //!< Whether Entity instances were added or overwritten since the group index was built.
+
 	private:
 
 		static const std::string c_ClassName; //!< A string with the friendly-formatted type name of this object.
 
 #pragma region INI Handling
+		/// <summary>
+		/// Gets the path of the index file a DataModule is created from, which is MergedIndex.ini if one exists and Index.ini otherwise.
+		/// </summary>
+		/// <param name="moduleName">File/folder name of the data module, e.g. "MyMod.rte".</param>
+		/// <returns>The full path of the index file.</returns>
+		static std::string GetIndexFilePath(const std::string &moduleName);
+
 		/// <summary>
 		/// Checks the module's supported game version against the current game version to ensure compatibility.
 		/// </summary>
@@ -383,6 +410,11 @@ namespace RTE {
 		/// <returns>Whether any Entities were found and added to the list.</returns>
 		bool GetAllOfOrNotOfGroups(std::list<Entity *> &entityList, const std::string &type, const std::vector<std::string> &groups, bool excludeGroups);
 
+		/// <summary>
+		/// Rebuilds the group posting lists from the "Entity" type-list if any Entity was added, overwritten or had its groups changed since they were last built.
+		/// </summary>
+		void UpdateGroupIndex();
+
 		/// <summary>
 		/// Checks if the type map has an instance added of a specific name and exact type.
 		/// Does not check if any parent types with that name has been added. If found, that instance is returned, otherwise 0.
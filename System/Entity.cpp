@@ -8,6 +8,29 @@ namespace RTE {
 
 	Entity::ClassInfo Entity::m_sClass("Entity");
 	Entity::ClassInfo * Entity::ClassInfo::s_ClassHead = 0;
+	int Entity::ClassInfo::s_ClassCount = 0;
+	std::atomic<unsigned int> Entity::s_PresetGroupsVersion = 0;
+
+	// Every group name an Entity was ever added to, mapped to the index of its bit in group bitsets. Names are never removed so IDs stay valid.
+	std::shared_mutex s_GroupIDsMutex;
+	std::unordered_map<std::string, int> s_GroupIDs;
+
+	// Set once the calling thread's ThreadCache is destroyed, so memory freed during the rest of thread exit goes straight to the shared pools.
+	thread_local bool s_ThreadCacheDestroyed = false;
+
+	struct Entity::ClassInfo::ThreadCache {
+		std::vector<std::vector<void *>> FreeLists; //!< The freed memory of each ClassInfo on this thread, by ClassInfo index.
+
+		/// <summary>
+		/// Hands everything this thread freed back to the shared pools when the thread exits, so other threads can use it.
+		/// </summary>
+		~ThreadCache() {
+			s_ThreadCacheDestroyed = true;
+			for (ClassInfo *itr = s_ClassHead; itr != nullptr; itr = itr->m_NextClass) {
+				if (itr->m_ClassIndex < static_cast<int>(FreeLists.size())) { itr->DrainThreadFreeList(FreeLists[itr->m_ClassIndex], 0); }
+			}
+		}
+	};
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -17,6 +40,7 @@ namespace RTE {
 		m_DefinedInModule = -1;
 		m_PresetDescription.clear();
 		m_Groups.clear();
+		m_GroupBits.clear();
 		m_RandomWeight = 100;
 	}
 
@@ -37,6 +61,7 @@ namespace RTE {
 		for (const std::string &group : reference.m_Groups) {
 			m_Groups.emplace(group);
 		}
+		m_GroupBits = reference.m_GroupBits;
 		m_RandomWeight = reference.m_RandomWeight;
 		return 0;
 	}
@@ -184,6 +209,86 @@ namespace RTE {
 		return true;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool Entity::IsInAnyGroup(const std::vector<uint64_t> &groupBits) const {
+		size_t wordCount = std::min(groupBits.size(), m_GroupBits.size());
+		for (size_t word = 0; word < wordCount; ++word) {
+			if ((groupBits[word] & m_GroupBits[word]) != 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Entity::AddToGroup(const std::string &newGroup) {
+		if (m_Groups.emplace(newGroup).second) { SetGroupBit(newGroup, true); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Entity::RemoveFromGroup(const std::string &groupToRemoveFrom) {
+		if (m_Groups.erase(groupToRemoveFrom) > 0) { SetGroupBit(groupToRemoveFrom, false); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Entity::SetGroupBit(const std::string &groupName, bool inGroup) {
+		int groupID = GetOrRegisterGroupID(groupName);
+		size_t word = static_cast<size_t>(groupID) / 64;
+		uint64_t bit = uint64_t(1) << (groupID % 64);
+
+		if (inGroup) {
+			if (m_GroupBits.size() <= word) { m_GroupBits.resize(word + 1, 0); }
+			m_GroupBits[word] |= bit;
+		} else if (word < m_GroupBits.size()) {
+			m_GroupBits[word] &= ~bit;
+		}
+		// Presets are indexed by group in their DataModules, so let the indices know they need rebuilding.
+		if (m_IsOriginalPreset) { s_PresetGroupsVersion.fetch_add(1, std::memory_order_release); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int Entity::GetOrRegisterGroupID(const std::string &groupName) {
+		if (int groupID = GetGroupID(groupName); groupID >= 0) {
+			return groupID;
+		}
+		std::unique_lock<std::shared_mutex> groupIDsLock(s_GroupIDsMutex);
+		return s_GroupIDs.try_emplace(groupName, static_cast<int>(s_GroupIDs.size())).first->second;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int Entity::GetGroupID(const std::string &groupName) {
+		std::shared_lock<std::shared_mutex> groupIDsLock(s_GroupIDsMutex);
+		auto groupIDItr = s_GroupIDs.find(groupName);
+		return groupIDItr != s_GroupIDs.end() ? groupIDItr->second : -1;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool Entity::MakeGroupBits(const std::vector<std::string> &groups, std::vector<uint64_t> &groupBits) {
+		groupBits.clear();
+		for (const std::string &group : groups) {
+			if (group == "All" || group == "Any") {
+				return true;
+			}
+			// "None" is never a match, so it must not pick up Entities that were explicitly added to a group by that name.
+			if (group == "None") {
+				continue;
+			}
+			if (int groupID = GetGroupID(group); groupID >= 0) {
+				size_t word = static_cast<size_t>(groupID) / 64;
+				if (groupBits.size() <= word) { groupBits.resize(word + 1, 0); }
+				groupBits[word] |= uint64_t(1) << (groupID % 64);
+			}
+		}
+		return false;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	Reader & operator>>(Reader &reader, Entity &operand) {
@@ -213,17 +318,25 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	Entity::ClassInfo::ClassInfo(const std::string &name, ClassInfo *parentInfo, MemoryAllocate allocFunc, MemoryDeallocate deallocFunc, Entity * (*newFunc)(), int allocBlockCount) :
+	Entity::ClassInfo::ClassInfo(const std::string &name, ClassInfo *parentInfo, MemoryAllocate allocFunc, MemoryDeallocate deallocFunc, Entity * (*newFunc)(), int allocBlockCount, size_t instanceSize) :
 		m_Name(name),
 		m_ParentInfo(parentInfo),
 		m_Allocate(allocFunc),
 		m_Deallocate(deallocFunc),
 		m_NewInstance(newFunc),
-		m_NextClass(s_ClassHead) {
+		m_NextClass(s_ClassHead),
+		m_InstancesInUse(0),
+		m_PeakInstancesInUse(0),
+		m_SlabCount(0) {
 			s_ClassHead = this;
+			m_ClassIndex = s_ClassCount++;
 
 			m_AllocatedPool.clear();
 			m_PoolAllocBlockCount = (allocBlockCount > 0) ? allocBlockCount : 10;
+
+			// Round up so every slot in a slab starts at an address malloc would have returned.
+			const size_t slotAlignment = alignof(std::max_align_t);
+			m_InstanceStride = ((instanceSize + slotAlignment - 1) / slotAlignment) * slotAlignment;
 		}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -264,10 +377,16 @@ namespace RTE {
 		// Default to the set block allocation size if fillAmount is 0
 		if (fillAmount <= 0) { fillAmount = m_PoolAllocBlockCount; }
 
-		// If concrete class, fill up the pool with pre-allocated memory blocks the size of the type
-		if (m_Allocate && fillAmount > 0) {
-			for (int i = 0; i < fillAmount; ++i) {
-				m_AllocatedPool.push_back(m_Allocate());
+		// If concrete class, carve a slab big enough for all the instances and fill up the pool with its slots. Slabs are never freed, same as the individually allocated instances weren't.
+		if (m_Allocate && m_InstanceStride > 0 && fillAmount > 0) {
+			char *slab = static_cast<char *>(std::malloc(m_InstanceStride * static_cast<size_t>(fillAmount)));
+			RTEAssert(slab, "Failed to allocate a memory pool slab for " + m_Name + "!");
+			m_SlabCount.fetch_add(1, std::memory_order_relaxed);
+
+			m_AllocatedPool.reserve(m_AllocatedPool.size() + static_cast<size_t>(fillAmount));
+			// Push in reverse so instances are handed out in address order.
+			for (int i = fillAmount - 1; i >= 0; --i) {
+				m_AllocatedPool.push_back(slab + m_InstanceStride * static_cast<size_t>(i));
 			}
 		}
 	}
@@ -285,22 +404,28 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void * Entity::ClassInfo::GetPoolMemory() {
-		std::lock_guard<std::mutex> guard(m_Mutex);
-
+	void * Entity::ClassInfo::GetPoolMemory(size_t requestedSize) {
 		RTEAssert(IsConcrete(), "Trying to get pool memory of an abstract Entity class!");
+		RTEAssert(requestedSize <= m_InstanceStride, "Trying to get pool memory of " + m_Name + " for a larger type! Subclasses need their own EntityAllocation.");
 
-		// If the pool is empty, then fill it up again with as many instances as we are set to
-		if (m_AllocatedPool.empty()) { FillPool((m_PoolAllocBlockCount > 0) ? m_PoolAllocBlockCount : 10); }
-
-		// Get the instance in the top of the pool and pop it off
-		void *foundMemory = m_AllocatedPool.back();
-		m_AllocatedPool.pop_back();
+		void *foundMemory = nullptr;
+		if (std::vector<void *> *threadFreeList = GetThreadFreeList()) {
+			if (threadFreeList->empty()) { RefillThreadFreeList(*threadFreeList); }
+			foundMemory = threadFreeList->back();
+			threadFreeList->pop_back();
+		} else {
+			std::lock_guard<std::mutex> guard(m_Mutex);
+			if (m_AllocatedPool.empty()) { FillPool(m_PoolAllocBlockCount); }
+			foundMemory = m_AllocatedPool.back();
+			m_AllocatedPool.pop_back();
+		}
 
 		RTEAssert(foundMemory, "Could not find an available instance in the pool, even after increasing its size!");
 
-		// Keep track of the number of instances passed out
-		m_InstancesInUse++;
+		// Keep track of the number of instances passed out, and the most there ever were
+		int instancesInUse = m_InstancesInUse.fetch_add(1, std::memory_order_relaxed) + 1;
+		int peakInstancesInUse = m_PeakInstancesInUse.load(std::memory_order_relaxed);
+		while (instancesInUse > peakInstancesInUse && !m_PeakInstancesInUse.compare_exchange_weak(peakInstancesInUse, instancesInUse, std::memory_order_relaxed)) {}
 
 		return foundMemory;
 	}
@@ -311,20 +436,57 @@ namespace RTE {
 		if (!returnedMemory) {
 			return 0;
 		}
-		std::lock_guard<std::mutex> guard(m_Mutex);
-		m_AllocatedPool.push_back(returnedMemory);
+		if (std::vector<void *> *threadFreeList = GetThreadFreeList()) {
+			threadFreeList->push_back(returnedMemory);
+			// Don't let one thread hoard memory that other threads are allocating, e.g. particles created on one thread and deleted on another.
+			if (threadFreeList->size() >= GetThreadBatchSize() * 2) { DrainThreadFreeList(*threadFreeList, GetThreadBatchSize()); }
+		} else {
+			std::lock_guard<std::mutex> guard(m_Mutex);
+			m_AllocatedPool.push_back(returnedMemory);
+		}
 
 		// Keep track of the number of instances passed in
-		m_InstancesInUse--;
+		return m_InstancesInUse.fetch_sub(1, std::memory_order_relaxed) - 1;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::vector<void *> * Entity::ClassInfo::GetThreadFreeList() const {
+		thread_local ThreadCache threadCache;
+		if (s_ThreadCacheDestroyed) {
+			return nullptr;
+		}
+		if (threadCache.FreeLists.size() <= static_cast<size_t>(m_ClassIndex)) { threadCache.FreeLists.resize(s_ClassCount); }
+		return &threadCache.FreeLists[m_ClassIndex];
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-		return m_InstancesInUse;
+	void Entity::ClassInfo::RefillThreadFreeList(std::vector<void *> &threadFreeList) {
+		std::lock_guard<std::mutex> guard(m_Mutex);
+		size_t batchSize = GetThreadBatchSize();
+		if (m_AllocatedPool.size() < batchSize) { FillPool(std::max(m_PoolAllocBlockCount, static_cast<int>(batchSize))); }
+
+		threadFreeList.insert(threadFreeList.end(), m_AllocatedPool.end() - batchSize, m_AllocatedPool.end());
+		m_AllocatedPool.resize(m_AllocatedPool.size() - batchSize);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Entity::ClassInfo::DrainThreadFreeList(std::vector<void *> &threadFreeList, size_t keepCount) {
+		if (threadFreeList.size() <= keepCount) {
+			return;
+		}
+		std::lock_guard<std::mutex> guard(m_Mutex);
+		m_AllocatedPool.insert(m_AllocatedPool.end(), threadFreeList.begin() + keepCount, threadFreeList.end());
+		threadFreeList.resize(keepCount);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void Entity::ClassInfo::DumpPoolMemoryInfo(const Writer &fileWriter) {
 		for (const ClassInfo *itr = s_ClassHead; itr != nullptr; itr = itr->m_NextClass) {
-			if (itr->IsConcrete()) { fileWriter.NewLineString(itr->GetName() + ": " + std::to_string(itr->m_InstancesInUse), false); }
+			if (itr->IsConcrete()) { fileWriter.NewLineString(itr->GetName() + ": " + std::to_string(itr->GetInstancesInUse()) + " live, " + std::to_string(itr->GetPeakInstancesInUse()) + " peak, " + std::to_string(itr->GetSlabCount()) + " slabs", false); }
 		}
 	}
 }
\ No newline at end of file
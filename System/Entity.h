@@ -14,10 +14,10 @@ namespace RTE {
 		Entity::ClassInfo TYPE::m_sClass(#TYPE, &PARENT::m_sClass);
 
 	#define ConcreteClassInfo(TYPE, PARENT, BLOCKCOUNT) \
-		Entity::ClassInfo TYPE::m_sClass(#TYPE, &PARENT::m_sClass, TYPE::Allocate, TYPE::Deallocate, TYPE::NewInstance, BLOCKCOUNT);
+		Entity::ClassInfo TYPE::m_sClass(#TYPE, &PARENT::m_sClass, TYPE::Allocate, TYPE::Deallocate, TYPE::NewInstance, BLOCKCOUNT, sizeof(TYPE));
 
 	#define ConcreteSubClassInfo(TYPE, SUPER, PARENT, BLOCKCOUNT) \
-		Entity::ClassInfo SUPER::TYPE::m_sClass(#TYPE, &PARENT::m_sClass, SUPER::TYPE::Allocate, SUPER::TYPE::Deallocate, SUPER::TYPE::NewInstance, BLOCKCOUNT);
+		Entity::ClassInfo SUPER::TYPE::m_sClass(#TYPE, &PARENT::m_sClass, SUPER::TYPE::Allocate, SUPER::TYPE::Deallocate, SUPER::TYPE::NewInstance, BLOCKCOUNT, sizeof(SUPER::TYPE));
 
 	/// <summary>
 	/// Convenience macro to cut down on duplicate ClassInfo methods in classes that extend Entity.
@@ -32,7 +32,7 @@ namespace RTE {
 	/// </summary>
 	/// <returns>A pointer to the newly dynamically allocated Entity. Ownership is transferred as well.</returns>
 	#define EntityAllocation(TYPE)																		\
-		static void * operator new (size_t size) { return TYPE::m_sClass.GetPoolMemory(); }				\
+		static void * operator new (size_t size) { return TYPE::m_sClass.GetPoolMemory(size); }			\
 		static void operator delete (void *instance) { TYPE::m_sClass.ReturnPoolMemory(instance); }		\
 		static void * operator new (size_t size, void *p) throw() { return p; }							\
 		static void operator delete (void *, void *) throw() {  }										\
@@ -91,7 +91,8 @@ namespace RTE {
 			/// <param name="deallocFunc">Function pointer to the raw deallocation function of memory. If the represented Entity subclass isn't concrete, pass in 0.</param>
 			/// <param name="newFunc">Function pointer to the new instance factory. If the represented Entity subclass isn't concrete, pass in 0.</param>
 			/// <param name="allocBlockCount">The number of new instances to fill the pre-allocated pool with when it runs out.</param>
-			ClassInfo(const std::string &name, ClassInfo *parentInfo = 0, MemoryAllocate allocFunc = 0, MemoryDeallocate deallocFunc = 0, Entity * (*newFunc)() = 0, int allocBlockCount = 10);
+			/// <param name="instanceSize">The size in bytes of the represented Entity subclass. If the represented Entity subclass isn't concrete, pass in 0.</param>
+			ClassInfo(const std::string &name, ClassInfo *parentInfo = 0, MemoryAllocate allocFunc = 0, MemoryDeallocate deallocFunc = 0, Entity * (*newFunc)() = 0, int allocBlockCount = 10, size_t instanceSize = 0);
 #pragma endregion
 
 #pragma region Getters
@@ -150,11 +151,31 @@ namespace RTE {
 #pragma endregion
 
 #pragma region Memory Management
+			/// <summary>
+			/// Gets the number of instances of the type described by this ClassInfo that are currently passed out from the pool.
+			/// </summary>
+			/// <returns>The number of live instances.</returns>
+			int GetInstancesInUse() const { return m_InstancesInUse.load(std::memory_order_relaxed); }
+
+			/// <summary>
+			/// Gets the highest number of instances of the type described by this ClassInfo that were ever passed out from the pool at the same time.
+			/// </summary>
+			/// <returns>The peak number of live instances.</returns>
+			int GetPeakInstancesInUse() const { return m_PeakInstancesInUse.load(std::memory_order_relaxed); }
+
+			/// <summary>
+			/// Gets the number of contiguous slabs the pool of this ClassInfo has carved its instances out of.
+			/// </summary>
+			/// <returns>The number of slabs.</returns>
+			int GetSlabCount() const { return m_SlabCount.load(std::memory_order_relaxed); }
+
 			/// <summary>
 			/// Grabs from the pre-allocated pool, an available chunk of memory the exact size of the Entity this ClassInfo represents. OWNERSHIP IS TRANSFERRED!
+			/// Memory freed on the calling thread is reused first, without taking any locks.
 			/// </summary>
+			/// <param name="requestedSize">The size operator new was called with, to catch subclasses that don't have their own pool. 0 skips the check.</param>
 			/// <returns>A pointer to the pre-allocated pool memory. OWNERSHIP IS TRANSFERRED!</returns>
-			void * GetPoolMemory();
+			void * GetPoolMemory(size_t requestedSize = 0);
 
 			/// <summary>
 			/// Returns a raw chunk of memory back to the pre-allocated available pool.
@@ -170,7 +191,7 @@ namespace RTE {
 			static void DumpPoolMemoryInfo(const Writer &fileWriter);
 
 			/// <summary>
-			/// Adds a certain number of newly allocated instances to this' pool.
+			/// Adds a certain number of newly allocated instances to this' pool, as one contiguous slab.
 			/// </summary>
 			/// <param name="fillAmount">The number of instances to fill the pool with. If 0 is specified, the set refill amount will be used.</param>
 			void FillPool(int fillAmount = 0);
@@ -199,6 +220,7 @@ namespace RTE {
 		protected:
 
 			static ClassInfo *s_ClassHead; //!< Head of unordered linked list of ClassInfos in existence.
+			static int s_ClassCount; //!< The number of ClassInfos in existence, used to hand out indices into each thread's cache.
 
 			const std::string m_Name; //!< A string with the friendly - formatted name of this ClassInfo.
 			const ClassInfo *m_ParentInfo; //!< A pointer to the parent ClassInfo.
@@ -210,11 +232,46 @@ namespace RTE {
 
 			ClassInfo *m_NextClass; //!< Next ClassInfo after this one on aforementioned unordered linked list.
 
-			std::vector<void *> m_AllocatedPool; //!< Pool of pre-allocated objects of the type described by this ClassInfo.
+			std::vector<void *> m_AllocatedPool; //!< Pool of pre-allocated objects of the type described by this ClassInfo, shared between all threads.
 			int m_PoolAllocBlockCount; //!< The number of instances to fill up the pool of this type with each time it runs dry.
-			int m_InstancesInUse; //!< The number of allocated instances passed out from the pool.
+			size_t m_InstanceStride; //!< The size of each instance's slot in a slab, which is the instance size rounded up so every slot is suitably aligned.
+			int m_ClassIndex; //!< The index of this ClassInfo in each thread's cache of freed memory.
+
+			std::atomic<int> m_InstancesInUse; //!< The number of allocated instances passed out from the pool.
+			std::atomic<int> m_PeakInstancesInUse; //!< The highest number of allocated instances passed out from the pool at the same time.
+			std::atomic<int> m_SlabCount; //!< The number of slabs allocated for the pool.
+
+			std::mutex m_Mutex; //!< Mutex to ensure multiple threads aren't moving memory in and out of the shared pool at the same time.
+
+			/// <summary>
+			/// Per-thread lists of freed memory for every ClassInfo, so most allocations and deallocations don't touch the shared pool.
+			/// </summary>
+			struct ThreadCache;
+
+			/// <summary>
+			/// Gets the calling thread's list of freed memory for this ClassInfo.
+			/// </summary>
+			/// <returns>The free list, or nullptr if the calling thread's cache was already destroyed because the thread is exiting.</returns>
+			std::vector<void *> * GetThreadFreeList() const;
+
+			/// <summary>
+			/// Moves a batch of memory chunks from the shared pool into a thread's free list, carving a new slab if the shared pool is empty.
+			/// </summary>
+			/// <param name="threadFreeList">The free list to move memory into.</param>
+			void RefillThreadFreeList(std::vector<void *> &threadFreeList);
 
-			std::mutex m_Mutex; //!< Mutex to ensure multiple things aren't grabbing/deallocating memory at the same time
+			/// <summary>
+			/// Moves memory chunks from a thread's free list back to the shared pool, so it can be used by other threads.
+			/// </summary>
+			/// <param name="threadFreeList">The free list to move memory out of.</param>
+			/// <param name="keepCount">The number of chunks to leave in the free list.</param>
+			void DrainThreadFreeList(std::vector<void *> &threadFreeList, size_t keepCount);
+
+			/// <summary>
+			/// Gets how many chunks are moved between the shared pool and a thread's free list at a time.
+			/// </summary>
+			/// <returns>The batch size.</returns>
+			size_t GetThreadBatchSize() const { return static_cast<size_t>(std::clamp(m_PoolAllocBlockCount / 2, 1, 64)); }
 
 			// Forbidding copying
 			ClassInfo(const ClassInfo &reference) = delete;
@@ -393,17 +450,58 @@ namespace RTE {
 		/// <returns>Whether this Entity is in the specified group or not.</returns>
 		bool IsInGroup(const std::string &whichGroup) const { return whichGroup == "None" ? false : (whichGroup == "All" || whichGroup == "Any" || m_Groups.contains(whichGroup)); }
 
+		/// <summary>
+		/// Gets the bitset of groups this is member of, indexed by group ID. Words past the end of the vector are all zero.
+		/// </summary>
+		/// <returns>The group membership bitset of this Entity.</returns>
+		const std::vector<uint64_t> & GetGroupBits() const { return m_GroupBits; }
+
+		/// <summary>
+		/// Gets whether this is part of any of the groups set in a group bitset, as made by MakeGroupBits.
+		/// </summary>
+		/// <param name="groupBits">The bitset of groups to check for.</param>
+		/// <returns>Whether this Entity is in any of the specified groups.</returns>
+		bool IsInAnyGroup(const std::vector<uint64_t> &groupBits) const;
+
 		/// <summary>
 		/// Adds this Entity to a new grouping.
 		/// </summary>
 		/// <param name="newGroup">A string which describes the group to add this to. Duplicates will be ignored.</param>
-		void AddToGroup(const std::string &newGroup) { m_Groups.emplace(newGroup); }
+		void AddToGroup(const std::string &newGroup);
 
 		/// <summary>
 		/// Removes this Entity from the specified grouping.
 		/// </summary>
 		/// <param name="groupToRemoveFrom">A string which describes the group to remove this from.</param>
-		void RemoveFromGroup(const std::string &groupToRemoveFrom) { m_Groups.erase(groupToRemoveFrom); }
+		void RemoveFromGroup(const std::string &groupToRemoveFrom);
+
+		/// <summary>
+		/// Gets the unique ID of a group name, registering the name if it wasn't seen before. Thread safe.
+		/// </summary>
+		/// <param name="groupName">The group name to get the ID of.</param>
+		/// <returns>The ID of the group.</returns>
+		static int GetOrRegisterGroupID(const std::string &groupName);
+
+		/// <summary>
+		/// Gets the unique ID of a group name without registering it. Thread safe.
+		/// </summary>
+		/// <param name="groupName">The group name to get the ID of.</param>
+		/// <returns>The ID of the group, or -1 if no Entity was ever added to a group with this name.</returns>
+		static int GetGroupID(const std::string &groupName);
+
+		/// <summary>
+		/// Makes a group bitset out of a list of group names. Names no Entity was ever added to, including "None", are left out.
+		/// </summary>
+		/// <param name="groups">The group names to make the bitset of.</param>
+		/// <param name="groupBits">The vector to fill with the bitset. It is cleared first.</param>
+		/// <returns>Whether any of the group names was "All" or "Any", meaning the bitset should be treated as matching every Entity.</returns>
+		static bool MakeGroupBits(const std::vector<std::string> &groups, std::vector<uint64_t> &groupBits);
+
+		/// <summary>
+		/// Gets a counter which increments every time the groups of an original preset change, so indices of preset groups can tell when they're stale.
+		/// </summary>
+		/// <returns>The current preset group version.</returns>
+		static unsigned int GetPresetGroupsVersion() { return s_PresetGroupsVersion.load(std::memory_order_acquire); }
 
 		/// <summary>
 		/// Returns random weight used in PresetMan::GetRandomBuyableOfGroupFromTech.
@@ -473,6 +571,7 @@ namespace RTE {
 		int m_DefinedInModule; //!< The DataModule ID that this was successfully added to at some point. -1 if not added to anything yet.
 
 		std::unordered_set<std::string> m_Groups; //!< List of all tags associated with this. The groups are used to categorize and organize Entities.
+		std::vector<uint64_t> m_GroupBits; //!< Bitset of the IDs of all groups in m_Groups, for fast membership tests against multiple groups.
 
 		int m_RandomWeight; //!< Random weight used when picking item using PresetMan::GetRandomBuyableOfGroupFromTech. From 0 to 100. 0 means item won't be ever picked.
 
@@ -482,6 +581,15 @@ namespace RTE {
 
 	private:
 
+		static std::atomic<unsigned int> s_PresetGroupsVersion; //!< Incremented every time the groups of an original preset change.
+
+		/// <summary>
+		/// Sets or clears the bit of a group in this Entity's group bitset.
+		/// </summary>
+		/// <param name="groupName">The name of the group to set or clear the bit of.</param>
+		/// <param name="inGroup">Whether to set or clear the bit.</param>
+		void SetGroupBit(const std::string &groupName, bool inGroup);
+
 		/// <summary>
 		/// Clears all the member variables of this Entity, effectively resetting the members of this abstraction level only.
 		/// </summary>
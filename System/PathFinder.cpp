@@ -3,36 +3,162 @@
 #include "Material.h"
 #include "Scene.h"
 #include "SceneMan.h"
+#include "ThreadMan.h"
 
 namespace RTE {
 
-	// One pathfinder per thread, lazily initialized. Shouldn't access this directly, use GetPather() instead.
-	struct MicroPatherWrapper {
-		MicroPatherWrapper() {
-			m_Instance = nullptr;
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathNode::PathNode(const Vector &pos) : Pos(pos) {
+		const Material *outOfBounds = g_SceneMan.GetMaterialFromID(MaterialColorKeys::g_MaterialOutOfBounds);
+		for (int i = 0; i < c_MaxAdjacentNodeCount; i++) {
+			AdjacentNodes[i] = nullptr;
+			AdjacentNodeBlockingMaterials[i] = outOfBounds; // Costs are infinite unless recalculated as otherwise.
 		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathFinder::PathSolver::PathSolver(const PathFinder *pathFinder) : m_PathFinder(pathFinder), m_DigStrength(0.0F), m_DigStrengthClass(-1), m_CostVersion(0), m_AllowedChunks(nullptr) {
+		// TODO: test dynamically setting the block size based on map area, with a hefty upper limit.
+		m_Pather = std::make_unique<MicroPather>(this, c_PatherBlockAllocationSize, PathNode::c_MaxAdjacentNodeCount, false);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathFinder::PathSolver::~PathSolver() = default;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::PathSolver::BeginSolving(std::shared_ptr<const CostSnapshot> costSnapshot, float digStrength) {
+		// MicroPather keeps the adjacent costs it has seen between solves, which are only still valid for the same CostSnapshot and a dig strength that can dig through the same Materials.
+		int digStrengthClass = m_PathFinder->GetDigStrengthClass(digStrength);
+		if (digStrengthClass != m_DigStrengthClass || costSnapshot->Version != m_CostVersion) {
+			m_Pather->Reset();
+			if (m_RestrictedPather) { m_RestrictedPather->Reset(); }
+			m_RestrictedPatherChunks.clear();
+			m_DigStrengthClass = digStrengthClass;
+			m_CostVersion = costSnapshot->Version;
+		}
+		m_CostSnapshot = std::move(costSnapshot);
+		m_DigStrength = digStrength;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int PathFinder::PathSolver::SolvePath(PathNode *startNode, PathNode *endNode, const std::vector<bool> *allowedChunks, std::vector<void *> *statePath, float *totalCost) {
+		if (!allowedChunks) {
+			return m_Pather->Solve(static_cast<void *>(startNode), static_cast<void *>(endNode), statePath, totalCost);
+		}
+		// Restricted solves leave out adjacent PathNodes, so their cached costs are only valid for solves restricted to the same chunks.
+		if (!m_RestrictedPather) {
+			m_RestrictedPather = std::make_unique<MicroPather>(this, c_PatherBlockAllocationSize, PathNode::c_MaxAdjacentNodeCount, false);
+		}
+		if (*allowedChunks != m_RestrictedPatherChunks) {
+			m_RestrictedPather->Reset();
+			m_RestrictedPatherChunks = *allowedChunks;
+		}
+		m_AllowedChunks = allowedChunks;
+		int result = m_RestrictedPather->Solve(static_cast<void *>(startNode), static_cast<void *>(endNode), statePath, totalCost);
+		m_AllowedChunks = nullptr;
+		return result;
+	}
 
-		~MicroPatherWrapper() {
-			delete m_Instance;
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int PathFinder::PathSolver::SolvePathThroughChunks(PathNode *startNode, PathNode *endNode, std::vector<void *> *statePath, float *totalCost) {
+		if (!m_ChunkPather) {
+			m_ChunkGraph = std::make_unique<ChunkGraph>(this);
+			m_ChunkPather = std::make_unique<MicroPather>(m_ChunkGraph.get(), c_ChunkPatherBlockAllocationSize, c_ChunkBorderCount, false);
+		}
+		// Chunk border costs are cached by the PathFinder rather than the pather, so it's cheap to start over on every solve.
+		m_ChunkPather->Reset();
+
+		int startChunkId = m_PathFinder->m_NodeChunkIds[m_PathFinder->GetNodeId(startNode)];
+		int endChunkId = m_PathFinder->m_NodeChunkIds[m_PathFinder->GetNodeId(endNode)];
+		std::vector<void *> chunkPath;
+		float chunkPathCost = 0.0F;
+		if (m_ChunkPather->Solve(ChunkGraph::ChunkIdToState(startChunkId), ChunkGraph::ChunkIdToState(endChunkId), &chunkPath, &chunkPathCost) != MicroPather::SOLVED) {
+			return MicroPather::NO_SOLUTION;
+		}
+
+		// Refine within the chunks along the route and every chunk around them, so the path isn't forced through the center PathNodes the route was solved between.
+		m_ChunkCorridor.assign(m_PathFinder->m_ChunkGridWidth * m_PathFinder->m_ChunkGridHeight, false);
+		for (void *chunkState : chunkPath) {
+			int chunkId = ChunkGraph::StateToChunkId(chunkState);
+			int chunkX = chunkId % m_PathFinder->m_ChunkGridWidth;
+			int chunkY = chunkId / m_PathFinder->m_ChunkGridWidth;
+			for (int offsetY = -1; offsetY <= 1; ++offsetY) {
+				for (int offsetX = -1; offsetX <= 1; ++offsetX) {
+					int corridorChunkId = m_PathFinder->ConvertChunkCoordsToChunkId(chunkX + offsetX, chunkY + offsetY);
+					if (corridorChunkId != -1) { m_ChunkCorridor[corridorChunkId] = true; }
+				}
+			}
 		}
+		return SolvePath(startNode, endNode, &m_ChunkCorridor, statePath, totalCost);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-		MicroPather *m_Instance;
-	};
+	float PathFinder::PathSolver::GetChunkLeastCostEstimate(int startChunkId, int endChunkId) const {
+		const PathNode &startNode = m_PathFinder->m_NodeGrid[m_CostSnapshot->ChunkCenterNodeIds[startChunkId]];
+		const PathNode &endNode = m_PathFinder->m_NodeGrid[m_CostSnapshot->ChunkCenterNodeIds[endChunkId]];
+		return g_SceneMan.ShortestDistance(startNode.Pos, endNode.Pos).GetMagnitude() / m_PathFinder->m_NodeDimension;
+	}
 
-	thread_local MicroPatherWrapper s_Pather;
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	// What material strength the search is capable of digging through.
-	// Needs to be thread-local because of how it's passed around, unfortunately it doesn't seem we can give userdata for a path agent in MicroPather.
-	// TODO: Enhance MicroPather to add that capability (or write our own pather)!
-	thread_local float s_DigStrength = 0.0F;
+	void PathFinder::PathSolver::GetAdjacentChunkCosts(int chunkId, std::vector<micropather::StateCost> *adjacentList) {
+		for (int border = 0; border < c_ChunkBorderCount; ++border) {
+			int borderingChunkId = m_PathFinder->GetBorderingChunkId(chunkId, border);
+			if (borderingChunkId == -1) {
+				continue;
+			}
+			// A cached cost is valid as long as neither chunk's costs changed since it was solved.
+			unsigned int chunkVersion = std::max(m_CostSnapshot->ChunkVersions[chunkId], m_CostSnapshot->ChunkVersions[borderingChunkId]);
+			int borderCostIndex = chunkId * c_ChunkBorderCount + border;
+			float borderCost = -1.0F;
+			{
+				std::lock_guard<std::mutex> borderCostLock(m_PathFinder->m_ChunkBorderCostMutex);
+				std::vector<ChunkBorderCost> &borderCosts = m_PathFinder->m_ChunkBorderCosts[m_DigStrengthClass];
+				if (borderCosts.empty()) { borderCosts.resize(m_PathFinder->m_ChunkGridWidth * m_PathFinder->m_ChunkGridHeight * c_ChunkBorderCount, { 0.0F, 0 }); }
+				if (borderCosts[borderCostIndex].ChunkVersion == chunkVersion) { borderCost = borderCosts[borderCostIndex].Cost; }
+			}
+
+			if (borderCost < 0) {
+				// Solve between the two chunks' center PathNodes without leaving either chunk. This uses the restricted pather, which isn't in use while routes between chunks are being solved.
+				m_ChunkBorder.assign(m_PathFinder->m_ChunkGridWidth * m_PathFinder->m_ChunkGridHeight, false);
+				m_ChunkBorder[chunkId] = true;
+				m_ChunkBorder[borderingChunkId] = true;
+				PathNode *startNode = const_cast<PathNode *>(&m_PathFinder->m_NodeGrid[m_CostSnapshot->ChunkCenterNodeIds[chunkId]]);
+				PathNode *endNode = const_cast<PathNode *>(&m_PathFinder->m_NodeGrid[m_CostSnapshot->ChunkCenterNodeIds[borderingChunkId]]);
+				std::vector<void *> statePath;
+				float totalCost = 0.0F;
+				int result = SolvePath(startNode, endNode, &m_ChunkBorder, &statePath, &totalCost);
+				borderCost = (result == MicroPather::SOLVED || result == MicroPather::START_END_SAME) ? totalCost : std::numeric_limits<float>::max();
+
+				std::lock_guard<std::mutex> borderCostLock(m_PathFinder->m_ChunkBorderCostMutex);
+				m_PathFinder->m_ChunkBorderCosts[m_DigStrengthClass][borderCostIndex] = { borderCost, chunkVersion };
+			}
+
+			if (borderCost < std::numeric_limits<float>::max()) {
+				adjacentList->push_back({ ChunkGraph::ChunkIdToState(borderingChunkId), borderCost });
+			}
+		}
+	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	PathNode::PathNode(const Vector &pos) : Pos(pos) {
-		const Material *outOfBounds = g_SceneMan.GetMaterialFromID(MaterialColorKeys::g_MaterialOutOfBounds);
-		for (int i = 0; i < c_MaxAdjacentNodeCount; i++) {
-			AdjacentNodes[i] = nullptr;
-			AdjacentNodeBlockingMaterials[i] = outOfBounds; // Costs are infinite unless recalculated as otherwise.
+	float PathFinder::PathSolver::LeastCostEstimate(void *startState, void *endState) {
+		return g_SceneMan.ShortestDistance((static_cast<PathNode *>(startState))->Pos, (static_cast<PathNode *>(endState))->Pos).GetMagnitude() / m_PathFinder->m_NodeDimension;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::PathSolver::AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList) {
+		m_PathFinder->GetAdjacentCosts(*static_cast<const PathNode *>(state), *m_CostSnapshot, m_DigStrength, adjacentList);
+		if (m_AllowedChunks) {
+			std::erase_if(*adjacentList, [this](const micropather::StateCost &adjCost) { return !(*m_AllowedChunks)[m_PathFinder->m_NodeChunkIds[m_PathFinder->GetNodeId(static_cast<const PathNode *>(adjCost.state))]]; });
 		}
 	}
 
@@ -41,11 +167,28 @@ namespace RTE {
 	void PathFinder::Clear() {
 		m_NodeGrid.clear();
 		m_NodeDimension = SCENEGRIDSIZE;
+		m_MaterialIntegrities.clear();
+		m_CostSnapshot.reset();
+		m_SpareCostSnapshot.reset();
+		m_LastPublishedNodeIds.clear();
+		m_CostVersion = 0;
+		m_CostRegionCount = 0;
+		m_NodeCostRegionIds.clear();
+		m_ChunkDimension = 0;
+		m_ChunkGridWidth = 0;
+		m_ChunkGridHeight = 0;
+		m_NodeChunkIds.clear();
+		m_ChunkBorderCosts.clear();
+		m_CachedPaths.clear();
+		m_InFlightPaths.clear();
+		m_IdleSolvers.clear();
+		m_QueuedRequests.clear();
+		m_NextRequestSequence = 0;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	int PathFinder::Create(int nodeDimension) {
+	int PathFinder::Create(int nodeDimension, int chunkDimension) {
 		RTEAssert(g_SceneMan.GetScene(), "Scene doesn't exist or isn't loaded when creating PathFinder!");
 
 		m_NodeDimension = nodeDimension;
@@ -59,6 +202,38 @@ namespace RTE {
 		m_WrapsX = g_SceneMan.SceneWrapsX();
 		m_WrapsY = g_SceneMan.SceneWrapsY();
 
+		// Split the grid into cost regions, which cost changes are tracked by regardless of whether chunks are used.
+		int costRegionGridWidth = (m_GridWidth + c_CostRegionDimension - 1) / c_CostRegionDimension;
+		m_CostRegionCount = costRegionGridWidth * ((m_GridHeight + c_CostRegionDimension - 1) / c_CostRegionDimension);
+		m_NodeCostRegionIds.reserve(m_GridWidth * m_GridHeight);
+		for (int y = 0; y < m_GridHeight; ++y) {
+			for (int x = 0; x < m_GridWidth; ++x) {
+				m_NodeCostRegionIds.push_back((y / c_CostRegionDimension) * costRegionGridWidth + (x / c_CostRegionDimension));
+			}
+		}
+
+		// Cluster the grid into chunks, if they're used and there's more than one of them.
+		m_ChunkDimension = std::max(chunkDimension, 0);
+		if (m_ChunkDimension > 0 && (m_GridWidth > m_ChunkDimension || m_GridHeight > m_ChunkDimension)) {
+			m_ChunkGridWidth = (m_GridWidth + m_ChunkDimension - 1) / m_ChunkDimension;
+			m_ChunkGridHeight = (m_GridHeight + m_ChunkDimension - 1) / m_ChunkDimension;
+			m_NodeChunkIds.reserve(m_GridWidth * m_GridHeight);
+			for (int y = 0; y < m_GridHeight; ++y) {
+				for (int x = 0; x < m_GridWidth; ++x) {
+					m_NodeChunkIds.push_back((y / m_ChunkDimension) * m_ChunkGridWidth + (x / m_ChunkDimension));
+				}
+			}
+		} else {
+			m_ChunkDimension = 0;
+		}
+
+		// Gather the distinct Material integrities, so dig strengths that can dig through the same Materials can share cached costs.
+		for (const Material *material : g_SceneMan.GetMaterialPalette()) {
+			if (material) { m_MaterialIntegrities.push_back(material->GetIntegrity()); }
+		}
+		std::sort(m_MaterialIntegrities.begin(), m_MaterialIntegrities.end());
+		m_MaterialIntegrities.erase(std::unique(m_MaterialIntegrities.begin(), m_MaterialIntegrities.end()), m_MaterialIntegrities.end());
+
 		// Create and assign scene coordinate positions for all nodes.
 		Vector nodePos = Vector(static_cast<float>(nodeDimension) / 2.0F, static_cast<float>(nodeDimension) / 2.0F);
 		m_NodeGrid.reserve(m_GridWidth * m_GridHeight);
@@ -111,25 +286,48 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void PathFinder::Destroy() {
+		{
+			std::lock_guard<std::mutex> queueLock(m_RequestQueueMutex);
+			for (const QueuedPathRequest &queuedRequest : m_QueuedRequests) {
+				const_cast<PathRequest &>(*queuedRequest.Request).cancelled = true;
+			}
+		}
+		// Every queued request still has a ThreadMan task coming that references this, so wait for them all to run before tearing down.
+		while (m_CurrentPathingRequests.load() != 0 || m_QueuedPathingRequests.load() != 0) {
+			std::this_thread::yield();
+		}
 		Clear();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	MicroPather * PathFinder::GetPather() {
-		// TODO: cache a collection of pathers. For async pathfinding right now we create a new pather for every thread!
-		if (!s_Pather.m_Instance || s_Pather.m_Instance->GetGraph() != this) {
-			// First time this thread has asked for a pather, let's initialize it
-			delete s_Pather.m_Instance; // Might be reinitialized and Graph ptrs mismatch, in that case delete the old one
-			
-			// TODO: test dynamically setting this. The code below sets it based on map area and block size, with a hefty upper limit.
-			//int sceneArea = m_GridWidth * m_GridHeight;
-			//unsigned int numberOfBlocksToAllocate = std::min(128000, sceneArea / (m_NodeDimension * m_NodeDimension));
-			unsigned int numberOfBlocksToAllocate = 4000;
-			s_Pather.m_Instance = new MicroPather(this, numberOfBlocksToAllocate, PathNode::c_MaxAdjacentNodeCount, false);
+	int PathFinder::GetDigStrengthClass(float digStrength) const {
+		return static_cast<int>(std::upper_bound(m_MaterialIntegrities.begin(), m_MaterialIntegrities.end(), digStrength) - m_MaterialIntegrities.begin());
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::unique_ptr<PathFinder::PathSolver> PathFinder::AcquireSolver(int digStrengthClass) {
+		std::lock_guard<std::mutex> poolLock(m_SolverPoolMutex);
+		if (m_IdleSolvers.empty()) {
+			return std::make_unique<PathSolver>(this);
+		}
+		// Prefer a PathSolver that has cached costs for this dig strength class, otherwise take the most recently used one.
+		auto solverItr = std::find_if(m_IdleSolvers.rbegin(), m_IdleSolvers.rend(), [&digStrengthClass](const std::unique_ptr<PathSolver> &solver) { return solver->GetDigStrengthClass() == digStrengthClass; });
+		std::unique_ptr<PathSolver> solver = std::move(solverItr != m_IdleSolvers.rend() ? *solverItr : m_IdleSolvers.back());
+		if (solverItr != m_IdleSolvers.rend()) {
+			m_IdleSolvers.erase(std::next(solverItr).base());
+		} else {
+			m_IdleSolvers.pop_back();
 		}
+		return solver;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-		return s_Pather.m_Instance;
+	void PathFinder::ReleaseSolver(std::unique_ptr<PathSolver> solver) {
+		std::lock_guard<std::mutex> poolLock(m_SolverPoolMutex);
+		m_IdleSolvers.push_back(std::move(solver));
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -150,30 +348,13 @@ namespace RTE {
 		// Clear out the results if it happens to contain anything
 		pathResult.clear();
 
-		// Due to different actors having different dig strengths, node costs aren't consistent, so reset on every path.
-		GetPather()->Reset();
-
-		// Actors capable of digging can use s_DigStrength to modify the node adjacency cost.
-		s_DigStrength = digStrength;
-
-		// Do the actual pathfinding, fetch out the list of states that comprise the best path.
-		std::vector<void *> statePath;
-		int result = GetPather()->Solve(static_cast<void *>(GetPathNodeAtGridCoords(startNodeX, startNodeY)), static_cast<void *>(GetPathNodeAtGridCoords(endNodeX, endNodeY)), &statePath, &totalCostResult);
-		if (result == MicroPather::NO_SOLUTION) {
-			// Otherwise micropather inits it to zero :)
-			totalCostResult = std::numeric_limits<float>::max();
-		}
+		SolvedPath solvedPath = GetSolvedPath(GetPathNodeAtGridCoords(startNodeX, startNodeY), GetPathNodeAtGridCoords(endNodeX, endNodeY), digStrength);
+		totalCostResult = solvedPath.TotalCost;
 
-		if (!statePath.empty()) {
+		if (!solvedPath.NodePath->empty()) {
 			// Replace the approximate first point from the pathfound path with the exact starting point.
 			pathResult.push_back(start);
-			std::vector<void *>::iterator itr = statePath.begin();
-			itr++;
-
-			// Convert from a list of state void pointers to a list of scene position vectors.
-			for (; itr != statePath.end(); ++itr) {
-				pathResult.push_back((static_cast<PathNode *>(*itr))->Pos);
-			}
+			pathResult.insert(pathResult.end(), std::next(solvedPath.NodePath->begin()), solvedPath.NodePath->end());
 
 			// Adjust the last point to be exactly where the end is supposed to be (really?).
 			if (pathResult.size() > 2) {
@@ -189,47 +370,165 @@ namespace RTE {
 		--m_CurrentPathingRequests;
 
 		// TODO: Clean up the path, remove series of nodes in the same direction etc?
-		return result;
+		return solvedPath.Status;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	PathFinder::SolvedPath PathFinder::GetSolvedPath(PathNode *startNode, PathNode *endNode, float digStrength) {
+		std::shared_ptr<const CostSnapshot> costSnapshot = GetCostSnapshot();
+		PathCacheKey pathCacheKey = { GetNodeId(startNode), GetNodeId(endNode), GetDigStrengthClass(digStrength) };
+
+		// Paths whose chunks haven't changed since they were solved are reused, and if the same path is already being solved, its result is waited on instead of solving it again.
+		std::promise<SolvedPath> solvedPathPromise;
+		std::shared_future<SolvedPath> inFlightResult;
+		bool registeredInFlight = false;
+		{
+			std::lock_guard<std::mutex> pathCacheLock(m_PathCacheMutex);
+			if (auto cachedPathItr = m_CachedPaths.find(pathCacheKey); cachedPathItr != m_CachedPaths.end() && IsCachedPathValid(cachedPathItr->second, *costSnapshot)) {
+				return cachedPathItr->second.Path;
+			}
+			if (auto inFlightPathItr = m_InFlightPaths.find(pathCacheKey); inFlightPathItr != m_InFlightPaths.end()) {
+				if (inFlightPathItr->second.CostVersion == costSnapshot->Version) { inFlightResult = inFlightPathItr->second.Result; }
+			} else {
+				m_InFlightPaths.try_emplace(pathCacheKey, InFlightPath { solvedPathPromise.get_future().share(), costSnapshot->Version });
+				registeredInFlight = true;
+			}
+		}
+		if (inFlightResult.valid()) {
+			g_ThreadMan.Wait(inFlightResult);
+			return inFlightResult.get();
+		}
+
+		// Do the actual pathfinding, fetch out the list of states that comprise the best path.
+		// Actors capable of digging use their dig strength to modify the node adjacency cost, so borrow a pather that already has costs cached for a similar dig strength.
+		std::vector<void *> statePath;
+		float totalCost = 0.0F;
+		std::unique_ptr<PathSolver> solver = AcquireSolver(pathCacheKey.DigStrengthClass);
+		solver->BeginSolving(costSnapshot, digStrength);
+		int result = MicroPather::NO_SOLUTION;
+		if (ShouldSolveThroughChunks(startNode, endNode)) {
+			result = solver->SolvePathThroughChunks(startNode, endNode, &statePath, &totalCost);
+		}
+		// Solving through chunks can miss paths that stray far from the route between chunks, so anything it can't solve is solved on all PathNodes.
+		if (result == MicroPather::NO_SOLUTION) {
+			statePath.clear();
+			result = solver->SolvePath(startNode, endNode, nullptr, &statePath, &totalCost);
+		}
+		solver->EndSolving();
+		ReleaseSolver(std::move(solver));
+		if (result == MicroPather::NO_SOLUTION) {
+			// Otherwise micropather inits it to zero :)
+			totalCost = std::numeric_limits<float>::max();
+		}
+
+		// Convert from a list of state void pointers to a list of scene position vectors, and note which cost regions the path crosses so it can be reused until any of them change.
+		std::vector<Vector> nodePath;
+		nodePath.reserve(statePath.size());
+		std::vector<int> pathCostRegionIds;
+		for (void *state : statePath) {
+			const PathNode *pathNode = static_cast<PathNode *>(state);
+			nodePath.push_back(pathNode->Pos);
+			if (result != MicroPather::NO_SOLUTION) {
+				int costRegionId = m_NodeCostRegionIds[GetNodeId(pathNode)];
+				if (std::find(pathCostRegionIds.begin(), pathCostRegionIds.end(), costRegionId) == pathCostRegionIds.end()) { pathCostRegionIds.push_back(costRegionId); }
+			}
+		}
+		SolvedPath solvedPath = { std::make_shared<const std::vector<Vector>>(std::move(nodePath)), result, totalCost };
+
+		{
+			std::lock_guard<std::mutex> pathCacheLock(m_PathCacheMutex);
+			if (m_CachedPaths.size() >= c_MaxCachedPaths) {
+				// Make room by throwing out paths that crossed changed cost regions first, and everything if that isn't enough.
+				std::erase_if(m_CachedPaths, [this, &costSnapshot](const auto &cachedPath) { return !IsCachedPathValid(cachedPath.second, *costSnapshot); });
+				if (m_CachedPaths.size() >= c_MaxCachedPaths) { m_CachedPaths.clear(); }
+			}
+			CachedPath &cachedPath = m_CachedPaths[pathCacheKey];
+			if (cachedPath.CostVersion <= costSnapshot->Version) { cachedPath = { solvedPath, costSnapshot->Version, std::move(pathCostRegionIds) }; }
+			if (registeredInFlight) { m_InFlightPaths.erase(pathCacheKey); }
+		}
+		if (registeredInFlight) { solvedPathPromise.set_value(solvedPath); }
+
+		return solvedPath;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PathFinder::IsCachedPathValid(const CachedPath &cachedPath, const CostSnapshot &costSnapshot) const {
+		if (cachedPath.CostVersion == costSnapshot.Version) {
+			return true;
+		}
+		// Without a path, any cost change could have made a path where there was none. A cost going down anywhere could have made a better path too.
+		if (cachedPath.CostRegionIds.empty() || cachedPath.CostVersion > costSnapshot.Version || costSnapshot.CostDecreaseVersion > cachedPath.CostVersion) {
+			return false;
+		}
+		return std::all_of(cachedPath.CostRegionIds.begin(), cachedPath.CostRegionIds.end(), [&cachedPath, &costSnapshot](int costRegionId) { return costSnapshot.CostRegionVersions[costRegionId] <= cachedPath.CostVersion; });
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	std::shared_ptr<volatile PathRequest> PathFinder::CalculatePathAsync(Vector start, Vector end, float digStrength, PathCompleteCallback callback) {
+	std::shared_ptr<volatile PathRequest> PathFinder::CalculatePathAsync(Vector start, Vector end, float digStrength, PathCompleteCallback callback, TaskPriority priority) {
 		std::shared_ptr<volatile PathRequest> pathRequest = std::make_shared<PathRequest>();
 
 		const_cast<Vector &>(pathRequest->startPos) = start;
 		const_cast<Vector &>(pathRequest->targetPos) = end;
 
-		std::thread pathThread([this, start, end, digStrength, callback](std::shared_ptr<volatile PathRequest> volRequest) {
-			// Cast away the volatile-ness - only matters outside (and complicates the API otherwise)
-			PathRequest &request = const_cast<PathRequest &>(*volRequest);
+		{
+			std::lock_guard<std::mutex> queueLock(m_RequestQueueMutex);
+			m_QueuedRequests.push_back({ pathRequest, digStrength, callback, priority, m_NextRequestSequence++ });
+			std::push_heap(m_QueuedRequests.begin(), m_QueuedRequests.end(), SolvesAfter);
+			++m_QueuedPathingRequests;
+		}
+
+		// Each task solves whichever queued request is most urgent when it gets picked up, rather than the one it was submitted for.
+		g_ThreadMan.Submit([this]() { SolveNextQueuedRequest(); }, priority);
+
+		return pathRequest;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::SolveNextQueuedRequest() {
+		QueuedPathRequest queuedRequest;
+		{
+			std::lock_guard<std::mutex> queueLock(m_RequestQueueMutex);
+			if (m_QueuedRequests.empty()) {
+				return;
+			}
+			std::pop_heap(m_QueuedRequests.begin(), m_QueuedRequests.end(), SolvesAfter);
+			queuedRequest = std::move(m_QueuedRequests.back());
+			m_QueuedRequests.pop_back();
+			// Count the request as active before it stops counting as queued, so Destroy can't see neither.
+			++m_CurrentPathingRequests;
+			--m_QueuedPathingRequests;
+		}
+
+		// Cast away the volatile-ness - only matters outside (and complicates the API otherwise)
+		PathRequest &request = const_cast<PathRequest &>(*queuedRequest.Request);
+
+		if (!request.cancelled) {
+			int status = CalculatePath(request.startPos, request.targetPos, request.path, request.totalCost, queuedRequest.DigStrength);
 
-			int status = this->CalculatePath(start, end, request.path, request.totalCost, digStrength);
-			
 			request.status = status;
 			request.pathLength = request.path.size();
 
-			if (callback) {
-				callback(volRequest);
+			if (queuedRequest.Callback) {
+				queuedRequest.Callback(queuedRequest.Request);
 			}
+		}
 
-			// Have to set to complete after the callback, so anything that blocks on it knows that the callback will have been called by now
-			// This has the awkward side-effect that the complete flag is actually false during the callback - but that's fine, if it's called we know it's complete anyways
-			request.complete = true;
-		}, pathRequest);
+		// Have to set to complete after the callback, so anything that blocks on it knows that the callback will have been called by now
+		// This has the awkward side-effect that the complete flag is actually false during the callback - but that's fine, if it's called we know it's complete anyways
+		request.complete = true;
 
-		pathThread.detach();
-		return pathRequest;
-    }
+		--m_CurrentPathingRequests;
+	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     void PathFinder::RecalculateAllCosts() {
         RTEAssert(g_SceneMan.GetScene(), "Scene doesn't exist or isn't loaded when recalculating PathFinder!");
 
-		// Deadlock until all path requests are complete
-		while (m_CurrentPathingRequests.load() != 0) { };
-
 		// I hate this copy, but fuck it.
 		std::vector<int> pathNodesIdsVec;
 		pathNodesIdsVec.reserve(m_NodeGrid.size());
@@ -237,7 +536,10 @@ namespace RTE {
 			pathNodesIdsVec.push_back(i);
 		}
 
-		UpdateNodeList(pathNodesIdsVec);
+		if (!UpdateNodeList(pathNodesIdsVec) && !m_CostSnapshot) {
+			// Nothing differed from the initial PathNode costs, but solves still need a snapshot of them.
+			PublishCostSnapshot(pathNodesIdsVec);
+		}
     }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -272,65 +574,59 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	float PathFinder::LeastCostEstimate(void *startState, void *endState) {
-		return g_SceneMan.ShortestDistance((static_cast<PathNode *>(startState))->Pos, (static_cast<PathNode *>(endState))->Pos).GetMagnitude() / m_NodeDimension;
-	}
-
-/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-	void PathFinder::AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList) {
-		const PathNode *node = static_cast<PathNode *>(state);
+	void PathFinder::GetAdjacentCosts(const PathNode &node, const CostSnapshot &costSnapshot, float digStrength, std::vector<micropather::StateCost> *adjacentList) const {
+		const std::array<const Material *, PathNode::c_MaxAdjacentNodeCount> &nodeMaterials = costSnapshot.NodeMaterials[&node - m_NodeGrid.data()];
 		micropather::StateCost adjCost;
 
 		// We do a little trick here, where we radiate out a little percentage of our average cost in all directions.
 		// This encourages the AI to generally try to give hard surfaces some berth when pathing, so we don't get too close and get stuck.
 		const float costRadiationMultiplier = 0.2F;
-		float radiatedCost = GetNodeAverageTransitionCost(*node) * costRadiationMultiplier;
+		float radiatedCost = GetNodeAverageTransitionCost(nodeMaterials) * costRadiationMultiplier;
 
 		// Cost to discourage us from going up. Until we have jetpack-aware pathing, this it the best we can do!
 		const float extraUpCost = 3.0F;
 
 		// Add cost for digging upwards.
-		if (node->Up) {
-			adjCost.cost = 1.0F + extraUpCost + (GetMaterialTransitionCost(*node->UpMaterial) * 4.0F) + radiatedCost; // Four times more expensive when digging.
-			adjCost.state = static_cast<void *>(node->Up);
+		if (node.Up) {
+			adjCost.cost = 1.0F + extraUpCost + (GetMaterialTransitionCost(*nodeMaterials[0], digStrength) * 4.0F) + radiatedCost; // Four times more expensive when digging.
+			adjCost.state = static_cast<void *>(node.Up);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->Right) {
-			adjCost.cost = 1.0F + GetMaterialTransitionCost(*node->RightMaterial) + radiatedCost;
-			adjCost.state = static_cast<void *>(node->Right);
+		if (node.Right) {
+			adjCost.cost = 1.0F + GetMaterialTransitionCost(*nodeMaterials[2], digStrength) + radiatedCost;
+			adjCost.state = static_cast<void *>(node.Right);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->Down) {
-			adjCost.cost = 1.0F + GetMaterialTransitionCost(*node->DownMaterial) + radiatedCost;
-			adjCost.state = static_cast<void *>(node->Down);
+		if (node.Down) {
+			adjCost.cost = 1.0F + GetMaterialTransitionCost(*nodeMaterials[4], digStrength) + radiatedCost;
+			adjCost.state = static_cast<void *>(node.Down);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->Left) {
-			adjCost.cost = 1.0F + GetMaterialTransitionCost(*node->LeftMaterial) + radiatedCost;
-			adjCost.state = static_cast<void *>(node->Left);
+		if (node.Left) {
+			adjCost.cost = 1.0F + GetMaterialTransitionCost(*nodeMaterials[6], digStrength) + radiatedCost;
+			adjCost.state = static_cast<void *>(node.Left);
 			adjacentList->push_back(adjCost);
 		}
 
 		// Add cost for digging at 45 degrees and for digging upwards.
-		if (node->UpRight) {
-			adjCost.cost = 1.4F + extraUpCost + (GetMaterialTransitionCost(*node->UpRightMaterial) * 1.4F * 3.0F) + radiatedCost;  // Three times more expensive when digging.
-			adjCost.state = static_cast<void *>(node->UpRight);
+		if (node.UpRight) {
+			adjCost.cost = 1.4F + extraUpCost + (GetMaterialTransitionCost(*nodeMaterials[1], digStrength) * 1.4F * 3.0F) + radiatedCost;  // Three times more expensive when digging.
+			adjCost.state = static_cast<void *>(node.UpRight);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->RightDown) {
-			adjCost.cost = 1.4F + (GetMaterialTransitionCost(*node->RightDownMaterial) * 1.4F) + radiatedCost;
-			adjCost.state = static_cast<void *>(node->RightDown);
+		if (node.RightDown) {
+			adjCost.cost = 1.4F + (GetMaterialTransitionCost(*nodeMaterials[3], digStrength) * 1.4F) + radiatedCost;
+			adjCost.state = static_cast<void *>(node.RightDown);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->DownLeft) {
-			adjCost.cost = 1.4F + (GetMaterialTransitionCost(*node->DownLeftMaterial) * 1.4F) + radiatedCost;
-			adjCost.state = static_cast<void *>(node->DownLeft);
+		if (node.DownLeft) {
+			adjCost.cost = 1.4F + (GetMaterialTransitionCost(*nodeMaterials[5], digStrength) * 1.4F) + radiatedCost;
+			adjCost.state = static_cast<void *>(node.DownLeft);
 			adjacentList->push_back(adjCost);
 		}
-		if (node->LeftUp) {
-			adjCost.cost = 1.4F + extraUpCost + (GetMaterialTransitionCost(*node->LeftUpMaterial) * 1.4F * 3.0F) + radiatedCost;  // Three times more expensive when digging.
-			adjCost.state = static_cast<void *>(node->LeftUp);
+		if (node.LeftUp) {
+			adjCost.cost = 1.4F + extraUpCost + (GetMaterialTransitionCost(*nodeMaterials[7], digStrength) * 1.4F * 3.0F) + radiatedCost;  // Three times more expensive when digging.
+			adjCost.state = static_cast<void *>(node.LeftUp);
 			adjacentList->push_back(adjCost);
 		}
 	}
@@ -347,10 +643,10 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	float PathFinder::GetMaterialTransitionCost(const Material &material) const {
+	float PathFinder::GetMaterialTransitionCost(const Material &material, float digStrength) const {
 		float strength = material.GetIntegrity();
 		// Always treat doors as diggable.
-		if (strength > s_DigStrength && material.GetIndex() != MaterialColorKeys::g_MaterialDoor) {
+		if (strength > digStrength && material.GetIndex() != MaterialColorKeys::g_MaterialDoor) {
 			strength *= 1000.0F;
 		}
 		return strength;
@@ -439,10 +735,10 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	float PathFinder::GetNodeAverageTransitionCost(const PathNode &node) const {
+	float PathFinder::GetNodeAverageTransitionCost(const std::array<const Material *, PathNode::c_MaxAdjacentNodeCount> &nodeMaterials) const {
 		float totalCostOfAdjacentNodes = 0.0F;
 		int count = 0;
-		for (const Material *material : node.AdjacentNodeBlockingMaterials) {
+		for (const Material *material : nodeMaterials) {
 			// Don't use node transition cost, because we don't care about digging.
 			float cost = material->GetIntegrity();
 			if (cost < std::numeric_limits<float>::max()) {
@@ -485,11 +781,204 @@ namespace RTE {
 					if (node->RightDown) { node->RightDown->LeftUpMaterial = node->RightDownMaterial; }
 				}
 			);
+
+			PublishCostSnapshot(nodeVec);
 		}
 
 		return anyChange;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<const PathFinder::CostSnapshot> PathFinder::GetCostSnapshot() {
+		std::lock_guard<std::mutex> snapshotLock(m_CostSnapshotMutex);
+		return m_CostSnapshot;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::PublishCostSnapshot(const std::vector<int> &changedNodeIds) {
+		std::shared_ptr<CostSnapshot> costSnapshot;
+		// The spare snapshot is the one published before the current one. If no solve is holding it anymore, catching it up with the changes of the last two publishes is far cheaper than copying every PathNode.
+		// Nothing can start holding the spare snapshot again, so once its use count drops to 1 it's safe to write to, as long as the writes don't get ordered before the last solve's reads.
+		if (m_SpareCostSnapshot && m_SpareCostSnapshot.use_count() == 1) {
+			std::atomic_thread_fence(std::memory_order_acquire);
+			costSnapshot = std::move(m_SpareCostSnapshot);
+			for (int nodeId : m_LastPublishedNodeIds) {
+				CopyNodeMaterials(*costSnapshot, nodeId);
+			}
+			for (int nodeId : changedNodeIds) {
+				CopyNodeMaterials(*costSnapshot, nodeId);
+			}
+		} else {
+			costSnapshot = std::make_shared<CostSnapshot>();
+			costSnapshot->NodeMaterials.reserve(m_NodeGrid.size());
+			for (const PathNode &node : m_NodeGrid) {
+				costSnapshot->NodeMaterials.push_back(node.AdjacentNodeBlockingMaterials);
+			}
+		}
+		costSnapshot->Version = ++m_CostVersion;
+		UpdateSnapshotCostRegions(*costSnapshot, changedNodeIds);
+		UpdateSnapshotChunks(*costSnapshot, changedNodeIds);
+
+		{
+			std::lock_guard<std::mutex> snapshotLock(m_CostSnapshotMutex);
+			m_SpareCostSnapshot = std::move(m_CostSnapshot);
+			m_CostSnapshot = std::move(costSnapshot);
+		}
+		m_LastPublishedNodeIds = changedNodeIds;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::CopyNodeMaterials(CostSnapshot &costSnapshot, int nodeId) const {
+		// Updating a PathNode also sets the opposite direction Materials of its Right, Down, UpRight and RightDown neighbors, so those need copying too.
+		const PathNode &node = m_NodeGrid[nodeId];
+		costSnapshot.NodeMaterials[nodeId] = node.AdjacentNodeBlockingMaterials;
+		for (const PathNode *neighbor : { node.Right, node.Down, node.UpRight, node.RightDown }) {
+			if (neighbor) { costSnapshot.NodeMaterials[neighbor - m_NodeGrid.data()] = neighbor->AdjacentNodeBlockingMaterials; }
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::UpdateSnapshotCostRegions(CostSnapshot &costSnapshot, const std::vector<int> &changedNodeIds) const {
+		if (!m_CostSnapshot) {
+			costSnapshot.CostDecreaseVersion = costSnapshot.Version;
+			costSnapshot.CostRegionVersions.assign(m_CostRegionCount, costSnapshot.Version);
+			return;
+		}
+		// Start from the currently published versions, which the spare snapshot's may lag behind, then mark the cost regions touched by this update as changed.
+		costSnapshot.CostRegionVersions = m_CostSnapshot->CostRegionVersions;
+		costSnapshot.CostDecreaseVersion = m_CostSnapshot->CostDecreaseVersion;
+		ForEachChangedNodeId(changedNodeIds, [this, &costSnapshot](int nodeId) {
+			if (costSnapshot.CostDecreaseVersion != costSnapshot.Version && AnyNodeCostDecreased(m_CostSnapshot->NodeMaterials[nodeId], costSnapshot.NodeMaterials[nodeId])) {
+				costSnapshot.CostDecreaseVersion = costSnapshot.Version;
+			}
+			costSnapshot.CostRegionVersions[m_NodeCostRegionIds[nodeId]] = costSnapshot.Version;
+		});
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PathFinder::UpdateSnapshotChunks(CostSnapshot &costSnapshot, const std::vector<int> &changedNodeIds) const {
+		if (m_ChunkDimension == 0) {
+			return;
+		}
+		int chunkCount = m_ChunkGridWidth * m_ChunkGridHeight;
+		std::vector<int> changedChunkIds;
+		if (!m_CostSnapshot) {
+			costSnapshot.ChunkVersions.assign(chunkCount, costSnapshot.Version);
+			costSnapshot.ChunkCenterNodeIds.assign(chunkCount, 0);
+			changedChunkIds.reserve(chunkCount);
+			for (int chunkId = 0; chunkId < chunkCount; ++chunkId) {
+				changedChunkIds.push_back(chunkId);
+			}
+		} else {
+			// Start from the currently published chunk data, which the spare snapshot's may lag behind, then mark the chunks touched by this update as changed.
+			costSnapshot.ChunkVersions = m_CostSnapshot->ChunkVersions;
+			costSnapshot.ChunkCenterNodeIds = m_CostSnapshot->ChunkCenterNodeIds;
+			std::vector<bool> chunkChanged(chunkCount, false);
+			ForEachChangedNodeId(changedNodeIds, [this, &chunkChanged, &changedChunkIds](int nodeId) {
+				if (int chunkId = m_NodeChunkIds[nodeId]; !chunkChanged[chunkId]) {
+					chunkChanged[chunkId] = true;
+					changedChunkIds.push_back(chunkId);
+				}
+			});
+		}
+		for (int chunkId : changedChunkIds) {
+			costSnapshot.ChunkVersions[chunkId] = costSnapshot.Version;
+			costSnapshot.ChunkCenterNodeIds[chunkId] = FindChunkCenterNodeId(costSnapshot, chunkId);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PathFinder::AnyNodeCostDecreased(const std::array<const Material *, PathNode::c_MaxAdjacentNodeCount> &oldNodeMaterials, const std::array<const Material *, PathNode::c_MaxAdjacentNodeCount> &newNodeMaterials) const {
+		// Transition costs only go down with the Material's integrity, or when it becomes a door, which is always treated as diggable.
+		for (int direction = 0; direction < PathNode::c_MaxAdjacentNodeCount; ++direction) {
+			const Material *oldMaterial = oldNodeMaterials[direction];
+			const Material *newMaterial = newNodeMaterials[direction];
+			if (oldMaterial != newMaterial && (newMaterial->GetIntegrity() < oldMaterial->GetIntegrity() || (newMaterial->GetIndex() == MaterialColorKeys::g_MaterialDoor && oldMaterial->GetIndex() != MaterialColorKeys::g_MaterialDoor))) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PathFinder::ShouldSolveThroughChunks(const PathNode *startNode, const PathNode *endNode) const {
+		if (m_ChunkDimension == 0) {
+			return false;
+		}
+		int startNodeId = GetNodeId(startNode);
+		int endNodeId = GetNodeId(endNode);
+		int distanceX = std::abs((startNodeId % m_GridWidth) - (endNodeId % m_GridWidth));
+		int distanceY = std::abs((startNodeId / m_GridWidth) - (endNodeId / m_GridWidth));
+		if (m_WrapsX) { distanceX = std::min(distanceX, m_GridWidth - distanceX); }
+		if (m_WrapsY) { distanceY = std::min(distanceY, m_GridHeight - distanceY); }
+		return std::max(distanceX, distanceY) >= c_MinChunkDistanceForChunkSolve * m_ChunkDimension;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int PathFinder::ConvertChunkCoordsToChunkId(int x, int y) const {
+		if (m_WrapsX) {
+			x = x % m_ChunkGridWidth;
+			x = x < 0 ? x + m_ChunkGridWidth : x;
+		}
+
+		if (m_WrapsY) {
+			y = y % m_ChunkGridHeight;
+			y = y < 0 ? y + m_ChunkGridHeight : y;
+		}
+
+		if (x < 0 || x >= m_ChunkGridWidth || y < 0 || y >= m_ChunkGridHeight) {
+			return -1;
+		}
+
+		return (y * m_ChunkGridWidth) + x;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int PathFinder::GetBorderingChunkId(int chunkId, int border) const {
+		static constexpr std::array<int, c_ChunkBorderCount> borderOffsetsX = { 0, 1, 0, -1 };
+		static constexpr std::array<int, c_ChunkBorderCount> borderOffsetsY = { -1, 0, 1, 0 };
+		int borderingChunkId = ConvertChunkCoordsToChunkId((chunkId % m_ChunkGridWidth) + borderOffsetsX[border], (chunkId / m_ChunkGridWidth) + borderOffsetsY[border]);
+		// A chunk can't border itself, which happens when a wrapping axis is only one chunk long.
+		return borderingChunkId != chunkId ? borderingChunkId : -1;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int PathFinder::FindChunkCenterNodeId(const CostSnapshot &costSnapshot, int chunkId) const {
+		int firstX = (chunkId % m_ChunkGridWidth) * m_ChunkDimension;
+		int firstY = (chunkId / m_ChunkGridWidth) * m_ChunkDimension;
+		int lastX = std::min(firstX + m_ChunkDimension, m_GridWidth) - 1;
+		int lastY = std::min(firstY + m_ChunkDimension, m_GridHeight) - 1;
+		float middleX = static_cast<float>(firstX + lastX) * 0.5F;
+		float middleY = static_cast<float>(firstY + lastY) * 0.5F;
+
+		int centerNodeId = -1;
+		float centerNodeCost = std::numeric_limits<float>::max();
+		float centerNodeDistance = std::numeric_limits<float>::max();
+		for (int y = firstY; y <= lastY; ++y) {
+			for (int x = firstX; x <= lastX; ++x) {
+				int nodeId = (y * m_GridWidth) + x;
+				float cost = GetNodeAverageTransitionCost(costSnapshot.NodeMaterials[nodeId]);
+				float distance = std::abs(static_cast<float>(x) - middleX) + std::abs(static_cast<float>(y) - middleY);
+				if (centerNodeId == -1 || cost < centerNodeCost || (cost == centerNodeCost && distance < centerNodeDistance)) {
+					centerNodeId = nodeId;
+					centerNodeCost = cost;
+					centerNodeDistance = distance;
+				}
+			}
+		}
+		return centerNodeId;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	PathNode * PathFinder::GetPathNodeAtGridCoords(int x, int y) {
@@ -2,6 +2,7 @@
 #define _RTEPATHFINDER_
 
 #include "Box.h"
+#include "ThreadMan.h"
 #include "System/MicroPather/micropather.h"
 
 using namespace micropather;
@@ -16,6 +17,7 @@ namespace RTE {
 	/// </summary>
 	struct PathRequest {
 		bool complete = false;
+		bool cancelled = false; //!< Set to drop the request if it hasn't started solving yet. It is then completed with NO_SOLUTION, without running its callback.
 		int status = MicroPather::NO_SOLUTION;
 		std::list<Vector> path;
 		float pathLength = 0.0f;
@@ -50,6 +52,7 @@ namespace RTE {
 
 		/// <summary>
 		/// The strongest material between us and our adjacent PathNodes, in clockwise order with top first.
+		/// These are the PathFinder's working copy that cost updates are calculated in. Solves read the published CostSnapshots instead.
 		/// </summary>
 		std::array<const Material *, c_MaxAdjacentNodeCount> AdjacentNodeBlockingMaterials;
 		const Material *&UpMaterial = AdjacentNodeBlockingMaterials[0];
@@ -70,8 +73,12 @@ namespace RTE {
 
 	/// <summary>
 	/// A class encapsulating and implementing the MicroPather A* pathfinding library.
+	/// Paths are solved by a pool of long-lived MicroPathers, and async requests are queued by priority and solved on the ThreadMan's workers.
+	/// PathNode cost updates are published as versioned snapshots, so terrain changes never have to wait for solves in progress, which keep using the snapshot they started with.
+	/// Solved paths are cached per pair of PathNodes and dig strength class until the costs of a chunk they cross change, and identical paths being solved at the same time are only solved once.
+	/// Optionally, the grid is also clustered into square chunks of PathNodes. Long paths are then first solved between chunks, and only refined on PathNodes in a corridor of chunks around that route.
 	/// </summary>
-	class PathFinder : public Graph {
+	class PathFinder {
 
 	public:
 
@@ -80,25 +87,26 @@ namespace RTE {
 		/// Constructor method used to instantiate a PathFinder object.
 		/// </summary>
 		/// <param name="nodeDimension">The width and height in scene pixels that of each PathNode should represent.</param>
-		/// <param name="allocate">The block size that the PathNode cache is allocated from. Should be about a fourth of the total number of PathNodes.</param>
-		PathFinder(int nodeDimension) { Clear(); Create(nodeDimension); }
+		/// <param name="chunkDimension">The width and height in PathNodes of each chunk used to solve long paths hierarchically. 0 means long paths are solved on PathNodes only.</param>
+		PathFinder(int nodeDimension, int chunkDimension = 0) { Clear(); Create(nodeDimension, chunkDimension); }
 
 		/// <summary>
 		/// Makes the PathFinder object ready for use.
 		/// </summary>
 		/// <param name="nodeDimension">The width and height in scene pixels that of each PathNode should represent.</param>
+		/// <param name="chunkDimension">The width and height in PathNodes of each chunk used to solve long paths hierarchically. 0 means long paths are solved on PathNodes only.</param>
 		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
-		int Create(int nodeDimension);
+		int Create(int nodeDimension, int chunkDimension = 0);
 #pragma endregion
 
 #pragma region Destruction
 		/// <summary>
 		/// Destructor method used to clean up a PathFinder object before deletion.
 		/// </summary>
-		~PathFinder() override { Destroy(); }
+		~PathFinder() { Destroy(); }
 
 		/// <summary>
-		/// Destroys and resets (through Clear()) this PathFinder object.
+		/// Destroys and resets (through Clear()) this PathFinder object. Queued requests are cancelled, and requests that are being solved are waited on.
 		/// </summary>
 		void Destroy();
 
@@ -129,22 +137,30 @@ namespace RTE {
 		/// <param name="end">End positions on the scene to find the path between.</param>
 		/// <param name="digStrength">What material strength the search is capable of digging through.</param>
 		/// <param name="callback">The callback function to be run when the path calculation is completed.</param>
+		/// <param name="priority">The priority of the request. Queued requests are solved highest priority first, and in the order they were made within the same priority.</param>
 		/// <returns>A shared pointer to the volatile PathRequest to be used to track whether the asynchronous path calculation has been completed, and check its results.</returns>
-		std::shared_ptr<volatile PathRequest> CalculatePathAsync(Vector start, Vector end, float digStrength, PathCompleteCallback callback = nullptr);
+		std::shared_ptr<volatile PathRequest> CalculatePathAsync(Vector start, Vector end, float digStrength, PathCompleteCallback callback = nullptr, TaskPriority priority = TaskPriority::Normal);
 
 		// <summary>
-		/// Returns how many pathfinding requests are currently active.
+		/// Returns how many pathfinding requests are currently being solved. Queued async requests that haven't started solving yet aren't counted.
 		/// </summary>
 		/// <returns>How many pathfinding requests are currently active.</returns>
 		int GetCurrentPathingRequests() const { return m_CurrentPathingRequests.load(); }
 
 		/// <summary>
-		/// Recalculates all the costs between all the PathNodes by tracing lines in the material layer and summing all the material strengths for each encountered pixel. Also resets the pather itself.
+		/// Returns how many async pathfinding requests are queued and haven't started solving yet.
+		/// </summary>
+		/// <returns>How many async pathfinding requests are queued.</returns>
+		int GetQueuedPathingRequests() const { return m_QueuedPathingRequests.load(); }
+
+		/// <summary>
+		/// Recalculates all the costs between all the PathNodes by tracing lines in the material layer and summing all the material strengths for each encountered pixel.
+		/// Doesn't wait on any pathing requests, solves in progress finish on the costs they started with.
 		/// </summary>
 		void RecalculateAllCosts();
 
 		/// <summary>
-		/// Recalculates the costs between all the PathNodes touching a deque of specific rectangular areas (which will be wrapped). Also resets the pather itself, if necessary.
+		/// Recalculates the costs between all the PathNodes touching a deque of specific rectangular areas (which will be wrapped).
 		/// </summary>
 		/// <param name="boxList">The deque of Boxes representing the updated areas.</param>
 		/// <param name="nodeUpdateLimit">The maximum number of PathNodes we'll try to update this frame. True PathNode update count can be higher if we received a big box, as we always do at least 1 box.</param>
@@ -152,30 +168,13 @@ namespace RTE {
 		std::vector<int> RecalculateAreaCosts(std::deque<Box> &boxList, int nodeUpdateLimit);
 
 		/// <summary>
-		/// Updates a set of PathNodes, adjusting their transitions.
-		/// This does NOT update the pather, which is required if PathNode costs changed.
+		/// Updates a set of PathNodes, adjusting their transitions. If any PathNode costs changed, a new CostSnapshot is published for solves that start from then on.
+		/// Cost updates may only be made from one thread at a time, but can run alongside any number of solves.
 		/// </summary>
 		/// <param name="nodeVec">The set of PathNode IDs to update.</param>
 		/// <returns>Whether any PathNode costs changed.</returns>
 		bool UpdateNodeList(const std::vector<int> &nodeVec);
 
-		/// <summary>
-		/// Implementation of the abstract interface of Graph.
-		/// Gets the least possible cost to get from PathNode A to B, if it all was air.
-		/// </summary>
-		/// <param name="startState">Pointer to PathNode to start from. OWNERSHIP IS NOT TRANSFERRED!</param>
-		/// <param name="endState">PathNode to end up at. OWNERSHIP IS NOT TRANSFERRED!</param>
-		/// <returns>The cost of the absolutely fastest possible way between the two points, as if traveled through air all the way.</returns>
-		float LeastCostEstimate(void *startState, void *endState) override;
-
-		/// <summary>
-		/// Implementation of the abstract interface of Graph.
-		/// Gets the cost to go to any adjacent PathNode of the one passed in.
-		/// </summary>
-		/// <param name="state">Pointer to PathNode to get to cost of all adjacents for. OWNERSHIP IS NOT TRANSFERRED!</param>
-		/// <param name="adjacentList">An empty vector which will be filled out with all the valid PathNodes adjacent to the one passed in. If at non-wrapping edge of seam, those non existent PathNodes won't be added.</param>
-		void AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList) override;
-
 		/// <summary>
 		/// Returns whether two position represent the same path nodes.
 		/// </summary>
@@ -185,33 +184,457 @@ namespace RTE {
 		bool PositionsAreTheSamePathNode(const Vector& pos1, const Vector& pos2) const;
 #pragma endregion
 
-#pragma region Misc
+	private:
+
 		/// <summary>
-		/// Implementation of the abstract interface of Graph. This function is only used in DEBUG mode - it dumps output to stdout.
-		/// Since void* aren't really human readable, this will print out some concise info without an ending newline.
+		/// An immutable copy of the blocking Materials of all PathNodes, which solves read their costs from.
 		/// </summary>
-		/// <param name="state">The state to print out info about.</param>
-		void PrintStateInfo(void *state) override {}
-#pragma endregion
+		struct CostSnapshot {
+			unsigned int Version; //!< The cost version of this snapshot. Each published snapshot has a higher version than the last.
+			std::vector<std::array<const Material *, PathNode::c_MaxAdjacentNodeCount>> NodeMaterials; //!< The blocking Materials of each PathNode, by PathNode id.
+			std::vector<unsigned int> CostRegionVersions; //!< The cost version in which the costs of each cost region last changed, by cost region id.
+			unsigned int CostDecreaseVersion; //!< The cost version in which the cost between any two PathNodes last went down. Paths solved before then could have a cheaper route now, even if the cost regions they cross haven't changed.
+			std::vector<unsigned int> ChunkVersions; //!< The cost version in which the costs of each chunk last changed, by chunk id. Empty if chunks aren't used.
+			std::vector<int> ChunkCenterNodeIds; //!< The id of the PathNode each chunk's routes between chunks are solved from and to, by chunk id. This is the chunk's most open PathNode. Empty if chunks aren't used.
+		};
 
-	private:
+		class ChunkGraph;
+
+		/// <summary>
+		/// A long-lived MicroPather together with the Graph it solves on. PathSolvers are pooled by their PathFinder and lent to whichever thread is solving a path, so MicroPather's node pool and cached adjacent costs survive between solves.
+		/// The cached costs are only thrown away when solving on a different CostSnapshot, or for a dig strength that can dig through a different set of Materials.
+		/// </summary>
+		class PathSolver : public Graph {
+
+		public:
+
+			/// <summary>
+			/// Constructor method used to instantiate a PathSolver object in system memory and make it ready for use.
+			/// </summary>
+			/// <param name="pathFinder">The PathFinder whose PathNodes this solves paths between. Ownership is NOT transferred!</param>
+			explicit PathSolver(const PathFinder *pathFinder);
+
+			/// <summary>
+			/// Gets the dig strength class this PathSolver's cached costs were calculated for.
+			/// </summary>
+			/// <returns>The dig strength class of the cached costs, or -1 if nothing is cached.</returns>
+			int GetDigStrengthClass() const { return m_DigStrengthClass; }
+
+			/// <summary>
+			/// Destructor method used to clean up a PathSolver object before deletion.
+			/// </summary>
+			~PathSolver() override;
+
+			/// <summary>
+			/// Sets up the CostSnapshot and dig strength that the following solves are done with. The pather is only reset if its cached costs don't apply to them.
+			/// </summary>
+			/// <param name="costSnapshot">The CostSnapshot to read PathNode costs from. Held on to until EndSolving is called.</param>
+			/// <param name="digStrength">What material strength the search is capable of digging through.</param>
+			void BeginSolving(std::shared_ptr<const CostSnapshot> costSnapshot, float digStrength);
+
+			/// <summary>
+			/// Lets go of the CostSnapshot of the solves, so it doesn't keep an outdated snapshot alive while this PathSolver is idle.
+			/// </summary>
+			void EndSolving() { m_CostSnapshot.reset(); }
+
+			/// <summary>
+			/// Solves the least difficult path between two PathNodes.
+			/// </summary>
+			/// <param name="startNode">The PathNode to start from.</param>
+			/// <param name="endNode">The PathNode to end up at.</param>
+			/// <param name="allowedChunks">If not null, only PathNodes in the chunks flagged in this are considered. Such solves use their own pather, whose cached costs are only thrown away when the flagged chunks differ from the last restricted solve's.</param>
+			/// <param name="statePath">A vector which will be filled out with the PathNodes of the path.</param>
+			/// <param name="totalCost">The total cost of the path.</param>
+			/// <returns>Success or failure, expressed as SOLVED, NO_SOLUTION, or START_END_SAME.</returns>
+			int SolvePath(PathNode *startNode, PathNode *endNode, const std::vector<bool> *allowedChunks, std::vector<void *> *statePath, float *totalCost);
+
+			/// <summary>
+			/// Solves the least difficult path between two PathNodes in different chunks by first solving the route between their chunks, then solving on the PathNodes of the chunks around that route only.
+			/// </summary>
+			/// <param name="startNode">The PathNode to start from.</param>
+			/// <param name="endNode">The PathNode to end up at.</param>
+			/// <param name="statePath">A vector which will be filled out with the PathNodes of the path.</param>
+			/// <param name="totalCost">The total cost of the path.</param>
+			/// <returns>Success or failure, expressed as SOLVED or NO_SOLUTION. If there's no solution, it may still be found by solving on all PathNodes.</returns>
+			int SolvePathThroughChunks(PathNode *startNode, PathNode *endNode, std::vector<void *> *statePath, float *totalCost);
+
+			/// <summary>
+			/// Gets the least possible cost to get between the center PathNodes of two chunks.
+			/// </summary>
+			/// <param name="startChunkId">The chunk to start from.</param>
+			/// <param name="endChunkId">The chunk to end up at.</param>
+			/// <returns>The cost of the absolutely fastest possible way between the center PathNodes of the chunks.</returns>
+			float GetChunkLeastCostEstimate(int startChunkId, int endChunkId) const;
+
+			/// <summary>
+			/// Gets the cost to go to each chunk bordering the one passed in, solving and caching the costs of borders that haven't been solved since either chunk changed.
+			/// </summary>
+			/// <param name="chunkId">The chunk to get the cost to all bordering chunks for.</param>
+			/// <param name="adjacentList">An empty vector which will be filled out with all the bordering chunks that can be reached.</param>
+			void GetAdjacentChunkCosts(int chunkId, std::vector<micropather::StateCost> *adjacentList);
+
+			/// <summary>
+			/// Implementation of the abstract interface of Graph.
+			/// Gets the least possible cost to get from PathNode A to B, if it all was air.
+			/// </summary>
+			/// <param name="startState">Pointer to PathNode to start from. OWNERSHIP IS NOT TRANSFERRED!</param>
+			/// <param name="endState">PathNode to end up at. OWNERSHIP IS NOT TRANSFERRED!</param>
+			/// <returns>The cost of the absolutely fastest possible way between the two points, as if traveled through air all the way.</returns>
+			float LeastCostEstimate(void *startState, void *endState) override;
+
+			/// <summary>
+			/// Implementation of the abstract interface of Graph.
+			/// Gets the cost to go to any adjacent PathNode of the one passed in, for the CostSnapshot and dig strength of the current solve.
+			/// </summary>
+			/// <param name="state">Pointer to PathNode to get to cost of all adjacents for. OWNERSHIP IS NOT TRANSFERRED!</param>
+			/// <param name="adjacentList">An empty vector which will be filled out with all the valid PathNodes adjacent to the one passed in. If at non-wrapping edge of seam, those non existent PathNodes won't be added.</param>
+			void AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList) override;
+
+			/// <summary>
+			/// Implementation of the abstract interface of Graph. This function is only used in DEBUG mode - it dumps output to stdout.
+			/// Since void* aren't really human readable, this will print out some concise info without an ending newline.
+			/// </summary>
+			/// <param name="state">The state to print out info about.</param>
+			void PrintStateInfo(void *state) override {}
+
+		private:
+
+			static constexpr unsigned int c_PatherBlockAllocationSize = 4000; //!< The block size that each MicroPather's PathNode cache is allocated in.
+			static constexpr unsigned int c_ChunkPatherBlockAllocationSize = 256; //!< The block size that each MicroPather's chunk cache is allocated in.
+
+			const PathFinder *m_PathFinder; //!< The PathFinder whose PathNodes this solves paths between. Not owned.
+			std::unique_ptr<MicroPather> m_Pather; //!< The actual pathing object that does the pathfinding work.
+			std::shared_ptr<const CostSnapshot> m_CostSnapshot; //!< The CostSnapshot of the current solves. Released by EndSolving, so it doesn't keep outdated snapshots alive.
+			float m_DigStrength; //!< The dig strength of the current solves.
+			int m_DigStrengthClass; //!< The dig strength class the pather's cached costs were calculated for, or -1 if nothing is cached.
+			unsigned int m_CostVersion; //!< The version of the CostSnapshot the pather's cached costs were calculated from.
+			const std::vector<bool> *m_AllowedChunks; //!< The chunks the current solve is restricted to, or nullptr if it isn't restricted.
+			std::unique_ptr<MicroPather> m_RestrictedPather; //!< The pathing object that does restricted solves, so their cached costs, which leave out adjacent PathNodes, never get mixed with unrestricted ones. Lazily made.
+			std::vector<bool> m_RestrictedPatherChunks; //!< The chunks the restricted pather's cached costs were calculated for. Empty if nothing is cached.
+
+			std::unique_ptr<ChunkGraph> m_ChunkGraph; //!< The Graph of chunks that routes between chunks are solved on. Lazily made.
+			std::unique_ptr<MicroPather> m_ChunkPather; //!< The pathing object that solves routes between chunks. Lazily made.
+			std::vector<bool> m_ChunkCorridor; //!< The chunks a path solved through chunks is refined in.
+			std::vector<bool> m_ChunkBorder; //!< The two chunks the cost of a chunk border is solved in.
+
+			// Disallow the use of some implicit methods.
+			PathSolver(const PathSolver &reference) = delete;
+			PathSolver & operator=(const PathSolver &rhs) = delete;
+		};
+
+		/// <summary>
+		/// The Graph of chunks a PathSolver solves routes between chunks on. States are chunk ids offset by one, since MicroPather doesn't allow null states.
+		/// </summary>
+		class ChunkGraph : public Graph {
+
+		public:
+
+			/// <summary>
+			/// Constructor method used to instantiate a ChunkGraph object in system memory and make it ready for use.
+			/// </summary>
+			/// <param name="solver">The PathSolver that solves and caches the costs between chunks. Ownership is NOT transferred!</param>
+			explicit ChunkGraph(PathSolver *solver) : m_Solver(solver) {}
+
+			/// <summary>
+			/// Converts a chunk id to a MicroPather state.
+			/// </summary>
+			/// <param name="chunkId">The chunk id to convert.</param>
+			/// <returns>The state of the chunk.</returns>
+			static void * ChunkIdToState(int chunkId) { return reinterpret_cast<void *>(static_cast<intptr_t>(chunkId) + 1); }
+
+			/// <summary>
+			/// Converts a MicroPather state to a chunk id.
+			/// </summary>
+			/// <param name="state">The state to convert.</param>
+			/// <returns>The chunk id of the state.</returns>
+			static int StateToChunkId(void *state) { return static_cast<int>(reinterpret_cast<intptr_t>(state) - 1); }
+
+			/// <summary>
+			/// Implementation of the abstract interface of Graph.
+			/// Gets the least possible cost to get from chunk A to B.
+			/// </summary>
+			/// <param name="startState">The chunk to start from.</param>
+			/// <param name="endState">The chunk to end up at.</param>
+			/// <returns>The cost of the absolutely fastest possible way between the two chunks.</returns>
+			float LeastCostEstimate(void *startState, void *endState) override { return m_Solver->GetChunkLeastCostEstimate(StateToChunkId(startState), StateToChunkId(endState)); }
+
+			/// <summary>
+			/// Implementation of the abstract interface of Graph.
+			/// Gets the cost to go to each chunk bordering the one passed in.
+			/// </summary>
+			/// <param name="state">The chunk to get to cost of all bordering chunks for.</param>
+			/// <param name="adjacentList">An empty vector which will be filled out with all the bordering chunks that can be reached.</param>
+			void AdjacentCost(void *state, std::vector<micropather::StateCost> *adjacentList) override { m_Solver->GetAdjacentChunkCosts(StateToChunkId(state), adjacentList); }
+
+			/// <summary>
+			/// Implementation of the abstract interface of Graph. This function is only used in DEBUG mode - it dumps output to stdout.
+			/// </summary>
+			/// <param name="state">The state to print out info about.</param>
+			void PrintStateInfo(void *state) override {}
+
+		private:
+
+			PathSolver *m_Solver; //!< The PathSolver that solves and caches the costs between chunks. Not owned.
+		};
+
+		/// <summary>
+		/// The cached cost of going from one chunk to a bordering chunk.
+		/// </summary>
+		struct ChunkBorderCost {
+			float Cost; //!< The cost of the path between the center PathNodes of the two chunks, through those chunks only.
+			unsigned int ChunkVersion; //!< The newer of the two chunks' cost versions when the cost was solved. 0 if it was never solved.
+		};
+
+		/// <summary>
+		/// The result of solving a path between two PathNodes, which is shared by every request for that path.
+		/// </summary>
+		struct SolvedPath {
+			std::shared_ptr<const std::vector<Vector>> NodePath; //!< The positions of the PathNodes of the path. Empty if there's no solution or the start and end are the same PathNode.
+			int Status; //!< Success or failure, expressed as SOLVED, NO_SOLUTION, or START_END_SAME.
+			float TotalCost; //!< The total cost of the path.
+		};
+
+		/// <summary>
+		/// What identifies a SolvedPath. Dig strengths of the same class give identical costs, so their paths are interchangeable.
+		/// </summary>
+		struct PathCacheKey {
+			int StartNodeId; //!< The id of the PathNode the path starts from.
+			int EndNodeId; //!< The id of the PathNode the path ends at.
+			int DigStrengthClass; //!< The dig strength class the path was solved for.
+
+			bool operator==(const PathCacheKey &rhs) const = default;
+		};
+
+		/// <summary>
+		/// Hash function for PathCacheKeys.
+		/// </summary>
+		struct PathCacheKeyHash {
+			size_t operator()(const PathCacheKey &key) const { return std::hash<uint64_t>()((static_cast<uint64_t>(static_cast<uint32_t>(key.StartNodeId)) << 32) ^ (static_cast<uint64_t>(static_cast<uint32_t>(key.EndNodeId)) << 8) ^ static_cast<uint64_t>(static_cast<uint32_t>(key.DigStrengthClass))); }
+		};
+
+		/// <summary>
+		/// A SolvedPath kept for reuse, along with the costs it was solved on and the cost regions it crosses.
+		/// </summary>
+		struct CachedPath {
+			SolvedPath Path; //!< The cached path.
+			unsigned int CostVersion; //!< The version of the CostSnapshot the path was solved on.
+			std::vector<int> CostRegionIds; //!< The ids of the cost regions the path crosses. The path is reused while none of them changed since it was solved. Empty if there's no path, in which case it's only reused on the same version.
+		};
+
+		/// <summary>
+		/// A path that is being solved right now, which other requests for the same path can wait on.
+		/// </summary>
+		struct InFlightPath {
+			std::shared_future<SolvedPath> Result; //!< The result of the solve, once it's done.
+			unsigned int CostVersion; //!< The version of the CostSnapshot the path is being solved on.
+		};
+
+		/// <summary>
+		/// An async PathRequest waiting to be solved.
+		/// </summary>
+		struct QueuedPathRequest {
+			std::shared_ptr<volatile PathRequest> Request; //!< The PathRequest to fill out.
+			float DigStrength; //!< What material strength the search is capable of digging through.
+			PathCompleteCallback Callback; //!< The callback function to be run when the path calculation is completed.
+			TaskPriority Priority; //!< The priority of the request.
+			unsigned int Sequence; //!< The order the request was made in, so requests of the same priority are solved first come first served.
+		};
+
+		/// <summary>
+		/// Heap ordering of queued PathRequests. The request that should be solved next ends up at the front of the heap.
+		/// </summary>
+		/// <param name="first">The first request to compare.</param>
+		/// <param name="second">The second request to compare.</param>
+		/// <returns>Whether the first request should be solved after the second.</returns>
+		static bool SolvesAfter(const QueuedPathRequest &first, const QueuedPathRequest &second) { return first.Priority != second.Priority ? first.Priority < second.Priority : first.Sequence > second.Sequence; }
 
 		static constexpr float c_NodeCostChangeEpsilon = 5.0F; //!< The minimum change in a PathNodes's cost for the pathfinder to recognize a change and reset itself. This is so minor changes (e.g. blood particles) don't force constant pathfinder resets.
+		static constexpr size_t c_MaxCachedPaths = 1024; //!< How many solved paths are cached before invalid ones are thrown out.
+		static constexpr int c_ChunkBorderCount = 4; //!< The number of chunks that border each chunk, in clockwise order with top first.
+		static constexpr int c_CostRegionDimension = 16; //!< The width and height of each cost region, in PathNodes. Cost changes are tracked per region, so cached paths are only thrown out when a region they cross changes.
+		static constexpr int c_MinChunkDistanceForChunkSolve = 3; //!< How many chunks apart the start and end of a path need to be for it to be solved through chunks. Shorter paths are cheaper to solve on PathNodes only.
 
-		MicroPather *m_Pather; //!< The actual pathing object that does the pathfinding work. Owned.
 		std::vector<PathNode> m_NodeGrid;  //!< The array of PathNodes representing the grid on the scene.
 		unsigned int m_NodeDimension; //!< The width and height of each PathNode, in pixels on the scene.
 		int m_GridWidth; //!< The width of the pathing grid, in PathNodes.
 		int m_GridHeight; //!< The height of the pathing grid, in PathNodes.
 		bool m_WrapsX; //!< Whether the pathing grid wraps on the X axis.
 		bool m_WrapsY; //!< Whether the pathing grid wraps on the Y axis.
-		std::atomic<int> m_CurrentPathingRequests; //!< The number of active async pathing requests.
+		std::atomic<int> m_CurrentPathingRequests; //!< The number of pathing requests being solved.
+		std::atomic<int> m_QueuedPathingRequests; //!< The number of async pathing requests waiting to be solved.
+		std::vector<float> m_MaterialIntegrities; //!< The distinct integrities of all Materials, in ascending order. Used to tell which dig strengths give the same costs.
+
+		std::mutex m_CostSnapshotMutex; //!< Mutex guarding which CostSnapshot is the published one.
+		std::shared_ptr<CostSnapshot> m_CostSnapshot; //!< The most recently published CostSnapshot, which new solves use.
+		std::shared_ptr<CostSnapshot> m_SpareCostSnapshot; //!< The previously published CostSnapshot. Once no solve holds it anymore, it is caught up and reused as the next published one instead of copying all the costs.
+		std::vector<int> m_LastPublishedNodeIds; //!< The ids of the PathNodes whose costs differ between the spare and the published CostSnapshot.
+		unsigned int m_CostVersion; //!< The version of the most recently published CostSnapshot. Only touched by cost updates.
+		int m_CostRegionCount; //!< The number of cost regions the pathing grid is split into.
+		std::vector<int> m_NodeCostRegionIds; //!< The id of the cost region each PathNode is in, by PathNode id.
+
+		int m_ChunkDimension; //!< The width and height of each chunk, in PathNodes. 0 if chunks aren't used.
+		int m_ChunkGridWidth; //!< The width of the chunk grid, in chunks.
+		int m_ChunkGridHeight; //!< The height of the chunk grid, in chunks.
+		std::vector<int> m_NodeChunkIds; //!< The id of the chunk each PathNode is in, by PathNode id.
+		mutable std::mutex m_ChunkBorderCostMutex; //!< Mutex guarding the cached chunk border costs, which are filled in by solves.
+		mutable std::unordered_map<int, std::vector<ChunkBorderCost>> m_ChunkBorderCosts; //!< The cached costs of going from each chunk to each of its bordering chunks, by dig strength class, then by chunk id times c_ChunkBorderCount plus border.
+
+		std::mutex m_SolverPoolMutex; //!< Mutex guarding the pool of idle PathSolvers.
+		std::vector<std::unique_ptr<PathSolver>> m_IdleSolvers; //!< The PathSolvers that aren't solving anything right now. New ones are only made when all are busy.
+
+		std::mutex m_PathCacheMutex; //!< Mutex guarding the cached and in-flight paths.
+		std::unordered_map<PathCacheKey, CachedPath, PathCacheKeyHash> m_CachedPaths; //!< The paths solved so far. Only used while the costs of the cost regions they cross haven't changed.
+		std::unordered_map<PathCacheKey, InFlightPath, PathCacheKeyHash> m_InFlightPaths; //!< The paths being solved right now.
+
+		std::mutex m_RequestQueueMutex; //!< Mutex guarding the queue of async PathRequests.
+		std::vector<QueuedPathRequest> m_QueuedRequests; //!< The async PathRequests waiting to be solved, as a heap with the request to solve next at the front.
+		unsigned int m_NextRequestSequence; //!< The sequence number of the next async PathRequest.
+
+#pragma region Solving
+		/// <summary>
+		/// Gets the dig strength class of a dig strength. All dig strengths of the same class can dig through the same Materials, so they give identical PathNode costs.
+		/// </summary>
+		/// <param name="digStrength">The dig strength to get the class of.</param>
+		/// <returns>The dig strength class, which is the number of distinct Material integrities the dig strength is at least as strong as.</returns>
+		int GetDigStrengthClass(float digStrength) const;
 
 		/// <summary>
-		/// Gets the pather for this thread. Lazily-initialized for each new thread that needs a pather.
+		/// Takes an idle PathSolver out of the pool, preferring one whose cached costs were calculated for the same dig strength class. Makes a new one if none are idle.
 		/// </summary>
-		/// <returns>The pather for this thread.</returns>
-		MicroPather * GetPather();
+		/// <param name="digStrengthClass">The dig strength class that is going to be solved for.</param>
+		/// <returns>The PathSolver to use. Must be given back with ReleaseSolver.</returns>
+		std::unique_ptr<PathSolver> AcquireSolver(int digStrengthClass);
+
+		/// <summary>
+		/// Puts a PathSolver back into the pool of idle PathSolvers.
+		/// </summary>
+		/// <param name="solver">The PathSolver to put back.</param>
+		void ReleaseSolver(std::unique_ptr<PathSolver> solver);
+
+		/// <summary>
+		/// Gets the least difficult path between two PathNodes, from the cache if it was solved before and is still valid, or by waiting on an identical solve in progress, or else by solving it.
+		/// </summary>
+		/// <param name="startNode">The PathNode to start from.</param>
+		/// <param name="endNode">The PathNode to end up at.</param>
+		/// <param name="digStrength">What material strength the search is capable of digging through.</param>
+		/// <returns>The solved path.</returns>
+		SolvedPath GetSolvedPath(PathNode *startNode, PathNode *endNode, float digStrength);
+
+		/// <summary>
+		/// Gets whether a CachedPath can still be used on a CostSnapshot. Paths are valid until any cost region they cross changes, or any cost on the scene goes down, so cost increases elsewhere on the scene don't throw them out.
+		/// </summary>
+		/// <param name="cachedPath">The CachedPath to check.</param>
+		/// <param name="costSnapshot">The CostSnapshot the path would be used on.</param>
+		/// <returns>Whether the CachedPath is still valid.</returns>
+		bool IsCachedPathValid(const CachedPath &cachedPath, const CostSnapshot &costSnapshot) const;
+
+		/// <summary>
+		/// Takes the async PathRequest to solve next off the queue and solves it, unless it was cancelled. Run by a ThreadMan task submitted for each queued request.
+		/// </summary>
+		void SolveNextQueuedRequest();
+
+		/// <summary>
+		/// Gets the cost to go to any adjacent PathNode of the one passed in.
+		/// </summary>
+		/// <param name="node">The PathNode to get the cost of all adjacents for.</param>
+		/// <param name="costSnapshot">The CostSnapshot to read the PathNode's blocking Materials from.</param>
+		/// <param name="digStrength">What material strength the search is capable of digging through.</param>
+		/// <param name="adjacentList">An empty vector which will be filled out with all the valid PathNodes adjacent to the one passed in.</param>
+		void GetAdjacentCosts(const PathNode &node, const CostSnapshot &costSnapshot, float digStrength, std::vector<micropather::StateCost> *adjacentList) const;
+#pragma endregion
+
+#pragma region Chunks
+		/// <summary>
+		/// Gets whether a path between two PathNodes should be solved through chunks.
+		/// </summary>
+		/// <param name="startNode">The PathNode the path starts from.</param>
+		/// <param name="endNode">The PathNode the path ends at.</param>
+		/// <returns>Whether chunks are used and the PathNodes are far enough apart for the path to be solved through them.</returns>
+		bool ShouldSolveThroughChunks(const PathNode *startNode, const PathNode *endNode) const;
+
+		/// <summary>
+		/// Gets the chunk id at the given chunk coordinates, wrapping them if the scene wraps.
+		/// </summary>
+		/// <param name="x">The X coordinate, in chunks.</param>
+		/// <param name="y">The Y coordinate, in chunks.</param>
+		/// <returns>The chunk id at the given coordinates, or -1 if they're off a non-wrapping edge.</returns>
+		int ConvertChunkCoordsToChunkId(int x, int y) const;
+
+		/// <summary>
+		/// Gets the id of a chunk bordering another.
+		/// </summary>
+		/// <param name="chunkId">The chunk to get the bordering chunk of.</param>
+		/// <param name="border">Which border to get the chunk across, in clockwise order with top first.</param>
+		/// <returns>The id of the bordering chunk, or -1 if there is none.</returns>
+		int GetBorderingChunkId(int chunkId, int border) const;
+
+		/// <summary>
+		/// Finds the most open PathNode of a chunk, which its routes to bordering chunks are solved from. Ties go to the PathNode closest to the middle of the chunk.
+		/// </summary>
+		/// <param name="costSnapshot">The CostSnapshot to read the PathNode costs from.</param>
+		/// <param name="chunkId">The chunk to find the center PathNode of.</param>
+		/// <returns>The id of the chunk's center PathNode.</returns>
+		int FindChunkCenterNodeId(const CostSnapshot &costSnapshot, int chunkId) const;
+#pragma endregion
+
+#pragma region Cost Snapshots
+		/// <summary>
+		/// Gets the most recently published CostSnapshot, for a solve to use from start to end.
+		/// </summary>
+		/// <returns>The most recently published CostSnapshot.</returns>
+		std::shared_ptr<const CostSnapshot> GetCostSnapshot();
+
+		/// <summary>
+		/// Publishes the current blocking Materials of all PathNodes as a new CostSnapshot. Solves already in progress keep the snapshot they started with.
+		/// </summary>
+		/// <param name="changedNodeIds">The ids of the PathNodes whose costs were updated since the last publish.</param>
+		void PublishCostSnapshot(const std::vector<int> &changedNodeIds);
+
+		/// <summary>
+		/// Copies the current blocking Materials of a PathNode into a CostSnapshot, along with those of the neighbors whose Materials it sets.
+		/// </summary>
+		/// <param name="costSnapshot">The CostSnapshot to copy into.</param>
+		/// <param name="nodeId">The id of the updated PathNode.</param>
+		void CopyNodeMaterials(CostSnapshot &costSnapshot, int nodeId) const;
+
+		/// <summary>
+		/// Brings the cost versions of a newly filled out CostSnapshot up to date, marking the cost regions of the updated PathNodes as changed in its version, and whether any of their costs went down.
+		/// </summary>
+		/// <param name="costSnapshot">The CostSnapshot to update, which already has its version and PathNode Materials set.</param>
+		/// <param name="changedNodeIds">The ids of the PathNodes whose costs were updated since the last publish.</param>
+		void UpdateSnapshotCostRegions(CostSnapshot &costSnapshot, const std::vector<int> &changedNodeIds) const;
+
+		/// <summary>
+		/// Brings the chunk data of a newly filled out CostSnapshot up to date, marking the chunks of the updated PathNodes as changed in its version. Does nothing if chunks aren't used.
+		/// </summary>
+		/// <param name="costSnapshot">The CostSnapshot to update, which already has its version and PathNode Materials set.</param>
+		/// <param name="changedNodeIds">The ids of the PathNodes whose costs were updated since the last publish.</param>
+		void UpdateSnapshotChunks(CostSnapshot &costSnapshot, const std::vector<int> &changedNodeIds) const;
+
+		/// <summary>
+		/// Calls a function with each PathNode whose costs are changed by updating the passed in PathNodes. Updating a PathNode also changes the costs of its Right, Down, UpRight and RightDown neighbors.
+		/// </summary>
+		/// <param name="changedNodeIds">The ids of the updated PathNodes.</param>
+		/// <param name="function">The function to call. Must be invocable with a single PathNode id argument. PathNodes can be passed in more than once.</param>
+		template <typename Function>
+		void ForEachChangedNodeId(const std::vector<int> &changedNodeIds, const Function &function) const {
+			for (int nodeId : changedNodeIds) {
+				const PathNode &node = m_NodeGrid[nodeId];
+				function(nodeId);
+				for (const PathNode *neighbor : { node.Right, node.Down, node.UpRight, node.RightDown }) {
+					if (neighbor) { function(GetNodeId(neighbor)); }
+				}
+			}
+		}
+
+		/// <summary>
+		/// Gets whether the cost of moving from a PathNode to any of its neighbors went down, for any dig strength, between two sets of its blocking Materials.
+		/// </summary>
+		/// <param name="oldNodeMaterials">The PathNode's blocking Materials before the update.</param>
+		/// <param name="newNodeMaterials">The PathNode's blocking Materials after the update.</param>
+		/// <returns>Whether any of the PathNode's transition costs went down.</returns>
+		bool AnyNodeCostDecreased(const std::array<const Material *, PathNode::c_MaxAdjacentNodeCount> &oldNodeMaterials, const std::array<const Material *, PathNode::c_MaxAdjacentNodeCount> &newNodeMaterials) const;
+#pragma endregion
 
 #pragma region Path Cost Updates
 		/// <summary>
@@ -241,17 +664,25 @@ namespace RTE {
 		/// Gets the cost for transitioning through this Material.
 		/// </summary>
 		/// <param name="material">The Material to get the transition cost for.</param>
+		/// <param name="digStrength">What material strength the search is capable of digging through.</param>
 		/// <returns>The transition cost for the Material.</returns>
-		float GetMaterialTransitionCost(const Material &material) const;
+		float GetMaterialTransitionCost(const Material &material, float digStrength) const;
 
 		/// <summary>
-		/// Gets the average cost for all transitions out of this PathNode, ignoring infinities/unpathable transitions.
+		/// Gets the average cost for all transitions out of a PathNode, ignoring infinities/unpathable transitions.
 		/// </summary>
-		/// <param name="node">The PathNode to get the average transition cost for.</param>
+		/// <param name="nodeMaterials">The blocking Materials of the PathNode to get the average transition cost for.</param>
 		/// <returns>The average transition cost.</returns>
-		float GetNodeAverageTransitionCost(const PathNode &node) const;
+		float GetNodeAverageTransitionCost(const std::array<const Material *, PathNode::c_MaxAdjacentNodeCount> &nodeMaterials) const;
 #pragma endregion
 
+		/// <summary>
+		/// Gets the id of a PathNode.
+		/// </summary>
+		/// <param name="node">The PathNode to get the id of.</param>
+		/// <returns>The id of the PathNode.</returns>
+		int GetNodeId(const PathNode *node) const { return static_cast<int>(node - m_NodeGrid.data()); }
+
 		/// <summary>
 		/// Gets the PathNode at the given coordinates.
 		/// </summary>
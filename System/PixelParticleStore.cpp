@@ -0,0 +1,480 @@
+#include "PixelParticleStore.h"
+
+#include "MOPixel.h"
+#include "Atom.h"
+#include "SLTerrain.h"
+
+#include "SceneMan.h"
+#include "TimerMan.h"
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleStore::Clear() {
+		std::lock_guard<std::mutex> pendingParticlesLock(m_PendingParticlesMutex);
+		m_PendingParticles.clear();
+
+		m_PosX.clear();
+		m_PosY.clear();
+		m_VelX.clear();
+		m_VelY.clear();
+		m_PrevVelX.clear();
+		m_PrevVelY.clear();
+		m_Mass.clear();
+		m_Sharpness.clear();
+		m_GlobalAccScalar.clear();
+		m_AirResistance.clear();
+		m_AirThreshold.clear();
+		m_Staininess.clear();
+		m_AgeMS.clear();
+		m_LifetimeMS.clear();
+		m_RestTimeMS.clear();
+		m_RestThreshold.clear();
+		m_NumPenetrations.clear();
+		m_VelOscillations.clear();
+		m_MaterialID.clear();
+		m_ColorIndex.clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PixelParticleStore::CanStore(const MovableObject *movableObject) {
+		const MOPixel *pixel = dynamic_cast<const MOPixel *>(movableObject);
+		if (!pixel) {
+			return false;
+		}
+
+		// Anything that other objects or scripts could observe or interact with has to stay a full MovableObject.
+		if (pixel->HasAnyScripts() || pixel->HitsMOs() || pixel->GetsHitByMOs() || pixel->IsMissionCritical() || pixel->IsSetToDelete()) {
+			return false;
+		}
+		if (pixel->IgnoreTerrain() || pixel->GetPinStrength() > 0 || pixel->GetScreenEffect() || pixel->GetRemoveOrphanTerrainRadius() > 0) {
+			return false;
+		}
+		const Atom *atom = pixel->GetAtom();
+		return atom && atom->GetTrailLength() == 0 && atom->GetOffset().IsZero();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleStore::Add(const MOPixel &pixel) {
+		PendingParticle pendingParticle;
+		pendingParticle.PosX = pixel.GetPos().GetX();
+		pendingParticle.PosY = pixel.GetPos().GetY();
+		pendingParticle.VelX = pixel.GetVel().GetX();
+		pendingParticle.VelY = pixel.GetVel().GetY();
+		pendingParticle.Mass = pixel.GetMass();
+		pendingParticle.Sharpness = pixel.GetSharpness();
+		pendingParticle.GlobalAccScalar = pixel.GetGlobalAccScalar();
+		pendingParticle.AirResistance = pixel.GetAirResistance();
+		pendingParticle.AirThreshold = pixel.GetAirThreshold();
+		pendingParticle.Staininess = pixel.GetStaininess();
+		pendingParticle.LifetimeMS = static_cast<float>(pixel.GetLifetime());
+		pendingParticle.RestThreshold = pixel.GetRestThreshold();
+		pendingParticle.MaterialID = static_cast<unsigned char>(pixel.GetMaterial()->GetIndex());
+		pendingParticle.ColorIndex = static_cast<unsigned char>(pixel.GetColor().GetIndex());
+
+		std::lock_guard<std::mutex> pendingParticlesLock(m_PendingParticlesMutex);
+		m_PendingParticles.emplace_back(pendingParticle);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleStore::CommitAddedParticles() {
+		std::lock_guard<std::mutex> pendingParticlesLock(m_PendingParticlesMutex);
+		for (const PendingParticle &pendingParticle : m_PendingParticles) {
+			m_PosX.emplace_back(pendingParticle.PosX);
+			m_PosY.emplace_back(pendingParticle.PosY);
+			m_VelX.emplace_back(pendingParticle.VelX);
+			m_VelY.emplace_back(pendingParticle.VelY);
+			m_PrevVelX.emplace_back(pendingParticle.VelX);
+			m_PrevVelY.emplace_back(pendingParticle.VelY);
+			m_Mass.emplace_back(pendingParticle.Mass);
+			m_Sharpness.emplace_back(pendingParticle.Sharpness);
+			m_GlobalAccScalar.emplace_back(pendingParticle.GlobalAccScalar);
+			m_AirResistance.emplace_back(pendingParticle.AirResistance);
+			m_AirThreshold.emplace_back(pendingParticle.AirThreshold);
+			m_Staininess.emplace_back(pendingParticle.Staininess);
+			m_AgeMS.emplace_back(0.0F);
+			m_LifetimeMS.emplace_back(pendingParticle.LifetimeMS);
+			m_RestTimeMS.emplace_back(0.0F);
+			m_RestThreshold.emplace_back(pendingParticle.RestThreshold);
+			m_NumPenetrations.emplace_back(0);
+			m_VelOscillations.emplace_back(0);
+			m_MaterialID.emplace_back(pendingParticle.MaterialID);
+			m_ColorIndex.emplace_back(pendingParticle.ColorIndex);
+		}
+		m_PendingParticles.clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleStore::Update(bool settlingEnabled) {
+		if (m_PosX.empty()) {
+			return;
+		}
+		const float deltaTime = g_TimerMan.GetDeltaTimeSecs();
+
+		Integrate(deltaTime);
+
+		bool sceneWasLocked = g_SceneMan.SceneIsLocked();
+		if (!sceneWasLocked) { g_SceneMan.LockScene(); }
+
+		size_t particleIndex = 0;
+		while (particleIndex < m_PosX.size()) {
+			Vector prevPos(m_PosX[particleIndex], m_PosY[particleIndex]);
+			Vector vel(m_VelX[particleIndex], m_VelY[particleIndex]);
+
+			// Same speed limits as MOPixel::Travel and MovableObject::PostTravel.
+			bool isAlive = vel.MagnitudeIsGreaterThan(500.0F) || TravelParticle(particleIndex, deltaTime);
+			if (isAlive) {
+				vel.SetXY(m_VelX[particleIndex], m_VelY[particleIndex]);
+				if (vel.MagnitudeIsGreaterThan(500.0F)) {
+					vel.SetMagnitude(450.0F);
+					m_VelX[particleIndex] = vel.GetX();
+					m_VelY[particleIndex] = vel.GetY();
+				}
+				bool isExpired = m_LifetimeMS[particleIndex] > 0 && m_AgeMS[particleIndex] > m_LifetimeMS[particleIndex];
+				isAlive = !isExpired && g_SceneMan.IsWithinBounds(static_cast<int>(m_PosX[particleIndex]), static_cast<int>(m_PosY[particleIndex]), 1000);
+			}
+			if (isAlive && UpdateRestDetection(particleIndex, prevPos, deltaTime) && settlingEnabled) {
+				SettleParticle(particleIndex);
+				isAlive = false;
+			}
+
+			if (isAlive) {
+				++particleIndex;
+			} else {
+				RemoveParticle(particleIndex);
+			}
+		}
+
+		if (!sceneWasLocked) { g_SceneMan.UnlockScene(); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleStore::Draw(BITMAP *targetBitmap, const Vector &targetPos) const {
+		if (!g_TimerMan.DrawnSimUpdate()) {
+			return;
+		}
+		for (size_t particleIndex = 0; particleIndex < m_PosX.size(); ++particleIndex) {
+			Vector pixelPos(m_PosX[particleIndex] - targetPos.GetX(), m_PosY[particleIndex] - targetPos.GetY());
+			putpixel(targetBitmap, pixelPos.GetFloorIntX(), pixelPos.GetFloorIntY(), m_ColorIndex[particleIndex]);
+			g_SceneMan.RegisterDrawing(targetBitmap, g_NoMOID, pixelPos, 1.0F);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleStore::DrawMaterial(BITMAP *targetBitmap, const Vector &targetPos) const {
+		for (size_t particleIndex = 0; particleIndex < m_PosX.size(); ++particleIndex) {
+			Vector pixelPos(m_PosX[particleIndex] - targetPos.GetX(), m_PosY[particleIndex] - targetPos.GetY());
+			putpixel(targetBitmap, pixelPos.GetFloorIntX(), pixelPos.GetFloorIntY(), g_SceneMan.GetMaterialFromID(m_MaterialID[particleIndex])->GetSettleMaterial());
+			g_SceneMan.RegisterDrawing(targetBitmap, g_NoMOID, pixelPos, 1.0F);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleStore::Integrate(float deltaTime) {
+		const Vector globalAcc = g_SceneMan.GetGlobalAcc() * deltaTime;
+		const float deltaTimeMS = deltaTime * 1000.0F;
+		const size_t particleCount = m_PosX.size();
+
+		float *velX = m_VelX.data();
+		float *velY = m_VelY.data();
+		float *prevVelX = m_PrevVelX.data();
+		float *prevVelY = m_PrevVelY.data();
+		float *ageMS = m_AgeMS.data();
+		const float *globalAccScalar = m_GlobalAccScalar.data();
+		const float *airResistance = m_AirResistance.data();
+		const float *airThreshold = m_AirThreshold.data();
+
+		for (size_t particleIndex = 0; particleIndex < particleCount; ++particleIndex) {
+			float newVelX = velX[particleIndex] + globalAcc.GetX() * globalAccScalar[particleIndex];
+			float newVelY = velY[particleIndex] + globalAcc.GetY() * globalAccScalar[particleIndex];
+
+			// Air resistance only applies when something flies faster than its threshold. Selected rather than branched on, so the loop stays vectorizable.
+			float largestVel = std::max(std::abs(newVelX), std::abs(newVelY));
+			float airResistanceFactor = (airResistance[particleIndex] > 0 && largestVel >= airThreshold[particleIndex]) ? 1.0F - (airResistance[particleIndex] * deltaTime) : 1.0F;
+			newVelX *= airResistanceFactor;
+			newVelY *= airResistanceFactor;
+
+			velX[particleIndex] = newVelX;
+			velY[particleIndex] = newVelY;
+			prevVelX[particleIndex] = newVelX;
+			prevVelY[particleIndex] = newVelY;
+			ageMS[particleIndex] += deltaTimeMS;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PixelParticleStore::TravelParticle(size_t particleIndex, float travelTime) {
+		Vector position(m_PosX[particleIndex], m_PosY[particleIndex]);
+		Vector velocity(m_VelX[particleIndex], m_VelY[particleIndex]);
+		const float impulseScale = m_Mass[particleIndex] * m_Sharpness[particleIndex];
+		const Material *material = g_SceneMan.GetMaterialFromID(m_MaterialID[particleIndex]);
+		int &numPenetrations = m_NumPenetrations[particleIndex];
+
+		int intPos[2];
+		int hitPos[2];
+		int delta[2];
+		int delta2[2];
+		int increment[2];
+
+		float timeLeft = travelTime;
+		float retardation = 0.0F;
+		int hitCount = 0;
+		bool hit = false;
+		Vector segTraj;
+
+		// This is Atom::Travel reduced to what a plain MOPixel can do: Bresenham stepping through the terrain, penetrating, sticking or bouncing on the way.
+		do {
+			intPos[X] = static_cast<int>(std::floor(position.GetX()));
+			intPos[Y] = static_cast<int>(std::floor(position.GetY()));
+
+			segTraj = velocity * timeLeft * c_PPM;
+
+			delta[X] = static_cast<int>(std::floor(position.GetX() + segTraj.GetX())) - intPos[X];
+			delta[Y] = static_cast<int>(std::floor(position.GetY() + segTraj.GetY())) - intPos[Y];
+
+			hit = false;
+			if (delta[X] == 0 && delta[Y] == 0) {
+				break;
+			}
+
+			for (int axis : { X, Y }) {
+				increment[axis] = delta[axis] < 0 ? -1 : 1;
+				delta[axis] = std::abs(delta[axis]);
+				delta2[axis] = delta[axis] << 1;
+			}
+			int dom = delta[X] > delta[Y] ? X : Y;
+			int sub = dom == X ? Y : X;
+			int error = delta2[sub] - delta[dom];
+
+			int subSteps = 0;
+			bool subStepped = false;
+			bool sinkHit = false;
+			Vector hitAccel;
+
+			for (int domSteps = 0; domSteps < delta[dom] && !hit; ++domSteps) {
+				// Particles can start out embedded if something was just settled on top of them.
+				if (domSteps == 0 && g_SceneMan.GetTerrMatter(intPos[X], intPos[Y]) != g_MaterialAir) {
+					++hitCount;
+					hit = true;
+					if (g_SceneMan.TryPenetrate(intPos[X], intPos[Y], velocity * impulseScale, velocity, retardation, 0.5F, numPenetrations)) {
+						velocity += velocity * retardation;
+					} else {
+						velocity.Reset();
+						timeLeft = 0.0F;
+					}
+					break;
+				}
+
+				if (subStepped) { ++subSteps; }
+				subStepped = false;
+
+				intPos[dom] += increment[dom];
+				if (error >= 0) {
+					intPos[sub] += increment[sub];
+					subStepped = true;
+					error -= delta2[dom];
+				}
+				error += delta2[sub];
+
+				g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
+
+				unsigned char hitMaterialID = g_SceneMan.GetTerrMatter(intPos[X], intPos[Y]);
+				if (hitMaterialID == g_MaterialAir) {
+					continue;
+				}
+				hit = true;
+				++hitCount;
+				hitPos[X] = intPos[X];
+				hitPos[Y] = intPos[Y];
+
+				if (hitMaterialID != g_MaterialOutOfBounds && g_SceneMan.TryPenetrate(intPos[X], intPos[Y], velocity * impulseScale, velocity, retardation, 0.65F, numPenetrations)) {
+					sinkHit = true;
+					++numPenetrations;
+					hitAccel = velocity * retardation;
+				} else {
+					numPenetrations = 0;
+
+					// Back up so the particle is not inside the terrain.
+					intPos[dom] -= increment[dom];
+					if (subStepped) { intPos[sub] -= increment[sub]; }
+					g_SceneMan.WrapPosition(intPos[X], intPos[Y]);
+
+					// Sticky or staining particles adhere to where they collided.
+					if (velocity.MagnitudeIsGreaterThan(1.0F)) {
+						float stickiness = material->GetStickiness();
+						float staininess = m_Staininess[particleIndex];
+						if (RandomNum() < std::max(stickiness, staininess)) {
+							const float randomChoice = RandomNum(0.0F, stickiness + staininess);
+							if (randomChoice <= stickiness) {
+								DrawParticleToTerrain(particleIndex, intPos[X], intPos[Y]);
+								return false;
+							} else if (randomChoice <= stickiness + staininess) {
+								Vector stickPos(static_cast<float>(intPos[X]), static_cast<float>(intPos[Y]));
+								stickPos += velocity * (c_PPM * g_TimerMan.GetDeltaTimeSecs()) * RandomNum();
+								int terrainMaterialID = g_SceneMan.GetTerrain()->GetMaterialPixel(stickPos.GetFloorIntX(), stickPos.GetFloorIntY());
+								if (terrainMaterialID != g_MaterialAir && terrainMaterialID != g_MaterialDoor) {
+									DrawParticleToTerrain(particleIndex, stickPos.GetRoundIntX(), stickPos.GetRoundIntY());
+								} else {
+									DrawParticleToTerrain(particleIndex, intPos[X], intPos[Y]);
+								}
+								return false;
+							}
+						}
+					}
+
+					// Gets the terrain next to the hit pixel along an axis, to figure out which way the surface faces.
+					auto terrMatterAlongAxis = [&intPos, &hitPos](int axis) { return axis == X ? g_SceneMan.GetTerrMatter(hitPos[X], intPos[Y]) : g_SceneMan.GetTerrMatter(intPos[X], hitPos[Y]); };
+
+					const Material *domMaterial = nullptr;
+					const Material *subMaterial = nullptr;
+					if (delta[dom]) {
+						if (unsigned char domMaterialID = terrMatterAlongAxis(dom)) {
+							domMaterial = g_SceneMan.GetMaterialFromID(domMaterialID);
+							hitAccel[dom] = -velocity[dom] - velocity[dom] * material->GetRestitution() * domMaterial->GetRestitution();
+						}
+					}
+					if (subStepped && delta[sub]) {
+						if (unsigned char subMaterialID = terrMatterAlongAxis(sub)) {
+							subMaterial = g_SceneMan.GetMaterialFromID(subMaterialID);
+							hitAccel[sub] = -velocity[sub] - velocity[sub] * material->GetRestitution() * subMaterial->GetRestitution();
+						}
+					}
+
+					if (!domMaterial && !subMaterial) {
+						// Hit right on the corner of a pixel, bounce straight back with no friction.
+						const Material *hitMaterial = g_SceneMan.GetMaterialFromID(hitMaterialID);
+						hitAccel[dom] = -velocity[dom] - velocity[dom] * material->GetRestitution() * hitMaterial->GetRestitution();
+						hitAccel[sub] = -velocity[sub] - velocity[sub] * material->GetRestitution() * hitMaterial->GetRestitution();
+					} else if (domMaterial && !subMaterial) {
+						hitAccel[sub] -= velocity[sub] * material->GetFriction() * domMaterial->GetFriction();
+					} else if (subMaterial && !domMaterial) {
+						hitAccel[dom] -= velocity[dom] * material->GetFriction() * subMaterial->GetFriction();
+					}
+				}
+
+				// Move up to the hit and spend the travel time that took. Sinking counts the hit step, because the particle wasn't backed out of the terrain.
+				int domProgress = domSteps + static_cast<int>(sinkHit);
+				int subProgress = subSteps + static_cast<int>(subStepped && sinkHit);
+				float segProgress = domProgress < delta[dom] ? static_cast<float>(domProgress) / std::fabs(segTraj[dom]) : 1.0F;
+				timeLeft -= timeLeft * segProgress;
+
+				position[dom] += static_cast<float>(domProgress * increment[dom]);
+				if (subProgress < delta[sub]) {
+					position[sub] += static_cast<float>(subProgress * increment[sub]);
+				} else {
+					position[sub] += segTraj[sub];
+				}
+				velocity += hitAccel;
+			}
+		} while (hit && hitCount < 100);
+
+		if (!hit) { position += segTraj; }
+		g_SceneMan.WrapPosition(position);
+
+		m_PosX[particleIndex] = position.GetX();
+		m_PosY[particleIndex] = position.GetY();
+		m_VelX[particleIndex] = velocity.GetX();
+		m_VelY[particleIndex] = velocity.GetY();
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool PixelParticleStore::UpdateRestDetection(size_t particleIndex, const Vector &prevPos, float deltaTime) {
+		Vector pos(m_PosX[particleIndex], m_PosY[particleIndex]);
+
+		if (m_VelX[particleIndex] * m_PrevVelX[particleIndex] + m_VelY[particleIndex] * m_PrevVelY[particleIndex] < 0) {
+			m_VelOscillations[particleIndex] = static_cast<unsigned char>(std::min(m_VelOscillations[particleIndex] + 1, 255));
+		} else {
+			m_VelOscillations[particleIndex] = 0;
+		}
+		if ((pos - prevPos).MagnitudeIsGreaterThan(1.0F)) {
+			m_RestTimeMS[particleIndex] = 0.0F;
+		} else {
+			m_RestTimeMS[particleIndex] += deltaTime * 1000.0F;
+		}
+
+		int restThreshold = m_RestThreshold[particleIndex];
+		bool isAtRest = restThreshold >= 0 && (m_VelOscillations[particleIndex] > 2 || m_RestTimeMS[particleIndex] > static_cast<float>(restThreshold));
+
+		// If we seem to be about to settle, make sure we're not still flying in the air.
+		if (isAtRest && g_SceneMan.OverAltitude(pos, 2, 0)) {
+			m_VelOscillations[particleIndex] = 0;
+			m_RestTimeMS[particleIndex] = 0.0F;
+			isAtRest = false;
+		}
+		return isAtRest;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleStore::SettleParticle(size_t particleIndex) {
+		const Material *material = g_SceneMan.GetMaterialFromID(m_MaterialID[particleIndex]);
+		Vector settlePos(m_PosX[particleIndex], m_PosY[particleIndex]);
+		const Material *terrMat = g_SceneMan.GetMaterialFromID(g_SceneMan.GetTerrain()->GetMaterialPixel(settlePos.GetFloorIntX(), settlePos.GetFloorIntY()));
+
+		if (int piling = material->GetPiling(); piling > 0) {
+			for (int s = 0; s < piling && (terrMat->GetIndex() == material->GetIndex() || terrMat->GetIndex() == material->GetSettleMaterial()); ++s) {
+				if ((piling - s) % 2 == 0) {
+					settlePos.m_Y -= 1.0F;
+				} else {
+					settlePos.m_X += (RandomNum() >= 0.5F ? 1.0F : -1.0F);
+				}
+				terrMat = g_SceneMan.GetMaterialFromID(g_SceneMan.GetTerrain()->GetMaterialPixel(settlePos.GetFloorIntX(), settlePos.GetFloorIntY()));
+			}
+		}
+		if (material->GetPriority() >= terrMat->GetPriority()) { DrawParticleToTerrain(particleIndex, settlePos.GetFloorIntX(), settlePos.GetFloorIntY()); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleStore::DrawParticleToTerrain(size_t particleIndex, int posX, int posY) const {
+		SLTerrain *terrain = g_SceneMan.GetTerrain();
+		putpixel(terrain->GetFGColorBitmap(), posX, posY, m_ColorIndex[particleIndex]);
+
+		const Material *material = g_SceneMan.GetMaterialFromID(m_MaterialID[particleIndex]);
+		if (material->GetPriority() > g_SceneMan.GetMaterialFromID(terrain->GetMaterialPixel(posX, posY))->GetPriority()) {
+			putpixel(terrain->GetMaterialBitmap(), posX, posY, material->GetSettleMaterial());
+		}
+		g_SceneMan.RegisterTerrainChange(posX, posY, 1, 1, DrawMode::g_DrawColor, false);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelParticleStore::RemoveParticle(size_t particleIndex) {
+		// Order doesn't matter, so fill the gap with the last particle instead of shifting everything down.
+		auto swapAndPop = [particleIndex](auto &values) {
+			values[particleIndex] = values.back();
+			values.pop_back();
+		};
+		swapAndPop(m_PosX);
+		swapAndPop(m_PosY);
+		swapAndPop(m_VelX);
+		swapAndPop(m_VelY);
+		swapAndPop(m_PrevVelX);
+		swapAndPop(m_PrevVelY);
+		swapAndPop(m_Mass);
+		swapAndPop(m_Sharpness);
+		swapAndPop(m_GlobalAccScalar);
+		swapAndPop(m_AirResistance);
+		swapAndPop(m_AirThreshold);
+		swapAndPop(m_Staininess);
+		swapAndPop(m_AgeMS);
+		swapAndPop(m_LifetimeMS);
+		swapAndPop(m_RestTimeMS);
+		swapAndPop(m_RestThreshold);
+		swapAndPop(m_NumPenetrations);
+		swapAndPop(m_VelOscillations);
+		swapAndPop(m_MaterialID);
+		swapAndPop(m_ColorIndex);
+	}
+}
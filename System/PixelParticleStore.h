@@ -0,0 +1,169 @@
+#ifndef _RTEPIXELPARTICLESTORE_
+#define _RTEPIXELPARTICLESTORE_
+
+#include "Vector.h"
+
+struct BITMAP;
+
+namespace RTE {
+
+	class MovableObject;
+	class MOPixel;
+
+	/// <summary>
+	/// A structure-of-arrays store for plain MOPixels, such as blood, debris and sparks, that don't need to exist as full MovableObjects.
+	/// Each property lives in its own contiguous array, so the integration step runs over tightly packed floats and only the terrain collision step touches each particle individually.
+	/// </summary>
+	class PixelParticleStore {
+
+	public:
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a PixelParticleStore object in system memory.
+		/// </summary>
+		PixelParticleStore() { Clear(); }
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Removes all particles from this PixelParticleStore, including ones that were added this frame.
+		/// </summary>
+		void Clear();
+#pragma endregion
+
+#pragma region Getters
+		/// <summary>
+		/// Gets the number of particles currently in this PixelParticleStore, not counting ones that were added this frame.
+		/// </summary>
+		/// <returns>The number of particles.</returns>
+		size_t GetParticleCount() const { return m_PosX.size(); }
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Gets whether a MovableObject can be represented by this PixelParticleStore without any change in behavior visible to the rest of the simulation.
+		/// That means a MOPixel with no scripts, no MO collisions in either direction, no trail, glow or pinning, that isn't mission critical.
+		/// </summary>
+		/// <param name="movableObject">The MovableObject to check.</param>
+		/// <returns>Whether the MovableObject can be added to this PixelParticleStore.</returns>
+		static bool CanStore(const MovableObject *movableObject);
+
+		/// <summary>
+		/// Copies the state of a MOPixel into this PixelParticleStore. The particle becomes part of the simulation at the start of the next update.
+		/// Thread safe, so it can be called from anywhere particles can be added to MovableMan.
+		/// </summary>
+		/// <param name="pixel">The MOPixel to copy. Ownership is NOT transferred, the caller is expected to delete it afterwards.</param>
+		void Add(const MOPixel &pixel);
+
+		/// <summary>
+		/// Moves particles that were added since the last call into the simulated arrays.
+		/// </summary>
+		void CommitAddedParticles();
+
+		/// <summary>
+		/// Integrates, travels and ages all particles by one simulation update, removing those that got stuck, expired, went out of bounds or came to rest.
+		/// </summary>
+		/// <param name="settlingEnabled">Whether particles that come to rest should be settled into the terrain. Otherwise they stay in the simulation, like regular particles do.</param>
+		void Update(bool settlingEnabled);
+
+		/// <summary>
+		/// Draws the color of all particles to a BITMAP of choice. Only draws on drawn simulation updates, like MOPixel does.
+		/// </summary>
+		/// <param name="targetBitmap">A pointer to a BITMAP to draw on.</param>
+		/// <param name="targetPos">The absolute position of the target bitmap's upper left corner in the Scene.</param>
+		void Draw(BITMAP *targetBitmap, const Vector &targetPos = Vector()) const;
+
+		/// <summary>
+		/// Draws the settle material of all particles to a BITMAP of choice.
+		/// </summary>
+		/// <param name="targetBitmap">A pointer to a BITMAP to draw on.</param>
+		/// <param name="targetPos">The absolute position of the target bitmap's upper left corner in the Scene.</param>
+		void DrawMaterial(BITMAP *targetBitmap, const Vector &targetPos) const;
+#pragma endregion
+
+	private:
+
+		/// <summary>
+		/// The full state of a single particle, used to stage particles added from other code until they're committed.
+		/// </summary>
+		struct PendingParticle {
+			float PosX, PosY, VelX, VelY, Mass, Sharpness, GlobalAccScalar, AirResistance, AirThreshold, Staininess;
+			float LifetimeMS;
+			int RestThreshold;
+			unsigned char MaterialID, ColorIndex;
+		};
+
+		std::mutex m_PendingParticlesMutex; //!< Mutex to ensure particles can be added from multiple threads.
+		std::vector<PendingParticle> m_PendingParticles; //!< Particles added since the last commit.
+
+		std::vector<float> m_PosX; //!< X positions, in pixels.
+		std::vector<float> m_PosY; //!< Y positions, in pixels.
+		std::vector<float> m_VelX; //!< X velocities, in m/s.
+		std::vector<float> m_VelY; //!< Y velocities, in m/s.
+		std::vector<float> m_PrevVelX; //!< X velocities at the start of the current update, used for rest detection.
+		std::vector<float> m_PrevVelY; //!< Y velocities at the start of the current update, used for rest detection.
+		std::vector<float> m_Mass; //!< Masses, in kg.
+		std::vector<float> m_Sharpness; //!< Sharpness values, used when trying to penetrate the terrain.
+		std::vector<float> m_GlobalAccScalar; //!< How much each particle is affected by global acceleration (gravity).
+		std::vector<float> m_AirResistance; //!< Air resistance ratios, per second.
+		std::vector<float> m_AirThreshold; //!< Velocities below which air resistance doesn't apply, in m/s.
+		std::vector<float> m_Staininess; //!< How likely each particle is to stain a surface it collides with.
+		std::vector<float> m_AgeMS; //!< Simulated ages, in ms.
+		std::vector<float> m_LifetimeMS; //!< Lifetimes, in ms. 0 means unlimited.
+		std::vector<float> m_RestTimeMS; //!< How long each particle hasn't moved more than a pixel, in ms.
+		std::vector<int> m_RestThreshold; //!< How long each particle needs to be still to be considered at rest, in ms. Negative means never.
+		std::vector<int> m_NumPenetrations; //!< How many consecutive terrain pixels each particle has penetrated.
+		std::vector<unsigned char> m_VelOscillations; //!< How many consecutive updates each particle's velocity has reversed.
+		std::vector<unsigned char> m_MaterialID; //!< Material indices.
+		std::vector<unsigned char> m_ColorIndex; //!< Palette color indices.
+
+		/// <summary>
+		/// Applies gravity and air resistance to all particles and ages them. Branch free, so it vectorizes.
+		/// </summary>
+		/// <param name="deltaTime">The simulation update duration, in seconds.</param>
+		void Integrate(float deltaTime);
+
+		/// <summary>
+		/// Moves a particle through the terrain along its velocity, penetrating, bouncing or sticking as a MOPixel's Atom would.
+		/// </summary>
+		/// <param name="particleIndex">The index of the particle to travel.</param>
+		/// <param name="travelTime">The time to travel for, in seconds.</param>
+		/// <returns>Whether the particle is still alive after traveling.</returns>
+		bool TravelParticle(size_t particleIndex, float travelTime);
+
+		/// <summary>
+		/// Gets whether a particle has come to rest, as MOPixel::RestDetection and MovableObject::IsAtRest would decide.
+		/// </summary>
+		/// <param name="particleIndex">The index of the particle to check.</param>
+		/// <param name="prevPos">The position of the particle at the start of the current update.</param>
+		/// <param name="deltaTime">The simulation update duration, in seconds.</param>
+		/// <returns>Whether the particle is at rest.</returns>
+		bool UpdateRestDetection(size_t particleIndex, const Vector &prevPos, float deltaTime);
+
+		/// <summary>
+		/// Piles a particle that came to rest on top of matching material and copies it into the terrain.
+		/// </summary>
+		/// <param name="particleIndex">The index of the particle to settle.</param>
+		void SettleParticle(size_t particleIndex);
+
+		/// <summary>
+		/// Copies a particle's color and material into the terrain at a given position.
+		/// </summary>
+		/// <param name="particleIndex">The index of the particle to draw.</param>
+		/// <param name="posX">The X coordinate to draw at.</param>
+		/// <param name="posY">The Y coordinate to draw at.</param>
+		void DrawParticleToTerrain(size_t particleIndex, int posX, int posY) const;
+
+		/// <summary>
+		/// Removes a particle by moving the last particle into its place.
+		/// </summary>
+		/// <param name="particleIndex">The index of the particle to remove.</param>
+		void RemoveParticle(size_t particleIndex);
+
+		// Disallow the use of some implicit methods.
+		PixelParticleStore(const PixelParticleStore &reference) = delete;
+		PixelParticleStore & operator=(const PixelParticleStore &rhs) = delete;
+	};
+}
+#endif
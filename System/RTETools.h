@@ -82,6 +82,13 @@ namespace RTE {
 	};
 
 	extern RandomGenerator g_RandomGenerator; //!< The global random number generator used in our simulation thread. 
+	inline thread_local RandomGenerator *g_ThreadRandomGenerator = nullptr; //!< Random number generator override for the current thread, used by parallel simulation stages so their results don't depend on scheduling.
+
+	/// <summary>
+	/// Gets the random number generator the calling thread should use for simulation randomness.
+	/// </summary>
+	/// <returns>The thread's override random number generator if one is set, otherwise the global one.</returns>
+	inline RandomGenerator & GetSimulationRandomGenerator() { return g_ThreadRandomGenerator ? *g_ThreadRandomGenerator : g_RandomGenerator; }
 
 	/// <summary>
 	/// Seed global the global random number generators.
@@ -92,32 +99,32 @@ namespace RTE {
 	// Or, in future, a render-thread random, as right now determinism isn't viable because framerate affects sim updates per draw
 	template <typename floatType = float>
 	typename std::enable_if<std::is_floating_point<floatType>::value, floatType>::type RandomNormalNum() {
-		return g_RandomGenerator.RandomNormalNum();
+		return GetSimulationRandomGenerator().RandomNormalNum();
 	}
 
 	template <typename intType>
 	typename std::enable_if<std::is_integral<intType>::value, intType>::type RandomNormalNum() {
-		return g_RandomGenerator.RandomNormalNum();
+		return GetSimulationRandomGenerator().RandomNormalNum();
 	}
 
 	template <typename floatType = float>
 	typename std::enable_if<std::is_floating_point<floatType>::value, floatType>::type RandomNum() {
-		return g_RandomGenerator.RandomNum();
+		return GetSimulationRandomGenerator().RandomNum();
 	}
 
 	template <typename intType>
 	typename std::enable_if<std::is_integral<intType>::value, intType>::type RandomNum() {
-		return g_RandomGenerator.RandomNum();
+		return GetSimulationRandomGenerator().RandomNum();
 	}
 
 	template <typename floatType = float>
 	typename std::enable_if<std::is_floating_point<floatType>::value, floatType>::type RandomNum(floatType min, floatType max) {
-		return g_RandomGenerator.RandomNum(min, max);
+		return GetSimulationRandomGenerator().RandomNum(min, max);
 	}
 
 	template <typename intType>
 	typename std::enable_if<std::is_integral<intType>::value, intType>::type RandomNum(intType min, intType max) {
-		return g_RandomGenerator.RandomNum(min, max);
+		return GetSimulationRandomGenerator().RandomNum(min, max);
 	}
 	#pragma endregion
 
@@ -2,9 +2,18 @@
 #include "ConsoleMan.h"
 #include "PresetMan.h"
 #include "SettingsMan.h"
+#include "GameVersion.h"
+#include "RTETools.h"
 
 namespace RTE {
 
+	const std::string Reader::c_FileCacheSignature = "RTEParsedFileCache2";
+
+	std::mutex Reader::s_ParsedFilesMutex;
+	std::unordered_map<std::string, Reader::HashedParsedFile> Reader::s_ParsedFiles;
+	std::unordered_map<std::string, Reader::HashedParsedFile> Reader::s_CachedParsedFiles;
+	bool Reader::s_FileCacheIsStale = false;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void Reader::Clear() {
@@ -15,6 +24,8 @@ namespace RTE {
 		m_IndentDifference = 0;
 		m_ObjectEndings = 0;
 		m_EndOfStreams = false;
+		m_ParsedFile = nullptr;
+		m_NextPropertyIndex = 0;
 		m_ReportProgress = nullptr;
 		m_ReportTabs = "\t";
 		m_FileName.clear();
@@ -62,12 +73,28 @@ namespace RTE {
 			m_DataModuleID = g_PresetMan.GetModuleID(m_DataModuleName);
 		}
 
-		return Create(std::make_unique<std::ifstream>(m_FilePath), overwrites, progressCallback, failOK);
+		// Files parsed ahead of time are read from their parsed properties, through a stream that's pointed at each property's text in turn.
+		m_ParsedFile = GetParsedFile(m_FilePath);
+		m_NextPropertyIndex = 0;
+		return Create(m_ParsedFile ? std::make_unique<MemoryStream>(std::string()) : OpenFileStream(m_FilePath), overwrites, progressCallback, failOK);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int Reader::Create(std::unique_ptr<std::istream> &&stream, bool overwrites, const ProgressCallback &progressCallback, bool failOK) {
+		m_ParsedFile = nullptr;
+		if (stream && stream->good()) {
+			std::string streamContents((std::istreambuf_iterator<char>(*stream)), std::istreambuf_iterator<char>());
+			return Create(std::make_unique<MemoryStream>(std::move(streamContents)), overwrites, progressCallback, failOK);
+		}
+		std::unique_ptr<MemoryStream> failedStream = std::make_unique<MemoryStream>(std::string());
+		failedStream->setstate(std::ios::failbit);
+		return Create(std::move(failedStream), overwrites, progressCallback, failOK);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int Reader::Create(std::unique_ptr<MemoryStream> &&stream, bool overwrites, const ProgressCallback &progressCallback, bool failOK) {
 		m_CanFail = failOK;
 
 		m_Stream = std::move(stream);
@@ -96,9 +123,9 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	std::string Reader::WholeFileAsString() const {
-		std::stringstream stringStream;
-		stringStream << m_Stream->rdbuf();
-		return stringStream.str();
+		std::string_view remainingContents = GetRemainingStreamContents();
+		m_Stream->GetBuffer().Advance(remainingContents.size());
+		return std::string(remainingContents);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -106,26 +133,11 @@ namespace RTE {
 	std::string Reader::ReadLine() {
 		DiscardEmptySpace();
 
-		std::string retString;
-		char temp;
-		char peek = static_cast<char>(m_Stream->peek());
-
-		while (peek != '\n' && peek != '\r' && peek != '\t') {
-			temp = static_cast<char>(m_Stream->get());
-
-			// Check for line comment "//"
-			if (peek == '/' && m_Stream->peek() == '/') {
-				m_Stream->unget();
-				break;
-			}
-
-			if (m_Stream->eof()) { break; }
-			if (!m_Stream->good()) { ReportError("Stream failed for some reason"); }
-
-			retString.append(1, temp);
-			peek = static_cast<char>(m_Stream->peek());
-		}
-		return TrimString(retString);
+		std::string_view remainingContents = GetRemainingStreamContents();
+		size_t lineLength = GetLineDataLength(remainingContents);
+		std::string retString(TrimSpaces(remainingContents.substr(0, lineLength)));
+		AdvanceStream(lineLength);
+		return retString;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -133,34 +145,25 @@ namespace RTE {
 	std::string Reader::ReadPropName() {
 		DiscardEmptySpace();
 
-		std::string retString;
-		char temp;
-		char peek;
+		std::string_view remainingContents = GetRemainingStreamContents();
+		size_t nameLength = std::min(remainingContents.find('='), remainingContents.size());
+		std::string_view propName = remainingContents.substr(0, nameLength);
 
-		while (true) {
-			peek = static_cast<char>(m_Stream->peek());
-			if (peek == '=') {
-				m_Stream->ignore(1);
-				break;
-			}
-			if (peek == '\n' || peek == '\r' || peek == '\t') {
-				ReportError("Property name wasn't followed by a value");
-			}
+		if (propName.find_first_of("\n\r\t") != std::string_view::npos) { ReportError("Property name wasn't followed by a value"); }
 
-			temp = static_cast<char>(m_Stream->get());
-			if (m_Stream->eof()) {
+		std::string retString(TrimSpaces(propName));
+		if (nameLength < remainingContents.size()) {
+			// Discard the '=' along with the name.
+			AdvanceStream(nameLength + 1);
+		} else {
+			AdvanceStream(nameLength);
+			// Parsed properties end with their line, so there's no following line to look for the '=' on.
+			if (m_ParsedFile) {
+				ReportError("Property name wasn't followed by a value");
+			} else {
 				EndIncludeFile();
-				break;
-			}
-			if (!m_Stream->good() || temp == -1) { 
-				ReportError("Stream failed for some reason");
-				EndIncludeFile(); 
-				break; 
 			}
-			retString.append(1, temp);
 		}
-		// Trim the string of whitespace
-		retString = TrimString(retString);
 
 		// If the property name turns out to be the special IncludeFile,and we're not skipping include files then open that file and read the first property from it instead.
 		if (retString == "IncludeFile") {
@@ -184,8 +187,8 @@ namespace RTE {
 	std::string Reader::ReadPropValue() {
 		std::string fullLine = ReadLine();
 		size_t valuePos = fullLine.find_first_of('=');
-		std::string propValue = (valuePos == std::string::npos) ? fullLine : fullLine.substr(valuePos + 1);
-		return TrimString(propValue);
+		// ReadLine already trimmed the whole line, so only a value split off of it needs trimming again.
+		return (valuePos == std::string::npos) ? fullLine : std::string(TrimSpaces(std::string_view(fullLine).substr(valuePos + 1)));
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -205,115 +208,468 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	std::string Reader::TrimString(const std::string &stringToTrim) const {
-		if (stringToTrim.empty()) {
-			return "";
-		}
+	std::string_view Reader::TrimSpaces(std::string_view stringToTrim) {
 		size_t start = stringToTrim.find_first_not_of(' ');
+		if (start == std::string_view::npos) {
+			return std::string_view();
+		}
 		size_t end = stringToTrim.find_last_not_of(' ');
-
-		return stringToTrim.substr(start, (end - start + 1));
+		return stringToTrim.substr(start, end - start + 1);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool Reader::DiscardEmptySpace() {
-		char peek;
-		int indent = 0;
-		int leadingSpaceCount = 0;
-		bool discardedLine = false;
+		// Not end-of-file but still can't read... something went to shit
+		if (m_Stream->fail() && !m_Stream->eof()) {
+			ReportError("Something went wrong reading the line; make sure it is providing the expected type");
+			return true;
+		}
+		if (m_ParsedFile) {
+			return DiscardParsedEmptySpace();
+		}
 
-		while (true) {
-			peek = static_cast<char>(m_Stream->peek());
+		std::string_view remainingContents = GetRemainingStreamContents();
+		size_t readPos = 0;
+		int previousLine = m_CurrentLine;
+		SkippedEmptySpace skippedEmptySpace = SkipEmptySpace(remainingContents, readPos, m_CurrentLine, m_BlockCommentOpenTagLines);
 
-			// If we have hit the end and don't have any files to resume, then quit and indicate that
-			if (m_Stream->eof()) {
-				return EndIncludeFile();
-			}
-			// Not end-of-file but still got junk back... something went to shit
-			if (peek == -1) { ReportError("Something went wrong reading the line; make sure it is providing the expected type"); }
+		// Only report every few lines
+		if (m_ReportProgress && (previousLine / g_SettingsMan.LoadingScreenProgressReportPrecision() != m_CurrentLine / g_SettingsMan.LoadingScreenProgressReportPrecision())) {
+			m_ReportProgress(m_ReportTabs + m_FileName + " reading line " + std::to_string(m_CurrentLine), false);
+		}
+		if (skippedEmptySpace.BlockCommentLeftOpen) {
+			ReportError("File stream ended with an open block comment!\nCouldn't find closing tag for block comment opened on line " + std::to_string(m_BlockCommentOpenTagLines.top()) + ".\n");
+		}
+		AdvanceStream(readPos);
+
+		// If we have hit the end and don't have any files to resume, then quit and indicate that
+		if (readPos >= remainingContents.size()) {
+			return EndIncludeFile();
+		}
+
+		// This precaution enables us to use DiscardEmptySpace repeatedly without messing up the indentation tracking logic
+		if (skippedEmptySpace.DiscardedLine) {
+			if (skippedEmptySpace.LeadingSpaceCount > 0) { ReportError("Encountered space characters used for indentation where a tab character was expected!\nPlease make sure the preset definition structure is correct.\n"); }
+			// Get indentation difference from the last line of the last call to DiscardEmptySpace(), and the last line of this call to DiscardEmptySpace().
+			m_IndentDifference = skippedEmptySpace.Indent - m_PreviousIndent;
+			if (m_IndentDifference > 1) { ReportError("Over indentation detected!\nPlease make sure the preset definition structure is correct.\n"); }
+			// Save the last tab count
+			m_PreviousIndent = skippedEmptySpace.Indent;
+		}
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	Reader::SkippedEmptySpace Reader::SkipEmptySpace(std::string_view contents, size_t &readPos, int &currentLine, std::stack<int> &blockCommentOpenTagLines) {
+		SkippedEmptySpace skippedEmptySpace;
+
+		while (readPos < contents.size()) {
+			char peek = contents[readPos];
+			char nextPeek = (readPos + 1 < contents.size()) ? contents[readPos + 1] : '\0';
 
 			// Discard spaces
 			if (peek == ' ') {
-				leadingSpaceCount++;
-				m_Stream->ignore(1);
+				skippedEmptySpace.LeadingSpaceCount++;
+				readPos++;
 			// Discard tabs, and count them
 			} else if (peek == '\t') {
-				indent++;
-				m_Stream->ignore(1);
+				skippedEmptySpace.Indent++;
+				readPos++;
 			// Discard newlines and reset the tab count for the new line, also count the lines
 			} else if (peek == '\n' || peek == '\r') {
 				// So we don't count lines twice when there are both newline and carriage return at the end of lines
-				if (peek == '\n') {
-					m_CurrentLine++;
-					// Only report every few lines
-					if (m_ReportProgress && (m_CurrentLine % g_SettingsMan.LoadingScreenProgressReportPrecision() == 0)) {
-						m_ReportProgress(m_ReportTabs + m_FileName + " reading line " + std::to_string(m_CurrentLine), false);
-					}
-				}
-				indent = 0;
-				leadingSpaceCount = 0;
-				discardedLine = true;
-				m_Stream->ignore(1);
-
-			// Comment line?
-			} else if (m_Stream->peek() == '/') {
-				char temp = static_cast<char>(m_Stream->get());
-
-				// Confirm that it's a comment line, if so discard it and continue
-				if (m_Stream->peek() == '/') {
-					while (m_Stream->peek() != '\n' && m_Stream->peek() != '\r' && !m_Stream->eof()) { m_Stream->ignore(1); }
-				// Block comment
-				} else if (m_Stream->peek() == '*') {
-					int openBlockComments = 1;
-					m_BlockCommentOpenTagLines.emplace(m_CurrentLine);
-
-					char temp2 = 0;
-					while (openBlockComments > 0 && !m_Stream->eof()) {
-						temp2 = static_cast<char>(m_Stream->get());
-						if (temp2 == '\n') { ++m_CurrentLine; }
-
-						// Find the matching close tag.
-						if (!(temp2 == '*' && m_Stream->peek() == '/')) {
-							// Check if a nested block comment open tag.
-							if (temp2 == '/' && m_Stream->peek() == '*') {
-								openBlockComments++;
-								m_BlockCommentOpenTagLines.emplace(m_CurrentLine);
-							}
-						} else {
-							openBlockComments--;
-							m_BlockCommentOpenTagLines.pop();
+				if (peek == '\n') { currentLine++; }
+				skippedEmptySpace.Indent = 0;
+				skippedEmptySpace.LeadingSpaceCount = 0;
+				skippedEmptySpace.DiscardedLine = true;
+				readPos++;
+			// Comment line, discard it up to the newline and continue
+			} else if (peek == '/' && nextPeek == '/') {
+				readPos = std::min(contents.find_first_of("\n\r", readPos), contents.size());
+			// Block comment
+			} else if (peek == '/' && nextPeek == '*') {
+				int openBlockComments = 1;
+				blockCommentOpenTagLines.emplace(currentLine);
+
+				// Only the opening '/' is skipped here, so "/*/" counts as a whole block comment.
+				readPos++;
+				while (openBlockComments > 0 && readPos < contents.size()) {
+					char blockChar = contents[readPos++];
+					char blockPeek = (readPos < contents.size()) ? contents[readPos] : '\0';
+					if (blockChar == '\n') { ++currentLine; }
+
+					// Find the matching close tag.
+					if (!(blockChar == '*' && blockPeek == '/')) {
+						// Check if a nested block comment open tag.
+						if (blockChar == '/' && blockPeek == '*') {
+							openBlockComments++;
+							blockCommentOpenTagLines.emplace(currentLine);
 						}
+					} else {
+						openBlockComments--;
+						blockCommentOpenTagLines.pop();
 					}
-					// Discard that final '/'.
-					if (!m_Stream->eof()) {
-						m_Stream->ignore(1);
-					} else if (openBlockComments > 0) {
-						ReportError("File stream ended with an open block comment!\nCouldn't find closing tag for block comment opened on line " + std::to_string(m_BlockCommentOpenTagLines.top()) + ".\n");
-					}
-
-				// Not a comment, so it's data, so quit.
+				}
+				// Discard that final '/'.
+				if (openBlockComments == 0) {
+					readPos++;
 				} else {
-					m_Stream->putback(temp);
-					break;
+					skippedEmptySpace.BlockCommentLeftOpen = true;
 				}
+			// Not a comment, so it's data, so quit.
 			} else {
 				break;
 			}
 		}
+		return skippedEmptySpace;
+	}
 
-		// This precaution enables us to use DiscardEmptySpace repeatedly without messing up the indentation tracking logic
-		if (discardedLine) {
-			if (leadingSpaceCount > 0) { ReportError("Encountered space characters used for indentation where a tab character was expected!\nPlease make sure the preset definition structure is correct.\n"); }
-			// Get indentation difference from the last line of the last call to DiscardEmptySpace(), and the last line of this call to DiscardEmptySpace().
-			m_IndentDifference = indent - m_PreviousIndent;
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t Reader::GetLineDataLength(std::string_view contents) {
+		size_t lineLength = 0;
+		for (; lineLength < contents.size(); ++lineLength) {
+			char currentChar = contents[lineLength];
+			if (currentChar == '\n' || currentChar == '\r' || currentChar == '\t') {
+				break;
+			}
+			// Check for line comment "//"
+			if (currentChar == '/' && lineLength + 1 < contents.size() && contents[lineLength + 1] == '/') {
+				break;
+			}
+		}
+		return lineLength;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Reader::AdvanceStream(size_t charCount) {
+		m_Stream->GetBuffer().Advance(charCount);
+		if (GetRemainingStreamContents().empty()) { m_Stream->setstate(std::ios::eofbit); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool Reader::DiscardParsedEmptySpace() {
+		// Anything left of the current property other than spaces and comments is still data to read. Comments were already left out of where the parse resumed, so only their start needs to be recognized here.
+		std::string_view remainingContents = GetRemainingStreamContents();
+		if (size_t dataPos = remainingContents.find_first_not_of(" \t"); dataPos != std::string_view::npos) {
+			std::string_view remainingData = remainingContents.substr(dataPos);
+			if (!remainingData.starts_with("//") && !remainingData.starts_with("/*")) {
+				AdvanceStream(dataPos);
+				return true;
+			}
+		}
+
+		if (m_NextPropertyIndex >= m_ParsedFile->Properties.size()) {
+			AdvanceStream(remainingContents.size());
+			m_CurrentLine = m_ParsedFile->LineCount;
+			if (m_ParsedFile->OpenBlockCommentLine > 0 && !m_EndOfStreams) {
+				ReportError("File stream ended with an open block comment!\nCouldn't find closing tag for block comment opened on line " + std::to_string(m_ParsedFile->OpenBlockCommentLine) + ".\n");
+			}
+			return EndIncludeFile();
+		}
+
+		const ParsedProperty &nextProperty = m_ParsedFile->Properties[m_NextPropertyIndex++];
+		m_Stream->clear();
+		m_Stream->GetBuffer().ReadFrom(nextProperty.Text);
+
+		// Only report every few lines
+		if (m_ReportProgress && (nextProperty.Line / g_SettingsMan.LoadingScreenProgressReportPrecision() != m_CurrentLine / g_SettingsMan.LoadingScreenProgressReportPrecision())) {
+			m_ReportProgress(m_ReportTabs + m_FileName + " reading line " + std::to_string(nextProperty.Line), false);
+		}
+		m_CurrentLine = nextProperty.Line;
+
+		// Same indentation tracking as DiscardEmptySpace, which only does it for lines it discarded a newline before.
+		if (nextProperty.StartsLine) {
+			if (nextProperty.SpaceIndented) { ReportError("Encountered space characters used for indentation where a tab character was expected!\nPlease make sure the preset definition structure is correct.\n"); }
+			m_IndentDifference = nextProperty.Indent - m_PreviousIndent;
 			if (m_IndentDifference > 1) { ReportError("Over indentation detected!\nPlease make sure the preset definition structure is correct.\n"); }
-			// Save the last tab count
-			m_PreviousIndent = indent;
+			m_PreviousIndent = nextProperty.Indent;
 		}
 		return true;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool Reader::ReadWholeFile(const std::string &filePath, std::string &fileContents) {
+		std::ifstream fileStream(filePath, std::ios::in | std::ios::binary);
+		if (!fileStream.good()) {
+			return false;
+		}
+		fileStream.seekg(0, std::ios::end);
+		std::streamoff fileSize = fileStream.tellg();
+		fileStream.seekg(0, std::ios::beg);
+		if (fileSize < 0) {
+			return false;
+		}
+		fileContents.resize(static_cast<size_t>(fileSize));
+		return fileSize == 0 || fileStream.read(fileContents.data(), fileSize).good();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::unique_ptr<Reader::MemoryStream> Reader::OpenFileStream(const std::string &filePath) {
+		std::string fileContents;
+		bool fileRead = ReadWholeFile(filePath, fileContents);
+
+		std::unique_ptr<MemoryStream> memoryStream = std::make_unique<MemoryStream>(fileRead ? std::move(fileContents) : std::string());
+		if (!fileRead) { memoryStream->setstate(std::ios::failbit); }
+		return memoryStream;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<const Reader::ParsedFile> Reader::GetParsedFile(const std::string &filePath) {
+		std::scoped_lock<std::mutex> parsedFilesLock(s_ParsedFilesMutex);
+		if (auto parsedFileItr = s_ParsedFiles.find(filePath); parsedFileItr != s_ParsedFiles.end()) {
+			return parsedFileItr->second.Parsed;
+		}
+		return nullptr;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<const Reader::ParsedFile> Reader::ParseFile(std::string_view fileContents) {
+		std::shared_ptr<ParsedFile> parsedFile = std::make_shared<ParsedFile>();
+		int currentLine = 1;
+		std::stack<int> blockCommentOpenTagLines;
+		size_t readPos = 0;
+
+		while (readPos < fileContents.size()) {
+			SkippedEmptySpace skippedEmptySpace = SkipEmptySpace(fileContents, readPos, currentLine, blockCommentOpenTagLines);
+			if (skippedEmptySpace.BlockCommentLeftOpen) { parsedFile->OpenBlockCommentLine = blockCommentOpenTagLines.top(); }
+			if (readPos >= fileContents.size()) {
+				break;
+			}
+
+			std::string_view line = fileContents.substr(readPos, std::min(fileContents.find_first_of("\n\r", readPos), fileContents.size()) - readPos);
+			size_t textLength = line.size();
+			size_t parseLength = line.size();
+
+			// The value ends where ReadLine would stop reading it. Whatever follows on the line is parsed on, like the Reader would discard or read it after the value.
+			if (size_t equalsPos = line.find('='); equalsPos != std::string_view::npos) {
+				size_t valueStart = std::min(line.find_first_not_of(" \t", equalsPos + 1), line.size());
+				textLength = valueStart + GetLineDataLength(line.substr(valueStart));
+				// A block comment opened after the value can span lines, so it's left to the empty space discarding. It's still part of the value text, as ReadLine doesn't stop at it either.
+				parseLength = std::min(line.find("/*", valueStart), textLength);
+
+				std::string_view propName = TrimSpaces(line.substr(0, equalsPos));
+				std::string_view propValue = TrimSpaces(line.substr(valueStart, textLength - valueStart));
+				if (size_t valuePos = propValue.find('='); valuePos != std::string_view::npos) { propValue = TrimSpaces(propValue.substr(valuePos + 1)); }
+
+				if (propName == "IncludeFile" && !propValue.empty()) {
+					parsedFile->IncludedFilePaths.emplace_back(g_PresetMan.GetFullModulePath(std::string(propValue)));
+				} else if ((propName == "FilePath" || propName == "Path") && !propValue.empty()) {
+					parsedFile->ContentFilePaths.emplace_back(propValue);
+				}
+			}
+			parsedFile->Properties.emplace_back(ParsedProperty { std::string(line.substr(0, textLength)), currentLine, skippedEmptySpace.Indent, skippedEmptySpace.DiscardedLine, skippedEmptySpace.DiscardedLine && skippedEmptySpace.LeadingSpaceCount > 0 });
+			readPos += std::max(parseLength, static_cast<size_t>(1));
+		}
+		parsedFile->LineCount = currentLine;
+		return parsedFile;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::vector<std::string> Reader::ParseFileTree(const std::string &filePath) {
+		std::vector<std::string> contentFilePaths;
+		std::vector<std::string> filesToParse { filePath };
+
+		while (!filesToParse.empty()) {
+			std::string fileToParse = std::move(filesToParse.back());
+			filesToParse.pop_back();
+
+			// Files included from more than one place, or from more than one module, are only parsed by whichever call gets to them first.
+			if (std::scoped_lock<std::mutex> parsedFilesLock(s_ParsedFilesMutex); !s_ParsedFiles.try_emplace(fileToParse, HashedParsedFile { 0, 0, 0, nullptr }).second) {
+				continue;
+			}
+			HashedParsedFile cachedParsedFile { 0, 0, 0, nullptr };
+			if (std::scoped_lock<std::mutex> parsedFilesLock(s_ParsedFilesMutex); !s_CachedParsedFiles.empty()) {
+				if (auto cachedFileItr = s_CachedParsedFiles.find(fileToParse); cachedFileItr != s_CachedParsedFiles.end()) { cachedParsedFile = cachedFileItr->second; }
+			}
+
+			std::error_code errorCode;
+			HashedParsedFile hashedParsedFile { std::filesystem::file_size(fileToParse, errorCode), 0, 0, nullptr };
+			if (!errorCode) { hashedParsedFile.LastWriteTime = std::filesystem::last_write_time(fileToParse, errorCode).time_since_epoch().count(); }
+
+			// Files that still have the size and last write time they had when they were cached are taken from the file cache without reading them at all.
+			if (!errorCode && cachedParsedFile.Parsed && cachedParsedFile.FileSize == hashedParsedFile.FileSize && cachedParsedFile.LastWriteTime == hashedParsedFile.LastWriteTime) {
+				hashedParsedFile = cachedParsedFile;
+			} else {
+				std::string fileContents;
+				// Missing files are reported by the Reader that actually tries to read them.
+				if (!ReadWholeFile(fileToParse, fileContents)) {
+					std::scoped_lock<std::mutex> parsedFilesLock(s_ParsedFilesMutex);
+					s_ParsedFiles.erase(fileToParse);
+					continue;
+				}
+				hashedParsedFile.ContentsHash = Hash(fileContents);
+				hashedParsedFile.Parsed = (cachedParsedFile.Parsed && cachedParsedFile.ContentsHash == hashedParsedFile.ContentsHash) ? cachedParsedFile.Parsed : ParseFile(fileContents);
+			}
+			const std::shared_ptr<const ParsedFile> &parsedFile = hashedParsedFile.Parsed;
+
+			{
+				std::scoped_lock<std::mutex> parsedFilesLock(s_ParsedFilesMutex);
+				s_ParsedFiles[fileToParse] = hashedParsedFile;
+				// Files whose contents only had to be hashed to match their file cache entry are stale too, so their new size and last write time get saved.
+				if (cachedParsedFile.Parsed != parsedFile || cachedParsedFile.FileSize != hashedParsedFile.FileSize || cachedParsedFile.LastWriteTime != hashedParsedFile.LastWriteTime) { s_FileCacheIsStale = true; }
+			}
+			filesToParse.insert(filesToParse.end(), parsedFile->IncludedFilePaths.begin(), parsedFile->IncludedFilePaths.end());
+			contentFilePaths.insert(contentFilePaths.end(), parsedFile->ContentFilePaths.begin(), parsedFile->ContentFilePaths.end());
+		}
+		return contentFilePaths;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Reader::ClearParsedFiles() {
+		std::scoped_lock<std::mutex> parsedFilesLock(s_ParsedFilesMutex);
+		s_ParsedFiles.clear();
+		s_CachedParsedFiles.clear();
+		s_FileCacheIsStale = false;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Reader::LoadFileCache(const std::string &cacheFilePath) {
+		std::string cacheContents;
+		if (!ReadWholeFile(cacheFilePath, cacheContents)) {
+			s_FileCacheIsStale = true;
+			return;
+		}
+		std::string_view remainingContents = cacheContents;
+
+		auto readValue = [&remainingContents](auto &value) {
+			if (remainingContents.size() < sizeof(value)) {
+				return false;
+			}
+			std::memcpy(&value, remainingContents.data(), sizeof(value));
+			remainingContents.remove_prefix(sizeof(value));
+			return true;
+		};
+		auto readString = [&remainingContents, &readValue](std::string &stringValue) {
+			uint64_t stringLength = 0;
+			if (!readValue(stringLength) || remainingContents.size() < stringLength) {
+				return false;
+			}
+			stringValue.assign(remainingContents.substr(0, static_cast<size_t>(stringLength)));
+			remainingContents.remove_prefix(static_cast<size_t>(stringLength));
+			return true;
+		};
+		auto readStrings = [&readValue, &readString](std::vector<std::string> &stringValues) {
+			uint64_t stringCount = 0;
+			if (!readValue(stringCount)) {
+				return false;
+			}
+			for (uint64_t stringIndex = 0; stringIndex < stringCount; ++stringIndex) {
+				if (!readString(stringValues.emplace_back())) {
+					return false;
+				}
+			}
+			return true;
+		};
+
+		std::string signature;
+		std::string gameVersion;
+		uint64_t entryCount = 0;
+		if (!readString(signature) || signature != c_FileCacheSignature || !readString(gameVersion) || gameVersion != c_VersionString || !readValue(entryCount)) {
+			s_FileCacheIsStale = true;
+			return;
+		}
+
+		std::unordered_map<std::string, HashedParsedFile> cachedParsedFiles;
+		for (uint64_t entry = 0; entry < entryCount; ++entry) {
+			std::string filePath;
+			HashedParsedFile hashedParsedFile { 0, 0, 0, nullptr };
+			uint64_t propertyCount = 0;
+			std::shared_ptr<ParsedFile> parsedFile = std::make_shared<ParsedFile>();
+			if (!readString(filePath) || !readValue(hashedParsedFile.FileSize) || !readValue(hashedParsedFile.LastWriteTime) || !readValue(hashedParsedFile.ContentsHash) || !readValue(parsedFile->LineCount) || !readValue(parsedFile->OpenBlockCommentLine) || !readValue(propertyCount)) {
+				s_FileCacheIsStale = true;
+				return;
+			}
+			for (uint64_t propertyIndex = 0; propertyIndex < propertyCount; ++propertyIndex) {
+				ParsedProperty &parsedProperty = parsedFile->Properties.emplace_back();
+				uint8_t lineFlags = 0;
+				if (!readString(parsedProperty.Text) || !readValue(parsedProperty.Line) || !readValue(parsedProperty.Indent) || !readValue(lineFlags)) {
+					s_FileCacheIsStale = true;
+					return;
+				}
+				parsedProperty.StartsLine = lineFlags & 1;
+				parsedProperty.SpaceIndented = lineFlags & 2;
+			}
+			if (!readStrings(parsedFile->IncludedFilePaths) || !readStrings(parsedFile->ContentFilePaths)) {
+				s_FileCacheIsStale = true;
+				return;
+			}
+			hashedParsedFile.Parsed = parsedFile;
+			cachedParsedFiles.try_emplace(filePath, hashedParsedFile);
+		}
+
+		std::scoped_lock<std::mutex> parsedFilesLock(s_ParsedFilesMutex);
+		s_CachedParsedFiles = std::move(cachedParsedFiles);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void Reader::SaveFileCache(const std::string &cacheFilePath) {
+		std::scoped_lock<std::mutex> parsedFilesLock(s_ParsedFilesMutex);
+		// Files in the file cache that weren't reached aren't used anymore, so they should be dropped from it.
+		if (!s_FileCacheIsStale && s_ParsedFiles.size() == s_CachedParsedFiles.size()) {
+			return;
+		}
+		// Write to a temporary file first, so an interrupted save doesn't leave a truncated cache behind.
+		const std::string tempCacheFilePath = cacheFilePath + ".tmp";
+		{
+			std::ofstream cacheFile(tempCacheFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!cacheFile.good()) {
+				return;
+			}
+			auto writeValue = [&cacheFile](const auto &value) { cacheFile.write(reinterpret_cast<const char *>(&value), sizeof(value)); };
+			auto writeString = [&cacheFile, &writeValue](std::string_view stringValue) {
+				writeValue(static_cast<uint64_t>(stringValue.size()));
+				cacheFile.write(stringValue.data(), static_cast<std::streamsize>(stringValue.size()));
+			};
+			auto writeStrings = [&writeValue, &writeString](const std::vector<std::string> &stringValues) {
+				writeValue(static_cast<uint64_t>(stringValues.size()));
+				for (const std::string &stringValue : stringValues) {
+					writeString(stringValue);
+				}
+			};
+
+			writeString(c_FileCacheSignature);
+			writeString(c_VersionString);
+			writeValue(static_cast<uint64_t>(s_ParsedFiles.size()));
+			for (const auto &[filePath, hashedParsedFile] : s_ParsedFiles) {
+				const ParsedFile &parsedFile = *hashedParsedFile.Parsed;
+				writeString(filePath);
+				writeValue(hashedParsedFile.FileSize);
+				writeValue(hashedParsedFile.LastWriteTime);
+				writeValue(hashedParsedFile.ContentsHash);
+				writeValue(parsedFile.LineCount);
+				writeValue(parsedFile.OpenBlockCommentLine);
+				writeValue(static_cast<uint64_t>(parsedFile.Properties.size()));
+				for (const ParsedProperty &parsedProperty : parsedFile.Properties) {
+					writeString(parsedProperty.Text);
+					writeValue(parsedProperty.Line);
+					writeValue(parsedProperty.Indent);
+					writeValue(static_cast<uint8_t>((parsedProperty.StartsLine ? 1 : 0) | (parsedProperty.SpaceIndented ? 2 : 0)));
+				}
+				writeStrings(parsedFile.IncludedFilePaths);
+				writeStrings(parsedFile.ContentFilePaths);
+			}
+			if (!cacheFile.good()) {
+				return;
+			}
+		}
+		std::error_code errorCode;
+		std::filesystem::rename(tempCacheFilePath, cacheFilePath, errorCode);
+		if (!errorCode) { s_FileCacheIsStale = false; }
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void Reader::ReportError(const std::string &errorDesc) const {
@@ -334,17 +690,21 @@ namespace RTE {
 		std::string includeFilePath = g_PresetMan.GetFullModulePath(ReadPropValue());
 
 		// Push the current stream onto the StreamStack for future retrieval when the new include file has run out of data.
-		m_StreamStack.push(StreamInfo(m_Stream.release(), m_FilePath, m_CurrentLine, m_PreviousIndent));
+		m_StreamStack.push(StreamInfo(m_Stream.release(), m_FilePath, m_CurrentLine, m_PreviousIndent, m_ParsedFile, m_NextPropertyIndex));
 
 		m_FilePath = includeFilePath;
-		m_Stream = std::make_unique<std::ifstream>(m_FilePath);
+		m_ParsedFile = GetParsedFile(m_FilePath);
+		m_NextPropertyIndex = 0;
+		m_Stream = m_ParsedFile ? std::make_unique<MemoryStream>(std::string()) : OpenFileStream(m_FilePath);
 
 		if (m_Stream->fail() || !System::PathExistsCaseSensitive(includeFilePath)) {
 			// Backpedal and set up to read the next property in the old stream
-			m_Stream.reset(m_StreamStack.top().Stream); // Destructs the current m_Stream and takes back ownership and management of the raw StreamInfo std::istream pointer.
+			m_Stream.reset(m_StreamStack.top().Stream); // Destructs the current m_Stream and takes back ownership and management of the raw StreamInfo MemoryStream pointer.
 			m_FilePath = m_StreamStack.top().FilePath;
 			m_CurrentLine = m_StreamStack.top().CurrentLine;
 			m_PreviousIndent = m_StreamStack.top().PreviousIndent;
+			m_ParsedFile = m_StreamStack.top().Parsed;
+			m_NextPropertyIndex = m_StreamStack.top().NextPropertyIndex;
 			m_StreamStack.pop();
 
 			ReportError((!m_CanFail ? "" : m_ReportTabs + "\t") + "Failed to open included data file \"" + includeFilePath + "\"");
@@ -386,6 +746,8 @@ namespace RTE {
 		m_Stream.reset(m_StreamStack.top().Stream);
 		m_FilePath = m_StreamStack.top().FilePath;
 		m_CurrentLine = m_StreamStack.top().CurrentLine;
+		m_ParsedFile = m_StreamStack.top().Parsed;
+		m_NextPropertyIndex = m_StreamStack.top().NextPropertyIndex;
 
 		// Observe it's being added, not just replaced. This is to keep proper track when exiting out of a file.
 		m_PreviousIndent += m_StreamStack.top().PreviousIndent;
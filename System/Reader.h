@@ -6,7 +6,8 @@ namespace RTE {
 	using ProgressCallback = std::function<void(std::string, bool)>; //!< Convenient name definition for the progress report callback function.
 
 	/// <summary>
-	/// Reads RTE objects from std::istreams.
+	/// Reads RTE objects from files or std::istreams. Each file is read into memory whole when opened, and tokenized straight out of that memory.
+	/// Files that were parsed ahead of time with ParseFileTree are read from their parsed properties instead, so they don't have to be tokenized again.
 	/// </summary>
 	class Reader {
 
@@ -50,7 +51,7 @@ namespace RTE {
 		/// <summary>
 		/// Makes the Reader object ready for use.
 		/// </summary>
-		/// <param name="stream">Stream to read from.</param>
+		/// <param name="stream">Stream to read from. Its remaining contents are read into memory whole.</param>
 		/// <param name="overwrites"> Whether object definitions read here overwrite existing ones with the same names.</param>
 		/// <param name="progressCallback">A function pointer to a function that will be called and sent a string with information about the progress of this Reader's reading.</param>
 		/// <param name="failOK">Whether it's ok for the file to not be there, ie we're only trying to open, and if it's not there, then fail silently.</param>
@@ -114,6 +115,35 @@ namespace RTE {
 		void SetSkipIncludes(bool skip) { m_SkipIncludes = skip; };
 #pragma endregion
 
+#pragma region Parsing Ahead
+		/// <summary>
+		/// Reads a file and every file it includes, recursively, and splits them into their property lines ahead of time, so Readers created for them later only have to walk the parsed properties.
+		/// Files that have the same size and last write time as when they were stored in the file cache are taken from it without being read. Otherwise they're read, and still taken from it if their contents hash the same.
+		/// Thread safe, so file trees can be parsed in parallel while nothing is being read from them yet.
+		/// </summary>
+		/// <param name="filePath">Path to the file to parse, as it would be passed to a Reader reading it.</param>
+		/// <returns>The values of all FilePath and Path properties in the files that were parsed by this call, so the data they point to can be requested before the files are read.</returns>
+		static std::vector<std::string> ParseFileTree(const std::string &filePath);
+
+		/// <summary>
+		/// Frees the memory of all parsed files and the file cache. Readers created afterwards will read from the disk and tokenize the files' text again.
+		/// </summary>
+		static void ClearParsedFiles();
+
+		/// <summary>
+		/// Loads the parsed files stored in a file cache previously saved with SaveFileCache, so ParseFileTree can take them from it instead of parsing them again.
+		/// A file cache saved by a different game version is ignored whole. Entries of files that changed since are only ignored when ParseFileTree finds their size or last write time and then their contents hash differently, so just those files are parsed again.
+		/// </summary>
+		/// <param name="cacheFilePath">Path to the file cache.</param>
+		static void LoadFileCache(const std::string &cacheFilePath);
+
+		/// <summary>
+		/// Saves all files parsed by ParseFileTree to a file cache, along with the sizes, last write times and hashes of the contents they were parsed from, if any of them weren't taken from the file cache in the first place.
+		/// </summary>
+		/// <param name="cacheFilePath">Path to save the file cache to.</param>
+		static void SaveFileCache(const std::string &cacheFilePath);
+#pragma endregion
+
 #pragma region Reading Operations
 		/// <summary>
 		/// Reads a file and constructs a string from all its contents.
@@ -157,7 +187,7 @@ namespace RTE {
 		/// </summary>
 		/// <param name="stringToTrim">String to remove whitespace from.</param>
 		/// <returns>The string that was passed in, sans whitespace in the front and end.</returns>
-		std::string TrimString(const std::string &stringToTrim) const;
+		std::string TrimString(const std::string &stringToTrim) const { return std::string(TrimSpaces(stringToTrim)); }
 
 		/// <summary>
 		/// Discards all whitespace, newlines and comment lines (which start with '//') so that the next thing to be read will be actual data.
@@ -171,7 +201,7 @@ namespace RTE {
 		/// Shows whether this is still OK to read from. If file isn't present, etc, this will return false.
 		/// </summary>
 		/// <returns>Whether this Reader's stream is OK or not.</returns>
-		bool ReaderOK() const { return m_Stream.get() && m_Stream->good(); }
+		bool ReaderOK() const { return m_Stream.get() && (m_ParsedFile ? !m_Stream->fail() && !m_EndOfStreams : m_Stream->good()); }
 
 		/// <summary>
 		/// Makes an error message box pop up for the user that tells them something went wrong with the reading, and where.
@@ -204,6 +234,89 @@ namespace RTE {
 
 	protected:
 
+		/// <summary>
+		/// A read-only stream buffer over the whole contents of a file held in memory.
+		/// The tokenizing methods scan its remaining contents directly, while the extraction operators still go through std::istream, so both share one read position.
+		/// </summary>
+		class MemoryStreamBuffer : public std::streambuf {
+
+		public:
+
+			/// <summary>
+			/// Constructor method used to instantiate a MemoryStreamBuffer object in system memory.
+			/// </summary>
+			/// <param name="contents">The contents to read from. Ownership IS transferred!</param>
+			explicit MemoryStreamBuffer(std::string &&contents) : m_Contents(std::move(contents)) { setg(m_Contents.data(), m_Contents.data(), m_Contents.data() + m_Contents.size()); }
+
+			/// <summary>
+			/// Gets the contents that haven't been read yet.
+			/// </summary>
+			/// <returns>A view of the unread contents. Invalidated once this MemoryStreamBuffer is destroyed.</returns>
+			std::string_view GetRemaining() const { return std::string_view(gptr(), static_cast<size_t>(egptr() - gptr())); }
+
+			/// <summary>
+			/// Marks a number of characters as read.
+			/// </summary>
+			/// <param name="charCount">The number of characters to skip. Must not be more than what GetRemaining returns.</param>
+			void Advance(size_t charCount) { setg(eback(), gptr() + charCount, egptr()); }
+
+			/// <summary>
+			/// Makes this read from contents held elsewhere instead of its own, e.g. the text of a parsed property.
+			/// </summary>
+			/// <param name="contents">The contents to read from. Ownership is NOT transferred, so they must outlive this MemoryStreamBuffer or the next call to this.</param>
+			void ReadFrom(std::string_view contents) { char *contentsStart = const_cast<char *>(contents.data()); setg(contentsStart, contentsStart, contentsStart + contents.size()); }
+
+		private:
+
+			std::string m_Contents; //!< The whole contents of the file.
+		};
+
+		/// <summary>
+		/// An std::istream reading from a MemoryStreamBuffer it owns.
+		/// </summary>
+		class MemoryStream : public std::istream {
+
+		public:
+
+			/// <summary>
+			/// Constructor method used to instantiate a MemoryStream object in system memory.
+			/// </summary>
+			/// <param name="contents">The contents to read from. Ownership IS transferred!</param>
+			explicit MemoryStream(std::string &&contents) : std::istream(nullptr), m_Buffer(std::move(contents)) { rdbuf(&m_Buffer); }
+
+			/// <summary>
+			/// Gets the MemoryStreamBuffer this reads from.
+			/// </summary>
+			/// <returns>The MemoryStreamBuffer of this MemoryStream.</returns>
+			MemoryStreamBuffer & GetBuffer() { return m_Buffer; }
+
+		private:
+
+			MemoryStreamBuffer m_Buffer; //!< The buffer holding the contents of this MemoryStream.
+		};
+
+		/// <summary>
+		/// A property line of a file that was parsed ahead of time, holding what the Reader would otherwise tokenize out of the file's text once it gets to it.
+		/// </summary>
+		struct ParsedProperty {
+			std::string Text; //!< The property's name, '=' and value as they appear in the file, up to where reading the value would stop. Lines without a '=' are kept whole.
+			int Line; //!< The line the property is on.
+			int Indent; //!< Count of tabs in front of the property on its line.
+			bool StartsLine; //!< Whether a newline was discarded before this property, so the indentation tracking is updated when it's reached.
+			bool SpaceIndented; //!< Whether space characters were used for indentation in front of this property.
+		};
+
+		/// <summary>
+		/// A file split into its property lines ahead of time, with all empty space and comments between them discarded.
+		/// </summary>
+		struct ParsedFile {
+			std::vector<ParsedProperty> Properties; //!< The property lines of the file, in order.
+			std::vector<std::string> IncludedFilePaths; //!< The full paths of the files included by this file's IncludeFile properties.
+			std::vector<std::string> ContentFilePaths; //!< The values of all FilePath and Path properties in this file.
+			int LineCount; //!< The line the file ends on.
+			int OpenBlockCommentLine; //!< The line a block comment left open at the end of the file was opened on, or 0 if there was none.
+		};
+
 		/// <summary>
 		/// A struct containing information from the currently used stream.
 		/// </summary>
@@ -211,19 +324,25 @@ namespace RTE {
 			/// <summary>
 			/// Constructor method used to instantiate a StreamInfo object in system memory.
 			/// </summary>
-			StreamInfo(std::istream *stream, const std::string &filePath, int currentLine, int prevIndent) : Stream(stream), FilePath(filePath), CurrentLine(currentLine), PreviousIndent(prevIndent) {}
+			StreamInfo(MemoryStream *stream, const std::string &filePath, int currentLine, int prevIndent, const std::shared_ptr<const ParsedFile> &parsedFile, size_t nextPropertyIndex) :
+				Stream(stream), FilePath(filePath), CurrentLine(currentLine), PreviousIndent(prevIndent), Parsed(parsedFile), NextPropertyIndex(nextPropertyIndex) {}
 
 			// NOTE: These members are owned by the reader that owns this struct, so are not deleted when this is destroyed.
-			std::istream *Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
+			MemoryStream *Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
 			std::string FilePath; //!< Currently used stream's filepath.
 			int CurrentLine; //!< The line number the stream is on.
 			int PreviousIndent; //!< Count of tabs encountered on the last line DiscardEmptySpace() discarded.
+			std::shared_ptr<const ParsedFile> Parsed; //!< The parsed properties of the stream's file, or nullptr if it's read from its text.
+			size_t NextPropertyIndex; //!< The index of the parsed property to read after the current one.
 		};
 
-		std::unique_ptr<std::istream> m_Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
+		std::unique_ptr<MemoryStream> m_Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
 		std::stack<StreamInfo> m_StreamStack; //!< Stack of open streams in this Reader, each one representing a file opened to read from within another.
 		bool m_EndOfStreams; //!< All streams have been depleted.
 
+		std::shared_ptr<const ParsedFile> m_ParsedFile; //!< The parsed properties of the currently read file, or nullptr if it's read from its text. The current stream reads from the text of the current property then.
+		size_t m_NextPropertyIndex; //!< The index of the parsed property to read after the current one.
+
 		ProgressCallback m_ReportProgress; //!< Function pointer to report our reading progress to, by calling it and passing a descriptive string to it.
 
 		std::string m_FilePath; //!< Currently used stream's filepath.
@@ -252,7 +371,115 @@ namespace RTE {
 
 	private:
 
+		/// <summary>
+		/// A parsed file along with the status and hash of the contents it was parsed from, to tell whether it can be used for the file's current contents.
+		/// </summary>
+		struct HashedParsedFile {
+			uint64_t FileSize; //!< The size of the file when it was parsed.
+			int64_t LastWriteTime; //!< The last write time of the file when it was parsed, in ticks of the filesystem clock.
+			uint64_t ContentsHash; //!< The hash of the contents the file was parsed from.
+			std::shared_ptr<const ParsedFile> Parsed; //!< The parsed properties of the file, or nullptr while it's still being parsed.
+		};
+
+		/// <summary>
+		/// What SkipEmptySpace skipped in front of the next data, for the indentation tracking and error reporting of whoever called it.
+		/// </summary>
+		struct SkippedEmptySpace {
+			int Indent = 0; //!< Count of tabs in front of the data on its line.
+			int LeadingSpaceCount = 0; //!< Count of spaces in front of the data on its line.
+			bool DiscardedLine = false; //!< Whether a newline was skipped, so the data starts a new line.
+			bool BlockCommentLeftOpen = false; //!< Whether the contents ended inside a block comment.
+		};
+
+		static const std::string c_FileCacheSignature; //!< The signature at the start of every file cache, followed by the game version that saved it. Changed whenever the layout of the file cache changes.
+
+		static std::mutex s_ParsedFilesMutex; //!< Mutex to ensure files can be parsed from multiple threads.
+		static std::unordered_map<std::string, HashedParsedFile> s_ParsedFiles; //!< Map of file paths to the files that were reached by ParseFileTree.
+		static std::unordered_map<std::string, HashedParsedFile> s_CachedParsedFiles; //!< Map of file paths to the parsed files loaded from the file cache, which may be outdated.
+		static bool s_FileCacheIsStale; //!< Whether any files had to be parsed instead of taken from the file cache, so it needs to be saved again.
+
+		/// <summary>
+		/// Makes the Reader object ready for use.
+		/// </summary>
+		/// <param name="stream">MemoryStream to read from.</param>
+		/// <param name="overwrites"> Whether object definitions read here overwrite existing ones with the same names.</param>
+		/// <param name="progressCallback">A function pointer to a function that will be called and sent a string with information about the progress of this Reader's reading.</param>
+		/// <param name="failOK">Whether it's ok for the file to not be there, ie we're only trying to open, and if it's not there, then fail silently.</param>
+		/// <returns>An error return value signaling success or any particular failure.  Anything below 0 is an error signal.</returns>
+		int Create(std::unique_ptr<MemoryStream> &&stream, bool overwrites, const ProgressCallback &progressCallback, bool failOK);
+
 #pragma region Reading Operations
+		/// <summary>
+		/// Reads the whole contents of a file into a string.
+		/// </summary>
+		/// <param name="filePath">The path of the file to read.</param>
+		/// <param name="fileContents">The string to read the file's contents into.</param>
+		/// <returns>Whether the file was read successfully.</returns>
+		static bool ReadWholeFile(const std::string &filePath, std::string &fileContents);
+
+		/// <summary>
+		/// Reads the whole contents of a file into a new MemoryStream.
+		/// </summary>
+		/// <param name="filePath">The path of the file to read.</param>
+		/// <returns>A MemoryStream with the file's contents, or an empty MemoryStream in a failed state if the file couldn't be read.</returns>
+		static std::unique_ptr<MemoryStream> OpenFileStream(const std::string &filePath);
+
+		/// <summary>
+		/// Gets the parsed properties of a file, if it was parsed ahead of time with ParseFileTree.
+		/// </summary>
+		/// <param name="filePath">The path of the file.</param>
+		/// <returns>The parsed properties of the file, or nullptr if the file wasn't parsed.</returns>
+		static std::shared_ptr<const ParsedFile> GetParsedFile(const std::string &filePath);
+
+		/// <summary>
+		/// Skips the empty space and comments in some contents up to the next data. Shared by DiscardEmptySpace and ParseFile, so files are tokenized the same way whether they were parsed ahead of time or not.
+		/// </summary>
+		/// <param name="contents">The contents to skip through.</param>
+		/// <param name="readPos">The position in the contents to start skipping from. Set to the position of the next data, or the end of the contents if there is none.</param>
+		/// <param name="currentLine">The line the skipping starts on. Incremented for every newline that's skipped.</param>
+		/// <param name="blockCommentOpenTagLines">Stack of the lines block comments were opened on. The line of a block comment left open is left on top of it.</param>
+		/// <returns>What was skipped in front of the next data.</returns>
+		static SkippedEmptySpace SkipEmptySpace(std::string_view contents, size_t &readPos, int &currentLine, std::stack<int> &blockCommentOpenTagLines);
+
+		/// <summary>
+		/// Gets how much of some contents ReadLine would read as one line's data, i.e. up to the next newline, tab or line comment.
+		/// </summary>
+		/// <param name="contents">The contents to measure, starting where the line's data starts.</param>
+		/// <returns>The length of the line's data.</returns>
+		static size_t GetLineDataLength(std::string_view contents);
+
+		/// <summary>
+		/// Splits the contents of a file into its property lines, discarding empty space and comments the same way DiscardEmptySpace does.
+		/// </summary>
+		/// <param name="fileContents">The whole contents of the file.</param>
+		/// <returns>The parsed file.</returns>
+		static std::shared_ptr<const ParsedFile> ParseFile(std::string_view fileContents);
+
+		/// <summary>
+		/// Takes out spaces from the beginning and the end of a string view.
+		/// </summary>
+		/// <param name="stringToTrim">String view to remove spaces from.</param>
+		/// <returns>A view of the passed in string view, sans spaces in the front and end.</returns>
+		static std::string_view TrimSpaces(std::string_view stringToTrim);
+
+		/// <summary>
+		/// Gets the contents of the current stream that haven't been read yet.
+		/// </summary>
+		/// <returns>A view of the unread contents of the current stream. Invalidated once the current stream changes.</returns>
+		std::string_view GetRemainingStreamContents() const { return m_Stream->GetBuffer().GetRemaining(); }
+
+		/// <summary>
+		/// Marks a number of characters of the current stream as read. If that reaches the end of the stream, the stream is flagged as such, like std::istream would.
+		/// </summary>
+		/// <param name="charCount">The number of characters to skip.</param>
+		void AdvanceStream(size_t charCount);
+
+		/// <summary>
+		/// DiscardEmptySpace for files read from their parsed properties. Discards what's left of the current property if it's only empty space or comments, and moves on to the next property.
+		/// </summary>
+		/// <returns>Whether there is more data to read from the file streams after this eat.</returns>
+		bool DiscardParsedEmptySpace();
+
 		/// <summary>
 		/// When ReadPropName encounters the property name "IncludeFile", it will automatically call this function to get started reading on that file.
 		/// This will create a new stream to the include file.
@@ -0,0 +1,84 @@
+#include "RotatedSpriteCache.h"
+
+#include "RTEError.h"
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void RotatedSpriteCache::Clear() {
+		std::lock_guard<std::mutex> cacheLock(m_CacheMutex);
+		m_EntryLookup.clear();
+		m_Entries.clear();
+		m_MemoryUsage = 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void RotatedSpriteCache::SetMemoryLimit(size_t newMemoryLimit) {
+		std::lock_guard<std::mutex> cacheLock(m_CacheMutex);
+		m_MemoryLimit = newMemoryLimit;
+		EvictToMemoryLimit();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int RotatedSpriteCache::QuantizeAngle(float allegroAngle, int angleStepCount) {
+		int angleIndex = static_cast<int>(std::lround(allegroAngle * static_cast<float>(angleStepCount) / 256.0F) % angleStepCount);
+		return angleIndex < 0 ? angleIndex + angleStepCount : angleIndex;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<BITMAP> RotatedSpriteCache::Get(const Key &key) {
+		std::lock_guard<std::mutex> cacheLock(m_CacheMutex);
+		std::unordered_map<Key, std::list<Entry>::iterator, KeyHash>::iterator foundEntry = m_EntryLookup.find(key);
+		if (foundEntry == m_EntryLookup.end()) {
+			return nullptr;
+		}
+		m_Entries.splice(m_Entries.begin(), m_Entries, foundEntry->second);
+		return foundEntry->second->RotatedSprite;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::shared_ptr<BITMAP> RotatedSpriteCache::Add(const Key &key, BITMAP *rotatedSprite) {
+		std::shared_ptr<BITMAP> rotatedSpriteToAdd(rotatedSprite, [](BITMAP *bitmap) { destroy_bitmap(bitmap); });
+		size_t memoryUsage = static_cast<size_t>(rotatedSprite->w) * static_cast<size_t>(rotatedSprite->h) * static_cast<size_t>((bitmap_color_depth(rotatedSprite) + 7) / 8);
+
+		std::lock_guard<std::mutex> cacheLock(m_CacheMutex);
+		if (std::unordered_map<Key, std::list<Entry>::iterator, KeyHash>::iterator foundEntry = m_EntryLookup.find(key); foundEntry != m_EntryLookup.end()) {
+			return foundEntry->second->RotatedSprite;
+		}
+		if (memoryUsage > m_MemoryLimit) {
+			return rotatedSpriteToAdd;
+		}
+		m_Entries.emplace_front(Entry{ key, rotatedSpriteToAdd, memoryUsage });
+		m_EntryLookup.try_emplace(key, m_Entries.begin());
+		m_MemoryUsage += memoryUsage;
+		EvictToMemoryLimit();
+
+		return rotatedSpriteToAdd;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void RotatedSpriteCache::EvictToMemoryLimit() {
+		while (m_MemoryUsage > m_MemoryLimit && !m_Entries.empty()) {
+			const Entry &leastRecentlyUsedEntry = m_Entries.back();
+			m_MemoryUsage -= leastRecentlyUsedEntry.MemoryUsage;
+			m_EntryLookup.erase(leastRecentlyUsedEntry.EntryKey);
+			m_Entries.pop_back();
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	size_t RotatedSpriteCache::KeyHash::operator()(const Key &key) const {
+		size_t hash = std::hash<const BITMAP *>()(key.Sprite);
+		for (size_t value : { static_cast<size_t>(key.DrawMode), static_cast<size_t>(key.SilhouetteColor), static_cast<size_t>(key.PivotX), static_cast<size_t>(key.PivotY), static_cast<size_t>(std::bit_cast<uint32_t>(key.Scale)), static_cast<size_t>(key.AngleIndex), static_cast<size_t>(key.AngleStepCount), static_cast<size_t>(key.HFlipped) }) {
+			hash ^= value + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+		}
+		return hash;
+	}
+}
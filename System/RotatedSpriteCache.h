@@ -0,0 +1,148 @@
+#ifndef _RTEROTATEDSPRITECACHE_
+#define _RTEROTATEDSPRITECACHE_
+
+struct BITMAP;
+
+namespace RTE {
+
+	/// <summary>
+	/// A memory capped cache of sprite frames that were already rotated, scaled and flipped, so objects that are drawn at the same few angles over and over don't have to rotate their sprites on every draw.
+	/// The least recently used entries are evicted first when the memory cap is reached.
+	/// </summary>
+	class RotatedSpriteCache {
+
+	public:
+
+		/// <summary>
+		/// Everything that determines what a rotated sprite looks like. Entries are only shared between draws whose keys match exactly.
+		/// </summary>
+		struct Key {
+			const BITMAP *Sprite = nullptr; //!< The sprite frame that was rotated.
+			int DrawMode = 0; //!< The DrawMode the sprite was drawn in.
+			int SilhouetteColor = -1; //!< The color the sprite was drawn as a silhouette of, or -1 if it was drawn in color.
+			int PivotX = 0; //!< The X coordinate of the pivot point on the sprite, after flipping.
+			int PivotY = 0; //!< The Y coordinate of the pivot point on the sprite, after flipping.
+			float Scale = 1.0F; //!< The scale the sprite was drawn at.
+			int AngleIndex = 0; //!< The index of the quantized angle the sprite was rotated to, out of AngleStepCount.
+			int AngleStepCount = 0; //!< The number of quantized angles per full rotation.
+			bool HFlipped = false; //!< Whether the sprite was flipped horizontally.
+
+			/// <summary>
+			/// Equality operator for Key.
+			/// </summary>
+			/// <param name="rhs">A Key reference as the right hand side operand.</param>
+			/// <returns>Whether the Keys are the same.</returns>
+			bool operator==(const Key &rhs) const = default;
+		};
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a RotatedSpriteCache object in system memory.
+		/// </summary>
+		RotatedSpriteCache() : m_MemoryLimit(c_DefaultMemoryLimit), m_MemoryUsage(0) {}
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Destructor method used to clean up a RotatedSpriteCache object before deletion from system memory.
+		/// </summary>
+		~RotatedSpriteCache() { Clear(); }
+
+		/// <summary>
+		/// Removes all entries from this RotatedSpriteCache. Needs to be done whenever sprite BITMAPs are reloaded or destroyed, because entries are keyed by them.
+		/// </summary>
+		void Clear();
+#pragma endregion
+
+#pragma region Getters and Setters
+		/// <summary>
+		/// Gets the maximum amount of memory the rotated sprites in this RotatedSpriteCache can take up.
+		/// </summary>
+		/// <returns>The memory cap, in bytes.</returns>
+		size_t GetMemoryLimit() const { return m_MemoryLimit; }
+
+		/// <summary>
+		/// Sets the maximum amount of memory the rotated sprites in this RotatedSpriteCache can take up, evicting entries if needed.
+		/// </summary>
+		/// <param name="newMemoryLimit">The new memory cap, in bytes. 0 means nothing is cached.</param>
+		void SetMemoryLimit(size_t newMemoryLimit);
+
+		/// <summary>
+		/// Gets the amount of memory the rotated sprites in this RotatedSpriteCache currently take up.
+		/// </summary>
+		/// <returns>The memory usage, in bytes.</returns>
+		size_t GetMemoryUsage() const { return m_MemoryUsage; }
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Quantizes an Allegro angle to the nearest of a number of evenly spaced angles.
+		/// </summary>
+		/// <param name="allegroAngle">The Allegro angle to quantize, where 256 is a full rotation.</param>
+		/// <param name="angleStepCount">The number of quantized angles per full rotation.</param>
+		/// <returns>The index of the nearest quantized angle, from 0 to angleStepCount - 1.</returns>
+		static int QuantizeAngle(float allegroAngle, int angleStepCount);
+
+		/// <summary>
+		/// Gets the Allegro angle of a quantized angle index.
+		/// </summary>
+		/// <param name="angleIndex">The index of the quantized angle.</param>
+		/// <param name="angleStepCount">The number of quantized angles per full rotation.</param>
+		/// <returns>The Allegro angle, where 256 is a full rotation.</returns>
+		static float GetQuantizedAllegroAngle(int angleIndex, int angleStepCount) { return static_cast<float>(angleIndex) * 256.0F / static_cast<float>(angleStepCount); }
+
+		/// <summary>
+		/// Looks up a rotated sprite and marks it as recently used. Thread safe.
+		/// The pivot point of the sprite is at the center of the returned BITMAP, at (w / 2, h / 2).
+		/// </summary>
+		/// <param name="key">The Key of the rotated sprite.</param>
+		/// <returns>The rotated sprite, or nullptr if it isn't cached. The BITMAP stays valid for as long as the returned pointer is held, even if the entry gets evicted.</returns>
+		std::shared_ptr<BITMAP> Get(const Key &key);
+
+		/// <summary>
+		/// Adds a rotated sprite, evicting the least recently used entries if the memory cap is exceeded. Thread safe.
+		/// </summary>
+		/// <param name="key">The Key of the rotated sprite.</param>
+		/// <param name="rotatedSprite">The rotated sprite, with its pivot point at (w / 2, h / 2). Ownership IS transferred!</param>
+		/// <returns>The rotated sprite. If another thread added the same Key in the meantime, that one is returned and the passed in one is destroyed.</returns>
+		std::shared_ptr<BITMAP> Add(const Key &key, BITMAP *rotatedSprite);
+#pragma endregion
+
+	private:
+
+		/// <summary>
+		/// Hash functor for Key.
+		/// </summary>
+		struct KeyHash {
+			size_t operator()(const Key &key) const;
+		};
+
+		/// <summary>
+		/// A cached rotated sprite.
+		/// </summary>
+		struct Entry {
+			Key EntryKey; //!< The Key this Entry was added with.
+			std::shared_ptr<BITMAP> RotatedSprite; //!< The rotated sprite.
+			size_t MemoryUsage; //!< The amount of memory the rotated sprite takes up, in bytes.
+		};
+
+		static constexpr size_t c_DefaultMemoryLimit = 64 * 1024 * 1024; //!< The default memory cap, in bytes.
+
+		std::mutex m_CacheMutex; //!< Mutex to ensure the cache can be used from multiple threads.
+		std::list<Entry> m_Entries; //!< The cached entries, from most to least recently used.
+		std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_EntryLookup; //!< Map of Keys to their entries in m_Entries.
+
+		size_t m_MemoryLimit; //!< The maximum amount of memory the cached rotated sprites can take up, in bytes.
+		size_t m_MemoryUsage; //!< The amount of memory the cached rotated sprites take up, in bytes.
+
+		/// <summary>
+		/// Evicts the least recently used entries until the memory usage is within the memory cap. The cache mutex must be held.
+		/// </summary>
+		void EvictToMemoryLimit();
+
+		// Disallow the use of some implicit methods.
+		RotatedSpriteCache(const RotatedSpriteCache &reference) = delete;
+		RotatedSpriteCache & operator=(const RotatedSpriteCache &rhs) = delete;
+	};
+}
+#endif
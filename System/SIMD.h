@@ -0,0 +1,72 @@
+#ifndef _RTESIMD_
+#define _RTESIMD_
+
+// Selects the widest x86 vector instruction set the build is compiled for. Code using these must always keep a scalar path for the remaining elements and for other targets.
+// RTE_SIMD_AVX2 is only defined when AVX2 is enabled for the whole build (e.g. -mavx2 or /arch:AVX2), SSE2 is always available on x86-64.
+#if defined(__AVX2__)
+#define RTE_SIMD_AVX2
+#define RTE_SIMD_SSE2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RTE_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+// Builds that don't enable AVX2 for the whole build can still compile individual hot loops for it, and pick them at runtime if the CPU supports it. Such functions are marked with RTE_SIMD_TARGET_AVX2 and only called if CPUSupportsAVX2 returns true.
+#if !defined(RTE_SIMD_AVX2) && (defined(__x86_64__) || defined(_M_X64))
+#define RTE_SIMD_AVX2_DISPATCH
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define RTE_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define RTE_SIMD_TARGET_AVX2
+#endif
+#endif
+
+#include <bit>
+
+namespace RTE {
+
+#ifdef RTE_SIMD_AVX2_DISPATCH
+	/// <summary>
+	/// Gets whether the CPU and OS support AVX2, so functions marked with RTE_SIMD_TARGET_AVX2 can be called. Only checked the first time this is called.
+	/// </summary>
+	/// <returns>Whether AVX2 instructions can be used.</returns>
+	inline bool CPUSupportsAVX2() {
+#ifdef _MSC_VER
+		static const bool supportsAVX2 = []() {
+			int cpuInfo[4];
+			__cpuid(cpuInfo, 0);
+			if (cpuInfo[0] < 7) {
+				return false;
+			}
+			// The OS has to save the AVX registers on context switches too, which is what OSXSAVE and the XCR0 bits are checked for.
+			__cpuid(cpuInfo, 1);
+			bool osSavesAVXState = (cpuInfo[2] & (1 << 27)) && (cpuInfo[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+			__cpuidex(cpuInfo, 7, 0);
+			return osSavesAVXState && (cpuInfo[1] & (1 << 5));
+		}();
+#else
+		static const bool supportsAVX2 = __builtin_cpu_supports("avx2");
+#endif
+		return supportsAVX2;
+	}
+#endif
+
+	/// <summary>
+	/// Calls a function with the index of each set bit of a mask, from lowest to highest. Used to visit the lanes that matched a vector comparison.
+	/// </summary>
+	/// <param name="mask">The bit mask, usually the result of a movemask instruction.</param>
+	/// <param name="function">The function to call. Must be invocable with a single int argument.</param>
+	template <typename Function>
+	inline void ForEachSetBit(unsigned int mask, const Function &function) {
+		while (mask != 0) {
+			function(std::countr_zero(mask));
+			mask &= mask - 1;
+		}
+	}
+}
+#endif
@@ -12,11 +12,9 @@ namespace RTE {
 		m_Width = 0;
 		m_Height = 0;
 		m_CellSize = 0;
-		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
-			m_Cells[team + 1].clear();
-			m_PhysicsCells[team + 1].clear();
-		}
-		m_UsedCellIds.clear();
+		m_Cells.clear();
+		m_Entries.clear();
+		m_Generation = 1;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -25,10 +23,7 @@ namespace RTE {
 		m_Width = width / cellSize;
 		m_Height = height / cellSize;
 		m_CellSize = cellSize;
-		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
-			m_Cells[team + 1].resize(m_Width * m_Height);
-			m_PhysicsCells[team + 1].resize(m_Width * m_Height);
-		}
+		m_Cells.assign(m_Width * m_Height, { 0, -1 });
 		return 0;
 	}
 
@@ -39,27 +34,25 @@ namespace RTE {
 		m_Height = reference.m_Height;
 		m_CellSize = reference.m_CellSize;
 		m_Cells = reference.m_Cells;
-		m_PhysicsCells = reference.m_PhysicsCells;
-		m_UsedCellIds = reference.m_UsedCellIds;
+		m_Entries = reference.m_Entries;
+		m_Generation = reference.m_Generation;
 		return 0;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void SpatialPartitionGrid::Reset() {
-		const Activity *activity = g_ActivityMan.GetActivity();
-		RTEAssert(activity, "Tried to reset spatial partition grid with no running Activity!");
-
-		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
-			if (team == Activity::NoTeam || activity->TeamActive(team)) {
-				for (int usedCellId : m_UsedCellIds) {
-					m_Cells[team + 1][usedCellId].clear();
-					m_PhysicsCells[team + 1][usedCellId].clear();
-				}
+		RTEAssert(g_ActivityMan.GetActivity(), "Tried to reset spatial partition grid with no running Activity!");
+
+		// Cells from older generations count as empty, so there's no need to touch any of them. Only when the generation counter wraps around do they need their stamps cleared, so old cells can't come back to life.
+		m_Entries.clear();
+		m_Generation++;
+		if (m_Generation == 0) {
+			for (Cell &cell : m_Cells) {
+				cell.Generation = 0;
 			}
+			m_Generation = 1;
 		}
-
-		m_UsedCellIds.clear();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -77,33 +70,64 @@ namespace RTE {
 		// We handle wrapping in GetCellIdForCellCoords, so make sure we've not already been passed wrapped data...
 		RTEAssert(topLeftCellX <= bottomRightCellX && topLeftCellY <= bottomRightCellY, "Invalidly wrapped rect passed to spatial partitioning grid!");
 
+		unsigned short teamMask = 0;
 		for (int team = Activity::NoTeam; team < Activity::MaxTeamCount; ++team) {
 			bool teamActive = team == Activity::NoTeam || activity->TeamActive(team);
 			bool ignoresThisTeam = team != Activity::NoTeam && rootParentMo.IgnoresTeamHits() && team == rootParentMo.GetTeam();
-			if (!teamActive || ignoresThisTeam) {
-				continue;
+			if (teamActive && !ignoresThisTeam) { teamMask |= static_cast<unsigned short>(1 << (team + 1)); }
+		}
+		if (teamMask == 0) {
+			return;
+		}
+		if (mo.GetsHitByMOs()) { teamMask |= static_cast<unsigned short>(teamMask << c_PhysicsTeamMaskShift); }
+
+		for (int x = topLeftCellX; x <= bottomRightCellX; x++) {
+			for (int y = topLeftCellY; y <= bottomRightCellY; y++) {
+				Cell &cell = m_Cells[GetCellIdForCellCoords(x, y)];
+				int nextEntry = cell.Generation == m_Generation ? cell.FirstEntry : -1;
+
+				cell.Generation = m_Generation;
+				cell.FirstEntry = static_cast<int>(m_Entries.size());
+				m_Entries.push_back({ mo.GetID(), teamMask, nextEntry });
 			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-			for (int x = topLeftCellX; x <= bottomRightCellX; x++) {
-				for (int y = topLeftCellY; y <= bottomRightCellY; y++) {
-					int cellId = GetCellIdForCellCoords(x, y);
-					m_UsedCellIds.insert(cellId);
+	void SpatialPartitionGrid::GetPotentialMOsInCells(int topLeftCellX, int topLeftCellY, int bottomRightCellX, int bottomRightCellY, unsigned short queryTeamMask, std::vector<MovableObject *> &potentialMOs) const {
+		// MOs are usually in more than one of the cells, so each MOID is stamped with the query it was last found by and skipped if it's found again.
+		// The stamps are kept per thread because scripts on different threaded Lua states can query the grid at the same time.
+		thread_local std::vector<unsigned int> moidQueryStamps;
+		thread_local unsigned int queryStamp = 0;
 
-					m_Cells[team + 1][cellId].push_back(mo.GetID());
-					if (mo.GetsHitByMOs()) {
-						m_PhysicsCells[team + 1][cellId].push_back(mo.GetID());
+		queryStamp++;
+		if (queryStamp == 0) {
+			std::fill(moidQueryStamps.begin(), moidQueryStamps.end(), 0);
+			queryStamp = 1;
+		}
+
+		// Note - GetCellIdForCellCoords accounts for wrapping automatically, so we don't have to deal with it here.
+		for (int x = topLeftCellX; x <= bottomRightCellX; x++) {
+			for (int y = topLeftCellY; y <= bottomRightCellY; y++) {
+				for (MOID moid : CellMOIDs(this, GetFirstEntryOfCell(GetCellIdForCellCoords(x, y)), queryTeamMask)) {
+					if (moid >= static_cast<int>(moidQueryStamps.size())) { moidQueryStamps.resize(std::max(moid + 1, static_cast<int>(moidQueryStamps.size()) * 2), 0); }
+					if (moidQueryStamps[moid] == queryStamp) {
+						continue;
 					}
+					moidQueryStamps[moid] = queryStamp;
+
+					if (MovableObject *mo = g_MovableMan.GetMOFromID(moid)) { potentialMOs.push_back(mo); }
 				}
 			}
 		}
 	}
-	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	std::vector<MovableObject *> SpatialPartitionGrid::GetMOsInBox(const Box &box, int ignoreTeam, bool getsHitByMOsOnly) const {
 		RTEAssert(ignoreTeam >= Activity::NoTeam && ignoreTeam < Activity::MaxTeamCount, "Invalid ignoreTeam given to SpatialPartitioningGrid::GetMOsInBox()!");
 
-		std::unordered_set<MOID> potentialMOIDs;
-
 		Vector topLeft = box.GetCorner();
 		Vector bottomRight = topLeft + Vector(box.GetWidth(), box.GetHeight());
 
@@ -112,27 +136,15 @@ namespace RTE {
 		int bottomRightCellX = static_cast<int>(std::floor(bottomRight.m_X / static_cast<float>(m_CellSize)));
 		int bottomRightCellY = static_cast<int>(std::floor(bottomRight.m_Y / static_cast<float>(m_CellSize)));
 
-		// Note - GetCellIdForCellCoords accounts for wrapping automatically, so we don't have to deal with it here.
-		auto &cells = getsHitByMOsOnly ? m_PhysicsCells : m_Cells;
-		for (int x = topLeftCellX; x <= bottomRightCellX; x++) {
-			for (int y = topLeftCellY; y <= bottomRightCellY; y++) {
-				const std::vector<MOID> &moidsInCell = cells[ignoreTeam + 1][GetCellIdForCellCoords(x, y)];
-				for (MOID moid : moidsInCell) {
-					potentialMOIDs.insert(moid);
-				}
-			}
-		}
+		std::vector<MovableObject *> MOList;
+		GetPotentialMOsInCells(topLeftCellX, topLeftCellY, bottomRightCellX, bottomRightCellY, GetQueryTeamMask(ignoreTeam, getsHitByMOsOnly), MOList);
 
 		std::list<Box> wrappedBoxes;
 		g_SceneMan.WrapBox(box, wrappedBoxes);
 
-		std::vector<MovableObject *> MOList;
-		for (MOID moid : potentialMOIDs) {
-			MovableObject *mo = g_MovableMan.GetMOFromID(moid);
-			if (mo && std::any_of(wrappedBoxes.begin(), wrappedBoxes.end(), [&mo](const Box &wrappedBox) { return wrappedBox.IsWithinBox(mo->GetPos()); })) {
-				MOList.push_back(mo);
-			}
-		}
+		MOList.erase(std::remove_if(MOList.begin(), MOList.end(), [&wrappedBoxes](const MovableObject *mo) {
+			return std::none_of(wrappedBoxes.begin(), wrappedBoxes.end(), [&mo](const Box &wrappedBox) { return wrappedBox.IsWithinBox(mo->GetPos()); });
+		}), MOList.end());
 
 		return MOList;
 	}
@@ -142,38 +154,24 @@ namespace RTE {
 	std::vector<MovableObject *> SpatialPartitionGrid::GetMOsInRadius(const Vector &center, float radius, int ignoreTeam, bool getsHitByMOsOnly) const {
 		RTEAssert(ignoreTeam >= Activity::NoTeam && ignoreTeam < Activity::MaxTeamCount, "Invalid ignoreTeam given to SpatialPartitioningGrid::GetMOsInRadius()!");
 
-		std::unordered_set<MOID> potentialMOIDs;
-
 		int topLeftCellX = static_cast<int>(std::floor((center.m_X - radius) / static_cast<float>(m_CellSize)));
 		int topLeftCellY = static_cast<int>(std::floor((center.m_Y - radius) / static_cast<float>(m_CellSize)));
 		int bottomRightCellX = static_cast<int>(std::floor((center.m_X + radius) / static_cast<float>(m_CellSize)));
 		int bottomRightCellY = static_cast<int>(std::floor((center.m_Y + radius) / static_cast<float>(m_CellSize)));
 
-		// Note - GetCellIdForCellCoords accounts for wrapping automatically, so we don't have to deal with it here.
-		auto &cells = getsHitByMOsOnly ? m_PhysicsCells : m_Cells;
-		for (int x = topLeftCellX; x <= bottomRightCellX; x++) {
-			for (int y = topLeftCellY; y <= bottomRightCellY; y++) {
-				const std::vector<MOID> &moidsInCell = cells[ignoreTeam + 1][GetCellIdForCellCoords(x, y)];
-				for (MOID moid : moidsInCell) {
-					potentialMOIDs.insert(moid);
-				}
-			}
-		}
-
 		std::vector<MovableObject *> MOList;
-		for (MOID moid : potentialMOIDs) {
-			MovableObject *mo = g_MovableMan.GetMOFromID(moid);
-			if (mo && !g_SceneMan.ShortestDistance(center, mo->GetPos()).MagnitudeIsGreaterThan(radius)) {
-				MOList.push_back(mo);
-			}
-		}
+		GetPotentialMOsInCells(topLeftCellX, topLeftCellY, bottomRightCellX, bottomRightCellY, GetQueryTeamMask(ignoreTeam, getsHitByMOsOnly), MOList);
+
+		MOList.erase(std::remove_if(MOList.begin(), MOList.end(), [&center, radius](const MovableObject *mo) {
+			return g_SceneMan.ShortestDistance(center, mo->GetPos()).MagnitudeIsGreaterThan(radius);
+		}), MOList.end());
 
 		return MOList;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	const std::vector<MOID> & SpatialPartitionGrid::GetMOIDsAtPosition(int x, int y, int ignoreTeam, bool getsHitByMOsOnly) const {
+	SpatialPartitionGrid::CellMOIDs SpatialPartitionGrid::GetMOIDsAtPosition(int x, int y, int ignoreTeam, bool getsHitByMOsOnly) const {
 		int cellX = x / m_CellSize;
 		int cellY = y / m_CellSize;
 
@@ -182,8 +180,7 @@ namespace RTE {
 		// So let's sanity check this shit.
 		ignoreTeam = ignoreTeam < Activity::NoTeam || ignoreTeam >= Activity::MaxTeamCount ? Activity::NoTeam : ignoreTeam;
 
-		auto &cells = getsHitByMOsOnly ? m_PhysicsCells : m_Cells;
-		return cells[ignoreTeam + 1][GetCellIdForCellCoords(cellX, cellY)];
+		return CellMOIDs(this, GetFirstEntryOfCell(GetCellIdForCellCoords(cellX, cellY)), GetQueryTeamMask(ignoreTeam, getsHitByMOsOnly));
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -19,6 +19,70 @@ namespace RTE {
 
 	public:
 
+		/// <summary>
+		/// The MOIDs of one cell that can collide with one team, from the most to the least recently added. Only valid until the SpatialPartitionGrid is next added to or Reset.
+		/// </summary>
+		class CellMOIDs {
+
+		public:
+
+			/// <summary>
+			/// Forward iterator over the MOIDs of a CellMOIDs.
+			/// </summary>
+			class Iterator {
+
+			public:
+
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = MOID;
+				using difference_type = std::ptrdiff_t;
+				using pointer = const MOID *;
+				using reference = const MOID &;
+
+				/// <summary>
+				/// Constructor method used to instantiate an Iterator object in system memory.
+				/// </summary>
+				/// <param name="grid">The SpatialPartitionGrid the Entries belong to.</param>
+				/// <param name="entryIndex">The index of the Entry to start at, or -1 for the end.</param>
+				/// <param name="queryTeamMask">The mask to filter Entries with.</param>
+				Iterator(const SpatialPartitionGrid *grid, int entryIndex, unsigned short queryTeamMask) : m_Grid(grid), m_EntryIndex(entryIndex), m_QueryTeamMask(queryTeamMask) { SkipFilteredEntries(); }
+
+				reference operator*() const { return m_Grid->m_Entries[m_EntryIndex].ID; }
+				Iterator & operator++() { m_EntryIndex = m_Grid->m_Entries[m_EntryIndex].Next; SkipFilteredEntries(); return *this; }
+				Iterator operator++(int) { Iterator previous = *this; ++(*this); return previous; }
+				bool operator==(const Iterator &rhs) const { return m_EntryIndex == rhs.m_EntryIndex; }
+				bool operator!=(const Iterator &rhs) const { return m_EntryIndex != rhs.m_EntryIndex; }
+
+			private:
+
+				const SpatialPartitionGrid *m_Grid; //!< The SpatialPartitionGrid the Entries belong to.
+				int m_EntryIndex; //!< The index of the current Entry, or -1 at the end.
+				unsigned short m_QueryTeamMask; //!< The mask to filter Entries with.
+
+				/// <summary>
+				/// Advances to the first Entry from the current one that passes the filter.
+				/// </summary>
+				void SkipFilteredEntries() { while (m_EntryIndex >= 0 && !(m_Grid->m_Entries[m_EntryIndex].TeamMask & m_QueryTeamMask)) { m_EntryIndex = m_Grid->m_Entries[m_EntryIndex].Next; } }
+			};
+
+			/// <summary>
+			/// Constructor method used to instantiate a CellMOIDs object in system memory.
+			/// </summary>
+			/// <param name="grid">The SpatialPartitionGrid the cell belongs to.</param>
+			/// <param name="firstEntry">The index of the first Entry of the cell, or -1 if it has none.</param>
+			/// <param name="queryTeamMask">The mask to filter Entries with.</param>
+			CellMOIDs(const SpatialPartitionGrid *grid, int firstEntry, unsigned short queryTeamMask) : m_Grid(grid), m_FirstEntry(firstEntry), m_QueryTeamMask(queryTeamMask) {}
+
+			Iterator begin() const { return Iterator(m_Grid, m_FirstEntry, m_QueryTeamMask); }
+			Iterator end() const { return Iterator(m_Grid, -1, m_QueryTeamMask); }
+
+		private:
+
+			const SpatialPartitionGrid *m_Grid; //!< The SpatialPartitionGrid the cell belongs to.
+			int m_FirstEntry; //!< The index of the first Entry of the cell, or -1 if it has none.
+			unsigned short m_QueryTeamMask; //!< The mask to filter Entries with.
+		};
+
 #pragma region Creation
 		/// <summary>
 		/// Constructor method used to instantiate a SpatialPartitionGrid object.
@@ -83,22 +147,66 @@ namespace RTE {
 		/// <param name="y">The Y coordinate to check.</param>
 		/// <param name="ignoreTeam">The team to ignore when getting MOIDs.</param>
 		/// <param name="getsHitByMOsOnly">Whether to only include MOs that have GetsHitByMOs enabled, or all MOs.</param>
-		/// <returns>A vector of MOIDs that are potentially overlapping the x and y coordinates.</returns>
-		const std::vector<int> & GetMOIDsAtPosition(int x, int y, int ignoreTeam, bool getsHitByMOsOnly) const;
+		/// <returns>The MOIDs that are potentially overlapping the x and y coordinates, from the most to the least recently added.</returns>
+		CellMOIDs GetMOIDsAtPosition(int x, int y, int ignoreTeam, bool getsHitByMOsOnly) const;
 #pragma endregion
 
 	private:
 
+		static constexpr int c_PhysicsTeamMaskShift = 8; //!< How far the team bits of an Entry's TeamMask are shifted to mark that it also collides with that team as a GetsHitByMOs MO.
+
+		/// <summary>
+		/// An MO added to a cell. All Entries live in one pool, and each cell's Entries are linked from the most to the least recently added.
+		/// </summary>
+		struct Entry {
+			MOID ID; //!< The MOID of the MO.
+			unsigned short TeamMask; //!< Bit team + 1 is set if the MO can collide with that team, and bit team + 1 + c_PhysicsTeamMaskShift if it also GetsHitByMOs.
+			int Next; //!< The index of the next Entry in the same cell, or -1 if this is the last one.
+		};
+
+		/// <summary>
+		/// A cell of the grid. Its Entries are only valid if its Generation matches the grid's, so the whole grid can be emptied by bumping the grid's Generation.
+		/// </summary>
+		struct Cell {
+			unsigned int Generation; //!< The Generation of the grid this Cell's Entries were added in.
+			int FirstEntry; //!< The index of the most recently added Entry of this Cell, or -1 if it has none.
+		};
+
 		int m_Width; //!< The width of the SpatialPartitionGrid, in cells.
 		int m_Height; //!< The height of the SpatialPartitionGrid, in cells.
 		int m_CellSize; //!< The size of each of the SpatialPartitionGrid's cells, in pixels.
 
-		// We store a list per team, so overlapping Actors don't waste loads of time collision checking against themselves.
-		// Note that this is this list of MOIDs that are potentially colliding per team, so the list for team 1 contains the MOIDs for team 2, 3, 4, and no-team, as well as anything for team 1 that doesn't ignore team hits.
-		std::array<std::vector<std::vector<int>>, Activity::MaxTeamCount + 1> m_Cells; //!< Array of cells for each team. The outside-vector is the vector of cells for the team, and each inside-vector entry contains all MOIDs in the cell's space that can collide with that team.
-		std::array<std::vector<std::vector<int>>, Activity::MaxTeamCount + 1> m_PhysicsCells; //!< Same as m_Cells, but includes only objects that are GetsHitByMOs.
+		// Each Entry is tagged with the teams it can collide with, so overlapping Actors don't waste loads of time collision checking against themselves.
+		// Note that these are the teams an MO is potentially colliding with, so an MO of team 1 is tagged with team 2, 3, 4, and no-team, as well as team 1 if it doesn't ignore team hits.
+		std::vector<Cell> m_Cells; //!< The cells of the grid, row by row.
+		std::vector<Entry> m_Entries; //!< The pool of Entries of all the cells, in the order they were added.
+		unsigned int m_Generation; //!< The current Generation of the grid. Cells from any other Generation are empty.
 
-		std::unordered_set<int> m_UsedCellIds; //!< Set of used cell Ids, maintained to avoid wasting time looping through and clearing unused cells.
+		/// <summary>
+		/// Gets the mask a query ignoring the given team checks Entries' TeamMasks with.
+		/// </summary>
+		/// <param name="ignoreTeam">The team to ignore.</param>
+		/// <param name="getsHitByMOsOnly">Whether to only include MOs that have GetsHitByMOs enabled, or all MOs.</param>
+		/// <returns>The mask of the team bit to check.</returns>
+		static unsigned short GetQueryTeamMask(int ignoreTeam, bool getsHitByMOsOnly) { return static_cast<unsigned short>(1 << (ignoreTeam + 1 + (getsHitByMOsOnly ? c_PhysicsTeamMaskShift : 0))); }
+
+		/// <summary>
+		/// Gets the index of the first Entry of the cell with the given Id, or -1 if the cell is empty this Generation.
+		/// </summary>
+		/// <param name="cellId">The Id of the cell.</param>
+		/// <returns>The index of the first Entry of the cell, or -1 if it has none.</returns>
+		int GetFirstEntryOfCell(int cellId) const { return m_Cells[cellId].Generation == m_Generation ? m_Cells[cellId].FirstEntry : -1; }
+
+		/// <summary>
+		/// Gets all the MovableObjects in the cells between the given cell coordinates that can collide with the given team, each only once. Shared by GetMOsInBox and GetMOsInRadius.
+		/// </summary>
+		/// <param name="topLeftCellX">The X coordinate of the top left cell.</param>
+		/// <param name="topLeftCellY">The Y coordinate of the top left cell.</param>
+		/// <param name="bottomRightCellX">The X coordinate of the bottom right cell.</param>
+		/// <param name="bottomRightCellY">The Y coordinate of the bottom right cell.</param>
+		/// <param name="queryTeamMask">The mask from GetQueryTeamMask to filter Entries with.</param>
+		/// <param name="potentialMOs">The vector to add the found MovableObjects to.</param>
+		void GetPotentialMOsInCells(int topLeftCellX, int topLeftCellY, int bottomRightCellX, int bottomRightCellY, unsigned short queryTeamMask, std::vector<MovableObject *> &potentialMOs) const;
 
 		/// <summary>
 		/// Gets the Id of the cell at the given SpatialPartitionGrid coordinates, automatically accounting for wrapping.
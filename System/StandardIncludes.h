@@ -55,6 +55,8 @@
 #include <functional>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <future>
 #include <cctype>
 #include <string>
 #include <cstring>
@@ -84,6 +86,9 @@
 #include <atomic>
 #include <execution>
 #include <source_location>
+#include <variant>
+#include <bit>
+#include <shared_mutex>
 #include <regex>
 
 namespace std {
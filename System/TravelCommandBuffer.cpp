@@ -0,0 +1,33 @@
+#include "TravelCommandBuffer.h"
+
+namespace RTE {
+
+	thread_local TravelCommandBuffer *TravelCommandBuffer::s_ActiveBuffer = nullptr;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TravelCommandBuffer::Begin(uint64_t seed) {
+		RTEAssert(!s_ActiveBuffer, "Trying to begin a TravelCommandBuffer while another one is active on the same thread!");
+		s_ActiveBuffer = this;
+		m_RandomGenerator.Seed(seed);
+		g_ThreadRandomGenerator = &m_RandomGenerator;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TravelCommandBuffer::End() {
+		s_ActiveBuffer = nullptr;
+		g_ThreadRandomGenerator = nullptr;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void TravelCommandBuffer::Execute() {
+		RTEAssert(s_ActiveBuffer != this, "Trying to execute a TravelCommandBuffer that is still active!");
+		for (Command &command : m_Commands) {
+			command();
+		}
+		m_Commands.clear();
+		m_RemovedTerrainPixels.clear();
+	}
+}
@@ -0,0 +1,104 @@
+#ifndef _RTETRAVELCOMMANDBUFFER_
+#define _RTETRAVELCOMMANDBUFFER_
+
+#include "RTETools.h"
+
+namespace RTE {
+
+	/// <summary>
+	/// A buffer of side effects produced while a chunk of MovableObjects travels in parallel with other chunks.
+	/// While a buffer is active on a thread, anything that would mutate shared state (terrain, MO lists, script callbacks) is recorded instead, and later executed in order on the main thread.
+	/// </summary>
+	class TravelCommandBuffer {
+
+	public:
+
+		/// <summary>
+		/// A deferred side effect.
+		/// </summary>
+		using Command = std::function<void()>;
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a TravelCommandBuffer object in system memory.
+		/// </summary>
+		TravelCommandBuffer() = default;
+#pragma endregion
+
+#pragma region Getters
+		/// <summary>
+		/// Gets the TravelCommandBuffer active on the calling thread, if any.
+		/// </summary>
+		/// <returns>The active TravelCommandBuffer, or nullptr if side effects should be applied immediately.</returns>
+		static TravelCommandBuffer * GetActive() { return s_ActiveBuffer; }
+
+		/// <summary>
+		/// Gets whether this TravelCommandBuffer has no commands waiting to be executed.
+		/// </summary>
+		/// <returns>Whether this TravelCommandBuffer is empty.</returns>
+		bool IsEmpty() const { return m_Commands.empty(); }
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Makes this TravelCommandBuffer the active one on the calling thread, and gives the thread its own random number generator so results don't depend on scheduling.
+		/// </summary>
+		/// <param name="seed">The seed for this buffer's random number generator.</param>
+		void Begin(uint64_t seed);
+
+		/// <summary>
+		/// Deactivates this TravelCommandBuffer on the calling thread. Recorded commands are kept until Execute is called.
+		/// </summary>
+		void End();
+
+		/// <summary>
+		/// Records a side effect to be executed later.
+		/// </summary>
+		/// <param name="command">The side effect to record.</param>
+		void Defer(Command &&command) { m_Commands.emplace_back(std::move(command)); }
+
+		/// <summary>
+		/// Executes all recorded commands in the order they were recorded, then clears this TravelCommandBuffer.
+		/// </summary>
+		void Execute();
+#pragma endregion
+
+#pragma region Terrain Overlay
+		/// <summary>
+		/// Marks a terrain pixel as about to be removed by a deferred command, so further reads through this buffer treat it as air.
+		/// </summary>
+		/// <param name="posX">The X coordinate of the pixel, already wrapped.</param>
+		/// <param name="posY">The Y coordinate of the pixel, already wrapped.</param>
+		void MarkTerrainPixelRemoved(int posX, int posY) { m_RemovedTerrainPixels.insert(PackPixelPos(posX, posY)); }
+
+		/// <summary>
+		/// Gets whether a terrain pixel was marked as removed through this buffer.
+		/// </summary>
+		/// <param name="posX">The X coordinate of the pixel, already wrapped.</param>
+		/// <param name="posY">The Y coordinate of the pixel, already wrapped.</param>
+		/// <returns>Whether the pixel was marked as removed.</returns>
+		bool IsTerrainPixelRemoved(int posX, int posY) const { return !m_RemovedTerrainPixels.empty() && m_RemovedTerrainPixels.contains(PackPixelPos(posX, posY)); }
+#pragma endregion
+
+	private:
+
+		static thread_local TravelCommandBuffer *s_ActiveBuffer; //!< The TravelCommandBuffer active on the current thread.
+
+		std::vector<Command> m_Commands; //!< The recorded side effects, in the order they were recorded.
+		std::unordered_set<uint64_t> m_RemovedTerrainPixels; //!< Terrain pixels that deferred commands will remove, packed with PackPixelPos.
+		RandomGenerator m_RandomGenerator; //!< The random number generator used by the thread this buffer is active on.
+
+		/// <summary>
+		/// Packs the coordinates of a terrain pixel into a single key for the set of removed terrain pixels.
+		/// </summary>
+		/// <param name="posX">The X coordinate of the pixel.</param>
+		/// <param name="posY">The Y coordinate of the pixel.</param>
+		/// <returns>The packed coordinates.</returns>
+		static uint64_t PackPixelPos(int posX, int posY) { return (static_cast<uint64_t>(static_cast<uint32_t>(posX)) << 32) | static_cast<uint32_t>(posY); }
+
+		// Disallow the use of some implicit methods.
+		TravelCommandBuffer(const TravelCommandBuffer &reference) = delete;
+		TravelCommandBuffer & operator=(const TravelCommandBuffer &rhs) = delete;
+	};
+}
+#endif
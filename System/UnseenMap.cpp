@@ -0,0 +1,171 @@
+#include "UnseenMap.h"
+
+#include "Constants.h"
+#include "RTEError.h"
+#include "SIMD.h"
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void UnseenMap::Clear() {
+		m_Width = 0;
+		m_Height = 0;
+		m_WordsPerRow = 0;
+		m_TileRows = 0;
+		m_Bits.clear();
+		m_RowUnseenCounts.clear();
+		m_TileUnseenCounts.clear();
+		m_UnseenCount = 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int UnseenMap::Create(BITMAP *unseenBitmap) {
+		Clear();
+		if (!unseenBitmap || unseenBitmap->w <= 0 || unseenBitmap->h <= 0) {
+			return -1;
+		}
+		m_Width = unseenBitmap->w;
+		m_Height = unseenBitmap->h;
+		m_WordsPerRow = (m_Width + c_TileWidth - 1) / c_TileWidth;
+		m_TileRows = (m_Height + c_TileHeight - 1) / c_TileHeight;
+		m_Bits.assign(static_cast<size_t>(m_WordsPerRow) * m_Height, 0);
+		m_RowUnseenCounts.assign(m_Height, 0);
+		m_TileUnseenCounts.assign(static_cast<size_t>(m_WordsPerRow) * m_TileRows, 0);
+
+		// Unseen layers are 8bpp memory bitmaps, so their rows can be compared against the mask color 16 pixels at a time. Anything else goes through getpixel.
+		bool directAccess = bitmap_color_depth(unseenBitmap) == 8 && is_memory_bitmap(unseenBitmap);
+		for (int posY = 0; posY < m_Height; ++posY) {
+			uint64_t *rowBits = &m_Bits[static_cast<size_t>(posY) * m_WordsPerRow];
+			int posX = 0;
+			if (directAccess) {
+				const unsigned char *line = unseenBitmap->line[posY];
+#ifdef RTE_SIMD_SSE2
+				const __m128i maskColor = _mm_set1_epi8(static_cast<char>(g_MaskColor));
+				for (; posX + 16 <= m_Width; posX += 16) {
+					unsigned int seenMask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(line + posX)), maskColor)));
+					rowBits[posX / c_TileWidth] |= static_cast<uint64_t>(~seenMask & 0xFFFF) << (posX % c_TileWidth);
+				}
+#endif
+				for (; posX < m_Width; ++posX) {
+					if (line[posX] != g_MaskColor) { rowBits[posX / c_TileWidth] |= GetBit(posX); }
+				}
+			} else {
+				for (; posX < m_Width; ++posX) {
+					if (getpixel(unseenBitmap, posX, posY) != g_MaskColor) { rowBits[posX / c_TileWidth] |= GetBit(posX); }
+				}
+			}
+			CountRow(posY);
+		}
+		return 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void UnseenMap::CountRow(int posY) {
+		const uint64_t *rowBits = &m_Bits[static_cast<size_t>(posY) * m_WordsPerRow];
+		int *tileCounts = &m_TileUnseenCounts[static_cast<size_t>(posY / c_TileHeight) * m_WordsPerRow];
+		for (int wordX = 0; wordX < m_WordsPerRow; ++wordX) {
+			int wordCount = std::popcount(rowBits[wordX]);
+			tileCounts[wordX] += wordCount;
+			m_RowUnseenCounts[posY] += wordCount;
+			m_UnseenCount += wordCount;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool UnseenMap::SetWord(int wordX, int posY, uint64_t newWord) {
+		uint64_t &word = m_Bits[static_cast<size_t>(posY) * m_WordsPerRow + wordX];
+		if (word == newWord) {
+			return false;
+		}
+		int countChange = std::popcount(newWord) - std::popcount(word);
+		word = newWord;
+		m_TileUnseenCounts[static_cast<size_t>(posY / c_TileHeight) * m_WordsPerRow + wordX] += countChange;
+		m_RowUnseenCounts[posY] += countChange;
+		m_UnseenCount += countChange;
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool UnseenMap::SetPixel(int posX, int posY, bool unseen) {
+		if (!IsOnMap(posX, posY)) {
+			return false;
+		}
+		uint64_t word = m_Bits[GetWordIndex(posX, posY)];
+		return SetWord(posX / c_TileWidth, posY, unseen ? (word | GetBit(posX)) : (word & ~GetBit(posX)));
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void UnseenMap::SetBox(int left, int top, int right, int bottom, bool unseen) {
+		if (right < left) { std::swap(left, right); }
+		if (bottom < top) { std::swap(top, bottom); }
+		left = std::max(left, 0);
+		top = std::max(top, 0);
+		right = std::min(right, m_Width - 1);
+		bottom = std::min(bottom, m_Height - 1);
+		if (left > right || top > bottom) {
+			return;
+		}
+
+		int firstWord = left / c_TileWidth;
+		int lastWord = right / c_TileWidth;
+		for (int posY = top; posY <= bottom; ++posY) {
+			// Revealing can skip rows and tiles that have nothing left to reveal.
+			if (!unseen && m_RowUnseenCounts[posY] == 0) {
+				continue;
+			}
+			const int *tileCounts = &m_TileUnseenCounts[static_cast<size_t>(posY / c_TileHeight) * m_WordsPerRow];
+			const uint64_t *rowBits = &m_Bits[static_cast<size_t>(posY) * m_WordsPerRow];
+			for (int wordX = firstWord; wordX <= lastWord; ++wordX) {
+				if (!unseen && tileCounts[wordX] == 0) {
+					continue;
+				}
+				int firstBit = (wordX == firstWord) ? left % c_TileWidth : 0;
+				int lastBit = (wordX == lastWord) ? right % c_TileWidth : c_TileWidth - 1;
+				uint64_t boxMask = (~uint64_t(0) >> (c_TileWidth - 1 - lastBit)) & (~uint64_t(0) << firstBit);
+				SetWord(wordX, posY, unseen ? (rowBits[wordX] | boxMask) : (rowBits[wordX] & ~boxMask));
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool UnseenMap::AnythingUnseenInBox(int left, int top, int right, int bottom) const {
+		if (right < left) { std::swap(left, right); }
+		if (bottom < top) { std::swap(top, bottom); }
+		left = std::max(left, 0);
+		top = std::max(top, 0);
+		right = std::min(right, m_Width - 1);
+		bottom = std::min(bottom, m_Height - 1);
+		if (left > right || top > bottom || m_UnseenCount == 0) {
+			return false;
+		}
+
+		int firstWord = left / c_TileWidth;
+		int lastWord = right / c_TileWidth;
+		for (int tileY = top / c_TileHeight; tileY <= bottom / c_TileHeight; ++tileY) {
+			const int *tileCounts = &m_TileUnseenCounts[static_cast<size_t>(tileY) * m_WordsPerRow];
+			int rowStart = std::max(top, tileY * c_TileHeight);
+			int rowEnd = std::min(bottom, tileY * c_TileHeight + c_TileHeight - 1);
+			for (int wordX = firstWord; wordX <= lastWord; ++wordX) {
+				if (tileCounts[wordX] == 0) {
+					continue;
+				}
+				int firstBit = (wordX == firstWord) ? left % c_TileWidth : 0;
+				int lastBit = (wordX == lastWord) ? right % c_TileWidth : c_TileWidth - 1;
+				uint64_t boxMask = (~uint64_t(0) >> (c_TileWidth - 1 - lastBit)) & (~uint64_t(0) << firstBit);
+				for (int posY = rowStart; posY <= rowEnd; ++posY) {
+					if (m_Bits[static_cast<size_t>(posY) * m_WordsPerRow + wordX] & boxMask) {
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,183 @@
+#ifndef _RTEUNSEENMAP_
+#define _RTEUNSEENMAP_
+
+struct BITMAP;
+
+namespace RTE {
+
+	/// <summary>
+	/// A packed bitset of which pixels of a team's unseen layer are still unseen, with running counts of unseen pixels per row, per tile and in total.
+	/// The unseen layer's bitmap is only what gets drawn, this is what the unseen state of the layer is checked and changed through.
+	/// </summary>
+	class UnseenMap {
+
+	public:
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate an UnseenMap object in system memory. Create() should be called before using the object.
+		/// </summary>
+		UnseenMap() { Clear(); }
+
+		/// <summary>
+		/// Makes the UnseenMap object ready for use, matching the pixels of an unseen layer's bitmap. Any pixel that isn't the mask color is unseen.
+		/// </summary>
+		/// <param name="unseenBitmap">The unseen layer bitmap to read the unseen pixels from. Ownership is NOT transferred!</param>
+		/// <returns>An error return value signaling success or any particular failure. Anything below 0 is an error signal.</returns>
+		int Create(BITMAP *unseenBitmap);
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Resets the entire UnseenMap, including its inherited members, to their default settings or values.
+		/// </summary>
+		void Reset() { Clear(); }
+#pragma endregion
+
+#pragma region Getters
+		/// <summary>
+		/// Gets whether this UnseenMap was created from a bitmap.
+		/// </summary>
+		/// <returns>Whether this UnseenMap was created from a bitmap.</returns>
+		bool IsCreated() const { return m_Width > 0 && m_Height > 0; }
+
+		/// <summary>
+		/// Gets whether any pixel of this UnseenMap is still unseen.
+		/// </summary>
+		/// <returns>Whether anything is still unseen.</returns>
+		bool AnythingUnseen() const { return m_UnseenCount > 0; }
+
+		/// <summary>
+		/// Gets whether a pixel of this UnseenMap is still unseen. Pixels off the map count as unseen, same as the unseen layer's bitmap treats them.
+		/// </summary>
+		/// <param name="posX">The X coordinate of the pixel.</param>
+		/// <param name="posY">The Y coordinate of the pixel.</param>
+		/// <returns>Whether the pixel is unseen.</returns>
+		bool IsUnseen(int posX, int posY) const { return !IsOnMap(posX, posY) || (m_Bits[GetWordIndex(posX, posY)] & GetBit(posX)) != 0; }
+
+		/// <summary>
+		/// Gets whether any pixel in a box of this UnseenMap is still unseen. Whole tiles that are fully seen are skipped without looking at their pixels.
+		/// </summary>
+		/// <param name="left">The left edge of the box, inclusive.</param>
+		/// <param name="top">The top edge of the box, inclusive.</param>
+		/// <param name="right">The right edge of the box, inclusive.</param>
+		/// <param name="bottom">The bottom edge of the box, inclusive.</param>
+		/// <returns>Whether anything in the part of the box that is on the map is unseen.</returns>
+		bool AnythingUnseenInBox(int left, int top, int right, int bottom) const;
+#pragma endregion
+
+#pragma region Concrete Methods
+		/// <summary>
+		/// Makes a pixel of this UnseenMap seen.
+		/// </summary>
+		/// <param name="posX">The X coordinate of the pixel.</param>
+		/// <param name="posY">The Y coordinate of the pixel.</param>
+		/// <returns>Whether the pixel was on the map and unseen before.</returns>
+		bool Reveal(int posX, int posY) { return SetPixel(posX, posY, false); }
+
+		/// <summary>
+		/// Makes a pixel of this UnseenMap unseen.
+		/// </summary>
+		/// <param name="posX">The X coordinate of the pixel.</param>
+		/// <param name="posY">The Y coordinate of the pixel.</param>
+		/// <returns>Whether the pixel was on the map and seen before.</returns>
+		bool Restore(int posX, int posY) { return SetPixel(posX, posY, true); }
+
+		/// <summary>
+		/// Makes a box of this UnseenMap seen. The box is clipped to the map, same as rectfill does.
+		/// </summary>
+		/// <param name="left">The left edge of the box, inclusive.</param>
+		/// <param name="top">The top edge of the box, inclusive.</param>
+		/// <param name="right">The right edge of the box, inclusive.</param>
+		/// <param name="bottom">The bottom edge of the box, inclusive.</param>
+		void RevealBox(int left, int top, int right, int bottom) { SetBox(left, top, right, bottom, false); }
+
+		/// <summary>
+		/// Makes a box of this UnseenMap unseen. The box is clipped to the map, same as rectfill does.
+		/// </summary>
+		/// <param name="left">The left edge of the box, inclusive.</param>
+		/// <param name="top">The top edge of the box, inclusive.</param>
+		/// <param name="right">The right edge of the box, inclusive.</param>
+		/// <param name="bottom">The bottom edge of the box, inclusive.</param>
+		void RestoreBox(int left, int top, int right, int bottom) { SetBox(left, top, right, bottom, true); }
+#pragma endregion
+
+	private:
+
+		static constexpr int c_TileWidth = 64; //!< The width of a tile of unseen counts, in pixels. Matches the bits of one word, so each word of a row belongs to exactly one tile.
+		static constexpr int c_TileHeight = 64; //!< The height of a tile of unseen counts, in pixels.
+
+		int m_Width; //!< The width of the map, in pixels.
+		int m_Height; //!< The height of the map, in pixels.
+		int m_WordsPerRow; //!< How many words of bits each row takes up. Also the number of tile columns.
+		int m_TileRows; //!< The number of tile rows.
+
+		std::vector<uint64_t> m_Bits; //!< The unseen bits of all pixels, row by row. A set bit is unseen. Bits past the width of a row are always clear.
+		std::vector<int> m_RowUnseenCounts; //!< How many pixels are unseen in each row.
+		std::vector<int> m_TileUnseenCounts; //!< How many pixels are unseen in each tile, tile row by tile row.
+		int m_UnseenCount; //!< How many pixels are unseen in total.
+
+		/// <summary>
+		/// Gets whether a pixel is on the map.
+		/// </summary>
+		/// <param name="posX">The X coordinate of the pixel.</param>
+		/// <param name="posY">The Y coordinate of the pixel.</param>
+		/// <returns>Whether the pixel is on the map.</returns>
+		bool IsOnMap(int posX, int posY) const { return posX >= 0 && posX < m_Width && posY >= 0 && posY < m_Height; }
+
+		/// <summary>
+		/// Gets the index of the word holding the bit of a pixel.
+		/// </summary>
+		/// <param name="posX">The X coordinate of the pixel.</param>
+		/// <param name="posY">The Y coordinate of the pixel.</param>
+		/// <returns>The index of the word in m_Bits.</returns>
+		int GetWordIndex(int posX, int posY) const { return posY * m_WordsPerRow + (posX / c_TileWidth); }
+
+		/// <summary>
+		/// Gets the bit of a pixel within its word.
+		/// </summary>
+		/// <param name="posX">The X coordinate of the pixel.</param>
+		/// <returns>The word with only the pixel's bit set.</returns>
+		static uint64_t GetBit(int posX) { return uint64_t(1) << (posX % c_TileWidth); }
+
+		/// <summary>
+		/// Replaces a word of bits and updates the unseen counts of its row, tile and the whole map to match.
+		/// </summary>
+		/// <param name="wordX">The index of the word within its row.</param>
+		/// <param name="posY">The Y coordinate of the row.</param>
+		/// <param name="newWord">The new bits of the word.</param>
+		/// <returns>Whether any bit changed.</returns>
+		bool SetWord(int wordX, int posY, uint64_t newWord);
+
+		/// <summary>
+		/// Sets whether a pixel is unseen.
+		/// </summary>
+		/// <param name="posX">The X coordinate of the pixel.</param>
+		/// <param name="posY">The Y coordinate of the pixel.</param>
+		/// <param name="unseen">Whether the pixel should be unseen.</param>
+		/// <returns>Whether the pixel was on the map and changed.</returns>
+		bool SetPixel(int posX, int posY, bool unseen);
+
+		/// <summary>
+		/// Sets whether all pixels of a box are unseen, clipped to the map.
+		/// </summary>
+		/// <param name="left">The left edge of the box, inclusive.</param>
+		/// <param name="top">The top edge of the box, inclusive.</param>
+		/// <param name="right">The right edge of the box, inclusive.</param>
+		/// <param name="bottom">The bottom edge of the box, inclusive.</param>
+		/// <param name="unseen">Whether the pixels should be unseen.</param>
+		void SetBox(int left, int top, int right, int bottom, bool unseen);
+
+		/// <summary>
+		/// Adds the unseen bits of a freshly read row to the unseen counts.
+		/// </summary>
+		/// <param name="posY">The Y coordinate of the row.</param>
+		void CountRow(int posY);
+
+		/// <summary>
+		/// Clears all the member variables of this UnseenMap, effectively resetting the members of this abstraction level only.
+		/// </summary>
+		void Clear();
+	};
+}
+#endif
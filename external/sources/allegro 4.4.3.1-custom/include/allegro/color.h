@@ -41,7 +41,7 @@ typedef struct {
 } COLOR_MAP;
 
 AL_VAR(RGB_MAP *, rgb_map);
-AL_VAR(COLOR_MAP *, color_map);
+AL_TLS_VAR(COLOR_MAP *, color_map);
 
 AL_VAR(PALETTE, _current_palette);
 
@@ -424,12 +424,12 @@ AL_VAR(int, _dispsw_status);
 
 
 /* current drawing mode */
-AL_VAR(int, _drawing_mode);
-AL_VAR(BITMAP *, _drawing_pattern);
-AL_VAR(int, _drawing_x_anchor);
-AL_VAR(int, _drawing_y_anchor);
-AL_VAR(unsigned int, _drawing_x_mask);
-AL_VAR(unsigned int, _drawing_y_mask);
+AL_TLS_VAR(int, _drawing_mode);
+AL_TLS_VAR(BITMAP *, _drawing_pattern);
+AL_TLS_VAR(int, _drawing_x_anchor);
+AL_TLS_VAR(int, _drawing_y_anchor);
+AL_TLS_VAR(unsigned int, _drawing_x_mask);
+AL_TLS_VAR(unsigned int, _drawing_y_mask);
 
 AL_FUNCPTR(int *, _palette_expansion_table, (int bpp));
 
@@ -446,21 +446,21 @@ AL_ARRAY(int, _palette_color24);
 AL_ARRAY(int, _palette_color32);
 
 /* truecolor blending functions */
-AL_VAR(BLENDER_FUNC, _blender_func15);
-AL_VAR(BLENDER_FUNC, _blender_func16);
-AL_VAR(BLENDER_FUNC, _blender_func24);
-AL_VAR(BLENDER_FUNC, _blender_func32);
+AL_TLS_VAR(BLENDER_FUNC, _blender_func15);
+AL_TLS_VAR(BLENDER_FUNC, _blender_func16);
+AL_TLS_VAR(BLENDER_FUNC, _blender_func24);
+AL_TLS_VAR(BLENDER_FUNC, _blender_func32);
 
-AL_VAR(BLENDER_FUNC, _blender_func15x);
-AL_VAR(BLENDER_FUNC, _blender_func16x);
-AL_VAR(BLENDER_FUNC, _blender_func24x);
+AL_TLS_VAR(BLENDER_FUNC, _blender_func15x);
+AL_TLS_VAR(BLENDER_FUNC, _blender_func16x);
+AL_TLS_VAR(BLENDER_FUNC, _blender_func24x);
 
-AL_VAR(int, _blender_col_15);
-AL_VAR(int, _blender_col_16);
-AL_VAR(int, _blender_col_24);
-AL_VAR(int, _blender_col_32);
+AL_TLS_VAR(int, _blender_col_15);
+AL_TLS_VAR(int, _blender_col_16);
+AL_TLS_VAR(int, _blender_col_24);
+AL_TLS_VAR(int, _blender_col_32);
 
-AL_VAR(int, _blender_alpha);
+AL_TLS_VAR(int, _blender_alpha);
 
 AL_FUNC(unsigned long, _blender_black, (unsigned long x, unsigned long y, unsigned long n));
 
@@ -217,6 +217,22 @@
    #define AL_ARRAY(type, name)                    extern type name[]
 #endif
 
+/* per-thread drawing state, so several threads can draw with their own
+ * drawing mode, blenders and color map at the same time. The i386 asm
+ * routines read that state as plain globals, so it stays shared there.
+ */
+#ifndef AL_TLS
+   #if (defined ALLEGRO_I386) && (!defined ALLEGRO_NO_ASM)
+      #define AL_TLS
+   #else
+      #define AL_TLS                               __thread
+   #endif
+#endif
+
+#ifndef AL_TLS_VAR
+   #define AL_TLS_VAR(type, name)                  extern AL_TLS type name
+#endif
+
 #ifndef AL_FUNC
    #define AL_FUNC(type, name, args)               type name args
 #endif
@@ -65,6 +65,15 @@
 #define AL_METHOD(type, name, args)    type (__cdecl *name) args
 #define AL_FUNCPTR(type, name, args)   extern _AL_DLL type (__cdecl *name) args
 
+/* thread-local variables can't be shared across a DLL boundary */
+#if defined ALLEGRO_STATICLINK
+   #define AL_TLS                      __declspec(thread)
+   #define AL_TLS_VAR(type, name)      extern AL_TLS type name
+#else
+   #define AL_TLS
+   #define AL_TLS_VAR(type, name)      AL_VAR(type, name)
+#endif
+
 #ifdef AL_INLINE
    #define END_OF_INLINE(name)         void *_force_instantiate_##name = name;
 #else
@@ -43,7 +43,7 @@ int _safe_gfx_mode_change = 0;         /* are we getting through GFX_SAFE? */
 
 RGB_MAP *rgb_map = NULL;               /* RGB -> palette entry conversion */
 
-COLOR_MAP *color_map = NULL;           /* translucency/lighting table */
+AL_TLS COLOR_MAP *color_map = NULL;    /* translucency/lighting table */
 
 int _color_depth = 8;                  /* how many bits per pixel? */
 
@@ -64,21 +64,21 @@ int _palette_color32[256];
 
 int *palette_color = _palette_color8; 
 
-BLENDER_FUNC _blender_func15 = NULL;   /* truecolor pixel blender routines */
-BLENDER_FUNC _blender_func16 = NULL;
-BLENDER_FUNC _blender_func24 = NULL;
-BLENDER_FUNC _blender_func32 = NULL;
+AL_TLS BLENDER_FUNC _blender_func15 = NULL;   /* truecolor pixel blender routines */
+AL_TLS BLENDER_FUNC _blender_func16 = NULL;
+AL_TLS BLENDER_FUNC _blender_func24 = NULL;
+AL_TLS BLENDER_FUNC _blender_func32 = NULL;
 
-BLENDER_FUNC _blender_func15x = NULL;
-BLENDER_FUNC _blender_func16x = NULL;
-BLENDER_FUNC _blender_func24x = NULL;
+AL_TLS BLENDER_FUNC _blender_func15x = NULL;
+AL_TLS BLENDER_FUNC _blender_func16x = NULL;
+AL_TLS BLENDER_FUNC _blender_func24x = NULL;
 
-int _blender_col_15 = 0;               /* for truecolor lit sprites */
-int _blender_col_16 = 0;
-int _blender_col_24 = 0;
-int _blender_col_32 = 0;
+AL_TLS int _blender_col_15 = 0;        /* for truecolor lit sprites */
+AL_TLS int _blender_col_16 = 0;
+AL_TLS int _blender_col_24 = 0;
+AL_TLS int _blender_col_32 = 0;
 
-int _blender_alpha = 0;                /* for truecolor translucent drawing */
+AL_TLS int _blender_alpha = 0;         /* for truecolor translucent drawing */
 
 int _rgb_r_shift_15 = DEFAULT_RGB_R_SHIFT_15;     /* truecolor pixel format */
 int _rgb_g_shift_15 = DEFAULT_RGB_G_SHIFT_15;